@@ -0,0 +1,88 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// Benchmark.h
+//========================================================================================================
+///
+/// File Description:
+///     Helpers for the benchmarks in src/bench/cpp.  A benchmark times a loop and records the result
+///     as a property of the running test, so it shows up in the gtest xml report instead of on the
+///     console.  Timings are never asserted; what the loop computed can be.
+///
+//========================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+namespace benchmark
+{
+    /// @brief      Time a loop
+    /// @param [in] int - number of iterations
+    /// @param [in] Body - called with the iteration number (0..iterations-1)
+    /// @return     double - average nanoseconds per iteration
+    template <typename Body>
+    double NsPerIteration
+    (
+        int         iterations,
+        Body        body
+    )
+    {
+        auto start = std::chrono::steady_clock::now();
+        for ( auto inx=0; inx<iterations; ++inx )
+        {
+            body( inx );
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>( end - start ).count() / iterations;
+    }
+
+    /// @brief      Record a result for the running benchmark
+    /// @param [in] const std::string& - property name (e.g. "state_machine_ns_per_cycle")
+    /// @param [in] double - value
+    inline void Record
+    (
+        const std::string&  name,
+        double              value
+    )
+    {
+        char text[32];
+        snprintf( text, sizeof( text ), "%.3f", value );
+        ::testing::Test::RecordProperty( name, text );
+    }
+
+    /// @brief      Record a count for the running benchmark
+    /// @param [in] const std::string& - property name (e.g. "state_machine_inits")
+    /// @param [in] int - value
+    inline void Record
+    (
+        const std::string&  name,
+        int                 value
+    )
+    {
+        ::testing::Test::RecordProperty( name, value );
+    }
+}
@@ -0,0 +1,183 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// StateMachineBenchmark.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Per-cycle cost of the table driven StateMachine dispatch against the if/else button chain the
+///     shooter state manager used before it.  The chain read the shoot button and all four prepare
+///     buttons every cycle and re-initialized the selected state on every cycle its button was held;
+///     the state machine only checks the transitions out of the current state and initializes a
+///     state once per press.  The blue button is held for 50 cycles out of every 350.
+///
+///     The scripted pad inlines its button reads and the states' Init is a counter, so this measures
+///     the dispatch alone and favors the chain:  on the robot each read goes through TeleopControl and
+///     the gamepad, and each Init re-sends the motor control constants.  The Init counts are asserted.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <array>
+#include <cstdint>
+
+// FRC includes
+
+// Team 302 includes
+#include <Benchmark.h>
+#include <gamepad/TeleopControl.h>
+#include <states/IState.h>
+#include <states/StateMachine.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+namespace
+{
+    constexpr int CYCLES = 350 * 6000;
+
+    /// @brief  buttons for one cycle; a press is a button that is down now and was up last cycle
+    class ScriptedPad
+    {
+        public:
+            void SetButtons( uint64_t down )
+            {
+                m_previous = m_down;
+                m_down = down;
+            }
+
+            bool IsButtonPressed( TeleopControl::FUNCTION_IDENTIFIER function ) const
+            {
+                return ( m_down >> function ) & 1U;
+            }
+
+            bool WasButtonPressed( TeleopControl::FUNCTION_IDENTIFIER function ) const
+            {
+                return IsButtonPressed( function ) && ( ( m_previous >> function ) & 1U ) == 0;
+            }
+
+        private:
+            uint64_t    m_down = 0;
+            uint64_t    m_previous = 0;
+    };
+
+    class CountingState : public IState
+    {
+        public:
+            void Init() override { ++m_inits; }
+            void Run() override {}
+            bool AtTarget() const override { return true; }
+
+            int     m_inits = 0;
+    };
+
+    enum SHOOTER_STATE
+    {
+        OFF,
+        GREEN,
+        YELLOW,
+        BLUE,
+        RED,
+        MAX_SHOOTER_STATES
+    };
+    using ShooterMachine = StateMachine<SHOOTER_STATE, MAX_SHOOTER_STATES>;
+
+    constexpr std::array<const char*, MAX_SHOOTER_STATES> STATE_NAMES =
+    {
+        "SHOOTEROFF", "SHOOTERSHOOTGREEN", "SHOOTERSHOOTYELLOW", "SHOOTERSHOOTBLUE", "SHOOTERSHOOTRED"
+    };
+
+    constexpr std::array<ShooterMachine::Transition, 4> TRANSITIONS =
+    {{
+        { MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_GREEN,  GREEN,  nullptr },
+        { MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_YELLOW, YELLOW, nullptr },
+        { MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_BLUE,   BLUE,   nullptr },
+        { MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_RED,    RED,    nullptr }
+    }};
+
+    uint64_t ButtonsFor( int cycle )
+    {
+        return ( cycle / 50 ) % 7 == 3 ? uint64_t( 1 ) << TeleopControl::SHOOTER_PREPARE_TO_SHOOT_BLUE : 0;
+    }
+}
+
+TEST( StateMachineBenchmark, DispatchAgainstButtonChain )
+{
+    ScriptedPad pad;
+    std::array<CountingState, MAX_SHOOTER_STATES> chainStates;
+    auto current = OFF;
+    auto chainHoldCycles = 0;
+    auto chainNs = benchmark::NsPerIteration( CYCLES, [&]( int cycle )
+    {
+        pad.SetButtons( ButtonsFor( cycle ) );
+        if ( !pad.IsButtonPressed( TeleopControl::SHOOTER_SHOOT ) && current != OFF )
+        {
+            ++chainHoldCycles;
+        }
+
+        if ( pad.IsButtonPressed( TeleopControl::SHOOTER_PREPARE_TO_SHOOT_GREEN ) )
+        {
+            current = GREEN;
+            chainStates[GREEN].Init();
+        }
+        else if ( pad.IsButtonPressed( TeleopControl::SHOOTER_PREPARE_TO_SHOOT_YELLOW ) )
+        {
+            current = YELLOW;
+            chainStates[YELLOW].Init();
+        }
+        else if ( pad.IsButtonPressed( TeleopControl::SHOOTER_PREPARE_TO_SHOOT_BLUE ) )
+        {
+            current = BLUE;
+            chainStates[BLUE].Init();
+        }
+        else if ( pad.IsButtonPressed( TeleopControl::SHOOTER_PREPARE_TO_SHOOT_RED ) )
+        {
+            current = RED;
+            chainStates[RED].Init();
+        }
+    } );
+
+    std::array<CountingState, MAX_SHOOTER_STATES> machineStates;
+    ShooterMachine machine( STATE_NAMES, TRANSITIONS );
+    for ( auto inx=0; inx<MAX_SHOOTER_STATES; ++inx )
+    {
+        machine.SetState( static_cast<SHOOTER_STATE>( inx ), &machineStates[inx] );
+    }
+    machine.SetCurrentState( OFF, false, false );
+    pad.SetButtons( 0 );
+    pad.SetButtons( 0 );
+    auto machineHoldCycles = 0;
+    auto machineNs = benchmark::NsPerIteration( CYCLES, [&]( int cycle )
+    {
+        pad.SetButtons( ButtonsFor( cycle ) );
+        if ( !pad.IsButtonPressed( TeleopControl::SHOOTER_SHOOT ) && machine.GetCurrentStateEnum() != OFF )
+        {
+            ++machineHoldCycles;
+        }
+        machine.ProcessEvents( &pad );
+    } );
+
+    benchmark::Record( "button_chain_ns_per_cycle", chainNs );
+    benchmark::Record( "state_machine_ns_per_cycle", machineNs );
+    benchmark::Record( "button_chain_inits", chainStates[BLUE].m_inits );
+    benchmark::Record( "state_machine_inits", machineStates[BLUE].m_inits );
+
+    // both dispatch the same states; the chain re-initializes on every held cycle, the machine once per press
+    auto presses = CYCLES / 350;
+    EXPECT_EQ( chainHoldCycles, machineHoldCycles );
+    EXPECT_EQ( presses * 50, chainStates[BLUE].m_inits );
+    EXPECT_EQ( presses, machineStates[BLUE].m_inits );
+}
@@ -0,0 +1,60 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// ImuOdometryFilterBenchmark.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Cost of one ImuOdometryFilter update, the work IMU_FUSED adds to each odometry cycle.  The
+///     inputs vary a little from update to update so the trig and the outlier gate are not folded
+///     away; the estimate is asserted to stay finite.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <cmath>
+
+// FRC includes
+
+// Team 302 includes
+#include <Benchmark.h>
+#include <subsys/ImuOdometryFilter.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+using namespace std;
+
+namespace
+{
+    constexpr int    UPDATES = 1000000;
+    constexpr double PERIOD  = 0.02;    // seconds (robot loop)
+}
+
+TEST( ImuOdometryFilterBenchmark, Update )
+{
+    ImuOdometryFilter filter;
+    filter.Reset( 0.0, 0.0 );
+
+    auto updateNs = benchmark::NsPerIteration( UPDATES, [&]( int inx )
+    {
+        filter.Update( 1.0 + 1e-3 * ( inx % 7 ), 0.1, 1.0, 0.3 * ( inx % 3 ), 0.1, 1e-6 * inx, 0.5, PERIOD );
+    } );
+
+    EXPECT_TRUE( isfinite( filter.GetX() ) );
+    EXPECT_TRUE( isfinite( filter.GetY() ) );
+    benchmark::Record( "update_ns", updateNs );
+}
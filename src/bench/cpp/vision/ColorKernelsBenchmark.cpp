@@ -0,0 +1,164 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// ColorKernelsBenchmark.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Per-pixel cost of each color kernel (BGR to HSV, in range, find runs), vectorized against its
+///     scalar reference, on the rendered galactic search images the pipeline test uses.  Each kernel
+///     runs over a whole 320x240 frame on its own, with its input already computed, so the results
+///     say which step the vectorization helps.  The outputs are asserted to match the reference.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <Benchmark.h>
+#include <vision/ColorKernels.h>
+
+// Third Party Includes
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgcodecs/imgcodecs.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#include "gtest/gtest.h"
+
+using namespace std;
+
+namespace
+{
+    constexpr int FRAMES = 200;
+    constexpr int WIDTH  = 320;
+    constexpr int HEIGHT = 240;
+    constexpr int PIXELS = WIDTH * HEIGHT;
+    constexpr int RUNS   = WIDTH / 2 + 1;   // most runs a row can have
+
+    // the pipeline's power cell thresholds (H 0-179, S and V 0-255)
+    const uint8_t LOW[]  = { 20, 120, 80 };
+    const uint8_t HIGH[] = { 35, 255, 255 };
+
+    /// rendered image from src/test/cpp/vision/images, as one continuous 320x240 BGR frame
+    cv::Mat LoadImage( const string& name )
+    {
+        string file( __FILE__ );
+        auto root  = file.substr( 0, file.rfind( "src/bench/cpp/" ) );
+        auto image = cv::imread( root + "src/test/cpp/vision/images/" + name, cv::IMREAD_COLOR );
+        if ( image.empty() )
+        {
+            return image;
+        }
+        cv::Mat frame( HEIGHT, WIDTH, CV_8UC3 );
+        cv::resize( image, frame, frame.size() );
+        return frame;
+    }
+
+    /// H, S and V planes and the mask for one frame
+    struct Planes
+    {
+        vector<uint8_t> hue        = vector<uint8_t>( PIXELS );
+        vector<uint8_t> saturation = vector<uint8_t>( PIXELS );
+        vector<uint8_t> value      = vector<uint8_t>( PIXELS );
+        vector<uint8_t> mask       = vector<uint8_t>( PIXELS );
+    };
+
+    void BenchmarkImage( const string& name )
+    {
+        auto image = LoadImage( name );
+        ASSERT_FALSE( image.empty() ) << name;
+        const auto* bgr = image.ptr<uint8_t>( 0 );
+
+        ::testing::Test::RecordProperty( "implementation", ColorKernels::GetImplementation() );
+
+        Planes reference;
+        Planes vectorized;
+
+        auto hsvReferenceNs = benchmark::NsPerIteration( FRAMES, [&]( int )
+        {
+            for ( auto row=0; row<HEIGHT; ++row )
+            {
+                auto offset = row * WIDTH;
+                ColorKernels::BGRToHSVReference( bgr + 3 * offset, &reference.hue[offset], &reference.saturation[offset], &reference.value[offset], WIDTH );
+            }
+        } );
+        auto hsvNs = benchmark::NsPerIteration( FRAMES, [&]( int )
+        {
+            for ( auto row=0; row<HEIGHT; ++row )
+            {
+                auto offset = row * WIDTH;
+                ColorKernels::BGRToHSV( bgr + 3 * offset, &vectorized.hue[offset], &vectorized.saturation[offset], &vectorized.value[offset], WIDTH );
+            }
+        } );
+        EXPECT_EQ( vectorized.hue, reference.hue );
+        EXPECT_EQ( vectorized.saturation, reference.saturation );
+        EXPECT_EQ( vectorized.value, reference.value );
+
+        // both versions threshold the same (reference) planes
+        auto inRangeReferenceNs = benchmark::NsPerIteration( FRAMES, [&]( int )
+        {
+            ColorKernels::InRangeReference( reference.hue.data(), reference.saturation.data(), reference.value.data(), LOW, HIGH, reference.mask.data(), PIXELS );
+        } );
+        auto inRangeNs = benchmark::NsPerIteration( FRAMES, [&]( int )
+        {
+            ColorKernels::InRange( reference.hue.data(), reference.saturation.data(), reference.value.data(), LOW, HIGH, vectorized.mask.data(), PIXELS );
+        } );
+        EXPECT_EQ( vectorized.mask, reference.mask );
+
+        vector<int16_t> starts( RUNS ), ends( RUNS );
+        auto referenceRuns = 0;
+        auto findRunsReferenceNs = benchmark::NsPerIteration( FRAMES, [&]( int )
+        {
+            referenceRuns = 0;
+            for ( auto row=0; row<HEIGHT; ++row )
+            {
+                referenceRuns += ColorKernels::FindRunsReference( &reference.mask[row * WIDTH], WIDTH, starts.data(), ends.data(), RUNS );
+            }
+        } );
+        auto runs = 0;
+        auto findRunsNs = benchmark::NsPerIteration( FRAMES, [&]( int )
+        {
+            runs = 0;
+            for ( auto row=0; row<HEIGHT; ++row )
+            {
+                runs += ColorKernels::FindRuns( &reference.mask[row * WIDTH], WIDTH, starts.data(), ends.data(), RUNS );
+            }
+        } );
+        EXPECT_EQ( runs, referenceRuns );
+
+        benchmark::Record( "bgr_to_hsv_reference_ns_per_pixel", hsvReferenceNs / PIXELS );
+        benchmark::Record( "bgr_to_hsv_ns_per_pixel", hsvNs / PIXELS );
+        benchmark::Record( "in_range_reference_ns_per_pixel", inRangeReferenceNs / PIXELS );
+        benchmark::Record( "in_range_ns_per_pixel", inRangeNs / PIXELS );
+        benchmark::Record( "find_runs_reference_ns_per_pixel", findRunsReferenceNs / PIXELS );
+        benchmark::Record( "find_runs_ns_per_pixel", findRunsNs / PIXELS );
+        benchmark::Record( "runs_per_frame", runs );
+    }
+}
+
+TEST( ColorKernelsBenchmark, PathARed )
+{
+    BenchmarkImage( "path_a_red.png" );
+}
+
+TEST( ColorKernelsBenchmark, PathBBlue )
+{
+    BenchmarkImage( "path_b_blue.png" );
+}
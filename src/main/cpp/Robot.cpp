@@ -19,20 +19,25 @@
 #include <unistd.h>
 
 // FRC includes
-
+#include <frc/DriverStation.h>
 
 // Team 302 Includes
 #include <Robot.h>
+#include <auton/BallMap.h>
+#include <controllers/ControlTuner.h>
+#include <gamepad/TeleopControl.h>
 #include <states/chassis/SwerveDrive.h>
 #include <states/shooter/ShooterStateMgr.h>
 #include <states/turret/TurretStateMgr.h>
 #include <subsys/MechanismFactory.h>
+#include <subsys/PowerManager.h>
 #include <subsys/Shooter.h>
 #include <subsys/SwerveChassisFactory.h>
 #include <subsys/SwerveChassis.h>
 #include <hw/factories/LimelightFactory.h>
 #include <vision/DriverMode.h>
 #include <xmlhw/RobotDefn.h>
+#include <xmlmechdata/StateDataRegistry.h>
 #include <hw/interfaces/IDragonSensor.h>
 
 #include <utils/GoalDetection.h>
@@ -64,6 +69,13 @@ void Robot::RobotInit()
     unique_ptr<RobotDefn>  robotXml = make_unique<RobotDefn>();
     robotXml->ParseXML();
 
+    // Parse the mechanism state data files (in parallel) so the state managers don't
+    // do any file I/O when they get created in the mode Init methods
+    StateDataRegistry::GetInstance()->ParseAll();
+
+    // publish the control constants and targets so they can be tuned from the dashboard
+    ControlTuner::GetInstance()->Publish();
+
     // auton magic
     m_cyclePrims= new CyclePrimitives();
 }
@@ -74,7 +86,24 @@ void Robot::RobotInit()
 /// @return void
 void Robot::RobotPeriodic() 
 {
+    // apply any dashboard tuning edits (nothing to do unless a value changed)
+    ControlTuner::GetInstance()->ApplyChanges();
 
+    // sample the battery and set the output scale the drive uses next cycle; the open loop mechanism
+    // outputs are rescaled every enabled cycle, since a state may only set its target in Init
+    PowerManager::GetInstance()->Update();
+    if ( DriverStation::GetInstance().IsEnabled() )
+    {
+        ApplyOutputScale();
+    }
+
+    // snapshot the controllers and dispatch the button events once per cycle in every mode, so the
+    // next cycle reads this snapshot and an edge from while disabled isn't held over into teleop.
+    // TeleopControl finds the controller types when it is created, so wait for the driver station.
+    if ( DriverStation::GetInstance().IsDSAttached() )
+    {
+        TeleopControl::GetInstance()->Update();
+    }
 }
 
 
@@ -163,6 +192,34 @@ void Robot::UpdateOdometry()
     {
         swerveChassis.get()->UpdateOdometry();
     }
+
+    // the goal filter predicts from the odometry, so run it right after the pose is updated
+    GoalDetection::GetInstance()->Update();
+    BallMap::GetInstance()->Update();
+}
+
+/// @brief Re-send the open loop mechanism outputs with the latest PowerManager output scale
+/// @return void
+void Robot::ApplyOutputScale()
+{
+    auto factory = MechanismFactory::GetMechanismFactory();
+    for ( shared_ptr<Mech1IndMotor> mech : { shared_ptr<Mech1IndMotor>( factory->GetBallHopper() ),
+                                             shared_ptr<Mech1IndMotor>( factory->GetBallTransfer() ),
+                                             shared_ptr<Mech1IndMotor>( factory->GetTurret() ) } )
+    {
+        if ( mech.get() != nullptr )
+        {
+            mech.get()->ApplyOutputScale();
+        }
+    }
+    for ( shared_ptr<Mech2IndMotors> mech : { shared_ptr<Mech2IndMotors>( factory->GetIntake() ),
+                                              shared_ptr<Mech2IndMotors>( factory->GetShooter() ) } )
+    {
+        if ( mech.get() != nullptr )
+        {
+            mech.get()->ApplyOutputScale();
+        }
+    }
 }
 
 #ifndef RUNNING_FRC_TESTS
@@ -64,6 +64,7 @@ class Robot : public frc::TimedRobot
   private:
 
     void UpdateOdometry();
+    void ApplyOutputScale();
  
     DragonLimelight*                  m_limelight;
     DriverMode*                       m_driverMode;
@@ -58,7 +58,9 @@ std::string AutonSelector::GetSelectedAutoFile()
 	{
 		//return GalacticSearchChooser.GetPath();
 		//Use angle only or Field Position with Angle distance converted to field position.
-		return GalacticSearchFinder().GetGSPathFromVisionTbl_Angle();
+		//The classifier falls back to the angle only finder when the coprocessor isn't publishing all of the cells
+		return GalacticSearchFinder().GetGSPathFromVisionTbl_Classifier();
+		//return GalacticSearchFinder().GetGSPathFromVisionTbl_Angle();
 		//return GalacticSearchFinder().GetGSPathFromVisionTbl_FP();
 	}
 
@@ -146,6 +148,8 @@ void AutonSelector::PutChoicesOnDashboard()
 	m_chooser.AddOption("Slalom Path", "slalom.xml");
 	m_chooser.AddOption("Zero Wheels", "zero_wheels.xml");
 	m_chooser.AddOption("Calibrate", "calibrate.xml");
+	m_chooser.AddOption("Calibrate Modules", "calibrate_modules.xml");
+	m_chooser.AddOption("Characterize Drive", "characterize_drive.xml");
 	m_chooser.AddOption("Sandbox", "sandbox.xml");
 
 	frc::SmartDashboard::PutData("Auto Modes", &m_chooser);
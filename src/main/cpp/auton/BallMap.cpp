@@ -0,0 +1,331 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+
+// FRC includes
+#include <frc/geometry/Pose2d.h>
+#include <frc2/Timer.h>
+#include <wpi/math>
+
+// Team 302 includes
+#include <auton/BallMap.h>
+#include <subsys/SwerveChassis.h>
+#include <subsys/SwerveChassisFactory.h>
+#include <utils/Logger.h>
+#include <utils/PoseHistory.h>
+#include <vision/PowerCellVision.h>
+
+// Third Party Includes
+
+using namespace std;
+
+namespace
+{
+    constexpr double DEGREES_PER_RADIAN = 180.0 / wpi::math::pi;
+
+    constexpr double CAMERA_X        = 0.0;     // meters forward of the robot center
+    constexpr double CAMERA_Y        = 0.0;     // meters left of the robot center
+    constexpr double MAX_RANGE       = 5.0;     // meters; farther detections are too noisy to place
+    constexpr double MERGE_RADIUS    = 0.25;    // meters; also the spatial hash cell size
+    constexpr double COLLECT_RADIUS  = 0.35;    // meters from the robot center
+    constexpr int    CONFIRM_HITS    = 3;
+    constexpr int    MAX_MERGE_HITS  = 10;      // caps the averaging weight so a ball can still settle
+    constexpr double STALE_TIME      = 1.0;     // seconds before an unconfirmed ball is dropped
+    constexpr double MAX_POSE_JUMP   = 0.6;     // meters in one loop; more means the odometry was reset
+}
+
+BallMap* BallMap::m_instance = nullptr;
+BallMap* BallMap::GetInstance()
+{
+    if ( BallMap::m_instance == nullptr )
+    {
+        BallMap::m_instance = new BallMap();
+    }
+    return BallMap::m_instance;
+}
+
+BallMap::BallMap() : m_chassis(SwerveChassisFactory::GetSwerveChassisFactory()->GetSwerveChassis()),
+                     m_history(),
+                     m_lastDetectionTime(0.0),
+                     m_balls(),
+                     m_active(),
+                     m_next(),
+                     m_bucketOf(),
+                     m_buckets()
+{
+    Reset();
+}
+
+/// @brief  Forget every ball (e.g. when the odometry is reset for a new path)
+/// @return void
+void BallMap::Reset()
+{
+    // poses from before the reset would place new detections in the old frame
+    m_history.Reset();
+    m_lastDetectionTime = 0.0;
+    m_active.fill( false );
+    m_next.fill( -1 );
+    m_bucketOf.fill( -1 );
+    m_buckets.fill( -1 );
+}
+
+/// @brief  Add the odometry pose to the history and map any new detections
+/// @return void
+void BallMap::Update()
+{
+    auto pose = ( m_chassis.get() != nullptr ) ? m_chassis.get()->GetPose() : frc::Pose2d();
+    Update( frc2::Timer::GetFPGATimestamp().to<double>(), pose, PowerCellVision::GetInstance()->GetDetections() );
+}
+
+/// @brief      Update() with its inputs passed in, so the map can be run on scripted poses
+/// @return     void
+void BallMap::Update
+(
+    double                                  now,
+    const frc::Pose2d&                      pose,
+    const PowerCellVision::Detections&      detections
+)
+{
+    PoseHistory::Sample current{ now, pose.X().to<double>(), pose.Y().to<double>(), pose.Rotation().Degrees().to<double>(), 0.0 };
+
+    // an odometry reset that didn't go through Reset() shows up as a jump no robot can drive
+    if ( !m_history.IsEmpty() )
+    {
+        const auto& last = m_history.GetLatest();
+        if ( hypot( current.x - last.x, current.y - last.y ) > MAX_POSE_JUMP )
+        {
+            Reset();
+        }
+    }
+    m_history.Add( current );
+
+    if ( detections.timestamp > m_lastDetectionTime )
+    {
+        m_lastDetectionTime = detections.timestamp;
+
+        PoseHistory::Sample imagePose;
+        if ( m_history.Get( detections.timestamp, imagePose ) )
+        {
+            auto rad  = imagePose.heading / DEGREES_PER_RADIAN;
+            auto camX = imagePose.x + CAMERA_X * cos( rad ) - CAMERA_Y * sin( rad );
+            auto camY = imagePose.y + CAMERA_X * sin( rad ) + CAMERA_Y * cos( rad );
+            for ( auto inx=0U; inx<detections.count; ++inx )
+            {
+                const auto& cell = detections.cells[inx];
+                if ( cell.distance > MAX_RANGE )
+                {
+                    continue;
+                }
+                auto angle = ( imagePose.heading + cell.bearing ) / DEGREES_PER_RADIAN;
+                AddDetection( camX + cell.distance * cos( angle ), camY + cell.distance * sin( angle ), detections.timestamp );
+            }
+        }
+    }
+
+    // drive over a ball to collect it; forget unconfirmed sightings that never came back
+    for ( auto inx=0U; inx<MAX_BALLS; ++inx )
+    {
+        if ( !m_active[inx] )
+        {
+            continue;
+        }
+        auto& ball = m_balls[inx];
+        if ( ball.hits < CONFIRM_HITS )
+        {
+            if ( ( now - ball.lastSeen ) > STALE_TIME )
+            {
+                Remove( inx );
+            }
+        }
+        else if ( !ball.collected && hypot( ball.x - current.x, ball.y - current.y ) < COLLECT_RADIUS )
+        {
+            ball.collected = true;
+        }
+    }
+
+    Logger::GetLogger()->ToNtTable( string( "BallMap" ), string( "Remaining Balls" ), static_cast<double>( GetRemainingBallCount() ) );
+}
+
+/// @brief  Number of confirmed balls that haven't been collected
+unsigned int BallMap::GetRemainingBallCount() const
+{
+    auto count = 0U;
+    for ( auto inx=0U; inx<MAX_BALLS; ++inx )
+    {
+        if ( m_active[inx] && IsRemaining( m_balls[inx] ) )
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/// @brief  Merge a field position into the nearby ball, or map a new one
+/// @return void
+void BallMap::AddDetection
+(
+    double              x,
+    double              y,
+    double              time
+)
+{
+    auto inx = FindNearby( x, y );
+    if ( inx >= 0 )
+    {
+        auto& ball   = m_balls[inx];
+        auto  weight = static_cast<double>( min( ball.hits, MAX_MERGE_HITS ) );
+        ball.x        = ( ball.x * weight + x ) / ( weight + 1.0 );
+        ball.y        = ( ball.y * weight + y ) / ( weight + 1.0 );
+        ball.hits     = ball.hits + 1;
+        ball.lastSeen = time;
+        if ( Bucket( ball.x, ball.y ) != m_bucketOf[inx] )
+        {
+            Remove( inx );
+            m_active[inx] = true;
+            Insert( inx );
+        }
+        return;
+    }
+
+    for ( auto slot=0U; slot<MAX_BALLS; ++slot )
+    {
+        if ( !m_active[slot] )
+        {
+            m_balls[slot]  = Ball{ x, y, 1, time, false };
+            m_active[slot] = true;
+            Insert( slot );
+            return;
+        }
+    }
+}
+
+/// @brief  Find the closest ball within the merge radius by searching the 3x3 neighboring hash cells
+/// @return int - ball index, or -1 if there isn't one
+int BallMap::FindNearby
+(
+    double              x,
+    double              y
+) const
+{
+    // step in whole cells; adding the radius to a position on a cell edge can round past the next cell
+    auto cellX    = Cell( x );
+    auto cellY    = Cell( y );
+    auto best     = -1;
+    auto bestDist = MERGE_RADIUS;
+    for ( auto dx=-1; dx<=1; ++dx )
+    {
+        for ( auto dy=-1; dy<=1; ++dy )
+        {
+            auto bucket = Hash( cellX + dx, cellY + dy );
+            for ( auto inx=m_buckets[bucket]; inx>=0; inx=m_next[inx] )
+            {
+                auto dist = hypot( m_balls[inx].x - x, m_balls[inx].y - y );
+                if ( dist < bestDist )
+                {
+                    best     = inx;
+                    bestDist = dist;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+/// @brief  Spatial hash bucket of the cell holding a field position
+/// @return int - bucket index
+int BallMap::Bucket
+(
+    double              x,
+    double              y
+) const
+{
+    return Hash( Cell( x ), Cell( y ) );
+}
+
+/// @brief  Spatial hash cell along one axis
+/// @return int - cell index
+int BallMap::Cell
+(
+    double              position
+) const
+{
+    return static_cast<int>( floor( position / MERGE_RADIUS ) );
+}
+
+/// @brief  Spatial hash bucket of a cell
+/// @return int - bucket index
+int BallMap::Hash
+(
+    int                 cellX,
+    int                 cellY
+) const
+{
+    auto ix = static_cast<unsigned int>( cellX );
+    auto iy = static_cast<unsigned int>( cellY );
+    return static_cast<int>( ( ix * 73856093U ^ iy * 19349663U ) % BUCKETS );
+}
+
+void BallMap::Insert
+(
+    int                 ball
+)
+{
+    auto bucket      = Bucket( m_balls[ball].x, m_balls[ball].y );
+    m_next[ball]     = m_buckets[bucket];
+    m_buckets[bucket] = ball;
+    m_bucketOf[ball] = bucket;
+}
+
+void BallMap::Remove
+(
+    int                 ball
+)
+{
+    auto bucket = m_bucketOf[ball];
+    if ( bucket >= 0 )
+    {
+        if ( m_buckets[bucket] == ball )
+        {
+            m_buckets[bucket] = m_next[ball];
+        }
+        else
+        {
+            for ( auto inx=m_buckets[bucket]; inx>=0; inx=m_next[inx] )
+            {
+                if ( m_next[inx] == ball )
+                {
+                    m_next[inx] = m_next[ball];
+                    break;
+                }
+            }
+        }
+    }
+    m_next[ball]     = -1;
+    m_bucketOf[ball] = -1;
+    m_active[ball]   = false;
+}
+
+bool BallMap::IsRemaining
+(
+    const Ball&         ball
+) const
+{
+    return ball.hits >= CONFIRM_HITS && !ball.collected;
+}
@@ -0,0 +1,150 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <array>
+#include <memory>
+
+// FRC includes
+#include <frc/geometry/Pose2d.h>
+
+// Team 302 includes
+#include <utils/PoseHistory.h>
+#include <vision/PowerCellVision.h>
+
+// Third Party Includes
+
+class SwerveChassis;
+
+//========================================================================================================
+/// BallMap.h
+//========================================================================================================
+///
+/// File Description:
+///     Field-frame map of the power cells seen during galactic search.  Each power cell detection
+///     is placed on the field using the odometry pose from when its image was captured, then merged
+///     with the ball already mapped at that spot (found through a small spatial hash) or added as a
+///     new one.  Balls stay on the map after they leave the camera view, and are marked collected
+///     when the robot drives over them, so auton can pick or repair its route from what is left.
+///
+///     Update() is fixed-size work (no allocation) and is meant to run every loop.
+///
+//========================================================================================================
+class BallMap
+{
+    public:
+        /// @brief  A mapped power cell
+        struct Ball
+        {
+            double  x;          // field meters
+            double  y;          // field meters
+            int     hits;       // detections merged into this ball
+            double  lastSeen;   // FPGA seconds
+            bool    collected;
+        };
+
+        static constexpr unsigned int MAX_BALLS = 32;
+
+        static BallMap* GetInstance();
+
+        /// @brief  Add the odometry pose to the history and map any new detections
+        /// @return void
+        void Update();
+
+        /// @brief      Update() with its inputs passed in, so the map can be run on scripted poses
+        /// @param [in] double - FPGA time now (seconds)
+        /// @param [in] const frc::Pose2d& - odometry pose now
+        /// @param [in] const PowerCellVision::Detections& - newest vision results
+        /// @return     void
+        void Update
+        (
+            double                                  now,
+            const frc::Pose2d&                      pose,
+            const PowerCellVision::Detections&      detections
+        );
+
+        /// @brief  Forget every ball (e.g. when the odometry is reset for a new path)
+        /// @return void
+        void Reset();
+
+        /// @brief  Number of confirmed balls that haven't been collected
+        unsigned int GetRemainingBallCount() const;
+
+    private:
+        BallMap();
+        ~BallMap() = default;
+
+        void AddDetection
+        (
+            double              x,
+            double              y,
+            double              time
+        );
+
+        int FindNearby
+        (
+            double              x,
+            double              y
+        ) const;
+
+        int Bucket
+        (
+            double              x,
+            double              y
+        ) const;
+
+        int Cell
+        (
+            double              position
+        ) const;
+
+        int Hash
+        (
+            int                 cellX,
+            int                 cellY
+        ) const;
+
+        void Insert
+        (
+            int                 ball
+        );
+
+        void Remove
+        (
+            int                 ball
+        );
+
+        bool IsRemaining
+        (
+            const Ball&         ball
+        ) const;
+
+        static BallMap*                         m_instance;
+
+        static constexpr unsigned int           BUCKETS      = 64;
+
+        std::shared_ptr<SwerveChassis>          m_chassis;
+        PoseHistory                             m_history;      // meters
+        double                                  m_lastDetectionTime;
+
+        std::array<Ball, MAX_BALLS>             m_balls;
+        std::array<bool, MAX_BALLS>             m_active;
+        std::array<int, MAX_BALLS>              m_next;         // next ball in the same bucket
+        std::array<int, MAX_BALLS>              m_bucketOf;
+        std::array<int, BUCKETS>                m_buckets;      // first ball in each bucket
+};
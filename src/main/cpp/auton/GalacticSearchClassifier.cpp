@@ -0,0 +1,234 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <algorithm>
+#include <array>
+#include <limits>
+
+// FRC includes
+#include <frc/geometry/Rotation2d.h>
+#include <frc/geometry/Translation2d.h>
+#include <units/angle.h>
+#include <units/length.h>
+
+// Team 302 includes
+#include <auton/GalacticSearchClassifier.h>
+
+// Third Party Includes
+
+using namespace frc;
+using namespace std;
+
+namespace
+{
+    /// field grid is 30 inches between the lettered rows and the numbered columns
+    constexpr double GRID = 0.762;
+
+    /// camera location at the galactic search start position (field coordinates, meters)
+    constexpr double CAMERA_X = 0.6096;
+    constexpr double CAMERA_Y = -2.285;
+
+    /// Ball locations for each course (x = column * grid, y = -row * grid where A=1 ... E=5)
+    constexpr double COURSE_X[GalacticSearchClassifier::MAX_GS_COURSES][GalacticSearchClassifier::BALLS_PER_COURSE] =
+    {
+        { 3.0*GRID, 5.0*GRID,  6.0*GRID },  // RED_A:  C3, D5, A6
+        { 6.0*GRID, 7.0*GRID,  9.0*GRID },  // BLUE_A: E6, B7, C9
+        { 3.0*GRID, 5.0*GRID,  7.0*GRID },  // RED_B:  B3, D5, B7
+        { 6.0*GRID, 8.0*GRID, 10.0*GRID }   // BLUE_B: D6, B8, D10
+    };
+    constexpr double COURSE_Y[GalacticSearchClassifier::MAX_GS_COURSES][GalacticSearchClassifier::BALLS_PER_COURSE] =
+    {
+        { -3.0*GRID, -4.0*GRID, -1.0*GRID },
+        { -5.0*GRID, -2.0*GRID, -3.0*GRID },
+        { -2.0*GRID, -4.0*GRID, -2.0*GRID },
+        { -4.0*GRID, -2.0*GRID, -4.0*GRID }
+    };
+
+    constexpr double NO_MATCH = std::numeric_limits<double>::max();
+}
+
+GalacticSearchClassifier::GalacticSearchClassifier() : GalacticSearchClassifier( 0.5, 0.25 )
+{
+}
+
+GalacticSearchClassifier::GalacticSearchClassifier
+(
+    double      gate,
+    double      clutterCost
+) : m_gateSquared( gate * gate ),
+    m_clutterCost( clutterCost ),
+    m_costs()
+{
+    m_costs.fill( 0.0 );
+}
+
+/// @brief      Convert a polar camera reading taken from the galactic search start position to field coordinates
+/// @param [in] double - horizontal angle to the power cell (degrees, counter-clockwise positive)
+/// @param [in] double - distance to the power cell (meters)
+/// @return     frc::Translation2d - field position of the power cell (meters)
+Translation2d GalacticSearchClassifier::ToFieldPosition
+(
+    double      angle,
+    double      distance
+)
+{
+    Translation2d polar{ units::length::meter_t(distance), Rotation2d( units::angle::degree_t(angle) ) };
+    return polar + Translation2d( units::length::meter_t(CAMERA_X), units::length::meter_t(CAMERA_Y) );
+}
+
+/// @brief      Classify one frame of detections
+/// @param [in] const frc::Translation2d* - power cell field positions
+/// @param [in] int - number of detections (only the first MAX_DETECTIONS are used)
+/// @return     GSResult - best course and margin
+GalacticSearchClassifier::GSResult GalacticSearchClassifier::Classify
+(
+    const Translation2d*    detections,
+    int                     numDetections
+) const
+{
+    GSResult result{ GS_COURSE::UNKNOWN_COURSE, 0.0, 0.0, 0 };
+
+    auto n = ( detections != nullptr ) ? clamp( numDetections, 0, MAX_DETECTIONS ) : 0;
+    if ( n == 0 )
+    {
+        m_costs.fill( 0.0 );
+        return result;
+    }
+
+    double x[MAX_DETECTIONS];
+    double y[MAX_DETECTIONS];
+    for ( auto inx=0; inx<n; ++inx )
+    {
+        x[inx] = detections[inx].X().to<double>();
+        y[inx] = detections[inx].Y().to<double>();
+    }
+
+    auto best = NO_MATCH;
+    auto second = NO_MATCH;
+    auto bestCourse = GS_COURSE::UNKNOWN_COURSE;
+    for ( auto course=0; course<MAX_GS_COURSES; ++course )
+    {
+        auto matched = 0;
+        auto cost = ScoreCourse( static_cast<GS_COURSE>(course), x, y, n, matched );
+        m_costs[course] = cost;
+        if ( cost < best )
+        {
+            second = best;
+            best = cost;
+            bestCourse = static_cast<GS_COURSE>(course);
+            result.matched = matched;
+        }
+        else if ( cost < second )
+        {
+            second = cost;
+        }
+    }
+    result.cost = best;
+    result.margin = second - best;
+
+    // with nothing matched every course costs the same, so picking one would be a guess;
+    // a tie for the best course is just as ambiguous
+    result.course = ( result.matched > 0 && result.margin > 0.0 ) ? bestCourse : GS_COURSE::UNKNOWN_COURSE;
+    return result;
+}
+
+/// @brief  Minimum cost assignment of the detections to one course.  With three course balls and at most
+///         MAX_DETECTIONS detections, trying every assignment is only a few hundred additions, so this is
+///         done exhaustively rather than with the hungarian algorithm.
+double GalacticSearchClassifier::ScoreCourse
+(
+    GS_COURSE       course,
+    const double*   x,
+    const double*   y,
+    int             numDetections,
+    int&            matched
+) const
+{
+    // squared distance from each course ball to each detection (NO_MATCH if outside the gate)
+    double dist[BALLS_PER_COURSE][MAX_DETECTIONS];
+    for ( auto ball=0; ball<BALLS_PER_COURSE; ++ball )
+    {
+        for ( auto det=0; det<numDetections; ++det )
+        {
+            auto dx = x[det] - COURSE_X[course][ball];
+            auto dy = y[det] - COURSE_Y[course][ball];
+            auto d2 = dx*dx + dy*dy;
+            dist[ball][det] = d2 <= m_gateSquared ? d2 : NO_MATCH;
+        }
+    }
+
+    // -1 means the course ball isn't matched (not seen) and it costs the gate
+    auto best = NO_MATCH;
+    for ( auto a=-1; a<numDetections; ++a )
+    {
+        auto costA = ( a < 0 ) ? m_gateSquared : dist[0][a];
+        if ( costA == NO_MATCH )
+        {
+            continue;
+        }
+        for ( auto b=-1; b<numDetections; ++b )
+        {
+            auto costB = ( b < 0 ) ? m_gateSquared : ( b == a ? NO_MATCH : dist[1][b] );
+            if ( costB == NO_MATCH )
+            {
+                continue;
+            }
+            for ( auto c=-1; c<numDetections; ++c )
+            {
+                auto costC = ( c < 0 ) ? m_gateSquared : ( ( c == a || c == b ) ? NO_MATCH : dist[2][c] );
+                if ( costC == NO_MATCH )
+                {
+                    continue;
+                }
+                auto used = ( a >= 0 ? 1 : 0 ) + ( b >= 0 ? 1 : 0 ) + ( c >= 0 ? 1 : 0 );
+                auto cost = costA + costB + costC + ( numDetections - used ) * m_clutterCost;
+                if ( cost < best )
+                {
+                    best = cost;
+                    matched = used;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+/// @brief      Retrieve the auton xml file to run for a course
+/// @param [in] GS_COURSE - course
+/// @return     const char* - auton file name
+const char* GalacticSearchClassifier::GetAutonFile
+(
+    GS_COURSE   course
+)
+{
+    switch ( course )
+    {
+        case GS_COURSE::RED_A:
+            return "galactic_red_a.xml";
+
+        case GS_COURSE::BLUE_A:
+            return "galactic_blue_a.xml";
+
+        case GS_COURSE::RED_B:
+            return "galactic_red_b.xml";
+
+        case GS_COURSE::BLUE_B:
+            return "galactic_blue_b.xml";
+
+        default:
+            return "";
+    }
+}
@@ -0,0 +1,118 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <array>
+
+// FRC includes
+#include <frc/geometry/Translation2d.h>
+
+// Team 302 includes
+
+// Third Party Includes
+
+
+///	 @class			GalacticSearchClassifier
+///  @brief      	Scores a single frame of power cell detections against all four galactic search course
+///                 layouts.  Each layout is matched to the detections with a minimum-cost assignment (each
+///                 course ball can claim at most one detection) and the best layout is returned along with
+///                 the cost margin to the runner up, so the caller can tell a clear match from a guess.
+///
+///                 This has no hardware or network table dependencies, so it can be run on recorded detections.
+class GalacticSearchClassifier
+{
+    public:
+        /// @enum GS_COURSE
+        /// @brief The four galactic search layouts
+        enum GS_COURSE
+        {
+            UNKNOWN_COURSE = -1,    ///< nothing matched or the best courses tied
+            RED_A,
+            BLUE_A,
+            RED_B,
+            BLUE_B,
+            MAX_GS_COURSES
+        };
+
+        /// @brief maximum number of detections considered from one frame (closest ones should be passed first)
+        static constexpr int MAX_DETECTIONS = 6;
+
+        /// @brief number of power cells in each course layout
+        static constexpr int BALLS_PER_COURSE = 3;
+
+        /// @struct GSResult
+        /// @brief  Result of classifying a frame
+        struct GSResult
+        {
+            GS_COURSE   course;     ///< best matching course (UNKNOWN_COURSE if nothing matched or the best courses tied)
+            double      cost;       ///< assignment cost of the best course (meters squared)
+            double      margin;     ///< runner up cost minus best cost (meters squared)
+            int         matched;    ///< number of course balls that claimed a detection
+        };
+
+        GalacticSearchClassifier();
+        GalacticSearchClassifier
+        (
+            double      gate,           /// <I> - max distance (meters) a detection can be from a course ball and still match it
+            double      clutterCost     /// <I> - cost (meters squared) of a detection that doesn't match any course ball
+        );
+        ~GalacticSearchClassifier() = default;
+
+        /// @brief      Convert a polar camera reading taken from the galactic search start position to field coordinates
+        /// @param [in] double - horizontal angle to the power cell (degrees, counter-clockwise positive)
+        /// @param [in] double - distance to the power cell (meters)
+        /// @return     frc::Translation2d - field position of the power cell (meters)
+        static frc::Translation2d ToFieldPosition
+        (
+            double      angle,
+            double      distance
+        );
+
+        /// @brief      Classify one frame of detections
+        /// @param [in] const frc::Translation2d* - power cell field positions
+        /// @param [in] int - number of detections (only the first MAX_DETECTIONS are used)
+        /// @return     GSResult - best course and margin
+        GSResult Classify
+        (
+            const frc::Translation2d*   detections,
+            int                         numDetections
+        ) const;
+
+        /// @brief      Retrieve the assignment cost of a single course for the last call to Classify
+        /// @param [in] GS_COURSE - course
+        /// @return     double - cost (meters squared)
+        inline double GetCourseCost( GS_COURSE course ) const { return m_costs[course]; }
+
+        /// @brief      Retrieve the auton xml file to run for a course
+        /// @param [in] GS_COURSE - course
+        /// @return     const char* - auton file name (empty for UNKNOWN_COURSE; the caller picks the fallback)
+        static const char* GetAutonFile( GS_COURSE course );
+
+    private:
+        double ScoreCourse
+        (
+            GS_COURSE                   course,
+            const double*               x,
+            const double*               y,
+            int                         numDetections,
+            int&                        matched
+        ) const;
+
+        double                                              m_gateSquared;
+        double                                              m_clutterCost;
+        mutable std::array<double, MAX_GS_COURSES>          m_costs;
+};
@@ -1,5 +1,6 @@
 
 //C++ Includes
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -349,3 +350,66 @@ double GalacticSearchFinder::Angle_Filtered()
 
 
 }
+
+
+//*****************  MULTI-BALL CLASSIFIER ********************************************************
+
+std::string GalacticSearchFinder::GetGSPathFromVisionTbl_Classifier()
+{
+   /*
+        Network Table Name : "visionTable"
+        Entries: 
+        "CellHorizontalAngles"  number array (degrees)
+        "CellDistances"         number array (meters)
+  */
+    auto NetTable = inst.GetTable(sTableName);
+    auto angles = NetTable->GetNumberArray(sRef_TblCVAngles, wpi::ArrayRef<double>());
+    auto distances = NetTable->GetNumberArray(sRef_TblCVDistances, wpi::ArrayRef<double>());
+
+    auto nCells = std::min(angles.size(), distances.size());
+    if (nCells == 0)
+    {
+        // coprocessor isn't publishing all of the cells, so use the nearest cell angle
+        Logger::GetLogger()->ToNtTable("visionTable", "Error", "No cell arrays - using angle");
+        return GetGSPathFromVisionTbl_Angle();
+    }
+
+    Translation2d cells[GalacticSearchClassifier::MAX_DETECTIONS];
+    auto nUsed = std::min(nCells, static_cast<size_t>(GalacticSearchClassifier::MAX_DETECTIONS));
+    for (size_t i = 0; i < nUsed; ++i)
+    {
+        cells[i] = GalacticSearchClassifier::ToFieldPosition(angles[i], distances[i]);
+    }
+
+    GalacticSearchClassifier classifier;
+    auto result = classifier.Classify(cells, static_cast<int>(nUsed));
+
+    Logger::GetLogger()->ToNtTable("visionTable", "Cells", static_cast<double>(nCells));
+    Logger::GetLogger()->ToNtTable("visionTable", "Cost", result.cost);
+    Logger::GetLogger()->ToNtTable("visionTable", "Margin", result.margin);
+    Logger::GetLogger()->ToNtTable("visionTable", "Matched", static_cast<double>(result.matched));
+
+    // Fallback: when the cells don't identify a course (nothing matched or the best courses tied),
+    // use the nearest cell angle, which is an independent reading of the same frame
+    if (result.course == GalacticSearchClassifier::UNKNOWN_COURSE)
+    {
+        Logger::GetLogger()->LogError(string("GS Path"), string("Classifier Error - no course identified, using angle"));
+        Logger::GetLogger()->ToNtTable("visionTable", "Error", "No course identified - using angle");
+        return GetGSPathFromVisionTbl_Angle();
+    }
+
+    std::string lGSPath2Load = GalacticSearchClassifier::GetAutonFile(result.course);
+    Logger::GetLogger()->ToNtTable("visionTable", "Path", lGSPath2Load);
+
+    if (result.margin < m_minMargin)
+    {
+        Logger::GetLogger()->LogError(string("GS Path"), string("Classifier Warning - low margin"));
+        Logger::GetLogger()->ToNtTable("visionTable", "Error", "Low margin");
+    }
+    else
+    {
+        Logger::GetLogger()->ToNtTable("visionTable", "Error", "No Error");
+    }
+    Logger::GetLogger()->LogError(string("GS Path"), lGSPath2Load);
+    return lGSPath2Load;
+}
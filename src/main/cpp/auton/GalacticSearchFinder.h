@@ -20,6 +20,7 @@
 //Team302 Includes
 #include <auton/PrimitiveParams.h>
 #include <auton/primitives/IPrimitive.h>
+#include <auton/GalacticSearchClassifier.h>
 #include <utils/Logger.h>
 
 //FRC,WPI Includes
@@ -40,6 +41,7 @@ class GalacticSearchFinder// : public IPrimitive
        
         std::string GetGSPathFromVisionTbl_FP(); 
         std::string GetGSPathFromVisionTbl_Angle(); 
+        std::string GetGSPathFromVisionTbl_Classifier(); 
 
     private:
 
@@ -58,4 +60,9 @@ class GalacticSearchFinder// : public IPrimitive
         wpi::Twine sTableName = "visionTable";
         wpi::StringRef sRef_TblCVAngle = "NearestCellHorizontalAngle";
         wpi::StringRef sRef_TblCVDistance = "NearestCellDistance";
+        wpi::StringRef sRef_TblCVAngles = "CellHorizontalAngles";   // all cells in the frame, nearest first
+        wpi::StringRef sRef_TblCVDistances = "CellDistances";
+
+        // below this margin (meters squared) the runner up course is too close to call with confidence
+        const double m_minMargin = 0.1;
  };
\ No newline at end of file
@@ -35,6 +35,8 @@ enum PRIMITIVE_IDENTIFIER
       TURN_ANGLE_ABS,
       TURN_ANGLE_REL,
       DRIVE_PATH,
+      CALIBRATE_MODULES,
+      CHARACTERIZE_DRIVE,
       MAX_AUTON_PRIMITIVES
   };
 
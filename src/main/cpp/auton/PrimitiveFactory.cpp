@@ -26,6 +26,8 @@
 #include <auton/PrimitiveFactory.h>
 #include <auton/PrimitiveParser.h>
 
+#include <auton/primitives/CalibrateModules.h>
+#include <auton/primitives/CharacterizeDrive.h>
 #include <auton/primitives/DoNothing.h>
 #include <auton/primitives/DriveDistance.h>
 #include <auton/primitives/DrivePath.h>
@@ -53,7 +55,9 @@ PrimitiveFactory::PrimitiveFactory() :
 				m_turnAngle(nullptr),
 				m_holdPosition(nullptr),
 				m_drivePath(nullptr),
-				m_resetPosition(nullptr)
+				m_resetPosition(nullptr),
+				m_calibrateModules(nullptr),
+				m_characterizeDrive(nullptr)
 {
 }
 
@@ -131,6 +135,22 @@ IPrimitive* PrimitiveFactory::GetIPrimitive(PrimitiveParams* primitivePasser)
 			primitive = m_drivePath;
 			break;
 
+		case CALIBRATE_MODULES:
+			if (m_calibrateModules == nullptr)
+			{
+				m_calibrateModules = new CalibrateModules();
+			}
+			primitive = m_calibrateModules;
+			break;
+
+		case CHARACTERIZE_DRIVE:
+			if (m_characterizeDrive == nullptr)
+			{
+				m_characterizeDrive = new CharacterizeDrive();
+			}
+			primitive = m_characterizeDrive;
+			break;
+
 		default:
 			break;
 	}
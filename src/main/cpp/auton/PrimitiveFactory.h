@@ -52,5 +52,7 @@ private:
     IPrimitive* m_holdPosition;
     IPrimitive* m_drivePath;
     IPrimitive* m_resetPosition;
+    IPrimitive* m_calibrateModules;
+    IPrimitive* m_characterizeDrive;
 };
 
@@ -50,6 +50,8 @@ PrimitiveParamsVector PrimitiveParser::ParseXML
     primStringToEnumMap["TURN_ANGLE_REL"] = TURN_ANGLE_REL;
     primStringToEnumMap["DRIVE_PATH"] = DRIVE_PATH;
     primStringToEnumMap["RESET_POSITION"] = RESET_POSITION;
+    primStringToEnumMap["CALIBRATE_MODULES"] = CALIBRATE_MODULES;
+    primStringToEnumMap["CHARACTERIZE_DRIVE"] = CHARACTERIZE_DRIVE;
 
     xml_document doc;
     xml_parse_result result = doc.load_file( fulldirfile.c_str() );
@@ -0,0 +1,354 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+
+// FRC includes
+#include <frc/Filesystem.h>
+#include <frc/kinematics/ChassisSpeeds.h>
+#include <frc/trajectory/Trajectory.h>
+#include <frc/trajectory/TrajectoryUtil.h>
+#include <units/angle.h>
+#include <units/angular_velocity.h>
+#include <units/length.h>
+#include <units/math.h>
+#include <units/time.h>
+#include <units/velocity.h>
+#include <wpi/Path.h>
+#include <wpi/SmallString.h>
+#include <wpi/math>
+
+// Team 302 includes
+#include <auton/PrimitiveParams.h>
+#include <auton/primitives/CalibrateModules.h>
+#include <auton/primitives/ModuleCalibrationFit.h>
+#include <hw/DragonPigeon.h>
+#include <hw/factories/PigeonFactory.h>
+#include <subsys/SwerveCalibration.h>
+#include <subsys/SwerveChassis.h>
+#include <subsys/SwerveChassisFactory.h>
+#include <subsys/SwerveModule.h>
+#include <utils/AngleUtils.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+
+using namespace std;
+using namespace frc;
+
+namespace
+{
+    constexpr double SETTLE_TIME = 1.0;             // seconds; the accelerometer bias is averaged over the second half
+    constexpr double STOP_TIME = 1.0;               // seconds
+    constexpr double MIN_CURVATURE = 0.5;           // radians per meter; only the curved part of the circle fits the diameter
+    constexpr double MIN_TURN_ANGLE = 180.0;        // degrees
+    constexpr double MIN_DIAMETER_RATIO = 0.8;
+    constexpr double MAX_DIAMETER_RATIO = 1.2;
+    constexpr double MAX_OFFSET_CORRECTION = 15.0;  // degrees
+    const string CIRCLE_PATH = string( "Calibrate_CIrcle.wpilib.json" );
+    const string STRAIGHT_PATH = string( "Calibrate_Straight.wpilib.json" );
+    const string NT_NAME = string( "Swerve Calibration" );
+    const array<string, 4> MODULE_NAMES = { "FL", "FR", "BL", "BR" };
+
+    // module location as a fraction of the wheel base (x, forward) and track (y, left)
+    const array<double, 4> MODULE_X = {  0.5,  0.5, -0.5, -0.5 };
+    const array<double, 4> MODULE_Y = {  0.5, -0.5,  0.5, -0.5 };
+
+    /// @brief  Read a path from the deploy directory (same as DrivePath)
+    Trajectory LoadPath
+    (
+        const string&   pathName
+    )
+    {
+        wpi::SmallString<64> deployDir;
+        frc::filesystem::GetDeployDirectory( deployDir );
+        wpi::sys::path::append( deployDir, "paths" );
+        wpi::sys::path::append( deployDir, pathName );
+        return TrajectoryUtil::FromPathweaverJson( deployDir );
+    }
+}
+
+CalibrateModules::CalibrateModules() : IPrimitive(),
+                                       m_chassis( SwerveChassisFactory::GetSwerveChassisFactory()->GetSwerveChassis() ),
+                                       m_pigeon( PigeonFactory::GetFactory()->GetPigeon() ),
+                                       m_modules(),
+                                       m_phase( DONE ),
+                                       m_timer(),
+                                       m_lastTime( 0.0 ),
+                                       m_circlePath( LoadPath( CIRCLE_PATH ) ),
+                                       m_straightPath( LoadPath( STRAIGHT_PATH ) ),
+                                       m_heading( 0.0 ),
+                                       m_biasX( 0.0 ),
+                                       m_biasY( 0.0 ),
+                                       m_biasCount( 0 ),
+                                       m_lastYaw( 0.0 ),
+                                       m_turnAngle( 0.0 ),
+                                       m_circleArc(),
+                                       m_circleDistance(),
+                                       m_accelX( 0.0 ),
+                                       m_accelY( 0.0 ),
+                                       m_moduleX(),
+                                       m_moduleY()
+{
+    if ( m_chassis.get() != nullptr )
+    {
+        m_modules = { m_chassis.get()->GetFrontLeft(), 
+                      m_chassis.get()->GetFrontRight(), 
+                      m_chassis.get()->GetBackLeft(), 
+                      m_chassis.get()->GetBackRight() };
+    }
+}
+
+void CalibrateModules::Init(PrimitiveParams* params)
+{
+    if ( m_chassis.get() == nullptr || m_pigeon == nullptr )
+    {
+        Logger::GetLogger()->LogError( string("CalibrateModules::Init"), string("no swerve chassis or pigeon") );
+        m_phase = DONE;
+        return;
+    }
+
+    m_biasX = 0.0;
+    m_biasY = 0.0;
+    m_biasCount = 0;
+    m_turnAngle = units::angle::degree_t( 0.0 );
+    m_circleArc.fill( units::length::meter_t( 0.0 ) );
+    m_circleDistance.fill( units::length::meter_t( 0.0 ) );
+    m_accelX = 0.0;
+    m_accelY = 0.0;
+    m_moduleX.fill( 0.0 );
+    m_moduleY.fill( 0.0 );
+
+    m_timer.Start();
+    NextPhase( SETTLE );
+}
+
+void CalibrateModules::Run()
+{
+    if ( m_phase == DONE )
+    {
+        return;
+    }
+
+    auto time = m_timer.Get();
+    auto dt = time - m_lastTime;
+    m_lastTime = time;
+
+    switch ( m_phase )
+    {
+        case SETTLE:
+            RunSettle( time );
+            break;
+
+        case CIRCLE:
+            RunCircle( time, dt );
+            break;
+
+        case STOP:
+            m_chassis.get()->ZeroAlignSwerveModules();
+            if ( time.to<double>() > STOP_TIME )
+            {
+                m_heading = m_chassis.get()->GetYaw();
+                m_chassis.get()->ResetHeadingController();
+                NextPhase( STRAIGHT );
+            }
+            break;
+
+        case STRAIGHT:
+            RunStraight( time, dt );
+            break;
+
+        default:
+            break;
+    }
+}
+
+bool CalibrateModules::IsDone()
+{
+    return m_phase == DONE;
+}
+
+/// @brief  Point the wheels forward and average the accelerometer while nothing moves
+void CalibrateModules::RunSettle
+(
+    units::time::second_t   time
+)
+{
+    m_chassis.get()->ZeroAlignSwerveModules();
+    if ( time.to<double>() > SETTLE_TIME / 2.0 )
+    {
+        m_biasX += m_pigeon->GetAccelX();
+        m_biasY += m_pigeon->GetAccelY();
+        m_biasCount++;
+    }
+
+    if ( time.to<double>() > SETTLE_TIME )
+    {
+        m_biasX /= max( m_biasCount, 1 );
+        m_biasY /= max( m_biasCount, 1 );
+        m_heading = m_chassis.get()->GetYaw();
+        m_lastYaw = m_heading;
+        m_chassis.get()->ResetHeadingController();
+        NextPhase( CIRCLE );
+    }
+}
+
+/// @brief  Drive the circle path; where it curves, add up the gyro turn, the arc each wheel rolled
+///         around the center of rotation and the distance each drive encoder reports
+void CalibrateModules::RunCircle
+(
+    units::time::second_t   time,
+    units::time::second_t   dt
+)
+{
+    m_chassis.get()->Drive( FollowPath( m_circlePath, time ), false );
+
+    auto yaw = m_chassis.get()->GetYaw();
+    auto turn = units::math::abs( AngleUtils::GetDeltaAngle( m_lastYaw, yaw ) );
+    m_lastYaw = yaw;
+
+    auto curvature = m_circlePath.Sample( time ).curvature.to<double>();
+    if ( abs( curvature ) >= MIN_CURVATURE )
+    {
+        units::length::meter_t wheelBase = m_chassis.get()->GetWheelBase();
+        units::length::meter_t track = m_chassis.get()->GetTrack();
+
+        m_turnAngle += turn;
+        for ( size_t i=0; i<m_modules.size(); ++i )
+        {
+            m_circleArc[i] += ModuleCalibrationFit::WheelArc( MODULE_X[i] * wheelBase, MODULE_Y[i] * track, curvature, turn );
+            m_circleDistance[i] += units::math::abs( m_modules[i].get()->GetState().speed ) * dt;
+        }
+    }
+
+    if ( time > m_circlePath.TotalTime() )
+    {
+        m_chassis.get()->Drive( ChassisSpeeds{ 0_mps, 0_mps, 0_rad_per_s }, false );
+        NextPhase( STOP );
+    }
+}
+
+/// @brief  Drive the straight path, adding up the acceleration (signed so speeding up and slowing
+///         down both point along the travel) and each module's velocity at its measured angle
+void CalibrateModules::RunStraight
+(
+    units::time::second_t   time,
+    units::time::second_t   dt
+)
+{
+    m_chassis.get()->Drive( FollowPath( m_straightPath, time ), false );
+
+    auto acceleration = m_straightPath.Sample( time ).acceleration.to<double>();
+    auto sign = acceleration > 0.0 ? 1.0 : ( acceleration < 0.0 ? -1.0 : 0.0 );
+    m_accelX += sign * ( m_pigeon->GetAccelX() - m_biasX );
+    m_accelY += sign * ( m_pigeon->GetAccelY() - m_biasY );
+
+    for ( size_t i=0; i<m_modules.size(); ++i )
+    {
+        auto module = m_modules[i].get();
+        auto speed = module->GetState().speed.to<double>();
+        auto angle = units::angle::radian_t( module->GetTurnAngle() ).to<double>();
+        m_moduleX[i] += speed * cos( angle ) * dt.to<double>();
+        m_moduleY[i] += speed * sin( angle ) * dt.to<double>();
+    }
+
+    if ( time > m_straightPath.TotalTime() )
+    {
+        m_chassis.get()->Drive( ChassisSpeeds{ 0_mps, 0_mps, 0_rad_per_s }, false );
+        Finish();
+        NextPhase( DONE );
+    }
+}
+
+/// @brief  Chassis relative speeds that drive the path from wherever the robot is: forward at the
+///         path velocity, turning at the path velocity times curvature, with the heading held to
+///         the path's change in rotation since it started
+/// @param [in] const frc::Trajectory&  path:   path to follow
+/// @param [in] units::time::second_t   time:   time since the path started
+/// @returns frc::ChassisSpeeds
+ChassisSpeeds CalibrateModules::FollowPath
+(
+    const Trajectory&       path,
+    units::time::second_t   time
+)
+{
+    auto state = path.Sample( time );
+    auto pathTurn = state.pose.Rotation() - path.InitialPose().Rotation();
+    auto rate = units::radians_per_second_t( state.velocity.to<double>() * state.curvature.to<double>() );
+    auto correction = m_chassis.get()->CalcHeadingCorrection( m_heading + pathTurn.Degrees() );
+    return ChassisSpeeds{ state.velocity, 0_mps, rate + correction };
+}
+
+void CalibrateModules::NextPhase
+(
+    CALIBRATION_PHASE       phase
+)
+{
+    m_phase = phase;
+    m_timer.Reset();
+    m_lastTime = units::time::second_t( 0.0 );
+    Logger::GetLogger()->ToNtTable( NT_NAME, string("phase"), static_cast<double>( phase ) );
+}
+
+/// @brief  Fit the calibration from the recorded runs, apply it to the modules and save it
+void CalibrateModules::Finish()
+{
+    auto travel = units::angle::radian_t( atan2( m_accelY, m_accelX ) );
+    Logger::GetLogger()->ToNtTable( NT_NAME, string("turn angle"), m_turnAngle.to<double>() );
+    Logger::GetLogger()->ToNtTable( NT_NAME, string("travel direction"), units::angle::degree_t( travel ).to<double>() );
+
+    if ( m_turnAngle.to<double>() < MIN_TURN_ANGLE )
+    {
+        Logger::GetLogger()->LogError( string("CalibrateModules::Finish"), string("chassis didn't turn through the circle; calibration not saved") );
+        return;
+    }
+
+    auto calibration = SwerveCalibration::GetInstance();
+    bool valid = true;
+    for ( size_t i=0; i<m_modules.size(); ++i )
+    {
+        auto module = m_modules[i];
+        auto ratio = ModuleCalibrationFit::DiameterRatio( m_circleArc[i], m_circleDistance[i] );
+        auto correction = ModuleCalibrationFit::OffsetCorrection( m_accelX, m_accelY, m_moduleX[i], m_moduleY[i] );
+
+        Logger::GetLogger()->ToNtTable( NT_NAME, MODULE_NAMES[i] + string(" diameter ratio"), ratio );
+        Logger::GetLogger()->ToNtTable( NT_NAME, MODULE_NAMES[i] + string(" offset correction"), correction.to<double>() );
+
+        if ( ratio < MIN_DIAMETER_RATIO || ratio > MAX_DIAMETER_RATIO || units::math::abs( correction ).to<double>() > MAX_OFFSET_CORRECTION )
+        {
+            Logger::GetLogger()->LogError( string("CalibrateModules::Finish"), MODULE_NAMES[i] + string(" fit is out of range") );
+            valid = false;
+            continue;
+        }
+        calibration->SetCalibration( module.get()->GetType(), 
+                                     AngleUtils::GetEquivAngle( module.get()->GetAngleOffset() + correction ), 
+                                     module.get()->GetWheelDiameter() * ratio );
+    }
+
+    // only keep a complete calibration; a partial one would mix old and new offsets
+    if ( valid )
+    {
+        for ( auto module : m_modules )
+        {
+            module.get()->SetCalibration( calibration->GetAngleOffset( module.get()->GetType() ), 
+                                          calibration->GetWheelDiameter( module.get()->GetType() ) );
+        }
+        calibration->Save();
+    }
+}
@@ -0,0 +1,119 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <array>
+#include <memory>
+
+// FRC includes
+#include <frc/kinematics/ChassisSpeeds.h>
+#include <frc/trajectory/Trajectory.h>
+#include <frc2/Timer.h>
+#include <units/angle.h>
+#include <units/length.h>
+#include <units/time.h>
+
+// Team 302 includes
+#include <auton/primitives/IPrimitive.h>
+
+// Third Party Includes
+
+//Forward declares
+class DragonPigeon;
+class PrimitiveParams;
+class SwerveChassis;
+class SwerveModule;
+
+//========================================================================================================
+/// CalibrateModules.h
+//========================================================================================================
+///
+/// File Description:
+///     Drives the Calibrate_CIrcle and Calibrate_Straight paths open loop (chassis relative, the
+///     heading following the path) and saves the measured swerve module calibration:
+///       - on the curved part of the circle path the wheel angles put the center of rotation at
+///         the path radius, so the gyro turn times each wheel's distance from that center is the
+///         true arc it rolled; dividing it by the distance the drive encoder reports gives the
+///         effective wheel diameter
+///       - on the straight path the accelerometer (in the robot frame) gives the true direction
+///         of travel while speeding up and slowing down, so the difference from the angle each
+///         module's turn sensor measures is the correction to its offset
+///     The paths start from wherever the robot is; it needs about 7 meters of clear floor in
+///     front of it and 3 meters to its left for the circle, then 7 meters in front for the straight.
+///
+//========================================================================================================
+class CalibrateModules : public IPrimitive
+{
+    public:
+        CalibrateModules();
+        virtual ~CalibrateModules() = default;
+
+        void Init(PrimitiveParams* params) override;
+        void Run() override;
+        bool IsDone() override;
+
+    private:
+        enum CALIBRATION_PHASE
+        {
+            SETTLE,
+            CIRCLE,
+            STOP,
+            STRAIGHT,
+            DONE
+        };
+
+        void RunSettle( units::time::second_t time );
+        void RunCircle( units::time::second_t time, units::time::second_t dt );
+        void RunStraight( units::time::second_t time, units::time::second_t dt );
+        frc::ChassisSpeeds FollowPath
+        ( 
+            const frc::Trajectory&  path, 
+            units::time::second_t   time 
+        );
+        void NextPhase( CALIBRATION_PHASE phase );
+        void Finish();
+
+        std::shared_ptr<SwerveChassis>                  m_chassis;
+        DragonPigeon*                                   m_pigeon;
+        std::array<std::shared_ptr<SwerveModule>, 4>    m_modules;
+        CALIBRATION_PHASE                               m_phase;
+        frc2::Timer                                     m_timer;
+        units::time::second_t                           m_lastTime;
+        frc::Trajectory                                 m_circlePath;
+        frc::Trajectory                                 m_straightPath;
+
+        // gyro heading when the current path started
+        units::angle::degree_t                          m_heading;
+
+        // accelerometer bias while settled
+        double                                          m_biasX;
+        double                                          m_biasY;
+        int                                             m_biasCount;
+
+        // circle: gyro turn, the arc each wheel rolled around the path's center of rotation
+        // and the distance each drive encoder reports
+        units::angle::degree_t                          m_lastYaw;
+        units::angle::degree_t                          m_turnAngle;
+        std::array<units::length::meter_t, 4>           m_circleArc;
+        std::array<units::length::meter_t, 4>           m_circleDistance;
+
+        // straight: accelerometer and measured module velocity summed over the run
+        double                                          m_accelX;
+        double                                          m_accelY;
+        std::array<double, 4>                           m_moduleX;
+        std::array<double, 4>                           m_moduleY;
+};
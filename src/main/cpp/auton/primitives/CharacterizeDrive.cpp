@@ -0,0 +1,305 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <array>
+#include <cmath>
+#include <memory>
+#include <string>
+
+// FRC includes
+#include <units/length.h>
+#include <units/math.h>
+#include <units/time.h>
+#include <units/velocity.h>
+#include <units/voltage.h>
+
+// Team 302 includes
+#include <auton/PrimitiveParams.h>
+#include <auton/primitives/CharacterizeDrive.h>
+#include <subsys/SwerveCalibration.h>
+#include <subsys/SwerveChassis.h>
+#include <subsys/SwerveChassisFactory.h>
+#include <subsys/SwerveModule.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+
+using namespace std;
+
+namespace
+{
+    constexpr double STOP_TIME = 1.0;           // seconds between tests (wheels align before the first one)
+    constexpr double RAMP_RATE = 1.0;           // volts per second for the quasistatic tests
+    constexpr double STEP_VOLTAGE = 4.0;        // volts for the dynamic tests
+    constexpr double MAX_VOLTAGE = 7.0;         // volts
+    constexpr double MAX_TEST_TIME = 10.0;      // seconds
+    constexpr double MAX_DISTANCE = 2.0;        // meters each test may travel
+    constexpr double MIN_SPEED = 0.05;          // meters per second; kS is undefined at rest so slower samples are skipped
+    constexpr int    MIN_SAMPLES = 50;
+    constexpr double MAX_KS = 3.0;              // volts
+    const string NT_NAME = string( "Drive Characterization" );
+    const array<string, 4> MODULE_NAMES = { "FL", "FR", "BL", "BR" };
+}
+
+CharacterizeDrive::CharacterizeDrive() : IPrimitive(),
+                                         m_chassis( SwerveChassisFactory::GetSwerveChassisFactory()->GetSwerveChassis() ),
+                                         m_modules(),
+                                         m_test( DONE ),
+                                         m_stopped( true ),
+                                         m_timer(),
+                                         m_volts( 0.0 ),
+                                         m_lastTime( 0.0 ),
+                                         m_distance( 0.0 ),
+                                         m_samples(),
+                                         m_sampleCount( 0 ),
+                                         m_fits()
+{
+    if ( m_chassis.get() != nullptr )
+    {
+        m_modules = { m_chassis.get()->GetFrontLeft(), 
+                      m_chassis.get()->GetFrontRight(), 
+                      m_chassis.get()->GetBackLeft(), 
+                      m_chassis.get()->GetBackRight() };
+    }
+}
+
+void CharacterizeDrive::Init(PrimitiveParams* params)
+{
+    if ( m_chassis.get() == nullptr )
+    {
+        Logger::GetLogger()->LogError( string("CharacterizeDrive::Init"), string("no swerve chassis") );
+        m_test = DONE;
+        return;
+    }
+
+    for ( auto& fit : m_fits )
+    {
+        for ( auto& row : fit.ata )
+        {
+            row.fill( 0.0 );
+        }
+        fit.atb.fill( 0.0 );
+        fit.count = 0;
+    }
+
+    m_test    = QUASISTATIC_FORWARD;
+    m_stopped = true;
+    m_volts   = units::voltage::volt_t( 0.0 );
+    m_timer.Reset();
+    m_timer.Start();
+    m_lastTime = units::time::second_t( 0.0 );
+}
+
+void CharacterizeDrive::Run()
+{
+    if ( m_test == DONE )
+    {
+        return;
+    }
+
+    auto time = m_timer.Get();
+    auto dt = time - m_lastTime;
+    m_lastTime = time;
+
+    // hold the wheels forward and stopped between tests
+    if ( m_stopped )
+    {
+        for ( auto module : m_modules )
+        {
+            module.get()->ZeroAlignModule();
+            module.get()->SetDriveVoltage( units::voltage::volt_t( 0.0 ) );
+        }
+        if ( time.to<double>() > STOP_TIME )
+        {
+            m_stopped     = false;
+            m_volts       = units::voltage::volt_t( 0.0 );
+            m_distance    = units::length::meter_t( 0.0 );
+            m_sampleCount = 0;
+            m_timer.Reset();
+            m_lastTime = units::time::second_t( 0.0 );
+            Logger::GetLogger()->ToNtTable( NT_NAME, string("test"), static_cast<double>( m_test ) );
+        }
+        return;
+    }
+
+    // the speeds read now respond to the voltage applied since the last cycle
+    auto speed = units::velocity::meters_per_second_t( 0.0 );
+    for ( size_t i=0; i<m_modules.size(); ++i )
+    {
+        auto moduleSpeed = m_modules[i].get()->GetState().speed;
+        AddSample( i, time.to<double>(), m_volts.to<double>(), moduleSpeed.to<double>() );
+        speed += units::math::abs( moduleSpeed ) / static_cast<double>( m_modules.size() );
+    }
+    m_sampleCount++;
+    m_distance += speed * dt;
+
+    m_volts = GetTestVoltage( time );
+    for ( auto module : m_modules )
+    {
+        module.get()->ZeroAlignModule();
+        module.get()->SetDriveVoltage( m_volts );
+    }
+
+    if ( m_distance.to<double>() > MAX_DISTANCE || time.to<double>() > MAX_TEST_TIME )
+    {
+        NextTest();
+    }
+}
+
+bool CharacterizeDrive::IsDone()
+{
+    return m_test == DONE;
+}
+
+/// @brief  Voltage to apply for the current test
+/// @param [in] units::time::second_t   time:   time since the test started
+/// @return units::voltage::volt_t  drive motor voltage
+units::voltage::volt_t CharacterizeDrive::GetTestVoltage
+(
+    units::time::second_t   time
+) const
+{
+    auto isQuasistatic = m_test == QUASISTATIC_FORWARD || m_test == QUASISTATIC_REVERSE;
+    auto isReverse     = m_test == QUASISTATIC_REVERSE || m_test == DYNAMIC_REVERSE;
+    auto volts = isQuasistatic ? min( RAMP_RATE * time.to<double>(), MAX_VOLTAGE ) : STEP_VOLTAGE;
+    return units::voltage::volt_t( isReverse ? -volts : volts );
+}
+
+/// @brief  Buffer a module's sample and add the middle sample of the window to its fit using
+///         the acceleration across the window
+/// @param [in] size_t  module: index of the module
+/// @param [in] double  time:   seconds since the test started
+/// @param [in] double  volts:  voltage applied to the drive motor
+/// @param [in] double  speed:  measured wheel speed in meters per second
+/// @return void
+void CharacterizeDrive::AddSample
+(
+    size_t  module,
+    double  time,
+    double  volts,
+    double  speed
+)
+{
+    auto& window = m_samples[module];
+    window[m_sampleCount % SAMPLE_WINDOW] = { time, volts, speed };
+    if ( m_sampleCount + 1 < SAMPLE_WINDOW )
+    {
+        return;
+    }
+
+    auto& newest = window[m_sampleCount % SAMPLE_WINDOW];
+    auto& oldest = window[(m_sampleCount + 1) % SAMPLE_WINDOW];
+    auto& middle = window[(m_sampleCount + 1 + SAMPLE_WINDOW / 2) % SAMPLE_WINDOW];
+    if ( abs( middle.speed ) < MIN_SPEED || newest.time <= oldest.time )
+    {
+        return;
+    }
+
+    auto accel = ( newest.speed - oldest.speed ) / ( newest.time - oldest.time );
+    array<double, 3> x = { middle.speed > 0.0 ? 1.0 : -1.0, middle.speed, accel };
+
+    auto& fit = m_fits[module];
+    for ( size_t row=0; row<x.size(); ++row )
+    {
+        for ( size_t col=0; col<x.size(); ++col )
+        {
+            fit.ata[row][col] += x[row] * x[col];
+        }
+        fit.atb[row] += x[row] * middle.volts;
+    }
+    fit.count++;
+}
+
+/// @brief  Stop and move on to the next test; after the last one fit the results
+/// @return void
+void CharacterizeDrive::NextTest()
+{
+    for ( auto module : m_modules )
+    {
+        module.get()->SetDriveVoltage( units::voltage::volt_t( 0.0 ) );
+    }
+
+    m_test    = static_cast<CHARACTERIZATION_TEST>( m_test + 1 );
+    m_stopped = true;
+    m_timer.Reset();
+    m_lastTime = units::time::second_t( 0.0 );
+
+    if ( m_test == DONE )
+    {
+        Finish();
+    }
+}
+
+/// @brief  Solve each module's normal equations for kS, kV and kA, then apply and save them
+///         if every module's fit is reasonable
+/// @return void
+void CharacterizeDrive::Finish()
+{
+    array<array<double, 3>, 4> gains;
+    bool valid = true;
+    for ( size_t i=0; i<m_fits.size(); ++i )
+    {
+        auto& a = m_fits[i].ata;
+        auto& b = m_fits[i].atb;
+
+        // Cramer's rule on the 3x3 symmetric system
+        auto det = [] ( const array<array<double, 3>, 3>& m )
+        {
+            return m[0][0] * ( m[1][1] * m[2][2] - m[1][2] * m[2][1] ) -
+                   m[0][1] * ( m[1][0] * m[2][2] - m[1][2] * m[2][0] ) +
+                   m[0][2] * ( m[1][0] * m[2][1] - m[1][1] * m[2][0] );
+        };
+        auto d = det( a );
+        for ( size_t col=0; col<b.size(); ++col )
+        {
+            auto m = a;
+            for ( size_t row=0; row<b.size(); ++row )
+            {
+                m[row][col] = b[row];
+            }
+            gains[i][col] = d != 0.0 ? det( m ) / d : 0.0;
+        }
+
+        auto kS = gains[i][0];
+        auto kV = gains[i][1];
+        auto kA = gains[i][2];
+        Logger::GetLogger()->ToNtTable( NT_NAME, MODULE_NAMES[i] + string(" kS"), kS );
+        Logger::GetLogger()->ToNtTable( NT_NAME, MODULE_NAMES[i] + string(" kV"), kV );
+        Logger::GetLogger()->ToNtTable( NT_NAME, MODULE_NAMES[i] + string(" kA"), kA );
+        Logger::GetLogger()->ToNtTable( NT_NAME, MODULE_NAMES[i] + string(" samples"), m_fits[i].count );
+
+        if ( m_fits[i].count < MIN_SAMPLES || d == 0.0 || kV <= 0.0 || kS < 0.0 || kS > MAX_KS || kA < 0.0 )
+        {
+            Logger::GetLogger()->LogError( string("CharacterizeDrive::Finish"), MODULE_NAMES[i] + string(" fit is out of range") );
+            valid = false;
+        }
+    }
+
+    // only keep a complete characterization so all modules run the same way
+    if ( !valid )
+    {
+        return;
+    }
+
+    auto calibration = SwerveCalibration::GetInstance();
+    for ( size_t i=0; i<m_modules.size(); ++i )
+    {
+        auto module = m_modules[i];
+        calibration->SetFeedforward( module.get()->GetType(), gains[i][0], gains[i][1], gains[i][2] );
+        module.get()->SetDriveFeedforward( gains[i][0], gains[i][1], gains[i][2] );
+    }
+    calibration->Save();
+}
@@ -0,0 +1,104 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <array>
+#include <memory>
+
+// FRC includes
+#include <frc2/Timer.h>
+#include <units/length.h>
+#include <units/time.h>
+#include <units/voltage.h>
+
+// Team 302 includes
+#include <auton/primitives/IPrimitive.h>
+
+// Third Party Includes
+
+//Forward declares
+class PrimitiveParams;
+class SwerveChassis;
+class SwerveModule;
+
+//========================================================================================================
+/// CharacterizeDrive.h
+//========================================================================================================
+///
+/// File Description:
+///     Measures the drive motor feedforward of each swerve module, fits
+///         volts = kS * sign(v) + kV * v + kA * a
+///     by least squares and saves it.  With the wheels pointed forward it runs four voltage tests:
+///     a slow (quasistatic) ramp forward and back, where acceleration is negligible and kS and kV
+///     dominate, then a voltage step (dynamic) forward and back, where kA dominates.  Each test
+///     stops after a couple meters, so the robot needs about 3 meters of clear floor in front of it.
+///
+//========================================================================================================
+class CharacterizeDrive : public IPrimitive
+{
+    public:
+        CharacterizeDrive();
+        virtual ~CharacterizeDrive() = default;
+
+        void Init(PrimitiveParams* params) override;
+        void Run() override;
+        bool IsDone() override;
+
+    private:
+        enum CHARACTERIZATION_TEST
+        {
+            QUASISTATIC_FORWARD,
+            QUASISTATIC_REVERSE,
+            DYNAMIC_FORWARD,
+            DYNAMIC_REVERSE,
+            DONE
+        };
+
+        // samples are buffered so the acceleration can be a centered difference of the speed
+        static constexpr int SAMPLE_WINDOW = 5;
+        struct Sample
+        {
+            double  time;
+            double  volts;
+            double  speed;
+        };
+
+        // running sums of the least squares normal equations
+        struct Fit
+        {
+            std::array<std::array<double, 3>, 3>    ata;
+            std::array<double, 3>                   atb;
+            int                                     count;
+        };
+
+        units::voltage::volt_t GetTestVoltage( units::time::second_t time ) const;
+        void AddSample( size_t module, double time, double volts, double speed );
+        void NextTest();
+        void Finish();
+
+        std::shared_ptr<SwerveChassis>                                  m_chassis;
+        std::array<std::shared_ptr<SwerveModule>, 4>                    m_modules;
+        CHARACTERIZATION_TEST                                           m_test;
+        bool                                                            m_stopped;
+        frc2::Timer                                                     m_timer;
+        units::voltage::volt_t                                          m_volts;
+        units::time::second_t                                           m_lastTime;
+        units::length::meter_t                                          m_distance;
+        std::array<std::array<Sample, SAMPLE_WINDOW>, 4>                m_samples;
+        int                                                             m_sampleCount;
+        std::array<Fit, 4>                                              m_fits;
+};
@@ -0,0 +1,72 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// C++ Includes
+#include <cmath>
+
+// FRC includes
+#include <units/angle.h>
+#include <units/length.h>
+
+// Team 302 includes
+#include <auton/primitives/ModuleCalibrationFit.h>
+#include <utils/AngleUtils.h>
+
+// Third Party Includes
+
+using namespace std;
+
+/// @brief      Arc a wheel rolls while the chassis turns around a center of rotation on its left/right axis
+/// @return     units::length::meter_t - arc length
+units::length::meter_t ModuleCalibrationFit::WheelArc
+(
+    units::length::meter_t      moduleX,
+    units::length::meter_t      moduleY,
+    double                      curvature,
+    units::angle::radian_t      turn
+)
+{
+    // the center of rotation is the path radius to the left (positive curvature) of the chassis center
+    auto center = 1.0 / curvature;
+    auto radius = hypot( moduleX.to<double>(), moduleY.to<double>() - center );
+    return units::length::meter_t( radius * turn.to<double>() );
+}
+
+/// @brief      Effective wheel diameter as a fraction of the configured diameter
+/// @return     double - diameter ratio (0.0 if the wheel didn't report any distance)
+double ModuleCalibrationFit::DiameterRatio
+(
+    units::length::meter_t      arc,
+    units::length::meter_t      reportedDistance
+)
+{
+    return reportedDistance.to<double>() > 0.0 ? arc.to<double>() / reportedDistance.to<double>() : 0.0;
+}
+
+/// @brief      Correction to a module's turn sensor offset
+/// @return     units::angle::degree_t - correction (-180 to 180 degrees)
+units::angle::degree_t ModuleCalibrationFit::OffsetCorrection
+(
+    double                      travelX,
+    double                      travelY,
+    double                      moduleX,
+    double                      moduleY
+)
+{
+    auto travel = units::angle::radian_t( atan2( travelY, travelX ) );
+    auto measured = units::angle::radian_t( atan2( moduleY, moduleX ) );
+    return AngleUtils::GetEquivAngle( measured - travel );
+}
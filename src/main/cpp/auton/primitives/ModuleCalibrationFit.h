@@ -0,0 +1,84 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+
+// FRC includes
+#include <units/angle.h>
+#include <units/length.h>
+
+// Team 302 includes
+
+// Third Party Includes
+
+//========================================================================================================
+/// ModuleCalibrationFit.h
+//========================================================================================================
+///
+/// File Description:
+///     The arithmetic CalibrateModules fits a swerve module's calibration with, kept apart from the
+///     chassis and sensors so it can be checked against known paths:
+///       - the arc a wheel really rolls while the chassis turns around a center of rotation
+///       - the effective wheel diameter as a ratio of the configured one
+///       - the correction to the turn sensor offset from the travel direction
+///
+//========================================================================================================
+class ModuleCalibrationFit
+{
+    public:
+        /// @brief      Arc a wheel rolls while the chassis turns around a center of rotation on its
+        ///             left/right axis (the path radius; left for positive curvature)
+        /// @param [in] units::length::meter_t - module location forward of the chassis center
+        /// @param [in] units::length::meter_t - module location left of the chassis center
+        /// @param [in] double - path curvature (radians per meter, counter clockwise positive)
+        /// @param [in] units::angle::radian_t - gyro turn (magnitude)
+        /// @return     units::length::meter_t - arc length
+        static units::length::meter_t WheelArc
+        (
+            units::length::meter_t      moduleX,
+            units::length::meter_t      moduleY,
+            double                      curvature,
+            units::angle::radian_t      turn
+        );
+
+        /// @brief      Effective wheel diameter as a fraction of the configured diameter:  the drive
+        ///             encoder reports distance with the configured diameter, so the true arc over
+        ///             the reported distance scales the diameter
+        /// @param [in] units::length::meter_t - arc the wheel really rolled
+        /// @param [in] units::length::meter_t - distance the drive encoder reports
+        /// @return     double - diameter ratio (0.0 if the wheel didn't report any distance)
+        static double DiameterRatio
+        (
+            units::length::meter_t      arc,
+            units::length::meter_t      reportedDistance
+        );
+
+        /// @brief      Correction to a module's turn sensor offset:  the angle from the true travel
+        ///             direction to the direction the module reports it moved, both in the robot frame
+        /// @param [in] double - travel direction x (any length, e.g. the signed sum of the acceleration)
+        /// @param [in] double - travel direction y
+        /// @param [in] double - module reported displacement x
+        /// @param [in] double - module reported displacement y
+        /// @return     units::angle::degree_t - correction (-180 to 180 degrees)
+        static units::angle::degree_t OffsetCorrection
+        (
+            double                      travelX,
+            double                      travelY,
+            double                      moduleX,
+            double                      moduleY
+        );
+};
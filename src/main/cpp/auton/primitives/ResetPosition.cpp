@@ -18,6 +18,7 @@
 #include <string>
 
 //Team 302 includes
+#include <auton/BallMap.h>
 #include <auton/primitives/ResetPosition.h>
 #include <auton/PrimitiveParams.h>
 #include <auton/primitives/IPrimitive.h>
@@ -51,6 +52,9 @@ void ResetPosition::Init(PrimitiveParams* params)
 
         m_chassis->ResetPosition(m_trajectory.InitialPose(), StartAngle);
 
+        // balls mapped so far are in the old odometry frame
+        BallMap::GetInstance()->Reset();
+
         PigeonFactory::GetFactory()->GetPigeon()->ReZeroPigeon(0, 0);
 
         Logger::GetLogger()->LogError(Logger::LOGGER_LEVEL::PRINT, "ResetPosX", to_string(m_chassis.get()->GetPose().X().to<double>()));
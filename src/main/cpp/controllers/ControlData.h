@@ -102,6 +102,18 @@ class ControlData
         /// @return double - nominal value
         inline double GetNominalValue() const { return m_nominalValue; };
 
+        /// @brief  Update the coefficients while tuning (mode, run location and identifier stay fixed)
+        /// @param [in] double - new value
+        inline void SetP( double proportional ) { m_proportional = proportional; };
+        inline void SetI( double integral ) { m_integral = integral; };
+        inline void SetD( double derivative ) { m_derivative = derivative; };
+        inline void SetF( double feedforward ) { m_feedforward = feedforward; };
+        inline void SetIZone( double iZone ) { m_iZone = iZone; };
+        inline void SetMaxAcceleration( double maxAcceleration ) { m_maxAcceleration = maxAcceleration; };
+        inline void SetCruiseVelocity( double cruiseVelocity ) { m_cruiseVelocity = cruiseVelocity; };
+        inline void SetPeakValue( double peakValue ) { m_peakValue = peakValue; };
+        inline void SetNominalValue( double nominalValue ) { m_nominalValue = nominalValue; };
+
  
     private:
         ControlData() = delete;
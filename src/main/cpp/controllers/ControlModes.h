@@ -36,6 +36,7 @@ class ControlModes
             TRAPEZOID,                  /// Closed Loop Control - trapezoid profile (e.g. Motion Magic)
             MOTION_PROFILE,             /// Closed Loop Control - motion profile
             MOTION_PROFILE_ARC,         /// Closed Loop Control - motion profile arc
+            TRAPEZOID_DEGREES,          /// Closed Loop Control - trapezoid profile (e.g. Motion Magic) to an angle in degrees
             MAX_CONTROL_TYPES
         };
 		
@@ -0,0 +1,543 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// FRC includes
+#include <networktables/EntryListenerFlags.h>
+#include <networktables/NetworkTable.h>
+#include <networktables/NetworkTableEntry.h>
+#include <networktables/NetworkTableInstance.h>
+#include <networktables/NetworkTableValue.h>
+
+// Team 302 includes
+#include <controllers/ControlData.h>
+#include <controllers/ControlTuner.h>
+#include <controllers/MechanismTargetData.h>
+#include <states/IState.h>
+#include <states/Mech1MotorState.h>
+#include <states/Mech2MotorState.h>
+#include <subsys/Mech1IndMotor.h>
+#include <subsys/Mech2IndMotors.h>
+#include <subsys/MechanismFactory.h>
+#include <subsys/MechanismTypes.h>
+#include <utils/Logger.h>
+#include <xmlmechdata/StateDataDefn.h>
+#include <xmlmechdata/StateDataRegistry.h>
+
+// Third Party Includes
+#include <pugixml/pugixml.hpp>
+
+using namespace nt;
+using namespace pugi;
+using namespace std;
+
+ControlTuner* ControlTuner::m_instance = nullptr;
+ControlTuner* ControlTuner::GetInstance()
+{
+    if ( ControlTuner::m_instance == nullptr )
+    {
+        ControlTuner::m_instance = new ControlTuner();
+    }
+    return ControlTuner::m_instance;
+}
+
+ControlTuner::ControlTuner() : m_values(),
+                               m_states(),
+                               m_unsaved(),
+                               m_published( false ),
+                               m_mutex(),
+                               m_changes(),
+                               m_pending( false ),
+                               m_savePending( false )
+{
+    m_unsaved.fill( false );
+}
+
+/// @brief  Publish the state data for all mechanisms and start listening for edits.  Call
+///         after StateDataRegistry::ParseAll.
+/// @return void
+void ControlTuner::Publish()
+{
+    if ( m_published )
+    {
+        return;
+    }
+    m_published = true;
+
+    for ( auto inx=0; inx<MechanismTypes::MAX_MECHANISM_TYPES; ++inx )
+    {
+        auto mech = static_cast<MechanismTypes::MECHANISM_TYPE>( inx );
+
+        // name the table after the state file (e.g. shooter.xml -> Tuning/shooter)
+        auto filename = StateDataDefn::GetFileName( mech );
+        auto start = filename.find_last_of( '/' ) + 1;
+        auto mechName = filename.substr( start, filename.find_last_of( '.' ) - start );
+
+        vector<ControlData*> published;
+        auto targets = StateDataRegistry::GetInstance()->GetTargetData( mech );
+        for ( auto td : targets )
+        {
+            if ( td == nullptr )
+            {
+                continue;
+            }
+
+            auto stateTable = mechName + "/" + td->GetStateString();
+            AddValue( mech, TUNING_PARAM::TARGET, nullptr, td, stateTable );
+            if ( td->GetController2() != nullptr )
+            {
+                AddValue( mech, TUNING_PARAM::SECOND_TARGET, nullptr, td, stateTable );
+            }
+
+            for ( auto cd : { td->GetController(), td->GetController2() } )
+            {
+                if ( cd != nullptr && find( published.begin(), published.end(), cd ) == published.end() )
+                {
+                    published.emplace_back( cd );
+                    for ( auto param=0; param<TUNING_PARAM::TARGET; ++param )
+                    {
+                        AddValue( mech, static_cast<TUNING_PARAM>( param ), cd, nullptr, mechName + "/" + cd->GetIdentifier() );
+                    }
+                }
+            }
+        }
+    }
+
+    auto save = NetworkTableInstance::GetDefault().GetTable( "Tuning" )->GetEntry( "Save" );
+    save.SetBoolean( false );
+    save.AddListener( [this]( const EntryNotification& event )
+                      {
+                          if ( event.value && event.value->IsBoolean() && event.value->GetBoolean() )
+                          {
+                              m_savePending = true;
+                              m_pending = true;
+                          }
+                      }, EntryListenerFlags::kUpdate );
+}
+
+/// @brief      Register a state so edits to its target are passed on to it
+/// @param [in] MechanismTargetData* - target data the state was created from
+/// @param [in] IState* - state (Mech1MotorState or Mech2MotorState, others are ignored)
+/// @return     void
+void ControlTuner::AddState
+(
+    MechanismTargetData*    target,
+    IState*                 state
+)
+{
+    if ( target != nullptr && state != nullptr )
+    {
+        m_states.emplace_back( make_pair( target, state ) );
+    }
+}
+
+/// @brief  Apply the edits made since the last call.  Returns right away if there aren't any.
+/// @return void
+void ControlTuner::ApplyChanges()
+{
+    if ( !m_pending.exchange( false ) )
+    {
+        return;
+    }
+
+    vector<PendingChange> changes;
+    {
+        lock_guard<mutex> lock( m_mutex );
+        changes.swap( m_changes );
+    }
+
+    for ( auto change : changes )
+    {
+        auto tunable = m_values[change.index];
+        if ( GetValue( tunable ) == change.value )
+        {
+            continue;
+        }
+
+        SetValue( tunable, change.value );
+        m_unsaved[tunable.mechanism] = true;
+        if ( tunable.control != nullptr )
+        {
+            UpdateMechanism( tunable.mechanism, tunable.control );
+        }
+        else
+        {
+            UpdateStates( tunable.target );
+        }
+    }
+
+    if ( m_savePending.exchange( false ) )
+    {
+        Save();
+        NetworkTableInstance::GetDefault().GetTable( "Tuning" )->GetEntry( "Save" ).SetBoolean( false );
+    }
+}
+
+void ControlTuner::AddValue
+(
+    MechanismTypes::MECHANISM_TYPE  mechanism,
+    TUNING_PARAM                    param,
+    ControlData*                    control,
+    MechanismTargetData*            target,
+    const string&                   tableName
+)
+{
+    TunableValue tunable = { mechanism, param, control, target };
+    unsigned int index = m_values.size();
+    m_values.emplace_back( tunable );
+
+    auto entry = NetworkTableInstance::GetDefault().GetTable( "Tuning/" + tableName )->GetEntry( GetParamName( param ) );
+    entry.SetDouble( GetValue( tunable ) );
+
+    // listeners run on the network table thread, so only queue the value here
+    entry.AddListener( [this, index]( const EntryNotification& event )
+                       {
+                           if ( event.value && event.value->IsDouble() )
+                           {
+                               lock_guard<mutex> lock( m_mutex );
+                               m_changes.emplace_back( PendingChange{ index, event.value->GetDouble() } );
+                               m_pending = true;
+                           }
+                       }, EntryListenerFlags::kUpdate );
+}
+
+double ControlTuner::GetValue
+(
+    const TunableValue&             tunable
+) const
+{
+    switch ( tunable.param )
+    {
+        case TUNING_PARAM::PROPORTIONAL:
+            return tunable.control->GetP();
+
+        case TUNING_PARAM::INTEGRAL:
+            return tunable.control->GetI();
+
+        case TUNING_PARAM::DERIVATIVE:
+            return tunable.control->GetD();
+
+        case TUNING_PARAM::FEEDFORWARD:
+            return tunable.control->GetF();
+
+        case TUNING_PARAM::IZONE:
+            return tunable.control->GetIZone();
+
+        case TUNING_PARAM::MAX_ACCELERATION:
+            return tunable.control->GetMaxAcceleration();
+
+        case TUNING_PARAM::CRUISE_VELOCITY:
+            return tunable.control->GetCruiseVelocity();
+
+        case TUNING_PARAM::PEAK:
+            return tunable.control->GetPeakValue();
+
+        case TUNING_PARAM::NOMINAL:
+            return tunable.control->GetNominalValue();
+
+        case TUNING_PARAM::TARGET:
+            return tunable.target->GetTarget();
+
+        case TUNING_PARAM::SECOND_TARGET:
+            return tunable.target->GetSecondTarget();
+
+        default:
+            return 0.0;
+    }
+}
+
+void ControlTuner::SetValue
+(
+    const TunableValue&             tunable,
+    double                          value
+)
+{
+    switch ( tunable.param )
+    {
+        case TUNING_PARAM::PROPORTIONAL:
+            tunable.control->SetP( value );
+            break;
+
+        case TUNING_PARAM::INTEGRAL:
+            tunable.control->SetI( value );
+            break;
+
+        case TUNING_PARAM::DERIVATIVE:
+            tunable.control->SetD( value );
+            break;
+
+        case TUNING_PARAM::FEEDFORWARD:
+            tunable.control->SetF( value );
+            break;
+
+        case TUNING_PARAM::IZONE:
+            tunable.control->SetIZone( value );
+            break;
+
+        case TUNING_PARAM::MAX_ACCELERATION:
+            tunable.control->SetMaxAcceleration( value );
+            break;
+
+        case TUNING_PARAM::CRUISE_VELOCITY:
+            tunable.control->SetCruiseVelocity( value );
+            break;
+
+        case TUNING_PARAM::PEAK:
+            tunable.control->SetPeakValue( value );
+            break;
+
+        case TUNING_PARAM::NOMINAL:
+            tunable.control->SetNominalValue( value );
+            break;
+
+        case TUNING_PARAM::TARGET:
+            tunable.target->SetTarget( value );
+            break;
+
+        case TUNING_PARAM::SECOND_TARGET:
+            tunable.target->SetSecondTarget( value );
+            break;
+
+        default:
+            break;
+    }
+}
+
+void ControlTuner::UpdateMechanism
+(
+    MechanismTypes::MECHANISM_TYPE  mechanism,
+    ControlData*                    control
+)
+{
+    auto factory = MechanismFactory::GetMechanismFactory();
+    switch ( mechanism )
+    {
+        case MechanismTypes::INTAKE:
+            UpdateMechanism( factory->GetIntake().get(), control );
+            break;
+
+        case MechanismTypes::BALL_TRANSFER:
+            UpdateMechanism( factory->GetBallTransfer().get(), control );
+            break;
+
+        case MechanismTypes::TURRET:
+            UpdateMechanism( factory->GetTurret().get(), control );
+            break;
+
+        case MechanismTypes::SHOOTER:
+            UpdateMechanism( factory->GetShooter().get(), control );
+            break;
+
+        case MechanismTypes::BALL_HOPPER:
+            UpdateMechanism( factory->GetBallHopper().get(), control );
+            break;
+
+        default:
+            break;
+    }
+}
+
+void ControlTuner::UpdateMechanism
+(
+    Mech1IndMotor*                  mechanism,
+    ControlData*                    control
+)
+{
+    if ( mechanism != nullptr && mechanism->GetControlData() == control )
+    {
+        mechanism->SetControlConstants( 0, control );
+    }
+}
+
+void ControlTuner::UpdateMechanism
+(
+    Mech2IndMotors*                 mechanism,
+    ControlData*                    control
+)
+{
+    if ( mechanism != nullptr )
+    {
+        if ( mechanism->GetPrimaryControlData() == control )
+        {
+            mechanism->SetControlConstants( 0, control );
+        }
+        if ( mechanism->GetSecondaryControlData() == control )
+        {
+            mechanism->SetSecondaryControlConstants( 0, control );
+        }
+    }
+}
+
+void ControlTuner::UpdateStates
+(
+    MechanismTargetData*            target
+)
+{
+    for ( auto state : m_states )
+    {
+        if ( state.first == target )
+        {
+            auto mech2State = dynamic_cast<Mech2MotorState*>( state.second );
+            auto mech1State = dynamic_cast<Mech1MotorState*>( state.second );
+            if ( mech2State != nullptr )
+            {
+                mech2State->SetTargets( target->GetTarget(), target->GetSecondTarget() );
+            }
+            else if ( mech1State != nullptr )
+            {
+                mech1State->SetTarget( target->GetTarget() );
+            }
+        }
+    }
+}
+
+void ControlTuner::Save()
+{
+    for ( auto inx=0; inx<MechanismTypes::MAX_MECHANISM_TYPES; ++inx )
+    {
+        if ( m_unsaved[inx] && Save( static_cast<MechanismTypes::MECHANISM_TYPE>( inx ) ) )
+        {
+            m_unsaved[inx] = false;
+        }
+    }
+}
+
+bool ControlTuner::Save
+(
+    MechanismTypes::MECHANISM_TYPE  mechanism
+)
+{
+    auto filename = StateDataDefn::GetFileName( mechanism );
+
+    // keep the deployed file the first time it gets overwritten
+    auto backupName = filename + ".orig";
+    if ( !ifstream( backupName ).good() )
+    {
+        ifstream original( filename, ios::binary );
+        ofstream backup( backupName, ios::binary );
+        backup << original.rdbuf();
+    }
+
+    xml_document doc;
+    auto result = doc.load_file( filename.c_str(), parse_default | parse_declaration | parse_doctype | parse_comments );
+    if ( !result )
+    {
+        Logger::GetLogger()->LogError( string( "ControlTuner::Save" ), filename + string( " " ) + result.description() );
+        return false;
+    }
+
+    auto setAttr = []( xml_node node, const char* name, double value, double defaultValue )
+    {
+        auto attr = node.attribute( name );
+        if ( !attr )
+        {
+            if ( value == defaultValue )
+            {
+                return;
+            }
+            attr = node.append_attribute( name );
+        }
+        // enough digits that the saved value reads back as the same double
+        char buffer[32];
+        snprintf( buffer, sizeof( buffer ), "%.17g", value );
+        attr.set_value( buffer );
+    };
+
+    for ( auto tunable : m_values )
+    {
+        if ( tunable.mechanism != mechanism )
+        {
+            continue;
+        }
+
+        auto isControl = tunable.control != nullptr;
+        auto element = isControl ? "controlData" : "mechanismTarget";
+        auto idAttr = isControl ? "identifier" : "stateIdentifier";
+        auto id = isControl ? tunable.control->GetIdentifier() : tunable.target->GetStateString();
+
+        for ( xml_node node = doc.root().first_child(); node; node = node.next_sibling() )
+        {
+            for ( xml_node child = node.first_child(); child; child = child.next_sibling() )
+            {
+                if ( strcmp( child.name(), element ) == 0 && id == child.attribute( idAttr ).value() )
+                {
+                    auto defaultValue = tunable.param == TUNING_PARAM::PEAK ? 1.0 : 0.0;
+                    setAttr( child, GetParamName( tunable.param ).c_str(), GetValue( tunable ), defaultValue );
+                }
+            }
+        }
+    }
+
+    if ( !doc.save_file( filename.c_str() ) )
+    {
+        Logger::GetLogger()->LogError( string( "ControlTuner::Save" ), string( "unable to write " ) + filename );
+        return false;
+    }
+    return true;
+}
+
+/// @brief  Network table entry / xml attribute name for a parameter
+string ControlTuner::GetParamName
+(
+    TUNING_PARAM                    param
+)
+{
+    switch ( param )
+    {
+        case TUNING_PARAM::PROPORTIONAL:
+            return string( "proportional" );
+
+        case TUNING_PARAM::INTEGRAL:
+            return string( "integral" );
+
+        case TUNING_PARAM::DERIVATIVE:
+            return string( "derivative" );
+
+        case TUNING_PARAM::FEEDFORWARD:
+            return string( "feedforward" );
+
+        case TUNING_PARAM::IZONE:
+            return string( "izone" );
+
+        case TUNING_PARAM::MAX_ACCELERATION:
+            return string( "maxacceleration" );
+
+        case TUNING_PARAM::CRUISE_VELOCITY:
+            return string( "cruisevelocity" );
+
+        case TUNING_PARAM::PEAK:
+            return string( "peak" );
+
+        case TUNING_PARAM::NOMINAL:
+            return string( "nominal" );
+
+        case TUNING_PARAM::TARGET:
+            return string( "value" );
+
+        case TUNING_PARAM::SECOND_TARGET:
+            return string( "secondValue" );
+
+        default:
+            return string( "unknown" );
+    }
+}
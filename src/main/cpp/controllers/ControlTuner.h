@@ -0,0 +1,179 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <controllers/ControlData.h>
+#include <controllers/MechanismTargetData.h>
+#include <subsys/MechanismTypes.h>
+
+// Third Party Includes
+
+class IState;
+class Mech1IndMotor;
+class Mech2IndMotors;
+
+//========================================================================================================
+/// ControlTuner.h
+//========================================================================================================
+///
+/// File Description:
+///     Publishes the parsed control data (PIDF, izone, motion profile and output limits) and the
+///     state targets for every mechanism under the "Tuning" network table, so they can be edited
+///     from the dashboard while the robot is running.
+///
+///     Edits are queued by network table listeners and applied on the main thread in
+///     ApplyChanges.  Changed control constants are sent to a mechanism's motors only if the
+///     mechanism is currently using them; changed targets take effect the next time the state is
+///     entered.  Setting "Tuning/Save" writes the tuned values back to the deployed state files.
+///
+//========================================================================================================
+class ControlTuner
+{
+    public:
+        /// @brief  Find or create the tuner
+        /// @return ControlTuner* - pointer to the tuner
+        static ControlTuner* GetInstance();
+
+        /// @brief  Publish the state data for all mechanisms and start listening for edits.  Call
+        ///         after StateDataRegistry::ParseAll.
+        /// @return void
+        void Publish();
+
+        /// @brief      Register a state so edits to its target are passed on to it
+        /// @param [in] MechanismTargetData* - target data the state was created from
+        /// @param [in] IState* - state (Mech1MotorState or Mech2MotorState, others are ignored)
+        /// @return     void
+        void AddState
+        (
+            MechanismTargetData*    target,
+            IState*                 state
+        );
+
+        /// @brief  Apply the edits made since the last call.  Returns right away if there aren't any.
+        /// @return void
+        void ApplyChanges();
+
+    private:
+        ControlTuner();
+        ~ControlTuner() = default;
+
+        enum TUNING_PARAM
+        {
+            PROPORTIONAL,
+            INTEGRAL,
+            DERIVATIVE,
+            FEEDFORWARD,
+            IZONE,
+            MAX_ACCELERATION,
+            CRUISE_VELOCITY,
+            PEAK,
+            NOMINAL,
+            TARGET,
+            SECOND_TARGET,
+            MAX_TUNING_PARAMS
+        };
+
+        struct TunableValue
+        {
+            MechanismTypes::MECHANISM_TYPE  mechanism;
+            TUNING_PARAM                    param;
+            ControlData*                    control;
+            MechanismTargetData*            target;
+        };
+
+        struct PendingChange
+        {
+            unsigned int                    index;
+            double                          value;
+        };
+
+        void AddValue
+        (
+            MechanismTypes::MECHANISM_TYPE  mechanism,
+            TUNING_PARAM                    param,
+            ControlData*                    control,
+            MechanismTargetData*            target,
+            const std::string&              tableName
+        );
+
+        double GetValue
+        (
+            const TunableValue&             tunable
+        ) const;
+
+        void SetValue
+        (
+            const TunableValue&             tunable,
+            double                          value
+        );
+
+        void UpdateMechanism
+        (
+            MechanismTypes::MECHANISM_TYPE  mechanism,
+            ControlData*                    control
+        );
+
+        void UpdateMechanism
+        (
+            Mech1IndMotor*                  mechanism,
+            ControlData*                    control
+        );
+
+        void UpdateMechanism
+        (
+            Mech2IndMotors*                 mechanism,
+            ControlData*                    control
+        );
+
+        void UpdateStates
+        (
+            MechanismTargetData*            target
+        );
+
+        void Save();
+
+        bool Save
+        (
+            MechanismTypes::MECHANISM_TYPE  mechanism
+        );
+
+        static std::string GetParamName
+        (
+            TUNING_PARAM                    param
+        );
+
+        static ControlTuner*                                                m_instance;
+        std::vector<TunableValue>                                           m_values;
+        std::vector<std::pair<MechanismTargetData*, IState*>>               m_states;
+        std::array<bool, MechanismTypes::MAX_MECHANISM_TYPES>               m_unsaved;
+        bool                                                                m_published;
+
+        std::mutex                                                          m_mutex;
+        std::vector<PendingChange>                                          m_changes;
+        std::atomic<bool>                                                   m_pending;
+        std::atomic<bool>                                                   m_savePending;
+};
@@ -57,6 +57,10 @@ class MechanismTargetData
         /// @return std::string controller indentifier
         inline std::string GetControllerString() const { return m_controller; };
 
+        /// @brief  Retrieve the second controller identifier
+        /// @return std::string controller indentifier
+        inline std::string GetController2String() const { return m_controller2; };
+
         /// @brief  Retrieve the controller
         /// @return ControlData* controller
         inline ControlData* GetController() const { return m_controlData; };
@@ -78,6 +82,11 @@ class MechanismTargetData
         /// @return double - target value
         inline double GetSecondTarget() const { return m_secondTarget; };
 
+        /// @brief  Update the target values while tuning
+        /// @param [in] double - target value
+        inline void SetTarget( double target ) { m_target = target; };
+        inline void SetSecondTarget( double secondTarget ) { m_secondTarget = secondTarget; };
+
         /// @brief update to include ControlData
         /// @param [in] std::vector<ControlData*> - vector of ControlData Objects
         /// @return void
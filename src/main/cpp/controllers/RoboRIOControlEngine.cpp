@@ -0,0 +1,389 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// FRC includes
+#include <frc/Notifier.h>
+#include <frc/Threads.h>
+#include <frc2/Timer.h>
+
+// Team 302 includes
+#include <controllers/ControlData.h>
+#include <controllers/ControlModes.h>
+#include <controllers/RoboRIOControlEngine.h>
+#include <hw/interfaces/IDragonMotorController.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+#include <units/time.h>
+
+using namespace frc;
+using namespace std;
+
+namespace
+{
+    // real-time priority (1-99) of the engine's thread; the main robot thread isn't real-time
+    constexpr int CONTROL_THREAD_PRIORITY = 30;
+}
+
+RoboRIOControlEngine* RoboRIOControlEngine::m_instance = nullptr;
+RoboRIOControlEngine* RoboRIOControlEngine::GetInstance()
+{
+    if ( RoboRIOControlEngine::m_instance == nullptr )
+    {
+        RoboRIOControlEngine::m_instance = new RoboRIOControlEngine();
+    }
+    return RoboRIOControlEngine::m_instance;
+}
+
+RoboRIOControlEngine::RoboRIOControlEngine() : m_notifier(),
+                                               m_mutex(),
+                                               m_runMutex(),
+                                               m_loops(),
+                                               m_io(),
+                                               m_period( units::second_t( 0.005 ) ),
+                                               m_running( false ),
+                                               m_priorityRaised( false ),
+                                               m_cycles( 0 ),
+                                               m_overruns( 0 ),
+                                               m_maxCycleTime( units::second_t( 0.0 ) )
+{
+    m_notifier = make_unique<Notifier>( [this] { Run(); } );
+}
+
+/// @brief      Set the loop period (clamped between 1 ms and 20 ms)
+/// @param [in] units::second_t - loop period
+/// @return     void
+void RoboRIOControlEngine::SetPeriod
+(
+    units::second_t                             period
+)
+{
+    lock_guard<mutex> lock( m_mutex );
+    m_period = units::second_t( clamp( period.to<double>(), 0.001, 0.020 ) );
+    if ( m_running )
+    {
+        m_notifier->StartPeriodic( m_period );
+    }
+}
+
+/// @brief      Start (or restart with new constants) the loop for a motor.  The motor is
+///             switched to percent output after any running callback has finished.
+/// @param [in] std::shared_ptr<IDragonMotorController> - motor to control
+/// @param [in] ControlData* - control constants (the values are copied)
+/// @return     void
+void RoboRIOControlEngine::Start
+(
+    shared_ptr<IDragonMotorController>          motor,
+    ControlData*                                controlData
+)
+{
+    if ( motor.get() == nullptr || controlData == nullptr )
+    {
+        Logger::GetLogger()->LogError( string( "RoboRIOControlEngine::Start" ), string( "no motor or control data" ) );
+        return;
+    }
+
+    // no callback runs while the mode changes and the loop is (re)set
+    lock_guard<mutex> runLock( m_runMutex );
+    motor.get()->SetControlMode( ControlModes::CONTROL_TYPE::PERCENT_OUTPUT );
+
+    lock_guard<mutex> lock( m_mutex );
+    auto loop = FindLoop( motor.get() );
+    if ( loop == nullptr )
+    {
+        ControlLoop newLoop = {};
+        newLoop.motor = motor;
+        newLoop.target = 0.0;
+        m_loops.emplace_back( newLoop );
+        loop = &m_loops.back();
+    }
+
+    loop->mode = controlData->GetMode();
+    loop->p = controlData->GetP();
+    loop->i = controlData->GetI();
+    loop->d = controlData->GetD();
+    loop->f = controlData->GetF();
+    loop->iZone = controlData->GetIZone();
+    loop->peak = controlData->GetPeakValue() > 0.0 ? controlData->GetPeakValue() : 1.0;
+    loop->nominal = controlData->GetNominalValue();
+    loop->integral = 0.0;
+    loop->firstRun = true;
+    loop->lastOutput = numeric_limits<double>::quiet_NaN();
+
+    if ( !m_running )
+    {
+        m_notifier->StartPeriodic( m_period );
+        m_running = true;
+    }
+}
+
+/// @brief      Stop the loop for a motor and wait for a running callback to finish, so the
+///             engine doesn't write to the motor after this returns (the motor keeps its
+///             last output)
+/// @param [in] IDragonMotorController* - motor
+/// @return     void
+void RoboRIOControlEngine::Stop
+(
+    IDragonMotorController*                     motor
+)
+{
+    lock_guard<mutex> runLock( m_runMutex );
+    lock_guard<mutex> lock( m_mutex );
+    m_loops.erase( remove_if( m_loops.begin(), m_loops.end(), [motor]( const ControlLoop& loop ) { return loop.motor.get() == motor; } ),
+                   m_loops.end() );
+}
+
+/// @brief      Indicates whether a motor is controlled by this engine
+/// @param [in] IDragonMotorController* - motor
+/// @return     bool - true if a loop is running for the motor
+bool RoboRIOControlEngine::IsRunning
+(
+    IDragonMotorController*                     motor
+)
+{
+    lock_guard<mutex> lock( m_mutex );
+    return FindLoop( motor ) != nullptr;
+}
+
+/// @brief      Update the target for a motor's loop
+/// @param [in] IDragonMotorController* - motor
+/// @param [in] double - target
+/// @return     void
+void RoboRIOControlEngine::SetTarget
+(
+    IDragonMotorController*                     motor,
+    double                                      target
+)
+{
+    lock_guard<mutex> lock( m_mutex );
+    auto loop = FindLoop( motor );
+    if ( loop != nullptr )
+    {
+        loop->target = target;
+    }
+}
+
+/// @brief      Close a motor's loop on a different measurement than its own sensor
+/// @param [in] IDragonMotorController* - motor
+/// @param [in] std::function<double()> - measurement (called on the engine's thread)
+/// @return     void
+void RoboRIOControlEngine::SetMeasurement
+(
+    IDragonMotorController*                     motor,
+    function<double()>                          measurement
+)
+{
+    lock_guard<mutex> lock( m_mutex );
+    auto loop = FindLoop( motor );
+    if ( loop != nullptr )
+    {
+        loop->measurement = measurement;
+        loop->firstRun = true;
+    }
+}
+
+/// @brief      Number of cycles run since the engine was created
+/// @return     int - cycles
+int RoboRIOControlEngine::GetCycleCount()
+{
+    lock_guard<mutex> lock( m_mutex );
+    return m_cycles;
+}
+
+/// @brief      Number of cycles that took longer than the loop period
+/// @return     int - overruns
+int RoboRIOControlEngine::GetOverrunCount()
+{
+    lock_guard<mutex> lock( m_mutex );
+    return m_overruns;
+}
+
+/// @brief      Longest cycle since the engine was created
+/// @return     units::second_t - cycle time
+units::second_t RoboRIOControlEngine::GetMaxCycleTime()
+{
+    lock_guard<mutex> lock( m_mutex );
+    return m_maxCycleTime;
+}
+
+/// @brief  run every loop once (called by the notifier).  Only the math is done under m_mutex;
+///         the sensor reads and motor writes happen outside of it.  Start and Stop can't change
+///         the loops during a cycle because the cycle holds m_runMutex.
+void RoboRIOControlEngine::Run()
+{
+    // the notifier creates its thread, so the priority can only be set from the callback
+    if ( !m_priorityRaised )
+    {
+        m_priorityRaised = true;
+        if ( !SetCurrentThreadPriority( true, CONTROL_THREAD_PRIORITY ) )
+        {
+            Logger::GetLogger()->LogError( string( "RoboRIOControlEngine::Run" ), string( "couldn't set the real-time thread priority" ) );
+        }
+    }
+
+    auto start = frc2::Timer::GetFPGATimestamp();
+    lock_guard<mutex> runLock( m_runMutex );
+    {
+        lock_guard<mutex> lock( m_mutex );
+        m_io.clear();
+        for ( auto& loop : m_loops )
+        {
+            m_io.emplace_back( LoopIO{ loop.motor, loop.measurement, loop.mode, loop.target, 0.0, false } );
+        }
+    }
+
+    for ( auto& io : m_io )
+    {
+        io.value = GetMeasurement( io );
+    }
+
+    {
+        lock_guard<mutex> lock( m_mutex );
+        for ( auto inx=0U; inx<m_io.size(); ++inx )
+        {
+            auto& loop = m_loops[inx];
+            auto& io = m_io[inx];
+            auto output = Calculate( loop, io.value );
+
+            // only send the output when it changes
+            io.send = std::isnan( loop.lastOutput ) || abs( output - loop.lastOutput ) > 0.0001;
+            if ( io.send )
+            {
+                loop.lastOutput = output;
+                io.value = output;
+            }
+        }
+    }
+
+    for ( auto& io : m_io )
+    {
+        if ( io.send )
+        {
+            io.motor.get()->Set( io.value );
+        }
+    }
+
+    auto cycleTime = frc2::Timer::GetFPGATimestamp() - start;
+    lock_guard<mutex> lock( m_mutex );
+    ++m_cycles;
+    if ( cycleTime > m_period )
+    {
+        ++m_overruns;
+    }
+    m_maxCycleTime = cycleTime > m_maxCycleTime ? cycleTime : m_maxCycleTime;
+}
+
+RoboRIOControlEngine::ControlLoop* RoboRIOControlEngine::FindLoop
+(
+    IDragonMotorController*                     motor
+)
+{
+    for ( auto& loop : m_loops )
+    {
+        if ( loop.motor.get() == motor )
+        {
+            return &loop;
+        }
+    }
+    return nullptr;
+}
+
+/// @brief  Read the loop's measurement.  Without a measurement function, position modes use
+///         the motor's position in degrees and velocity modes its speed; other modes have no
+///         measurement and run feedforward only.
+double RoboRIOControlEngine::GetMeasurement
+(
+    const LoopIO&                               io
+) const
+{
+    if ( io.measurement )
+    {
+        return io.measurement();
+    }
+
+    switch ( io.mode )
+    {
+        case ControlModes::CONTROL_TYPE::POSITION_DEGREES:
+        case ControlModes::CONTROL_TYPE::POSITION_DEGREES_ABSOLUTE:
+        case ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES:
+            return io.motor.get()->GetRotations() * 360.0;
+
+        case ControlModes::CONTROL_TYPE::VELOCITY_DEGREES:
+            return io.motor.get()->GetRPS() * 360.0;
+
+        case ControlModes::CONTROL_TYPE::VELOCITY_RPS:
+            return io.motor.get()->GetRPS();
+
+        default:
+            return io.target;
+    }
+}
+
+/// @brief  PIDF with the gains in percent output per unit of the measurement.  The integral is
+///         reset outside of the izone (if one is set) and the derivative is taken on the
+///         measurement so target changes don't kick the output.  Anti-windup:  the integral term
+///         is limited to the peak output, and the integral doesn't grow while the output is
+///         saturated in the direction of the error.
+double RoboRIOControlEngine::Calculate
+(
+    ControlLoop&                                loop,
+    double                                      measurement
+) const
+{
+    auto dt = m_period.to<double>();
+    if ( loop.firstRun )
+    {
+        loop.prevMeasurement = measurement;
+        loop.integral = 0.0;
+        loop.firstRun = false;
+    }
+
+    auto error = loop.target - measurement;
+    auto derivative = ( loop.prevMeasurement - measurement ) / dt;
+    loop.prevMeasurement = measurement;
+    auto unintegrated = loop.f * loop.target + loop.p * error + loop.d * derivative;
+
+    if ( loop.iZone > 0.0 && abs( error ) > loop.iZone )
+    {
+        loop.integral = 0.0;
+    }
+    else if ( loop.i != 0.0 )
+    {
+        auto saturated = abs( unintegrated + loop.i * loop.integral ) >= loop.peak;
+        auto windingUp = ( unintegrated + loop.i * loop.integral ) * error > 0.0;
+        if ( !( saturated && windingUp ) )
+        {
+            loop.integral += error * dt;
+        }
+        auto maxIntegral = loop.peak / abs( loop.i );
+        loop.integral = clamp( loop.integral, -maxIntegral, maxIntegral );
+    }
+
+    auto output = unintegrated + loop.i * loop.integral;
+    if ( output != 0.0 && abs( output ) < loop.nominal )
+    {
+        output = copysign( loop.nominal, output );
+    }
+    return clamp( output, -loop.peak, loop.peak );
+}
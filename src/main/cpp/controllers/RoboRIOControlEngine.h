@@ -0,0 +1,201 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// FRC includes
+#include <frc/Notifier.h>
+
+// Team 302 includes
+#include <controllers/ControlData.h>
+#include <controllers/ControlModes.h>
+#include <hw/interfaces/IDragonMotorController.h>
+
+// Third Party Includes
+#include <units/time.h>
+
+//========================================================================================================
+/// RoboRIOControlEngine.h
+//========================================================================================================
+///
+/// File Description:
+///     Runs the PIDF loops for control data that has constrolServer="ROBORIO".  The loops run on
+///     a notifier thread (200 Hz by default) instead of the main robot loop.  The thread raises
+///     itself to a real-time priority on its first cycle so the main loop can't delay it, and each
+///     cycle is timed:  a cycle that takes longer than the period is counted as an overrun.  The
+///     loops read the motor
+///     sensors (the controllers' latest status frames) or a supplied measurement function, and
+///     only send a new percent output to the motor controller when it changes.
+///
+///     A measurement function lets a loop close on something the motor controller can't see,
+///     e.g. a turret angle fused from the limelight and the pigeon.
+///
+///     Threading:  m_mutex only guards the loop data, so it is never held across CAN reads or
+///     writes and SetTarget doesn't wait on the bus.  m_runMutex is held for a whole notifier
+///     cycle; Start and Stop take it, so once they return no callback is still writing to the
+///     motor and the caller can change the motor's control mode safely.
+///
+///     The engine is opt-in:  only control data with constrolServer="ROBORIO" uses it, and none of
+///     the deployed state data selects it yet.
+///
+//========================================================================================================
+class RoboRIOControlEngine
+{
+    public:
+        /// @brief  Find or create the control engine
+        /// @return RoboRIOControlEngine* - pointer to the engine
+        static RoboRIOControlEngine* GetInstance();
+
+        /// @brief      Set the loop period (clamped between 1 ms and 20 ms)
+        /// @param [in] units::second_t - loop period
+        /// @return     void
+        void SetPeriod
+        (
+            units::second_t                             period
+        );
+
+        /// @brief      Start (or restart with new constants) the loop for a motor.  The motor is
+        ///             switched to percent output after any running callback has finished.
+        /// @param [in] std::shared_ptr<IDragonMotorController> - motor to control
+        /// @param [in] ControlData* - control constants (the values are copied)
+        /// @return     void
+        void Start
+        (
+            std::shared_ptr<IDragonMotorController>     motor,
+            ControlData*                                controlData
+        );
+
+        /// @brief      Stop the loop for a motor and wait for a running callback to finish, so the
+        ///             engine doesn't write to the motor after this returns (the motor keeps its
+        ///             last output)
+        /// @param [in] IDragonMotorController* - motor
+        /// @return     void
+        void Stop
+        (
+            IDragonMotorController*                     motor
+        );
+
+        /// @brief      Indicates whether a motor is controlled by this engine
+        /// @param [in] IDragonMotorController* - motor
+        /// @return     bool - true if a loop is running for the motor
+        bool IsRunning
+        (
+            IDragonMotorController*                     motor
+        );
+
+        /// @brief      Update the target for a motor's loop (degrees, degrees per second or revolutions
+        ///             per second depending on the control mode, or the measurement function's units)
+        /// @param [in] IDragonMotorController* - motor
+        /// @param [in] double - target
+        /// @return     void
+        void SetTarget
+        (
+            IDragonMotorController*                     motor,
+            double                                      target
+        );
+
+        /// @brief      Close a motor's loop on a different measurement than its own sensor
+        /// @param [in] IDragonMotorController* - motor
+        /// @param [in] std::function<double()> - measurement (called on the engine's thread)
+        /// @return     void
+        void SetMeasurement
+        (
+            IDragonMotorController*                     motor,
+            std::function<double()>                     measurement
+        );
+
+        /// @brief  Number of cycles run since the engine was created
+        /// @return int - cycles
+        int GetCycleCount();
+
+        /// @brief  Number of cycles that took longer than the loop period
+        /// @return int - overruns
+        int GetOverrunCount();
+
+        /// @brief  Longest cycle since the engine was created
+        /// @return units::second_t - cycle time
+        units::second_t GetMaxCycleTime();
+
+    private:
+        RoboRIOControlEngine();
+        ~RoboRIOControlEngine() = default;
+
+        struct ControlLoop
+        {
+            std::shared_ptr<IDragonMotorController>     motor;
+            ControlModes::CONTROL_TYPE                  mode;
+            double                                      p;
+            double                                      i;
+            double                                      d;
+            double                                      f;
+            double                                      iZone;
+            double                                      peak;
+            double                                      nominal;
+            std::function<double()>                     measurement;
+            double                                      target;
+            double                                      integral;
+            double                                      prevMeasurement;
+            bool                                        firstRun;
+            double                                      lastOutput;
+        };
+
+        /// @brief  what a cycle reads and writes outside of m_mutex
+        struct LoopIO
+        {
+            std::shared_ptr<IDragonMotorController>     motor;
+            std::function<double()>                     measurement;
+            ControlModes::CONTROL_TYPE                  mode;
+            double                                      target;
+            double                                      value;
+            bool                                        send;
+        };
+
+        void Run();
+
+        ControlLoop* FindLoop
+        (
+            IDragonMotorController*                     motor
+        );
+
+        double GetMeasurement
+        (
+            const LoopIO&                               io
+        ) const;
+
+        double Calculate
+        (
+            ControlLoop&                                loop,
+            double                                      measurement
+        ) const;
+
+        static RoboRIOControlEngine*                    m_instance;
+        std::unique_ptr<frc::Notifier>                  m_notifier;
+        std::mutex                                      m_mutex;        ///< loop data
+        std::mutex                                      m_runMutex;     ///< held for a whole cycle
+        std::vector<ControlLoop>                        m_loops;
+        std::vector<LoopIO>                             m_io;           ///< only used while m_runMutex is held
+        units::second_t                                 m_period;
+        bool                                            m_running;
+        bool                                            m_priorityRaised;   ///< only used on the notifier thread
+        int                                             m_cycles;
+        int                                             m_overruns;
+        units::second_t                                 m_maxCycleTime;
+};
@@ -41,7 +41,9 @@ m_axisScale(),
 m_axisInversionFactor(),
 m_axisProfile(),
 //m_button(),
-m_button()
+m_button(),
+m_pressed(),
+m_previous()
 {
 // device type is 24
 // 8 axis
@@ -133,6 +135,17 @@ DragonGamepad::~DragonGamepad()
     m_gamepad = nullptr;
 }
 
+/// @brief  Read every button once and keep the previous reading, so the button queries
+///         all answer from the same snapshot.  Call this once per cycle.
+void DragonGamepad::Update()
+{
+    m_previous = m_pressed;
+    for ( auto inx=0; inx<BUTTON_IDENTIFIER::MAX_BUTTONS; ++inx )
+    {
+        m_pressed[inx] = ( m_button[inx] != nullptr ) && m_button[inx]->IsButtonPressed();
+    }
+}
+
 double DragonGamepad::GetAxisValue
 (
     AXIS_IDENTIFIER axis
@@ -162,7 +175,7 @@ bool DragonGamepad::IsButtonPressed
     bool isPressed = false;
     if ( m_button[button] != nullptr )
     {
-        isPressed = m_button[button]->IsButtonPressed();
+        isPressed = m_pressed[button];
     }
 	else
 	{
@@ -268,7 +281,7 @@ bool DragonGamepad::WasButtonPressed
 	bool isPressed = false;
 	if ( m_button[button] != nullptr )
 	{
-		isPressed = m_button[button]->WasButtonPressed();
+		isPressed = m_pressed[button] && !m_previous[button];
 	}
     else
     {
@@ -285,7 +298,7 @@ bool DragonGamepad::WasButtonReleased
 	bool isPressed = false;
 	if ( m_button[button] != nullptr )
 	{
-		isPressed = m_button[button]->WasButtonReleased();
+		isPressed = m_previous[button] && !m_pressed[button];
 	}
     else
     {
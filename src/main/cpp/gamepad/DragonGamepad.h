@@ -18,6 +18,8 @@
 #pragma once
 
 // C++ Includes
+#include <bitset>
+#include <vector>
 
 // FRC includes
 #include <frc/GenericHID.h>
@@ -43,7 +45,7 @@ class DragonGamepad : public IDragonGamePad
         );
         ~DragonGamepad();
 
-        
+        void Update() override;
 
         bool IsButtonPressed
         (
@@ -105,6 +107,8 @@ class DragonGamepad : public IDragonGamePad
         std::vector<AXIS_PROFILE> m_axisProfile;
 
         std::vector<IButton*> m_button;
+        std::bitset<MAX_BUTTONS> m_pressed;
+        std::bitset<MAX_BUTTONS> m_previous;
         //std::vector<AnalogButton*> m_analogButtons;
 
 
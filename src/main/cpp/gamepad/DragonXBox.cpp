@@ -33,7 +33,11 @@
 DragonXBox::DragonXBox
 ( 
     int port
-) : m_xbox( new frc::XboxController( port ) )
+) : m_xbox( new frc::XboxController( port ) ),
+    m_axis(),
+    m_button(),
+    m_pressed(),
+    m_previous()
 {
     // Create Axis Objects
     m_axis[ LEFT_JOYSTICK_X ] = new AnalogAxis( m_xbox, 0, false );
@@ -77,6 +81,21 @@ DragonXBox::~DragonXBox()
     m_xbox = nullptr;
 }
 
+///-------------------------------------------------------------------------------------------------
+/// Method:      Update
+/// Description: Read every button once and keep the previous reading, so the button queries
+///              below all answer from the same snapshot.
+/// Returns:     void
+///-------------------------------------------------------------------------------------------------
+void DragonXBox::Update()
+{
+    m_previous = m_pressed;
+    for ( auto inx=0; inx<MAX_BUTTONS; ++inx )
+    {
+        m_pressed[inx] = ( m_button[inx] != nullptr ) && m_button[inx]->IsButtonPressed();
+    }
+}
+
    
 //getters
 ///-------------------------------------------------------------------------------------------------
@@ -105,7 +124,8 @@ double DragonXBox::GetAxisValue
 
 ///-------------------------------------------------------------------------------------------------
 /// Method:      IsButtonPressed
-/// Description: Return whether the requested button is selected (true) or not (false)
+/// Description: Return whether the requested button was selected (true) or not (false) in the
+///              latest snapshot
 /// Returns:     bool    true  - button is pressed
 ///              false - button is not pressed
 ///-------------------------------------------------------------------------------------------------
@@ -114,20 +134,15 @@ bool DragonXBox::IsButtonPressed
     BUTTON_IDENTIFIER    button // <I> - button to check
 ) const
 {
-    bool isPressed = false;
-    if ( m_button[button] != nullptr )
-    {
-        isPressed = m_button[button]->IsButtonPressed();
-    }
-    return isPressed;
+    return m_pressed[button];
 }
         
 
     //==================================================================================
     /// <summary>
     /// Method:         WasButtonReleased
-    /// Description:    Read whether the button was released since the last query.  This
-    ///                 is only valid for digital buttons (normal buttons and bumpers).
+    /// Description:    Read whether the button was released between the previous
+    ///                 snapshot and this one.
     /// </summary>
     //==================================================================================
     bool DragonXBox::WasButtonReleased
@@ -135,20 +150,15 @@ bool DragonXBox::IsButtonPressed
         BUTTON_IDENTIFIER    button // <I> - button to check
     ) const    
     {
-        bool isPressed = false;
-        if ( m_button[button] != nullptr )
-        {
-            isPressed = m_button[button]->WasButtonReleased();
-        }
-        return isPressed;
+        return m_previous[button] && !m_pressed[button];
     }
     
 
     //==================================================================================
     /// <summary>
     /// Method:         WasButtonPressed
-    /// Description:    Read whether the button was pressed since the last query.  This
-    ///                 is only valid for digital buttons (normal buttons and bumpers).
+    /// Description:    Read whether the button was pressed between the previous
+    ///                 snapshot and this one.
     /// </summary>
     //==================================================================================
     bool DragonXBox::WasButtonPressed
@@ -156,12 +166,7 @@ bool DragonXBox::IsButtonPressed
         BUTTON_IDENTIFIER    button // <I> - button to check
     ) const        
     {
-        bool isPressed = false;
-        if ( m_button[button] != nullptr )
-        {
-            isPressed = m_button[button]->WasButtonPressed();
-        }
-        return isPressed;
+        return m_pressed[button] && !m_previous[button];
     }
  
 
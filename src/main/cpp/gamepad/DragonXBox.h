@@ -26,6 +26,7 @@
 #pragma once
 
 // C++ Includes
+#include <bitset>
 
 // FRC includes
 #include <frc/GenericHID.h>
@@ -50,6 +51,14 @@ class DragonXBox : public IDragonGamePad
 
         ~DragonXBox();
 
+        ///-------------------------------------------------------------------------------------------------
+        /// Method:      Update
+        /// Description: Read every button once and keep the previous reading, so the button queries
+        ///              below all answer from the same snapshot.  Call this once per cycle before
+        ///              querying any buttons.
+        /// Returns:     void
+        ///-------------------------------------------------------------------------------------------------
+        void Update() override;
         
         //getters
         ///-------------------------------------------------------------------------------------------------
@@ -77,8 +86,8 @@ class DragonXBox : public IDragonGamePad
         //==================================================================================
         /// <summary>
         /// Method:         WasButtonReleased
-        /// Description:    Read whether the button was released since the last query.  This
-        ///                 is only valid for digital buttons (normal buttons and bumpers).
+        /// Description:    Read whether the button was released between the previous
+        ///                 snapshot and this one.
         /// </summary>
         //==================================================================================
         bool WasButtonReleased
@@ -90,8 +99,8 @@ class DragonXBox : public IDragonGamePad
         //==================================================================================
         /// <summary>
         /// Method:         WasButtonPressed
-        /// Description:    Read whether the button was pressed since the last query.  This
-        ///                 is only valid for digital buttons (normal buttons and bumpers).
+        /// Description:    Read whether the button was pressed between the previous
+        ///                 snapshot and this one.
         /// </summary>
         //==================================================================================
         bool WasButtonPressed
@@ -175,6 +184,8 @@ class DragonXBox : public IDragonGamePad
         frc::XboxController*        m_xbox;
         AnalogAxis*                 m_axis[MAX_AXIS];
         IButton*                    m_button[MAX_BUTTONS];
+        std::bitset<MAX_BUTTONS>    m_pressed;
+        std::bitset<MAX_BUTTONS>    m_previous;
         
 
         DragonXBox() = delete;
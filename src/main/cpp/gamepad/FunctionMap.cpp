@@ -35,6 +35,7 @@ FunctionMap::FunctionMap() : m_function( TeleopControl::FUNCTION_IDENTIFIER::UNK
                              m_axisID( IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS ),
                              m_axisDeadband( IDragonGamePad::AXIS_DEADBAND::APPLY_STANDARD_DEADBAND ),
                              m_axisProfile( IDragonGamePad::AXIS_PROFILE::CUBED ),
+                             m_axisScale( 1.0 ),
                              m_buttonID( IDragonGamePad::BUTTON_IDENTIFIER::UNDEFINED_BUTTON ),
                              m_buttonMode( IDragonGamePad::BUTTON_MODE::STANDARD )
 {
@@ -45,6 +46,7 @@ FunctionMap::FunctionMap() : m_function( TeleopControl::FUNCTION_IDENTIFIER::UNK
 /// @param [in] IDragonGamePad::AXIS_IDENTIFIER axisID - the axis ID this maps to
 /// @param [in] IDragonGamePad::AXIS_DEADBAND deadband - the deadband type this axis should have
 /// @param [in] IDragonGamePad::AXIS_PROFILE profile - the profile type this axis should have
+/// @param [in] double scaleFactor - the scale factor this axis should have
 /// @param [in] IDragonGamePad::BUTTON_IDENTIFIER buttonID - the button ID this maps to
 /// @param [in] IDragonGamePad::BUTTON_MODE buttonType - the type of button this should beS
 FunctionMap::FunctionMap
@@ -54,6 +56,7 @@ FunctionMap::FunctionMap
     IDragonGamePad::AXIS_IDENTIFIER     axisID,
     IDragonGamePad::AXIS_DEADBAND       deadBand,
     IDragonGamePad::AXIS_PROFILE        profile,
+    double                              scaleFactor,
     IDragonGamePad::BUTTON_IDENTIFIER   buttonID,
     IDragonGamePad::BUTTON_MODE         buttonType
 ) : m_function( function ),
@@ -61,6 +64,7 @@ FunctionMap::FunctionMap
     m_axisID( axisID ),
     m_axisDeadband( deadBand ),
     m_axisProfile( profile ),
+    m_axisScale( scaleFactor ),
     m_buttonID( buttonID ),
     m_buttonMode( buttonType )
 {
@@ -109,6 +113,14 @@ IDragonGamePad::AXIS_PROFILE FunctionMap::GetProfile() const
 }
 
 
+/// @brief  Returns the axis scale factor
+/// @return double the axis scale factor
+double FunctionMap::GetScaleFactor() const
+{
+    return m_axisScale;
+}
+
+
 /// @brief  Returns the button identifier
 /// @return int the button this is valid for (UNDEFINED_BUTTON means this isn't using a button) 
 IDragonGamePad::BUTTON_IDENTIFIER FunctionMap::GetButtonID() const
@@ -39,6 +39,7 @@ class FunctionMap
             IDragonGamePad::AXIS_IDENTIFIER     axisID,
             IDragonGamePad::AXIS_DEADBAND       deadBand,
             IDragonGamePad::AXIS_PROFILE        profile,
+            double                              scaleFactor,
             IDragonGamePad::BUTTON_IDENTIFIER   buttonID,
             IDragonGamePad::BUTTON_MODE         buttonType
         );
@@ -49,6 +50,7 @@ class FunctionMap
         IDragonGamePad::AXIS_IDENTIFIER GetAxisID() const;
         IDragonGamePad::AXIS_DEADBAND GetDeadband() const;
         IDragonGamePad::AXIS_PROFILE GetProfile() const;
+        double GetScaleFactor() const;
         IDragonGamePad::BUTTON_IDENTIFIER GetButtonID() const;
         IDragonGamePad::BUTTON_MODE GetMode() const;
 
@@ -59,6 +61,7 @@ class FunctionMap
         IDragonGamePad::AXIS_IDENTIFIER         m_axisID;
         IDragonGamePad::AXIS_DEADBAND           m_axisDeadband;
         IDragonGamePad::AXIS_PROFILE            m_axisProfile;
+        double                                  m_axisScale;
         IDragonGamePad::BUTTON_IDENTIFIER       m_buttonID;
         IDragonGamePad::BUTTON_MODE             m_buttonMode;
 };
\ No newline at end of file
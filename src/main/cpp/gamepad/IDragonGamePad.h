@@ -142,6 +142,15 @@ class IDragonGamePad
         ~IDragonGamePad() = default;
 
         
+        ///-------------------------------------------------------------------------------------------------
+        /// Method:      Update
+        /// Description: Read every button once and keep the previous reading, so the button queries
+        ///              below all answer from the same snapshot.  Call this once per cycle before
+        ///              querying any buttons.
+        /// Returns:     void
+        ///-------------------------------------------------------------------------------------------------
+        virtual void Update() = 0;
+
         //getters
         ///-------------------------------------------------------------------------------------------------
         /// Method:      GetAxisValue
@@ -169,8 +178,8 @@ class IDragonGamePad
         //==================================================================================
         /// <summary>
         /// Method:         WasButtonReleased
-        /// Description:    Read whether the button was released since the last query.  This
-        ///                 is only valid for digital buttons (normal buttons and bumpers).
+        /// Description:    Read whether the button was released between the previous
+        ///                 snapshot and this one.
         /// </summary>
         //==================================================================================
         virtual bool WasButtonReleased
@@ -181,8 +190,8 @@ class IDragonGamePad
         //==================================================================================
         /// <summary>
         /// Method:         WasButtonPressed
-        /// Description:    Read whether the button was pressed since the last query.  This
-        ///                 is only valid for digital buttons (normal buttons and bumpers).
+        /// Description:    Read whether the button was pressed between the previous
+        ///                 snapshot and this one.
         /// </summary>
         //==================================================================================
         virtual bool WasButtonPressed
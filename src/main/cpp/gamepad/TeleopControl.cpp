@@ -22,12 +22,16 @@
 // Team 302 includes
 
 // Third Party Includes
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <frc/GenericHID.h>
 #include <gamepad/IDragonGamePad.h>
 #include <gamepad/DragonXBox.h>
 #include <gamepad/DragonGamePad.h>
 #include <gamepad/TeleopControl.h>
+#include <gamepad/FunctionMap.h>
+#include <xmlhw/ControlsDefn.h>
 #include <frc/DriverStation.h>
 #include <utils/Logger.h>
 
@@ -52,13 +56,19 @@ TeleopControl* TeleopControl::GetInstance()
 //----------------------------------------------------------------------------------
 // Method:      OperatorInterface <<constructor>>
 // Description: This will construct and initialize the object.
-//              It maps the functions to the buttons/axis.
+//              It maps the functions to the buttons/axis from
+//              controls.xml.
 //---------------------------------------------------------------------------------
-TeleopControl::TeleopControl() : m_axisIDs(),
-								 m_buttonIDs(),
-								 m_controllerIndex(),
-								 m_controllers(),
-								 m_count( 0 )
+TeleopControl::TeleopControl() : m_controllers(),
+								 m_bindings(),
+								 m_count( 0 ),
+								 m_buttonFunctions(),
+								 m_events(),
+								 m_eventCount( 0 ),
+								 m_subscriptions(),
+								 m_dispatching( false ),
+								 m_unsubscribed( false ),
+								 m_pending()
 {
 	DriverStation* ds = &DriverStation::GetInstance();
 	for ( int inx=0; inx<DriverStation::kJoystickPorts; ++inx )
@@ -76,134 +86,180 @@ TeleopControl::TeleopControl() : m_axisIDs(),
 		}
 	}
 
-
     // Initialize the items to not defined
-	m_axisIDs.resize(FUNCTION_IDENTIFIER::MAX_FUNCTIONS);
-	m_buttonIDs.resize(FUNCTION_IDENTIFIER::MAX_FUNCTIONS);
-	m_controllerIndex.resize(FUNCTION_IDENTIFIER::MAX_FUNCTIONS);
-    for ( int inx=0; inx<FUNCTION_IDENTIFIER::MAX_FUNCTIONS; ++inx )
+    for ( auto& binding : m_bindings )
     {
-        m_axisIDs[inx]    		= IDragonGamePad::UNDEFINED_AXIS;
-        m_buttonIDs[inx]  		= IDragonGamePad::UNDEFINED_BUTTON;
-        m_controllerIndex[inx]  = -1;
+        binding = FunctionBinding{ nullptr, IDragonGamePad::UNDEFINED_AXIS, IDragonGamePad::UNDEFINED_BUTTON };
     }
 
-    auto ctrlNo = 0;
-    if ( m_controllers[ctrlNo] != nullptr && ds->GetJoystickIsXbox(ctrlNo) )
-    {
-		m_controllerIndex[ SWERVE_DRIVE_DRIVE]			= ctrlNo;
-		m_axisIDs[ SWERVE_DRIVE_DRIVE]					= IDragonGamePad::LEFT_JOYSTICK_Y;
-		m_controllerIndex[ SWERVE_DRIVE_STEER]			= ctrlNo;
-		m_axisIDs[ SWERVE_DRIVE_STEER]					= IDragonGamePad::LEFT_JOYSTICK_X;
-		m_controllerIndex[ SWERVE_DRIVE_ROTATE]			= ctrlNo;
-		m_axisIDs[ SWERVE_DRIVE_ROTATE]					= IDragonGamePad::RIGHT_JOYSTICK_X;
-		m_controllerIndex[ REZERO_PIGEON ]				= ctrlNo;
-		m_buttonIDs[ REZERO_PIGEON ]					= IDragonGamePad::X_BUTTON;
-
-		m_controllerIndex[ AUTO_DRIVE_TO_YELLOW ]		= ctrlNo;
-		m_buttonIDs[ AUTO_DRIVE_TO_YELLOW ]				= IDragonGamePad::Y_BUTTON;
-		m_controllerIndex[ AUTO_DRIVE_TO_LOADING_ZONE ]	= ctrlNo;
-		m_buttonIDs[ AUTO_DRIVE_TO_LOADING_ZONE ]		= IDragonGamePad::B_BUTTON;
-
-		m_controllerIndex[DRIVE_FULL] 		= ctrlNo;
-		m_buttonIDs[DRIVE_FULL] 			= IDragonGamePad::POV_0;	
-		m_controllerIndex[DRIVE_75PERCENT] 	= ctrlNo;
-		m_buttonIDs[DRIVE_75PERCENT] 		= IDragonGamePad::POV_90;	
-		m_controllerIndex[DRIVE_50PERCENT] 	= ctrlNo;
-		m_buttonIDs[DRIVE_50PERCENT] 		= IDragonGamePad::POV_270;	
-		m_controllerIndex[DRIVE_25PERCENT] 	= ctrlNo;
-		m_buttonIDs[DRIVE_25PERCENT] 		= IDragonGamePad::POV_180;	
-		m_controllerIndex[DRIVE_SHIFT_UP] 	= ctrlNo;
-		m_buttonIDs[DRIVE_SHIFT_UP] 		= IDragonGamePad::RIGHT_BUMPER;	
-		m_controllerIndex[DRIVE_SHIFT_DOWN] = ctrlNo;
-		m_buttonIDs[DRIVE_SHIFT_DOWN] 		= IDragonGamePad::LEFT_BUMPER;	
-		m_controllerIndex[DRIVE_TURBO] 		= ctrlNo;
-		m_axisIDs[ DRIVE_TURBO]	     		= IDragonGamePad::RIGHT_TRIGGER;
-		m_controllerIndex[DRIVE_BRAKE] 		= ctrlNo;
-		m_axisIDs[ DRIVE_BRAKE]	     		= IDragonGamePad::LEFT_TRIGGER;
-    }
-    else
-    {
-        Logger::GetLogger()->LogError( string("TeleopControl::TeleopControl"), string("No controller plugged into port 0"));
-    }
+	// the bindings and the axis shaping come from controls.xml
+	auto defn = make_unique<ControlsDefn>();
+	auto functions = defn->ParseXML( string( "/home/lvuser/deploy/controls.xml" ) );
+	for ( const auto& function : functions )
+	{
+		auto controller = m_controllers[ function.GetControllerIndex() ];
+		if ( controller == nullptr )
+		{
+			continue;
+		}
 
-    ctrlNo = 1;
-    if ( m_controllers[ctrlNo] != nullptr && ds->GetJoystickIsXbox(ctrlNo) )
-    {
-		m_controllerIndex[ SHOOTER_PREPARE_TO_SHOOT_GREEN ] = ctrlNo;
-		m_buttonIDs[ SHOOTER_PREPARE_TO_SHOOT_GREEN ] = IDragonGamePad::A_BUTTON;
-
-		m_controllerIndex[ SHOOTER_PREPARE_TO_SHOOT_RED] = ctrlNo;
-		m_buttonIDs[ SHOOTER_PREPARE_TO_SHOOT_RED ] = IDragonGamePad::B_BUTTON;
-
-		m_controllerIndex[ SHOOTER_PREPARE_TO_SHOOT_BLUE ] = ctrlNo;
-		m_buttonIDs[ SHOOTER_PREPARE_TO_SHOOT_BLUE ] = IDragonGamePad::X_BUTTON;
-		
-		m_controllerIndex[ SHOOTER_PREPARE_TO_SHOOT_YELLOW] = ctrlNo;
-		m_buttonIDs[ SHOOTER_PREPARE_TO_SHOOT_YELLOW ] = IDragonGamePad::Y_BUTTON;
-	
-		m_controllerIndex[SHOOTER_SHOOT] = ctrlNo;
-		m_buttonIDs[SHOOTER_SHOOT] = IDragonGamePad::RIGHT_BUMPER;	
-	
-		m_controllerIndex[TURRET_LIMELIGHT_AIM] = ctrlNo;
-		m_buttonIDs[TURRET_LIMELIGHT_AIM] = IDragonGamePad::LEFT_BUMPER;
-	}
-    else if ( m_controllers[ctrlNo] != nullptr )
-    {
+		auto& binding = m_bindings[ function.GetFunction() ];
+		binding.controller = controller;
+
+		auto axis = function.GetAxisID();
+		if ( axis != IDragonGamePad::UNDEFINED_AXIS )
+		{
+			binding.axis = axis;
+			controller->SetAxisDeadband( axis, function.GetDeadband() );
+			controller->SetAxisProfile( axis, function.GetProfile() );
+			controller->SetAxisScale( axis, function.GetScaleFactor() );
+		}
+
+		auto btn = function.GetButtonID();
+		if ( btn != IDragonGamePad::UNDEFINED_BUTTON )
+		{
+			binding.button = btn;
+			controller->SetButtonMode( btn, function.GetMode() );
+		}
 	}
-	else
-	{
-        Logger::GetLogger()->LogError( string("TeleopControl::TeleopControl"), string("Controller 1 not handled"));
-    }
 
-	ctrlNo = 2;
-    if ( m_controllers[ctrlNo] != nullptr && ds->GetJoystickIsXbox(ctrlNo) )
+	// only the functions that have a button need to be checked for events
+    for ( int inx=0; inx<FUNCTION_IDENTIFIER::MAX_FUNCTIONS; ++inx )
     {
+		if ( m_bindings[inx].controller != nullptr && m_bindings[inx].button != IDragonGamePad::UNDEFINED_BUTTON )
+		{
+			m_buttonFunctions.emplace_back( static_cast<FUNCTION_IDENTIFIER>( inx ) );
+		}
 	}
-    else if ( m_controllers[ctrlNo] != nullptr )
-    {
+}
+
+void TeleopControl::Update()
+{
+	for ( auto controller : m_controllers )
+	{
+		if ( controller != nullptr )
+		{
+			controller->Update();
+		}
 	}
-	else
+
+	m_eventCount = 0;
+	for ( auto function : m_buttonFunctions )
 	{
-        Logger::GetLogger()->LogError( string("TeleopControl::TeleopControl"), string("Controller 2 not handled"));
-    }
+		auto controller = m_bindings[function].controller;
+		auto btn = m_bindings[function].button;
+		if ( controller->WasButtonPressed( btn ) )
+		{
+			m_events[m_eventCount++] = ButtonEvent{ function, true };
+		}
+		else if ( controller->WasButtonReleased( btn ) )
+		{
+			m_events[m_eventCount++] = ButtonEvent{ function, false };
+		}
+	}
 
-    ctrlNo = 3;
-    if ( m_controllers[ctrlNo] != nullptr && ds->GetJoystickIsXbox(ctrlNo) )
-    {
+	// a handler that subscribes or unsubscribes would otherwise change the list being iterated
+	m_dispatching = true;
+	for ( auto inx=0U; inx<m_eventCount; ++inx )
+	{
+		const auto& event = m_events[inx];
+		for ( auto& subscription : m_subscriptions[event.function] )
+		{
+			if ( subscription.active )
+			{
+				subscription.handler( event.pressed );
+			}
+		}
 	}
-    else if ( m_controllers[ctrlNo] != nullptr )
-    {
+	m_dispatching = false;
+
+	if ( m_unsubscribed )
+	{
+		for ( auto& subscriptions : m_subscriptions )
+		{
+			subscriptions.erase( remove_if( subscriptions.begin(), subscriptions.end(),
+											[]( const Subscription& subscription ) { return !subscription.active; } ),
+								 subscriptions.end() );
+		}
+		m_unsubscribed = false;
 	}
-	else
+	for ( auto& pending : m_pending )
 	{
-		Logger::GetLogger()->LogError( string("TeleopControl::TeleopControl"), string("Controller 3 not handled"));
-
+		m_subscriptions[pending.function].emplace_back( pending.subscription );
 	}
+	m_pending.clear();
+}
 
-    ctrlNo = 4;
-    if ( m_controllers[ctrlNo] != nullptr && ds->GetJoystickIsXbox(ctrlNo) )
-    {
-	}
-    else if ( m_controllers[ctrlNo] != nullptr )
-    {
+//------------------------------------------------------------------
+// Method:      Subscribe
+// Description: Call the handler from Update whenever the function's
+//              button is pressed or released.  A subscription made
+//              from a handler starts with the next Update.
+// Returns:     void
+//------------------------------------------------------------------
+void TeleopControl::Subscribe
+(
+    TeleopControl::FUNCTION_IDENTIFIER  function,   // <I> - function to watch
+    const void*                         owner,      // <I> - used to unsubscribe
+    ButtonHandler                       handler     // <I> - called on press/release
+)
+{
+	if ( function > UNKNOWN_FUNCTION && function < MAX_FUNCTIONS && handler )
+	{
+		if ( m_dispatching )
+		{
+			m_pending.emplace_back( PendingSubscription{ function, Subscription{ owner, handler, true } } );
+		}
+		else
+		{
+			m_subscriptions[function].emplace_back( Subscription{ owner, handler, true } );
+		}
 	}
 	else
 	{
-        Logger::GetLogger()->LogError( string("TeleopControl::TeleopControl"), string("Controller 4 not handled"));
-    }
-
-    ctrlNo = 5;
-    if ( m_controllers[ctrlNo] != nullptr && ds->GetJoystickIsXbox(ctrlNo) )
-    {
+        Logger::GetLogger()->LogError( string("TeleopControl::Subscribe"), string("invalid function or handler"));
 	}
-    else if ( m_controllers[ctrlNo] != nullptr )
-    {
+}
+
+//------------------------------------------------------------------
+// Method:      Unsubscribe
+// Description: Remove every subscription the owner made.  From a
+//              handler, the owner's handlers aren't called again
+//              (even for the events still being dispatched).
+// Returns:     void
+//------------------------------------------------------------------
+void TeleopControl::Unsubscribe
+(
+    const void*                         owner       // <I> - owner passed to Subscribe
+)
+{
+	m_pending.erase( remove_if( m_pending.begin(), m_pending.end(),
+								[owner]( const PendingSubscription& pending ) { return pending.subscription.owner == owner; } ),
+					 m_pending.end() );
+
+	if ( m_dispatching )
+	{
+		// Update removes them once it is done iterating
+		for ( auto& subscriptions : m_subscriptions )
+		{
+			for ( auto& subscription : subscriptions )
+			{
+				if ( subscription.owner == owner )
+				{
+					subscription.active = false;
+					m_unsubscribed = true;
+				}
+			}
+		}
+		return;
 	}
-	else
+
+	for ( auto& subscriptions : m_subscriptions )
 	{
-        Logger::GetLogger()->LogError( string("TeleopControl::TeleopControl"), string("Controller 5 not handled"));
-    }
+		subscriptions.erase( remove_if( subscriptions.begin(), subscriptions.end(),
+										[owner]( const Subscription& subscription ) { return subscription.owner == owner; } ),
+							 subscriptions.end() );
+	}
 }
 
 
@@ -223,14 +279,10 @@ void TeleopControl::SetAxisScaleFactor
     double                                  scaleFactor    // <I> - scale factor used to limit the range
 )
 {
-	int ctlIndex = m_controllerIndex[ function];
-	IDragonGamePad::AXIS_IDENTIFIER axis = m_axisIDs[ function ];
-    if ( ctlIndex > -1 && axis != IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS  )
+	const auto& binding = m_bindings[ function ];
+    if ( binding.controller != nullptr && binding.axis != IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS  )
     {
-    	if (m_controllers[ ctlIndex ] != nullptr)
-    	{
-    		m_controllers[ ctlIndex ]->SetAxisScale( axis,scaleFactor);
-    	}
+		binding.controller->SetAxisScale( binding.axis, scaleFactor );
     }
 }
 
@@ -240,15 +292,12 @@ void TeleopControl::SetDeadBand
 	IDragonGamePad::AXIS_DEADBAND			deadband    
 )
 {
-	int ctlIndex = m_controllerIndex[ function];
-	IDragonGamePad::AXIS_IDENTIFIER axis = m_axisIDs[ function ];
-    if ( ctlIndex > -1 && axis != IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS  )
+	const auto& binding = m_bindings[ function ];
+    if ( binding.controller != nullptr && binding.axis != IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS  )
     {
-    	if (m_controllers[ ctlIndex ] != nullptr)
-    	{
-    		m_controllers[ ctlIndex ]->SetAxisDeadband( axis,deadband);
-    	}
-    }}
+		binding.controller->SetAxisDeadband( binding.axis, deadband );
+    }
+}
 
 void TeleopControl::SetSlewRateLimiter
 (
@@ -256,15 +305,11 @@ void TeleopControl::SetSlewRateLimiter
 	double 									slewRateFactor
 )
 {
-	int ctlIndex = m_controllerIndex[ function ];
-	IDragonGamePad::AXIS_IDENTIFIER axis = m_axisIDs [ function ];
-	if ( ctlIndex > -1 && axis != IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS )
-		{
-			if ( m_controllers [ ctlIndex ] != nullptr )
-				{
-					m_controllers[ ctlIndex ]->SetSlewLimit( axis, slewRateFactor);
-				}
-		}
+	const auto& binding = m_bindings[ function ];
+    if ( binding.controller != nullptr && binding.axis != IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS  )
+    {
+		binding.controller->SetSlewLimit( binding.axis, slewRateFactor );
+    }
 }
 
 //------------------------------------------------------------------
@@ -278,14 +323,10 @@ void TeleopControl::SetAxisProfile
     IDragonGamePad::AXIS_PROFILE        profile         // <I> - profile to use
 )
 {
-	int ctlIndex = m_controllerIndex[ function];
-	IDragonGamePad::AXIS_IDENTIFIER axis = m_axisIDs[ function ];
-    if ( ctlIndex > -1 && axis != IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS  )
+	const auto& binding = m_bindings[ function ];
+    if ( binding.controller != nullptr && binding.axis != IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS  )
     {
-    	if (m_controllers[ ctlIndex ] != nullptr)
-    	{
-    		m_controllers[ ctlIndex ]->SetAxisProfile( axis,profile);
-    	}
+		binding.controller->SetAxisProfile( binding.axis, profile );
     }
 }
  
@@ -301,14 +342,10 @@ double TeleopControl::GetAxisValue
 ) const
 {
     double value = 0.0;
-	int ctlIndex = m_controllerIndex[ function];
-	IDragonGamePad::AXIS_IDENTIFIER axis = m_axisIDs[ function ];
-    if ( ctlIndex > -1 && axis != IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS  )
+	const auto& binding = m_bindings[ function ];
+    if ( binding.controller != nullptr && binding.axis != IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS  )
     {
-    	if (m_controllers[ ctlIndex ] != nullptr)
-    	{
-    		value = m_controllers[ ctlIndex ]->GetAxisValue( axis );
-    	}
+		value = binding.controller->GetAxisValue( binding.axis );
     }
     return value;
 }
@@ -325,16 +362,52 @@ bool TeleopControl::IsButtonPressed
 ) const
 {
     bool isSelected = false;
-	int ctlIndex = m_controllerIndex[ function];
-	IDragonGamePad::BUTTON_IDENTIFIER btn = m_buttonIDs[ function ];
-    if ( ctlIndex > -1 && btn != IDragonGamePad::BUTTON_IDENTIFIER::UNDEFINED_BUTTON  )
+	const auto& binding = m_bindings[ function ];
+    if ( binding.controller != nullptr && binding.button != IDragonGamePad::BUTTON_IDENTIFIER::UNDEFINED_BUTTON  )
     {
-    	if (m_controllers[ ctlIndex ] != nullptr)
-    	{
-    		isSelected = m_controllers[ ctlIndex ]->IsButtonPressed( btn );
-    	}
+		isSelected = binding.controller->IsButtonPressed( binding.button );
     }
     return isSelected;
 }
 
+//------------------------------------------------------------------
+// Method:      WasButtonPressed
+// Description: Whether the function's button went down between the
+//              last two snapshots.
+// Returns:     bool
+//------------------------------------------------------------------
+bool TeleopControl::WasButtonPressed
+(
+    TeleopControl::FUNCTION_IDENTIFIER  function    // <I> - function that whose button will be read
+) const
+{
+    bool wasPressed = false;
+	const auto& binding = m_bindings[ function ];
+    if ( binding.controller != nullptr && binding.button != IDragonGamePad::BUTTON_IDENTIFIER::UNDEFINED_BUTTON  )
+    {
+		wasPressed = binding.controller->WasButtonPressed( binding.button );
+    }
+    return wasPressed;
+}
+
+//------------------------------------------------------------------
+// Method:      WasButtonReleased
+// Description: Whether the function's button went up between the
+//              last two snapshots.
+// Returns:     bool
+//------------------------------------------------------------------
+bool TeleopControl::WasButtonReleased
+(
+    TeleopControl::FUNCTION_IDENTIFIER  function    // <I> - function that whose button will be read
+) const
+{
+    bool wasReleased = false;
+	const auto& binding = m_bindings[ function ];
+    if ( binding.controller != nullptr && binding.button != IDragonGamePad::BUTTON_IDENTIFIER::UNDEFINED_BUTTON  )
+    {
+		wasReleased = binding.controller->WasButtonReleased( binding.button );
+    }
+    return wasReleased;
+}
+
 
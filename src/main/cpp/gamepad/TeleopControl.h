@@ -17,8 +17,10 @@
 #pragma once 
 
 // C++ Includes
+#include <array>
+#include <functional>
 #include <memory>
-#include <map>
+#include <vector>
 
 
 // FRC includes
@@ -55,14 +57,29 @@ class TeleopControl
             SHOOTER_PREPARE_TO_SHOOT_YELLOW,
             SHOOTER_PREPARE_TO_SHOOT_BLUE,
             SHOOTER_PREPARE_TO_SHOOT_RED,
+            SHOOTER_PREPARE_TO_SHOOT_DISTANCE,
             SHOOTER_SHOOT,
             TURRET_LIMELIGHT_AIM,
             REZERO_PIGEON,
             AUTO_DRIVE_TO_YELLOW,
             AUTO_DRIVE_TO_LOADING_ZONE,
+            HEADING_SNAP_0,
+            HEADING_SNAP_90,
+            HEADING_SNAP_180,
+            HEADING_SNAP_270,
             MAX_FUNCTIONS
         };
 
+        /// @brief  A change in the state of a function's button
+        struct ButtonEvent
+        {
+            FUNCTION_IDENTIFIER     function;
+            bool                    pressed;    // true - the button went down, false - it was released
+        };
+
+        /// @brief  Subscriber callback; the argument is true for a press and false for a release
+        using ButtonHandler = std::function<void( bool )>;
+
 
         //----------------------------------------------------------------------------------
         // Method:      GetInstance
@@ -72,6 +89,44 @@ class TeleopControl
         //----------------------------------------------------------------------------------
         static TeleopControl* GetInstance();
 
+        //------------------------------------------------------------------
+        // Method:      Update
+        // Description: Takes one snapshot of every controller, queues a
+        //              press or release event for each function whose
+        //              button changed since the last snapshot and calls
+        //              that function's subscribers.  Robot calls this
+        //              once per cycle in every mode (from RobotPeriodic),
+        //              so the next cycle reads this snapshot.
+        // Returns:     void
+        //------------------------------------------------------------------
+        void Update();
+
+        //------------------------------------------------------------------
+        // Method:      Subscribe
+        // Description: Call the handler from Update whenever the function's
+        //              button is pressed or released.  A subscription made
+        //              from a handler starts with the next Update.
+        // Returns:     void
+        //------------------------------------------------------------------
+        void Subscribe
+        (
+            TeleopControl::FUNCTION_IDENTIFIER  function,   // <I> - function to watch
+            const void*                         owner,      // <I> - used to unsubscribe
+            ButtonHandler                       handler     // <I> - called on press/release
+        );
+
+        //------------------------------------------------------------------
+        // Method:      Unsubscribe
+        // Description: Remove every subscription the owner made.  From a
+        //              handler, the owner's handlers aren't called again
+        //              (even for the events still being dispatched).
+        // Returns:     void
+        //------------------------------------------------------------------
+        void Unsubscribe
+        (
+            const void*                         owner       // <I> - owner passed to Subscribe
+        );
+
 
         //------------------------------------------------------------------
         // Method:      SetScaleFactor
@@ -134,6 +189,22 @@ class TeleopControl
             TeleopControl::FUNCTION_IDENTIFIER button   // <I> - button number to query
         ) const;
 
+        //------------------------------------------------------------------
+        // Method:      WasButtonPressed / WasButtonReleased
+        // Description: Whether the function's button went down (up) between
+        //              the last two snapshots.
+        // Returns:     bool
+        //------------------------------------------------------------------
+        bool WasButtonPressed
+        (
+            TeleopControl::FUNCTION_IDENTIFIER button   // <I> - button number to query
+        ) const;
+
+        bool WasButtonReleased
+        (
+            TeleopControl::FUNCTION_IDENTIFIER button   // <I> - button number to query
+        ) const;
+
 
     private:
         //----------------------------------------------------------------------------------
@@ -153,16 +224,45 @@ class TeleopControl
         //----------------------------------------------------------------------------------
         static TeleopControl*               m_instance; // Singleton instance of this class
 
-        std::map<FUNCTION_IDENTIFIER, IDragonGamePad::AXIS_IDENTIFIER> m_axisMap;
-        std::map<FUNCTION_IDENTIFIER, IDragonGamePad::BUTTON_IDENTIFIER> m_buttonMap;
-        std::map<FUNCTION_IDENTIFIER, int> m_controllerMap;
-
-        std::vector<IDragonGamePad::AXIS_IDENTIFIER>     m_axisIDs;
-        std::vector<IDragonGamePad::BUTTON_IDENTIFIER>   m_buttonIDs;
-        std::vector<int>							     m_controllerIndex;
+        /// @brief  Where a function's input comes from (loaded from controls.xml)
+        struct FunctionBinding
+        {
+            IDragonGamePad*                     controller; // nullptr - the function isn't mapped
+            IDragonGamePad::AXIS_IDENTIFIER     axis;
+            IDragonGamePad::BUTTON_IDENTIFIER   button;
+        };
 
         IDragonGamePad*			            m_controllers[frc::DriverStation::kJoystickPorts];
+        std::array<FunctionBinding, MAX_FUNCTIONS>  m_bindings;    // indexed by FUNCTION_IDENTIFIER
 
         mutable int                         m_count;
+
+        struct Subscription
+        {
+            const void*                     owner;
+            ButtonHandler                   handler;
+            bool                            active;     // false once unsubscribed during dispatch
+        };
+
+        struct PendingSubscription
+        {
+            FUNCTION_IDENTIFIER             function;
+            Subscription                    subscription;
+        };
+
+        // each function changes at most once per snapshot, so the queue can't overflow
+        static constexpr unsigned int       MAX_EVENTS = 32;
+        static_assert( MAX_FUNCTIONS <= MAX_EVENTS, "event queue smaller than the number of functions" );
+
+        std::vector<FUNCTION_IDENTIFIER>    m_buttonFunctions;  // functions with a button mapped
+        std::array<ButtonEvent, MAX_EVENTS> m_events;
+        unsigned int                        m_eventCount;
+        std::array<std::vector<Subscription>, MAX_FUNCTIONS>    m_subscriptions;
+
+        // the subscription lists aren't changed while Update calls the handlers; changes the handlers
+        // make are applied when the dispatch finishes
+        bool                                m_dispatching;
+        bool                                m_unsubscribed;
+        std::vector<PendingSubscription>    m_pending;
 };
 
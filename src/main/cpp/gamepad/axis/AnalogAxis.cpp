@@ -19,6 +19,7 @@
 //==================================================================================
 
 // C++ Includes
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <units/dimensionless.h>
@@ -36,6 +37,7 @@
 #include <gamepad/axis/DeadbandValue.h>
 #include <gamepad/axis/FlippedAxis.h>
 #include <gamepad/axis/NoDeadbandValue.h>
+#include <gamepad/axis/PiecewiseLinearProfile.h>
 #include <gamepad/axis/ScaledDeadbandValue.h>
 #include <gamepad/axis/SquaredProfile.h>
 
@@ -47,6 +49,8 @@
 using namespace std;
 using namespace frc;
 
+bool AnalogAxis::m_debug = false;
+
 //=========================================================================================
 /// @brief  construct the AnalogAxis object
 /// @param [in] frc::GenericHID* gamepad - gamepad to query
@@ -64,12 +68,15 @@ AnalogAxis::AnalogAxis
     m_profile( LinearProfile::GetInstance() ),  
     m_deadband( NoDeadbandValue::GetInstance() ), 
     m_scale( new ScaledAxis()  ),
-    m_slewRateFactor ( new SlewedAxis() )
+    m_slewRateFactor ( new SlewedAxis() ),
+    m_table(),
+    m_ntName( string("Axis - ") + to_string( axisID ) )
 {
     if ( flipAxis )
     {
         m_scale->SetScaleFactor( -1.0 );
     }
+    BuildTable();
 }
 
 //================================================================================================
@@ -83,18 +90,20 @@ double AnalogAxis::GetAxisValue()
 
     if ( m_gamepad != nullptr )
     {
-        auto ntName = string("Axis - ");
-        ntName += to_string(m_axis);
+        auto raw = clamp( GetRawValue(), -1.0, 1.0 );
 
-        value = GetRawValue();
-        Logger::GetLogger()->ToNtTable(ntName, "raw value", value );
-        value = m_deadband->ApplyDeadband( value );
-        Logger::GetLogger()->ToNtTable(ntName, "after deadband", value );
+        // deadband, profile and scale are all in the table
+        auto pos  = ( raw + 1.0 ) * ( TABLE_SIZE - 1 ) / 2.0;
+        auto inx  = min( static_cast<int>( pos ), TABLE_SIZE - 2 );
+        auto frac = pos - inx;
+        value = m_table[inx] + frac * ( m_table[inx+1] - m_table[inx] );
     //    value = m_slewRateFactor->SlewRate( value );
-        value = m_profile->ApplyProfile( value );
-        Logger::GetLogger()->ToNtTable(ntName, "after profile", value );
-        value = m_scale->Scale( value );
-        Logger::GetLogger()->ToNtTable(ntName, "after scale", value );
+
+        if ( m_debug )
+        {
+            Logger::GetLogger()->ToNtTable(m_ntName, "raw value", raw );
+            Logger::GetLogger()->ToNtTable(m_ntName, "value", value );
+        }
    }
     else
     {
@@ -133,6 +142,7 @@ void AnalogAxis::SetDeadBand
             Logger::GetLogger()->LogError( "AnalogAxis::SetDeadBand", msg );
             break;
     }
+    BuildTable();
 
 }
 
@@ -161,11 +171,16 @@ void AnalogAxis::SetAxisProfile
             m_profile = LinearProfile::GetInstance();
             break;
 
+        case IDragonGamePad::AXIS_PROFILE::PIECEWISE_LINEAR:
+            m_profile = PiecewiseLinearProfile::GetInstance();
+            break;
+
         default:
             string msg = "invalid profile specified ";
             Logger::GetLogger()->LogError( "AnalogAxis::SetAxisProfile", msg );
             break;
     }
+    BuildTable();
 }
 
 //================================================================================================
@@ -179,6 +194,7 @@ void AnalogAxis::SetAxisScaleFactor
 )
 {
     m_scale->SetScaleFactor( scale );
+    BuildTable();
 }
 
 
@@ -190,6 +206,34 @@ void AnalogAxis::SetSlewRateLimiter
 {
     m_slewRateFactor->SetSlewRateLimiter( slewRateFactor );
 }
+
+//================================================================================================
+/// @brief  Publish the raw and final value of every axis to the network table (off by default)
+/// @param  bool debug - true to publish
+/// @return void
+//================================================================================================
+void AnalogAxis::SetDebug
+(
+    bool debug
+)
+{
+    m_debug = debug;
+}
+
+//================================================================================================
+/// @brief  Evaluate the deadband, profile and scale at each table point
+/// @return void
+//================================================================================================
+void AnalogAxis::BuildTable()
+{
+    for ( auto inx=0; inx<TABLE_SIZE; ++inx )
+    {
+        auto value = -1.0 + 2.0 * inx / ( TABLE_SIZE - 1 );
+        value = m_deadband->ApplyDeadband( value );
+        value = m_profile->ApplyProfile( value );
+        m_table[inx] = m_scale->Scale( value );
+    }
+}
        
 //==================================================================================
 /// @brief  Returns the analog input's raw value. If there is a connection problem, 
@@ -17,7 +17,8 @@
 #pragma once
 
 // C++ Includes
-
+#include <array>
+#include <string>
 
 // FRC includes
 #include <frc/GenericHID.h>
@@ -35,7 +36,10 @@
 
 //==================================================================================
 /// @class  AnalogAxis
-/// @brief  This class handles the analog inputs on a gamepad
+/// @brief  This class handles the analog inputs on a gamepad.  The deadband, profile
+///         and scale are composed into one lookup table over the raw range (-1.0 to
+///         1.0) that is rebuilt when any of them change, so reading the axis is one
+///         interpolated table read.
 //==================================================================================
 class AnalogAxis
 {
@@ -99,6 +103,16 @@ class AnalogAxis
             double slewRateFactor
         );
 
+        //================================================================================================
+        /// @brief  Publish the raw and final value of every axis to the network table (off by default)
+        /// @param  bool debug - true to publish
+        /// @return void
+        //================================================================================================
+        static void SetDebug
+        (
+            bool debug
+        );
+
 
     protected:
        
@@ -110,6 +124,14 @@ class AnalogAxis
         virtual double GetRawValue();
  
     private:
+        //================================================================================================
+        /// @brief  Evaluate the deadband, profile and scale at each table point
+        /// @return void
+        //================================================================================================
+        void BuildTable();
+
+        static constexpr int                TABLE_SIZE = 513;   // 1/256 steps from -1.0 to 1.0
+        static bool                         m_debug;
 
         frc::GenericHID*                    m_gamepad;
         int                                 m_axis;
@@ -117,4 +139,6 @@ class AnalogAxis
         IDeadband*                          m_deadband;
         ScaledAxis*                         m_scale;
         SlewedAxis*                         m_slewRateFactor;
+        std::array<double, TABLE_SIZE>      m_table;
+        std::string                         m_ntName;
 };
@@ -32,6 +32,16 @@
 
 
 using namespace std;
+
+PiecewiseLinearProfile* PiecewiseLinearProfile::m_instance = nullptr;
+PiecewiseLinearProfile* PiecewiseLinearProfile::GetInstance()
+{
+    if (m_instance == nullptr)
+    {
+        m_instance = new PiecewiseLinearProfile();
+    }
+    return m_instance;
+}
     
 PiecewiseLinearProfile::PiecewiseLinearProfile() :  IProfile(),
                                                     m_intercept(0.25),
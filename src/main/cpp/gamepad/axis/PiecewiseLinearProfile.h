@@ -35,6 +35,12 @@
 class PiecewiseLinearProfile : public IProfile
 {
     public:
+        //==================================================================================
+        /// @brief  Static singleton method to create the object
+        /// @return PiecewiseLinearProfile*  Singleton piecewise linear profile object
+        //==================================================================================
+        static PiecewiseLinearProfile* GetInstance();
+
         PiecewiseLinearProfile();
         ~PiecewiseLinearProfile() = default;
 
@@ -54,6 +60,8 @@ class PiecewiseLinearProfile : public IProfile
         double              m_inflectionX;
         double              m_inflectionY;
 
+        static PiecewiseLinearProfile*     m_instance;
+
 
 };
 
@@ -29,6 +29,8 @@
 /// <summary>
 /// Class:          IButton
 /// Description:    This interface is for treating gamepad inputs as digital inputs.
+///                 The gamepad reads each button once per cycle and finds the
+///                 presses and releases by comparing consecutive readings.
 /// </summary>
 //==================================================================================
 class IButton
@@ -43,26 +45,6 @@ class IButton
         /// </summary>
         //==================================================================================
         virtual bool IsButtonPressed() const = 0;
-        
-
-        //==================================================================================
-        /// <summary>
-        /// Method:         WasButtonReleased
-        /// Description:    Read whether the button was released since the last query.  This
-        ///                 is only valid for digital buttons (normal buttons and bumpers).
-        /// </summary>
-        //==================================================================================
-        virtual bool WasButtonReleased() const = 0;
-        
-
-        //==================================================================================
-        /// <summary>
-        /// Method:         WasButtonPressed
-        /// Description:    Read whether the button was pressed since the last query.  This
-        ///                 is only valid for digital buttons (normal buttons and bumpers).
-        /// </summary>
-        //==================================================================================
-        virtual bool WasButtonPressed() const = 0;
 
     protected:
         IButton() = default;
@@ -51,16 +51,6 @@ bool POVButton::IsButtonPressed() const
     return pressed;
 }
 
-bool POVButton::WasButtonReleased() const 
-{
-    return !IsButtonPressed();
-}
-
-bool POVButton::WasButtonPressed() const 
-{
-    return IsButtonPressed();
-}
-
 
 
 
@@ -43,28 +43,9 @@ class ToggleButton : public ButtonDecorator
         ToggleButton() = delete;
         ~ToggleButton() = default;
         
+        /// @brief  Flip the toggle when the button goes down.  Each call samples the button,
+        ///         so it should only be called once per cycle (the gamepad's Update does this).
         bool IsButtonPressed() const override;
-        
-
-        //==================================================================================
-        /// <summary>
-        /// Method:         WasButtonReleased
-        /// Description:    Read whether the button was released since the last query.  This
-        ///                 is only valid for digital buttons (normal buttons and bumpers).
-        /// </summary>
-        //==================================================================================
-        bool WasButtonReleased() const override;
-        
-
-        //==================================================================================
-        /// <summary>
-        /// Method:         WasButtonPressed
-        /// Description:    Read whether the button was pressed since the last query.  This
-        ///                 is only valid for digital buttons (normal buttons and bumpers).
-        /// </summary>
-        //==================================================================================
-        bool WasButtonPressed() const override;
- 
 
     private:
         mutable bool        m_isPressed;
@@ -28,7 +28,7 @@
 // Team 302 includes
 #include <hw/interfaces/IDragonMotorController.h>
 #include <hw/DragonFalcon.h>
-//#include <hw/DragonPDP.h>
+#include <hw/DragonPDP.h>
 #include <hw/usages/MotorControllerUsage.h>
 #include <utils/Logger.h>
 #include <utils/ConversionUtils.h>
@@ -59,7 +59,8 @@ DragonFalcon::DragonFalcon
 	m_countsPerRev(countsPerRev),
 	m_tickOffset(0),
 	m_gearRatio(gearRatio),
-	m_diameter( 1.0 )
+	m_diameter( 1.0 ),
+	m_arbFeedForward( 0.0 )
 {
 	// for all calls if we get an error log it; for key items try again
 	auto prompt = string("Dragon Falcon");
@@ -305,9 +306,8 @@ shared_ptr<SpeedController> DragonFalcon::GetSpeedController() const
 
 double DragonFalcon::GetCurrent() const
 {
-	return 0.0;
-	//PowerDistributionPanel* pdp = DragonPDP::GetInstance()->GetPDP();
-    //return ( pdp != nullptr ) ? pdp->GetCurrent( m_pdp ) : 0.0;
+	// sampled by the power manager so reading it doesn't add CAN traffic
+	return DragonPDP::GetInstance()->GetCurrent( m_pdp );
 }
 
 void DragonFalcon::UpdateFramePeriods
@@ -405,6 +405,7 @@ void DragonFalcon::Set(std::shared_ptr<nt::NetworkTable> nt, double value)
 
 			case ControlModes::CONTROL_TYPE::POSITION_DEGREES_ABSOLUTE:
 			case ControlModes::CONTROL_TYPE::TRAPEZOID:
+			case ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES:
 				ctreMode =:: ctre::phoenix::motorcontrol::TalonFXControlMode::MotionMagic;
 				break;
 			
@@ -440,6 +441,7 @@ void DragonFalcon::Set(std::shared_ptr<nt::NetworkTable> nt, double value)
 		switch (m_controlMode)
 		{
 			case ControlModes::CONTROL_TYPE::POSITION_DEGREES:
+			case ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES:
 				output = (ConversionUtils::DegreesToCounts(value,m_countsPerRev) * m_gearRatio);
 				break;
 
@@ -466,7 +468,14 @@ void DragonFalcon::Set(std::shared_ptr<nt::NetworkTable> nt, double value)
 
 		Logger::GetLogger()->ToNtTable(nt, string("motor target output"), output);
 
-		m_talon.get()->Set( ctreMode, output );
+		if ( m_arbFeedForward != 0.0 && ctreMode != ctre::phoenix::motorcontrol::TalonFXControlMode::PercentOutput )
+		{
+			m_talon.get()->Set( ctreMode, output, DemandType::DemandType_ArbitraryFeedForward, m_arbFeedForward );
+		}
+		else
+		{
+			m_talon.get()->Set( ctreMode, output );
+		}
 
 	}
 	Logger::GetLogger()->ToNtTable(nt, string("motor current percent output"), m_talon.get()->Get() );
@@ -774,7 +783,8 @@ void DragonFalcon::SetControlConstants(int slot, ControlData* controlInfo)
 		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::VELOCITY_RPS  ||
 		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::VOLTAGE ||
 		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::CURRENT ||
-		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID )
+		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID ||
+		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES )
 	{
 		error = m_talon.get()->Config_kP(slot, controlInfo->GetP());
 		if ( error != ErrorCode::OKAY )
@@ -810,14 +820,24 @@ void DragonFalcon::SetControlConstants(int slot, ControlData* controlInfo)
 	
 	if ( //controlInfo->GetMode() == ControlModes::CONTROL_TYPE::POSITION_ABSOLUTE ||
 		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::POSITION_DEGREES_ABSOLUTE ||
-	     controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID  )
+	     controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID ||
+	     controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES )
 	{
-		error = m_talon.get()->ConfigMotionAcceleration( controlInfo->GetMaxAcceleration() );
+		// TRAPEZOID_DEGREES profiles are in degrees/second and degrees/second^2, the others are in sensor units
+		auto acceleration = controlInfo->GetMaxAcceleration();
+		auto cruise       = controlInfo->GetCruiseVelocity();
+		if ( controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES )
+		{
+			acceleration = ConversionUtils::DegreesPerSecondToCounts100ms( acceleration, m_countsPerRev ) * m_gearRatio;
+			cruise       = ConversionUtils::DegreesPerSecondToCounts100ms( cruise, m_countsPerRev ) * m_gearRatio;
+		}
+
+		error = m_talon.get()->ConfigMotionAcceleration( acceleration );
 		if ( error != ErrorCode::OKAY )
 		{
 			Logger::GetLogger()->LogError(prompt, string("ConfigMotionAcceleration error"));
 		}
-		error = m_talon.get()->ConfigMotionCruiseVelocity( controlInfo->GetCruiseVelocity(), 0);
+		error = m_talon.get()->ConfigMotionCruiseVelocity( cruise, 0);
 		if ( error != ErrorCode::OKAY )
 		{
 			Logger::GetLogger()->LogError(prompt, string("ConfigMotionCruiseVelocity error"));
@@ -891,4 +911,12 @@ void DragonFalcon::SetVoltage
 )
 {
 	m_talon.get()->SetVoltage(output);
+}
+
+void DragonFalcon::SetArbitraryFeedForward
+(
+	double percentOutput
+)
+{
+	m_arbFeedForward = percentOutput;
 }
\ No newline at end of file
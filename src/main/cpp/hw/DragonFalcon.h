@@ -124,6 +124,8 @@ class DragonFalcon : public IDragonMotorController
 
         void SetVoltage(units::volt_t output) override;
 
+        void SetArbitraryFeedForward( double percentOutput ) override;
+
         double GetCountsPerRev() const override {return m_countsPerRev;}
         void UpdateFramePeriods
         (
@@ -148,6 +150,7 @@ class DragonFalcon : public IDragonMotorController
         int m_tickOffset;
         double m_gearRatio;
 		double m_diameter;
+        double m_arbFeedForward;
 
 };
 
@@ -23,6 +23,8 @@
 #include <networktables/NetworkTableInstance.h>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableEntry.h>
+#include <networktables/EntryListenerFlags.h>
+#include <frc2/Timer.h>
 #include <units/angle.h>
 #include <units/length.h>
 #include <units/time.h>
@@ -36,6 +38,12 @@
 using namespace nt;
 using namespace std;
 
+namespace
+{
+    // a frame that hasn't been updated for this long doesn't report a target (about ten limelight images)
+    constexpr double MAX_FRAME_AGE = 0.1;  // seconds
+}
+
 ///-----------------------------------------------------------------------------------
 /// Method:         DragonLimelight (constructor)
 /// Description:    Create the object
@@ -57,9 +65,55 @@ DragonLimelight::DragonLimelight
     m_rotation(rotation),
     m_mountingAngle( mountingAngle ),
     m_targetHeight( targetHeight ),
-    m_targetHeight2( targetHeight2 )
+    m_targetHeight2( targetHeight2 ),
+    m_tv( m_networktable.get()->GetEntry( "tv" ) ),
+    m_tx( m_networktable.get()->GetEntry( "tx" ) ),
+    m_ty( m_networktable.get()->GetEntry( "ty" ) ),
+    m_ta( m_networktable.get()->GetEntry( "ta" ) ),
+    m_ts( m_networktable.get()->GetEntry( "ts" ) ),
+    m_tl( m_networktable.get()->GetEntry( "tl" ) ),
+    m_frame()
 {
     //SetLEDMode( DragonLimelight::LED_MODE::LED_OFF);
+
+    // The limelight publishes all of its results together each frame, but network tables only notifies
+    // when a value changes, and no single entry is guaranteed to change with every image (the latency
+    // can repeat).  So a change to any of the results that describe the target re-snapshots the whole
+    // frame through the cached entries (no string lookups) and publishes it under the seqlock.  All of
+    // the listeners run on the network table listener thread, so it is the only writer; kImmediate
+    // delivers the current values on that thread instead of capturing them here.
+    for ( auto entry : { m_tv, m_tx, m_ty, m_tl } )
+    {
+        entry.AddListener( [this]( const EntryNotification& )
+                           {
+                               CaptureFrame();
+                           }, EntryListenerFlags::kImmediate | EntryListenerFlags::kNew | EntryListenerFlags::kUpdate );
+    }
+}
+
+void DragonLimelight::CaptureFrame()
+{
+    Frame frame;
+    frame.hasTarget = m_tv.GetDouble( 0.0 ) > 0.1;
+    frame.tx        = m_tx.GetDouble( 0.0 );
+    frame.ty        = m_ty.GetDouble( 0.0 );
+    frame.ta        = m_ta.GetDouble( 0.0 );
+    frame.ts        = m_ts.GetDouble( 0.0 );
+    frame.tl        = m_tl.GetDouble( 0.0 );
+    frame.timestamp = frc2::Timer::GetFPGATimestamp().to<double>();
+    m_frame.Write( frame );
+}
+
+DragonLimelight::Frame DragonLimelight::GetFrame() const
+{
+    // while the camera is tracking a target its offsets change every image, so a frame that hasn't been
+    // updated for a while means the limelight (or its connection) stopped; don't report its target
+    auto frame = m_frame.Read();
+    if ( frc2::Timer::GetFPGATimestamp().to<double>() - frame.timestamp > MAX_FRAME_AGE )
+    {
+        frame.hasTarget = false;
+    }
+    return frame;
 }
 
 std::vector<double> DragonLimelight::Get3DSolve() const
@@ -69,13 +123,21 @@ std::vector<double> DragonLimelight::Get3DSolve() const
 
 bool DragonLimelight::HasTarget() const
 {
-    return ( m_networktable.get()->GetNumber("tv", 0.0) > 0.1 );
+    return GetFrame().hasTarget;
 }
 
 units::angle::degree_t DragonLimelight::GetTargetHorizontalOffset() const
 {
-    units::angle::degree_t tx = units::angle::degree_t(m_networktable.get()->GetNumber("tx", 0.0));
-    units::angle::degree_t ty = units::angle::degree_t(m_networktable.get()->GetNumber("ty", 0.0));
+    return GetTargetHorizontalOffset( GetFrame() );
+}
+
+units::angle::degree_t DragonLimelight::GetTargetHorizontalOffset
+(
+    const Frame&    frame
+) const
+{
+    units::angle::degree_t tx = units::angle::degree_t(frame.tx);
+    units::angle::degree_t ty = units::angle::degree_t(frame.ty);
     if ( abs(m_rotation.to<double>()) < 1.0 )
     //if(m_rotation == units::angle::degree_t(0.0))
     {
@@ -105,8 +167,16 @@ units::angle::degree_t DragonLimelight::GetTargetHorizontalOffset() const
 
 units::angle::degree_t DragonLimelight::GetTargetVerticalOffset() const
 {
-    units::angle::degree_t tx = units::angle::degree_t(m_networktable.get()->GetNumber("tx", 0.0));
-    units::angle::degree_t ty = units::angle::degree_t(m_networktable.get()->GetNumber("ty", 0.0));
+    return GetTargetVerticalOffset( GetFrame() );
+}
+
+units::angle::degree_t DragonLimelight::GetTargetVerticalOffset
+(
+    const Frame&    frame
+) const
+{
+    units::angle::degree_t tx = units::angle::degree_t(frame.tx);
+    units::angle::degree_t ty = units::angle::degree_t(frame.ty);
     if ( abs(m_rotation.to<double>()) < 1.0 )
     //if(m_rotation == units::angle::degree_t(0.0))
     {
@@ -137,17 +207,18 @@ units::angle::degree_t DragonLimelight::GetTargetVerticalOffset() const
 
 double DragonLimelight::GetTargetArea() const
 {
-    return m_networktable.get()->GetNumber("ta", 0.0);
+    return GetFrame().ta;
 }
 
 units::angle::degree_t DragonLimelight::GetTargetSkew() const
 {
-    return units::angle::degree_t(m_networktable.get()->GetNumber("ts", 0.0));
+    return units::angle::degree_t(GetFrame().ts);
 }
 
 units::time::microsecond_t DragonLimelight::GetPipelineLatency() const
 {
-    return units::time::second_t(m_networktable.get()->GetNumber("tl", 0.0));
+    // the limelight publishes tl in milliseconds
+    return units::time::millisecond_t(GetFrame().tl);
 }
 
 
@@ -204,12 +275,20 @@ void DragonLimelight::PrintValues()
     Logger::GetLogger()->LogError( "DragonLimelight::PrintValues YOffset", to_string( GetTargetVerticalOffset().to<double>() ) ); 
     Logger::GetLogger()->LogError( "DragonLimelight::PrintValues Area", to_string( GetTargetArea() ) ); 
     Logger::GetLogger()->LogError( "DragonLimelight::PrintValues Skew", to_string( GetTargetSkew().to<double>() ) ); 
-    Logger::GetLogger()->LogError( "DragonLimelight::PrintValues Latency", to_string( GetPipelineLatency().to<double>() ) ); 
+    Logger::GetLogger()->LogError( "DragonLimelight::PrintValues Latency (ms)", to_string( units::time::millisecond_t( GetPipelineLatency() ).to<double>() ) ); 
 }
 
 units::length::inch_t DragonLimelight::EstimateTargetDistance() const
 {
-    units::angle::degree_t angleFromHorizon = (GetMountingAngle() + GetTargetVerticalOffset());
+    return EstimateTargetDistance( GetFrame() );
+}
+
+units::length::inch_t DragonLimelight::EstimateTargetDistance
+(
+    const Frame&    frame
+) const
+{
+    units::angle::degree_t angleFromHorizon = (GetMountingAngle() + GetTargetVerticalOffset(frame));
     units::angle::radian_t angleRad = angleFromHorizon;
     double tanAngle = tan(angleRad.to<double>());
     return (GetTargetHeight()-GetMountingHeight()) / tanAngle;
@@ -24,6 +24,7 @@
 
 // FRC includes
 #include <networktables/NetworkTable.h>
+#include <networktables/NetworkTableEntry.h>
 #include <units/angle.h>
 #include <units/length.h>
 #include <units/time.h>
@@ -31,6 +32,7 @@
 // Team 302 includes
 #include <hw/interfaces/IDragonSensor.h>
 #include <hw/interfaces/IDragonDistanceSensor.h>
+#include <utils/SeqLock.h>
 
 // Third Party Includes
 
@@ -66,6 +68,20 @@ class DragonLimelight //: public IDragonSensor, public IDragonDistanceSensor
             SNAP_ON
         };
 
+        /// @brief  One complete set of limelight results.  Everything in a frame comes from the
+        ///         same network table update, so tx and ty always describe the same image.  A frame
+        ///         is captured whenever tv, tx, ty or tl changes and stamped with the capture time.
+        struct Frame
+        {
+            bool    hasTarget;      /// tv > 0
+            double  tx;             /// raw horizontal offset (degrees, camera frame)
+            double  ty;             /// raw vertical offset (degrees, camera frame)
+            double  ta;             /// target area (% of image)
+            double  ts;             /// skew (degrees)
+            double  tl;             /// pipeline latency (milliseconds)
+            double  timestamp;      /// FPGA time the frame was captured (seconds)
+        };
+
         ///-----------------------------------------------------------------------------------
         /// Method:         DragonLimelight (constructor)
         /// Description:    Create the object
@@ -90,15 +106,34 @@ class DragonLimelight //: public IDragonSensor, public IDragonDistanceSensor
 
 
         // Getters
+        /// @brief  Latest complete frame.  O(1), never touches the network table.  A frame that is
+        ///         more than 100 ms old reports no target.
+        Frame GetFrame() const;
+
         bool HasTarget() const;
         units::angle::degree_t GetTargetHorizontalOffset() const;
         units::angle::degree_t GetTargetVerticalOffset() const;
         double GetTargetArea() const;
         units::angle::degree_t GetTargetSkew() const;
+        /// @brief  Pipeline latency (the limelight's tl, which is in milliseconds)
         units::time::microsecond_t GetPipelineLatency() const;
         units::length::inch_t EstimateTargetDistance() const;
         std::vector<double> Get3DSolve() const;
 
+        // Frame based getters - use these when several values must agree with each other
+        units::angle::degree_t GetTargetHorizontalOffset
+        (
+            const Frame&    frame
+        ) const;
+        units::angle::degree_t GetTargetVerticalOffset
+        (
+            const Frame&    frame
+        ) const;
+        units::length::inch_t EstimateTargetDistance
+        (
+            const Frame&    frame
+        ) const;
+
         // Setters
         void SetTargetHeight
         (
@@ -157,6 +192,17 @@ class DragonLimelight //: public IDragonSensor, public IDragonDistanceSensor
         units::length::inch_t m_targetHeight;
         units::length::inch_t m_targetHeight2;
 
+        // only called from the entry listeners, which all run on the listener thread, so it is the seqlock's single writer
+        void CaptureFrame();
+
+        nt::NetworkTableEntry m_tv;
+        nt::NetworkTableEntry m_tx;
+        nt::NetworkTableEntry m_ty;
+        nt::NetworkTableEntry m_ta;
+        nt::NetworkTableEntry m_ts;
+        nt::NetworkTableEntry m_tl;
+        SeqLock<Frame>        m_frame;
+
         double PI = 3.14159265;
 
 
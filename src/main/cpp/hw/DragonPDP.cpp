@@ -21,7 +21,10 @@ DragonPDP* DragonPDP::GetInstance()
 	return DragonPDP::m_instance;
 }
 
-DragonPDP::DragonPDP()
+DragonPDP::DragonPDP() : m_pdp( nullptr ),
+						 m_voltage( 0.0 ),
+						 m_totalCurrent( 0.0 ),
+						 m_currents()
 {
 	if ( DragonPDP::m_pdp == nullptr )
 	{
@@ -34,6 +37,37 @@ PowerDistributionPanel* DragonPDP::GetPDP() const
 	return DragonPDP::m_pdp;
 }
 
+//=======================================================================================
+// Method:  		Sample
+// Description:		Read the battery voltage, total current and channel currents
+// Returns:         void
+//=======================================================================================
+void DragonPDP::Sample()
+{
+	if ( m_pdp != nullptr )
+	{
+		m_voltage      = m_pdp->GetVoltage();
+		m_totalCurrent = m_pdp->GetTotalCurrent();
+		for ( size_t channel=0; channel<m_currents.size(); ++channel )
+		{
+			m_currents[channel] = m_pdp->GetCurrent( static_cast<int>( channel ) );
+		}
+	}
+}
+
+//=======================================================================================
+// Method:  		GetCurrent
+// Description:		Current on a PDP channel from the last sample
+// Returns:         double	amps (0.0 for an invalid channel)
+//=======================================================================================
+double DragonPDP::GetCurrent
+(
+	int			channel				// <I> - PDP channel
+) const
+{
+	return ( channel >= 0 && channel < static_cast<int>( m_currents.size() ) ) ? m_currents[channel] : 0.0;
+}
+
 //=======================================================================================
 // Method:  		CreatePDP
 // Description:		Create a PDP from the inputs
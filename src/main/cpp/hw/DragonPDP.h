@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <frc/PowerDistributionPanel.h>
 
@@ -26,12 +27,31 @@ class DragonPDP
 
 		frc::PowerDistributionPanel* GetPDP() const;
 
+		//=======================================================================================
+		// Method:  		Sample
+		// Description:		Read the battery voltage, total current and channel currents.  Each
+		//					read is a CAN status lookup, so this is called at a controlled rate
+		//					(PowerManager) and the getters below return the last sample.
+		// Returns:         void
+		//=======================================================================================
+		void Sample();
+
+		double GetVoltage() const { return m_voltage; }
+		double GetTotalCurrent() const { return m_totalCurrent; }
+		double GetCurrent
+		(
+			int			channel				// <I> - PDP channel
+		) const;
+
 	private:
 		DragonPDP();
 		virtual ~DragonPDP() = default;
 
 		static DragonPDP*						m_instance;
 		mutable frc::PowerDistributionPanel*	m_pdp;
+		double									m_voltage;
+		double									m_totalCurrent;
+		std::array<double, 16>					m_currents;
 
 };
 
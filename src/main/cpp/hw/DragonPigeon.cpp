@@ -16,10 +16,19 @@
 
 #include <ctre/phoenix/Sensors/PigeonIMU.h>
 #include <hw/DragonPigeon.h>
+#include <cmath>
 #include <memory>
+#include <wpi/math>
 
 using namespace std;
 
+namespace
+{
+    constexpr double ACCEL_COUNTS_PER_G = 16384.0;     // biased accelerometer is Q2.14 fixed point
+    constexpr double GRAVITY = 9.80665;                // meters per second squared
+    constexpr double DEGREES_TO_RADIANS = wpi::math::pi / 180.0;
+}
+
 using namespace ctre::phoenix::sensors;
 
 DragonPigeon::DragonPigeon
@@ -38,7 +47,9 @@ DragonPigeon::DragonPigeon
 
     m_pigeon.get()->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_BiasedStatus_4_Mag, 120, 0);
     m_pigeon.get()->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_CondStatus_11_GyroAccum, 120, 0);
-    m_pigeon.get()->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_BiasedStatus_6_Accel, 120, 0); // using fused heading not yaw
+    m_pigeon.get()->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_BiasedStatus_6_Accel, 120, 0); // SetFastAccelerometer for IMU fused odometry
+    m_pigeon.get()->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_BiasedStatus_2_Gyro, 10, 0); // yaw rate for shooting on the move
+    m_pigeon.get()->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_CondStatus_9_SixDeg_YPR, 5, 0); // turret field lock runs at 200 Hz
 //    m_pigeon.get()->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_CondStatus_9_SixDeg_YPR, 120, 0); // using fused heading not yaw
 
     /**
@@ -68,6 +79,53 @@ double DragonPigeon::GetYaw()
     //return GetRawYaw() - m_initialYaw;
 }
 
+double DragonPigeon::GetYawRate()
+{
+    double xyz[3]; // degrees per second about x = 0 y = 1 z = 2
+    m_pigeon.get()->GetRawGyro(xyz);
+    return xyz[2];
+}
+
+double DragonPigeon::GetAccelX()
+{
+    double x;
+    double y;
+    GetRobotAccel( x, y );
+    return x;
+}
+
+double DragonPigeon::GetAccelY()
+{
+    double x;
+    double y;
+    GetRobotAccel( x, y );
+    return y;
+}
+
+/// @brief  Read the accelerometer and rotate it by the mounting rotation from robot.xml
+///         (counter clockwise positive), so x is robot forward and y is robot left
+void DragonPigeon::GetRobotAccel
+(
+    double&     x,
+    double&     y
+)
+{
+    int16_t xyz[3];
+    m_pigeon.get()->GetBiasedAccelerometer(xyz);
+    auto ax = xyz[0] / ACCEL_COUNTS_PER_G * GRAVITY;
+    auto ay = xyz[1] / ACCEL_COUNTS_PER_G * GRAVITY;
+    auto rotation = m_initialYaw * DEGREES_TO_RADIANS;
+    x = ax * cos( rotation ) - ay * sin( rotation );
+    y = ax * sin( rotation ) + ay * cos( rotation );
+}
+
+/// @brief  Send the accelerometer fast enough for IMU fused odometry, or slow it back down
+/// @param [in] bool - true: every 10 ms, false: every 120 ms
+void DragonPigeon::SetFastAccelerometer( bool fast )
+{
+    m_pigeon.get()->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_BiasedStatus_6_Accel, fast ? 10 : 120, 0 );
+}
+
 void DragonPigeon::ReZeroPigeon( double angleDeg, int timeoutMs)
 {
     m_pigeon.get()->SetFusedHeading( angleDeg, timeoutMs);
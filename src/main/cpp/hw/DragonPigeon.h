@@ -34,8 +34,15 @@ class DragonPigeon
         double GetPitch();
         double GetRoll();
         double GetYaw();
+        double GetYawRate();    // degrees per second, counter-clockwise positive
+        double GetAccelX();     // meters per second squared, robot forward positive (bias not removed, mounting rotation removed)
+        double GetAccelY();     // meters per second squared, robot left positive (bias not removed, mounting rotation removed)
         void ReZeroPigeon( double angleDeg, int timeoutMs = 0);
 
+        /// @brief  Send the accelerometer fast enough for IMU fused odometry, or slow it back down
+        /// @param [in] bool - true: every 10 ms, false: every 120 ms
+        void SetFastAccelerometer( bool fast );
+
     private:
 
         std::unique_ptr<ctre::phoenix::sensors::PigeonIMU> m_pigeon;
@@ -48,6 +55,9 @@ class DragonPigeon
         double GetRawYaw();
         double GetRawRoll();
         double GetRawPitch();
+
+        // rotates the accelerometer from the pigeon mounting to the robot frame
+        void GetRobotAccel( double& x, double& y );
 };
 
 
@@ -28,7 +28,7 @@
 // Team 302 includes
 #include <hw/interfaces/IDragonMotorController.h>
 #include <hw/DragonTalon.h>
-//#include <hw/DragonPDP.h>
+#include <hw/DragonPDP.h>
 #include <hw/usages/MotorControllerUsage.h>
 #include <utils/ConversionUtils.h>
 #include <utils/Logger.h>
@@ -61,7 +61,8 @@ DragonTalon::DragonTalon
 	m_countsPerRev(countsPerRev),
 	m_tickOffset(0),
 	m_gearRatio(gearRatio),
-	m_diameter( 1.0 )
+	m_diameter( 1.0 ),
+	m_arbFeedForward( 0.0 )
 {
 	// for all calls if we get an error log it; for key items try again
 	auto prompt = string("Dragon Talon");
@@ -296,9 +297,8 @@ shared_ptr<SpeedController> DragonTalon::GetSpeedController() const
 
 double DragonTalon::GetCurrent() const
 {
-	return 0.0;
-	//PowerDistributionPanel* pdp = DragonPDP::GetInstance()->GetPDP();
-    //return ( pdp != nullptr ) ? pdp->GetCurrent( m_pdp ) : 0.0;
+	// sampled by the power manager so reading it doesn't add CAN traffic
+	return DragonPDP::GetInstance()->GetCurrent( m_pdp );
 }
 
 void DragonTalon::UpdateFramePeriods
@@ -394,6 +394,7 @@ void DragonTalon::Set(std::shared_ptr<nt::NetworkTable> nt, double value)
 
 			case ControlModes::CONTROL_TYPE::POSITION_DEGREES_ABSOLUTE:
 			case ControlModes::CONTROL_TYPE::TRAPEZOID:
+			case ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES:
 				ctreMode =:: ctre::phoenix::motorcontrol::ControlMode::MotionMagic;
 				break;
 			
@@ -424,6 +425,7 @@ void DragonTalon::Set(std::shared_ptr<nt::NetworkTable> nt, double value)
 		switch (m_controlMode)
 		{
 			case ControlModes::CONTROL_TYPE::POSITION_DEGREES:
+			case ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES:
 				output = (ConversionUtils::DegreesToCounts(value,m_countsPerRev) * m_gearRatio);
 				break;
 
@@ -450,7 +452,14 @@ void DragonTalon::Set(std::shared_ptr<nt::NetworkTable> nt, double value)
 
 		Logger::GetLogger()->ToNtTable(nt, string("motor target output"), output);
 
-		m_talon.get()->Set( ctreMode, output );
+		if ( m_arbFeedForward != 0.0 && ctreMode != ctre::phoenix::motorcontrol::ControlMode::PercentOutput )
+		{
+			m_talon.get()->Set( ctreMode, output, DemandType::DemandType_ArbitraryFeedForward, m_arbFeedForward );
+		}
+		else
+		{
+			m_talon.get()->Set( ctreMode, output );
+		}
 
 	}
 	Logger::GetLogger()->ToNtTable(nt, string("motor current percent output"), m_talon.get()->Get() );
@@ -686,7 +695,8 @@ void DragonTalon::SetControlConstants(int slot, ControlData* controlInfo)
 		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::VELOCITY_RPS  ||
 		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::VOLTAGE ||
 		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::CURRENT ||
-		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID )
+		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID ||
+		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES )
 	{
 		error = m_talon.get()->Config_kP(slot, controlInfo->GetP());
 		if ( error != ErrorCode::OKAY )
@@ -722,14 +732,24 @@ void DragonTalon::SetControlConstants(int slot, ControlData* controlInfo)
 	
 	if ( //controlInfo->GetMode() == ControlModes::CONTROL_TYPE::POSITION_ABSOLUTE ||
 		 controlInfo->GetMode() == ControlModes::CONTROL_TYPE::POSITION_DEGREES_ABSOLUTE ||
-	     controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID  )
+	     controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID ||
+	     controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES )
 	{
-		error = m_talon.get()->ConfigMotionAcceleration( controlInfo->GetMaxAcceleration() );
+		// TRAPEZOID_DEGREES profiles are in degrees/second and degrees/second^2, the others are in sensor units
+		auto acceleration = controlInfo->GetMaxAcceleration();
+		auto cruise       = controlInfo->GetCruiseVelocity();
+		if ( controlInfo->GetMode() == ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES )
+		{
+			acceleration = ConversionUtils::DegreesPerSecondToCounts100ms( acceleration, m_countsPerRev ) * m_gearRatio;
+			cruise       = ConversionUtils::DegreesPerSecondToCounts100ms( cruise, m_countsPerRev ) * m_gearRatio;
+		}
+
+		error = m_talon.get()->ConfigMotionAcceleration( acceleration );
 		if ( error != ErrorCode::OKAY )
 		{
 			Logger::GetLogger()->LogError(prompt, string("ConfigMotionAcceleration error"));
 		}
-		error = m_talon.get()->ConfigMotionCruiseVelocity( controlInfo->GetCruiseVelocity(), 0);
+		error = m_talon.get()->ConfigMotionCruiseVelocity( cruise, 0);
 		if ( error != ErrorCode::OKAY )
 		{
 			Logger::GetLogger()->LogError(prompt, string("ConfigMotionCruiseVelocity error"));
@@ -782,3 +802,11 @@ void DragonTalon::SetVoltage
 {
 	m_talon.get()->SetVoltage(output);
 }
+
+void DragonTalon::SetArbitraryFeedForward
+(
+	double percentOutput
+)
+{
+	m_arbFeedForward = percentOutput;
+}
@@ -121,6 +121,11 @@ class DragonTalon : public IDragonMotorController
             units::volt_t output
         ) override;
 
+        void SetArbitraryFeedForward
+        (
+            double percentOutput
+        ) override;
+
         double GetGearRatio() const override { return m_gearRatio;}
 
     private:
@@ -134,6 +139,7 @@ class DragonTalon : public IDragonMotorController
         int m_tickOffset;
         double m_gearRatio;
         double m_diameter;
+        double m_arbFeedForward;
 };
 
 typedef std::vector<DragonTalon*> DragonTalonVector;
\ No newline at end of file
@@ -85,6 +85,11 @@ class IDragonMotorController
 		virtual void SetDiameter( double diameter ) = 0;
         virtual void SetVoltage(  units::volt_t output ) = 0;
 
+        /// @brief  Set an open loop term that is added to the closed loop output on subsequent Set calls
+        /// @param [in] double  percentOutput - feedforward in percent output (0.0 disables it)
+        /// @return void
+        virtual void SetArbitraryFeedForward( double percentOutput ) = 0;
+
 
         /// @brief  Set the control constants (e.g. PIDF values).
         /// @param [in] int             slot - hardware slot to use
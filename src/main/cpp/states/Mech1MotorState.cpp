@@ -73,6 +73,7 @@ Mech1MotorState::Mech1MotorState
 
             case ControlModes::CONTROL_TYPE::POSITION_DEGREES:
             case ControlModes::CONTROL_TYPE::POSITION_INCH:
+            case ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES:
                 m_positionBased = true;
                 m_speedBased = false;
                 break;
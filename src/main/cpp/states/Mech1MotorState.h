@@ -39,6 +39,7 @@ class Mech1MotorState : public IState
         bool AtTarget() const override;
 
         double GetTarget() const {return m_target;}
+        void SetTarget( double target ) {m_target = target;}
         double GetRPS() const {return m_mechanism->GetSpeed();}
 
     protected:
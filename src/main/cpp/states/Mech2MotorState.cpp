@@ -85,6 +85,7 @@ Mech2MotorState::Mech2MotorState
 
                 case ControlModes::CONTROL_TYPE::POSITION_DEGREES:
                 case ControlModes::CONTROL_TYPE::POSITION_INCH:
+                case ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES:
                     m_positionBased = true;
                     m_speedBased = false;
                     break;
@@ -147,9 +148,22 @@ void Mech2MotorState::Run()
     if ( m_mechanism != nullptr )
     {
         m_mechanism->Update();
+        LogTargets( GetPrimaryTarget(), GetSecondaryTarget() );
+    }
+}
+
+/// @brief  log the targets the mechanism is running at and its speeds to its network table
+void Mech2MotorState::LogTargets
+(
+    double          primaryTarget,
+    double          secondaryTarget
+) const
+{
+    if ( m_mechanism != nullptr )
+    {
         auto ntName = m_mechanism->GetNetworkTableName();
-        Logger::GetLogger()->ToNtTable(string(ntName), string("Primary Target"), GetPrimaryTarget());
-        Logger::GetLogger()->ToNtTable(string(ntName), string("Secondary Target"), GetSecondaryTarget());
+        Logger::GetLogger()->ToNtTable(string(ntName), string("Primary Target"), primaryTarget);
+        Logger::GetLogger()->ToNtTable(string(ntName), string("Secondary Target"), secondaryTarget);
         Logger::GetLogger()->ToNtTable(string(ntName), string("Primary Speed"), GetPrimaryRPS());
         Logger::GetLogger()->ToNtTable(string(ntName), string("Secondary Speed"), GetSecondaryRPS());
     }
@@ -41,9 +41,14 @@ class Mech2MotorState : public IState
         bool AtTarget() const override;
         double GetPrimaryTarget() const {return m_primaryTarget;}
         double GetSecondaryTarget() const {return m_secondaryTarget;}
+        void SetTargets( double primaryTarget, double secondaryTarget ) {m_primaryTarget = primaryTarget; m_secondaryTarget = secondaryTarget;}
         double GetPrimaryRPS() const {return m_mechanism->GetPrimarySpeed();}
         double GetSecondaryRPS() const {return m_mechanism->GetSecondarySpeed();}
 
+    protected:
+        /// @brief  log the targets the mechanism is running at and its speeds to its network table
+        void LogTargets( double primaryTarget, double secondaryTarget ) const;
+
     private:
 
         IMech2IndMotors*                m_mechanism;
@@ -0,0 +1,227 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <array>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <gamepad/TeleopControl.h>
+#include <states/IState.h>
+
+// Third Party Includes
+
+//========================================================================================================
+/// StateMachine.h
+//========================================================================================================
+///
+/// File Description:
+///     Table driven state machine used by the mechanism state managers.  The manager supplies
+///     the xml state names (indexed by the state enum) and a constexpr transition table; the
+///     states themselves are created from the state data and added with SetState.
+///
+///     Transitions are indexed by the state they leave, so ProcessEvents only checks the buttons
+///     of transitions that can fire from the current state.  A transition fires when its button
+///     is pressed (TeleopControl's press edge for this cycle, not while it is held), so holding a
+///     button doesn't re-initialize the state every cycle; pressing it again re-enters the state.
+///     Within a state, transitions are checked in table order and the first one that fires wins.
+///
+///     StateEnum must be an unscoped enum whose values are 0..N-1; the value N (the MAX_ entry)
+///     is used as the "from any state" wildcard.
+///
+//========================================================================================================
+template <typename StateEnum, int N>
+class StateMachine
+{
+    public:
+        /// @brief  guard that has to be true for a transition to fire
+        using Guard = bool (*)();
+
+        /// @brief  entry action called after the new state is initialized (state, run)
+        using EntryAction = std::function<void( StateEnum, bool )>;
+
+        struct Transition
+        {
+            StateEnum                           from;       // state the transition leaves (N means any state)
+            TeleopControl::FUNCTION_IDENTIFIER  event;      // button press that triggers the transition
+            StateEnum                           to;         // state to enter
+            Guard                               guard;      // nullptr means no guard
+        };
+
+        /// @brief      Create the state machine
+        /// @param [in] const std::array<const char*, N>& - xml state identifier for each state
+        /// @param [in] const std::array<Transition, M>& - transition table
+        template <size_t M>
+        StateMachine
+        (
+            const std::array<const char*, N>&   names,
+            const std::array<Transition, M>&    transitions
+        ) : m_names( names ),
+            m_states(),
+            m_transitions(),
+            m_entryAction(),
+            m_currentState( nullptr ),
+            m_currentStateEnum( static_cast<StateEnum>( 0 ) )
+        {
+            m_states.fill( nullptr );
+            for ( auto inx=0; inx<N; ++inx )
+            {
+                for ( auto& transition : transitions )
+                {
+                    if ( transition.from == inx || transition.from == N )
+                    {
+                        m_transitions[inx].emplace_back( transition );
+                    }
+                }
+            }
+        }
+        StateMachine() = delete;
+        ~StateMachine() = default;
+
+        /// @brief      Find the state for an xml state identifier
+        /// @param [in] const std::string& - state identifier from the state data
+        /// @return     StateEnum - the state (N if the identifier isn't known)
+        StateEnum FindState
+        (
+            const std::string&  name
+        ) const
+        {
+            for ( auto inx=0; inx<N; ++inx )
+            {
+                if ( strcmp( m_names[inx], name.c_str() ) == 0 )
+                {
+                    return static_cast<StateEnum>( inx );
+                }
+            }
+            return static_cast<StateEnum>( N );
+        }
+
+        /// @brief  Set the action that is called whenever a state is entered
+        void SetEntryAction
+        (
+            EntryAction         action
+        )
+        {
+            m_entryAction = action;
+        }
+
+        /// @brief  Add the state object for a state
+        void SetState
+        (
+            StateEnum           stateEnum,
+            IState*             state
+        )
+        {
+            m_states[stateEnum] = state;
+        }
+
+        /// @brief  Get the state object for a state (nullptr if it wasn't created)
+        IState* GetState
+        (
+            StateEnum           stateEnum
+        ) const
+        {
+            return m_states[stateEnum];
+        }
+
+        /// @brief  Get the current state object (nullptr if no state has been entered)
+        IState* GetCurrentState() const { return m_currentState; }
+
+        /// @brief  Get the current state
+        StateEnum GetCurrentStateEnum() const { return m_currentStateEnum; }
+
+        /// @brief      Enter a state:  initialize it, call the entry action and optionally run it
+        /// @param [in] StateEnum - state to enter
+        /// @param [in] bool - true means run the state after initializing it
+        /// @param [in] bool - true means re-initialize the state if it is already the current state
+        /// @return     bool - true if the state was entered
+        bool SetCurrentState
+        (
+            StateEnum           stateEnum,
+            bool                run,
+            bool                reenter
+        )
+        {
+            auto state = m_states[stateEnum];
+            if ( state == nullptr || ( state == m_currentState && !reenter ) )
+            {
+                return false;
+            }
+
+            m_currentState = state;
+            m_currentStateEnum = stateEnum;
+            m_currentState->Init();
+            if ( m_entryAction )
+            {
+                m_entryAction( stateEnum, run );
+            }
+            if ( run )
+            {
+                m_currentState->Run();
+            }
+            return true;
+        }
+
+        /// @brief      Check the transitions that leave the current state and take the first one that fires
+        /// @param [in] Controller* - controller whose buttons are the events (TeleopControl on the robot;
+        ///                           anything with WasButtonPressed( FUNCTION_IDENTIFIER ) in the tests)
+        /// @return     bool - true if a transition was taken
+        template <typename Controller>
+        bool ProcessEvents
+        (
+            Controller*         controller
+        )
+        {
+            auto fired = false;
+            auto toState = m_currentStateEnum;
+            if ( controller != nullptr )
+            {
+                for ( auto& transition : m_transitions[m_currentStateEnum] )
+                {
+                    if ( controller->WasButtonPressed( transition.event ) && ( transition.guard == nullptr || transition.guard() ) )
+                    {
+                        fired = true;
+                        toState = transition.to;
+                        break;
+                    }
+                }
+            }
+            return fired && SetCurrentState( toState, false, true );
+        }
+
+        /// @brief  Run the current state
+        void Run()
+        {
+            if ( m_currentState != nullptr )
+            {
+                m_currentState->Run();
+            }
+        }
+
+    private:
+        std::array<const char*, N>                  m_names;
+        std::array<IState*, N>                      m_states;
+        std::array<std::vector<Transition>, N>      m_transitions;
+        EntryAction                                 m_entryAction;
+        IState*                                     m_currentState;
+        StateEnum                                   m_currentStateEnum;
+};
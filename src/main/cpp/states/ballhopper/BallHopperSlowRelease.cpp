@@ -15,7 +15,9 @@
 
 //C++ Includes
 #include <memory>
-#include <units/time.h>
+
+//FRC Includes
+#include <frc2/Timer.h>
 
 //Team 302 Includes
 #include <states/IState.h>
@@ -36,12 +38,9 @@ BallHopperSlowRelease::BallHopperSlowRelease
     ControlData*        control,
     double              target
 ) : Mech1MotorState ( MechanismFactory::GetMechanismFactory()->GetBallHopper().get(), control, target ),
-    m_timer(),
+    m_gate(target),
     m_ballHopper(MechanismFactory::GetMechanismFactory()->GetBallHopper()),
-    m_waitTime(target),
-    m_isHolding(false),
-    m_canDetect(true),
-    m_timesSeen(0),
+    m_shooter(MechanismFactory::GetMechanismFactory()->GetShooter()),
     m_holdState(nullptr),
     m_releaseState(nullptr)
 {
@@ -49,10 +48,8 @@ BallHopperSlowRelease::BallHopperSlowRelease
 
 void BallHopperSlowRelease::Init()
 {
-    //Initialize default values
-    m_isHolding = false;
-    m_canDetect = true;
-    m_timesSeen = 0;
+    //Start a new set of shots
+    m_gate.Reset();
 
     auto StateMgr = BallHopperStateMgr::GetInstance();
 
@@ -62,38 +59,29 @@ void BallHopperSlowRelease::Init()
 
 void BallHopperSlowRelease::Run()
 {
-    //Check if we are sensing the ball and we have not already see the same ball 
-    //(canDetect allows us to not check if we have seen the ball but the holdBall timer hasn't ran out yet)
-   if (m_ballHopper.get()->isBallDetected() && m_canDetect)
-   {
-       m_timer.Start();
-       m_isHolding = true;
-       m_canDetect = false;
-       m_timesSeen++;
-   } 
-   else if ( !m_ballHopper.get()->isBallDetected() && !m_isHolding )
-   {
-       m_releaseState->Run();
-   } 
-   else if ( m_isHolding )
-   {
-       m_holdState->Run();
-   }
-
-    //this waits until our shooter cooldown has passed so the shooter motors can get back up to full speed
-   if ( m_timer.HasPeriodPassed(units::second_t(m_waitTime)))
-   {
-       m_isHolding = false;
-       m_canDetect = true;
-       m_timer.Stop();
-       m_timer.Reset();
-   }
+    //hold each ball at the sensor until the shooter has seen the previous ball's shot and the flywheels are
+    //back up to speed (the wait time is only a fallback in case the shot is never detected), and while the
+    //shooter state manager doesn't allow a release
+    auto shooter = m_shooter.get();
+    auto hold = m_gate.Update( frc2::Timer::GetFPGATimestamp().to<double>(),
+                               m_ballHopper.get()->isBallDetected(),
+                               shooter != nullptr ? shooter->GetShotCount() : 0,
+                               shooter != nullptr && shooter->IsReadyToFire(),
+                               BallHopperStateMgr::GetInstance()->IsReleaseAllowed() );
+    if ( hold )
+    {
+        m_holdState->Run();
+    }
+    else
+    {
+        m_releaseState->Run();
+    }
 }
 
 bool BallHopperSlowRelease::AtTarget()
 {
-    //check the timesSeen variable until we have seen 3 balls, after we have released 3 balls, we're done
-    if ( m_timesSeen == 3)
+    //check the balls seen until we have seen 3 balls, after we have released 3 balls, we're done
+    if ( m_gate.GetBallsSeen() == 3)
     {
         return true;
     }
@@ -19,10 +19,11 @@
 #include <memory>
 
 //FRC Includes
-#include <frc2/Timer.h>
 
 //Team 302 Includes
+#include <states/ballhopper/BallReleaseGate.h>
 #include <subsys/BallHopper.h>
+#include <subsys/Shooter.h>
 #include <states/Mech1MotorState.h>
 
 
@@ -46,18 +47,13 @@ class BallHopperSlowRelease : public Mech1MotorState
 
     private:
 
-        //Hold timer
-        frc2::Timer      m_timer;
+        //decides whether the ball at the sensor is held or fed
+        BallReleaseGate             m_gate;
         //BallHopper object to access sensor to detect balls
         std::shared_ptr<BallHopper> m_ballHopper;
-        //Time to wait until we release another ball
-        const double m_waitTime;
-        //These bools make sure we aren't detecting the same ball multiple times and we are running the right state
-        bool m_isHolding;
-        bool m_canDetect;
-        //used to know when we have hit our target of 3 balls
-        int m_timesSeen;
+        //Shooter object to know when the flywheels have recovered from the last shot
+        std::shared_ptr<Shooter>    m_shooter;
         //The pointers to run the holdState and releaseState without switching off of the slowReleaseState in the stateMgr
         IState*     m_holdState;
         IState*     m_releaseState;
-};
\ No newline at end of file
+};
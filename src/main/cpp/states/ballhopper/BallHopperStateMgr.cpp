@@ -14,7 +14,7 @@
 //====================================================================================================================================================
 
 //C++ Includes
-#include <map>
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -25,8 +25,10 @@
 
 //Team 302 Includes
 #include <states/IState.h>
+#include <states/StateMachine.h>
 #include <states/ballhopper/BallHopperStateMgr.h>
-#include <xmlmechdata/StateDataDefn.h>
+#include <xmlmechdata/StateDataRegistry.h>
+#include <controllers/ControlTuner.h>
 #include <controllers/MechanismTargetData.h>
 #include <utils/Logger.h>
 #include <states/ballhopper/BallHopperState.h>
@@ -35,9 +37,23 @@
 #include <states/ballhopper/BallHopperSlowRelease.h>
 #include <gamepad/TeleopControl.h>
 
-
+//Third Party Includes
 using namespace std;
 
+using BallHopperStateMachine = StateMachine<BallHopperStateMgr::BALL_HOPPER_STATE, BallHopperStateMgr::MAX_BALL_HOPPER_STATES>;
+
+/// @brief  xml state identifiers (indexed by BALL_HOPPER_STATE)
+constexpr array<const char*, BallHopperStateMgr::MAX_BALL_HOPPER_STATES> ballHopperStateNames = 
+{
+    "BALLHOPPEROFF",
+    "BALLHOPPERHOLD",
+    "BALLHOPPERRAPIDRELEASE",
+    "BALLHOPPERSLOWRELEASE"
+};
+
+/// @brief  the hopper is driven by the shooter state manager, so it has no button transitions
+constexpr array<BallHopperStateMachine::Transition, 0> ballHopperTransitions = {};
+
 BallHopperStateMgr* BallHopperStateMgr::m_instance = nullptr;
 BallHopperStateMgr* BallHopperStateMgr::GetInstance()
 {
@@ -49,76 +65,35 @@ BallHopperStateMgr* BallHopperStateMgr::GetInstance()
 }
 
 /// @brief initialize the state manager, parse the configuration file and create the states
-BallHopperStateMgr::BallHopperStateMgr() : m_currentState(nullptr),
-                                           m_stateVector(),
-                                           m_currentStateEnum(BALL_HOPPER_STATE::OFF)
+BallHopperStateMgr::BallHopperStateMgr() : m_stateMachine( ballHopperStateNames, ballHopperTransitions ),
+                                           m_releaseAllowed( true )
 {
-    //Parse the configuration file
-    auto stateXML = make_unique<StateDataDefn>();
-    vector<MechanismTargetData*> targetData = stateXML.get()->ParseXML( MechanismTypes::MECHANISM_TYPE::BALL_HOPPER );
-
-    // initialize the xml string to state map
-    map<string, BALL_HOPPER_STATE> stateMap;
-    stateMap["BALLHOPPEROFF"] = BALL_HOPPER_STATE::OFF;
-    stateMap["BALLHOPPERHOLD"] = BALL_HOPPER_STATE::HOLD;
-    stateMap["BALLHOPPERRAPIDRELEASE"] = BALL_HOPPER_STATE::RAPID_RELEASE;
-    stateMap["BALLHOPPERSLOWRELEASE"] = BALL_HOPPER_STATE::SLOW_RELEASE;
-    m_stateVector.resize(4);
+    //Get the parsed configuration data (parsed in RobotInit)
+    vector<MechanismTargetData*> targetData = StateDataRegistry::GetInstance()->GetTargetData( MechanismTypes::MECHANISM_TYPE::BALL_HOPPER );
+
     //create the states passing the configuration data
     for ( auto td: targetData )
     {
-        auto stateString = td->GetStateString();
-        auto stateStringToEnumItr = stateMap.find( stateString );
-        if ( stateStringToEnumItr != stateMap.end() )
+        auto stateEnum = m_stateMachine.FindState( td->GetStateString() );
+        if ( stateEnum != MAX_BALL_HOPPER_STATES )
         {
-            auto stateEnum = stateStringToEnumItr->second;
-            if ( m_stateVector[stateEnum]  == nullptr)
+            if ( m_stateMachine.GetState( stateEnum ) == nullptr )
             {
                 auto controlData = td->GetController();
                 auto target = td->GetTarget();
-                Logger::GetLogger()->LogError( string("ballhopperstatemgr state "),to_string(stateEnum));
-                Logger::GetLogger()->LogError( string("ballhopperstatemgr control data "),controlData == nullptr?string("nullptr"):string("good"));
-                Logger::GetLogger()->LogError( string("ballhopperstatemgr target data "),to_string(target));
-                switch ( stateEnum)
+                IState* thisState = nullptr;
+                if ( stateEnum == BALL_HOPPER_STATE::SLOW_RELEASE )
+                {
+                    thisState = new BallHopperSlowRelease( controlData, target );
+                }
+                else
                 {
-                    case BALL_HOPPER_STATE::OFF:
-                    {
-                        auto thisState = new BallHopperState( controlData, target );
-                        m_stateVector[stateEnum] = thisState;
-                        m_currentState = thisState;
-                        m_currentStateEnum = stateEnum;
-                        m_currentState->Init();
-                    }
-                    break;
-
-                    case BALL_HOPPER_STATE::HOLD:
-                    {
-                        auto thisState = new BallHopperState( controlData, target );
-                        m_stateVector[stateEnum] = thisState;
-                    }
-                    break;
-
-                    case BALL_HOPPER_STATE::SLOW_RELEASE:
-                    {
-                        auto thisState = new BallHopperSlowRelease( controlData, target);
-                        m_stateVector[stateEnum] = thisState;
-                    }
-                    break;
-
-                    case BALL_HOPPER_STATE::RAPID_RELEASE:
-                    {
-                        auto thisState = new BallHopperState( controlData, target );
-                        m_stateVector[stateEnum] = thisState;
-                    }
-                    break;
-
-                    default:
-                    {
-                        Logger::GetLogger()->LogError( Logger::LOGGER_LEVEL::ERROR_ONCE, string("BallHopperStateMgr::BallHopperStateMgr"), string("unknown state"));
-
-                    }
-                    break;
+                    thisState = new BallHopperState( controlData, target );
                 }
+                m_stateMachine.SetState( stateEnum, thisState );
+
+                // let dashboard edits to the target reach the state
+                ControlTuner::GetInstance()->AddState( td, thisState );
             }
             else
             {
@@ -131,6 +106,30 @@ BallHopperStateMgr::BallHopperStateMgr() : m_currentState(nullptr),
             Logger::GetLogger()->LogError( Logger::LOGGER_LEVEL::ERROR_ONCE, string("BallHopperStateMgr::BallHopperStateMgr"), string("state not found"));
         }
     }
+
+    m_stateMachine.SetCurrentState( BALL_HOPPER_STATE::OFF, false, false );
+    m_stateMachine.SetEntryAction( []( BALL_HOPPER_STATE state, bool )
+                                   {
+                                       auto nt = nt::NetworkTableInstance::GetDefault().GetTable(string("Ball Hopper State Manager"));
+                                       switch ( state )
+                                       {
+                                           case BALL_HOPPER_STATE::HOLD:
+                                               nt.get()->PutString("Current State", "Hold");
+                                               break;
+
+                                           case BALL_HOPPER_STATE::RAPID_RELEASE:
+                                               nt.get()->PutString("Current State", "Rapid Release");
+                                               break;
+
+                                           case BALL_HOPPER_STATE::SLOW_RELEASE:
+                                               nt.get()->PutString("Current State", "Slow Release");
+                                               break;
+
+                                           default:
+                                               nt.get()->PutString("Current State", "Off");
+                                               break;
+                                       }
+                                   } );
 }
 
 /// @brief run the current state 
@@ -138,9 +137,9 @@ BallHopperStateMgr::BallHopperStateMgr() : m_currentState(nullptr),
 void BallHopperStateMgr::RunCurrentState()
 {
     //run the current state
-    if ( m_currentState != nullptr)
+    if ( m_stateMachine.GetCurrentState() != nullptr)
     {
-        m_currentState->Run();        
+        m_stateMachine.Run();        
     }
     else
     {
@@ -157,48 +156,11 @@ void BallHopperStateMgr::SetCurrentState
     bool                    run
 )
 {
-    auto nt = nt::NetworkTableInstance::GetDefault().GetTable(string("Ball Hopper State Manager"));
-    nt.get()->PutString("Current State", "Off");
-    auto state = m_stateVector[stateEnum];
-//    if ( state != nullptr && state != m_currentState)
-    if ( state != nullptr )
-    {
-        if ( m_currentStateEnum == BallHopperStateMgr::BALL_HOPPER_STATE::HOLD)
-        {
-            nt.get()->PutString("Current State", "Hold");
-        }
-        else if (m_currentStateEnum == BallHopperStateMgr::BALL_HOPPER_STATE::OFF)
-        {
-            nt.get()->PutString("Current State", "Off");
-        }
-        else if (m_currentStateEnum == BallHopperStateMgr::BALL_HOPPER_STATE::RAPID_RELEASE)
-        {
-            nt.get()->PutString("Current State", "Rapid Release");
-        }
-        else
-        {
-            nt.get()->PutString("Current State", "Slow Release");
-        }
-        
-        m_currentState = state;
-        m_currentStateEnum = stateEnum;
-        m_currentState->Init();
-        if( run )
-        {
-            if ( MechanismFactory::GetMechanismFactory()->GetBallHopper().get() != nullptr )
-            {
-                m_currentState->Run();
-            }
-        }
-    }
-    else //if (state == nullptr)
+    // the hopper states are re-initialized even if they are already current (e.g. to restart the slow release)
+    auto hasMech = MechanismFactory::GetMechanismFactory()->GetBallHopper().get() != nullptr;
+    if ( !m_stateMachine.SetCurrentState( stateEnum, run && hasMech, true ) )
     {
+        auto nt = nt::NetworkTableInstance::GetDefault().GetTable(string("Ball Hopper State Manager"));
         nt.get()->PutString("Current State", "nullptr");
-    }   
-    /** 
-    else 
-    {
-        nt.get()->PutString("Current State", "same state");
     }
-    **/
-}
\ No newline at end of file
+}
@@ -16,10 +16,11 @@
 #pragma once
 
 //C++ Includes
-#include <vector>
+#include <array>
 
 //Team 302 Includes
 #include <states/IState.h>
+#include <states/StateMachine.h>
 #include <states/ballhopper/BallHopperSlowRelease.h>
 
 class BallHopperStateMgr
@@ -56,24 +57,28 @@ class BallHopperStateMgr
 
         /// @brief return the current state
         /// @return BALL_HOPPER_STATE - the current state
-        inline BALL_HOPPER_STATE GetCurrentState() const { return m_currentStateEnum; };
+        inline BALL_HOPPER_STATE GetCurrentState() const { return m_stateMachine.GetCurrentStateEnum(); };
 
-        inline IState* GetState( BALL_HOPPER_STATE state ) { return m_stateVector[state];}
+        inline IState* GetState( BALL_HOPPER_STATE state ) { return m_stateMachine.GetState( state );}
+
+        /// @brief  allow or stop the slow release feeding balls without restarting it, so it keeps
+        ///         track of the shots it has already waited for
+        /// @param [in]     bool - true to allow releasing balls
+        /// @return void
+        inline void SetReleaseAllowed( bool allowed ) { m_releaseAllowed = allowed; }
+
+        /// @brief  indicates whether the slow release may feed balls
+        /// @return bool - true if releasing is allowed
+        inline bool IsReleaseAllowed() const { return m_releaseAllowed; }
         
 
     private:
 
-        IState* m_currentState;
-        IState* m_holdState;
-        IState* m_releaseState;
-
-        std::vector<IState*> m_stateVector;
-        BALL_HOPPER_STATE m_currentStateEnum;
+        StateMachine<BALL_HOPPER_STATE, MAX_BALL_HOPPER_STATES> m_stateMachine;
+        bool m_releaseAllowed;
 
         BallHopperStateMgr();
         ~BallHopperStateMgr() = default;
 
-        bool m_isSlowRelease = false;
-
         static BallHopperStateMgr*  m_instance;
 };
\ No newline at end of file
@@ -0,0 +1,89 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+
+// FRC includes
+
+// Team 302 includes
+#include <states/ballhopper/BallReleaseGate.h>
+
+// Third Party Includes
+
+/// @brief      Create the gate
+/// @param [in] double - longest time to hold a ball if its shot is never detected (seconds)
+BallReleaseGate::BallReleaseGate
+(
+    double      waitTime
+) : m_waitTime( waitTime ),
+    m_holdStart( 0.0 ),
+    m_shotsAtRelease( 0 ),
+    m_hasReleased( false ),
+    m_isHolding( false ),
+    m_canDetect( true ),
+    m_ballsSeen( 0 )
+{
+}
+
+/// @brief  Start a new set of shots
+/// @return void
+void BallReleaseGate::Reset()
+{
+    m_holdStart = 0.0;
+    m_shotsAtRelease = 0;
+    m_hasReleased = false;
+    m_isHolding = false;
+    m_canDetect = true;
+    m_ballsSeen = 0;
+}
+
+/// @brief      Update the gate for one cycle
+/// @param [in] double - current time (seconds)
+/// @param [in] bool - true if a ball is at the hopper sensor
+/// @param [in] int - shots the shooter has detected
+/// @param [in] bool - true if the flywheels are ready to fire
+/// @param [in] bool - true if balls may be released
+/// @return     bool - true to hold the ball at the sensor, false to feed
+bool BallReleaseGate::Update
+(
+    double      now,
+    bool        ballDetected,
+    int         shotCount,
+    bool        readyToFire,
+    bool        releaseAllowed
+)
+{
+    // a new ball; the sensor re-arms once the released ball has cleared it, so a ball is only counted once
+    if ( ballDetected && m_canDetect )
+    {
+        m_holdStart = now;
+        m_isHolding = true;
+        m_canDetect = false;
+        m_ballsSeen++;
+    }
+    else if ( !ballDetected && !m_isHolding )
+    {
+        m_canDetect = true;
+    }
+
+    auto shooterReady = ( !m_hasReleased || shotCount > m_shotsAtRelease ) && readyToFire;
+    if ( m_isHolding && releaseAllowed && ( shooterReady || now - m_holdStart >= m_waitTime ) )
+    {
+        m_isHolding = false;
+        m_hasReleased = true;
+        m_shotsAtRelease = shotCount;
+    }
+    return m_isHolding;
+}
@@ -0,0 +1,83 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+//========================================================================================================
+/// BallReleaseGate.h
+//========================================================================================================
+///
+/// File Description:
+///     Decides, for the hopper's slow release, whether the ball at the sensor is held or fed to the
+///     shooter.  A ball that reaches the sensor is held until the shooter has seen the previous
+///     ball's shot (its shot count has gone past the count at the last release) and the flywheels
+///     are ready again.  The wait time is only a fallback for a shot that is never detected.  While
+///     the release isn't allowed (e.g. the aim isn't confident) the ball stays held, but what the
+///     gate knows about the shots so far is kept.
+///
+//========================================================================================================
+class BallReleaseGate
+{
+    public:
+        /// @brief      Create the gate
+        /// @param [in] double - longest time to hold a ball if its shot is never detected (seconds)
+        explicit BallReleaseGate
+        (
+            double      waitTime
+        );
+        BallReleaseGate() = delete;
+        ~BallReleaseGate() = default;
+
+        /// @brief  Start a new set of shots
+        /// @return void
+        void Reset();
+
+        /// @brief      Update the gate for one cycle
+        /// @param [in] double - current time (seconds)
+        /// @param [in] bool - true if a ball is at the hopper sensor
+        /// @param [in] int - shots the shooter has detected
+        /// @param [in] bool - true if the flywheels are ready to fire
+        /// @param [in] bool - true if balls may be released
+        /// @return     bool - true to hold the ball at the sensor, false to feed
+        bool Update
+        (
+            double      now,
+            bool        ballDetected,
+            int         shotCount,
+            bool        readyToFire,
+            bool        releaseAllowed
+        );
+
+        /// @brief  Number of balls that have reached the sensor since the last reset
+        /// @return int - balls
+        int GetBallsSeen() const { return m_ballsSeen; }
+
+    private:
+        double  m_waitTime;
+        double  m_holdStart;        // time the held ball reached the sensor
+        int     m_shotsAtRelease;   // shot count when the last ball was released
+        bool    m_hasReleased;      // a ball has been released, so the next one waits for its shot
+        bool    m_isHolding;
+        bool    m_canDetect;        // false from a ball's detection until it has cleared the sensor
+        int     m_ballsSeen;
+};
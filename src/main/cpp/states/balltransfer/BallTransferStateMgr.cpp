@@ -14,7 +14,7 @@
 //====================================================================================================================================================
 
 // C++ Includes
-#include <map>
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -25,8 +25,10 @@
 
 // Team 302 includes
 #include <states/IState.h>
+#include <states/StateMachine.h>
 #include <states/balltransfer/BallTransferStateMgr.h>
-#include <xmlmechdata/StateDataDefn.h>
+#include <xmlmechdata/StateDataRegistry.h>
+#include <controllers/ControlTuner.h>
 #include <controllers/MechanismTargetData.h>
 #include <utils/Logger.h>
 #include <gamepad/TeleopControl.h>
@@ -39,6 +41,21 @@
 
 using namespace std;
 
+using BallTransferStateMachine = StateMachine<BallTransferStateMgr::BALL_TRANSFER_STATE, BallTransferStateMgr::MAX_BALL_TRANSFER_STATES>;
+
+/// @brief  xml state identifiers (indexed by BALL_TRANSFER_STATE)
+constexpr array<const char*, BallTransferStateMgr::MAX_BALL_TRANSFER_STATES> ballTransferStateNames = 
+{
+    "BALLTRANSFEROFF",
+    "BALLTRANSFERTOSHOOTER"
+};
+
+/// @brief  button transitions; earlier entries have priority
+constexpr array<BallTransferStateMachine::Transition, 2> ballTransferTransitions = 
+{{
+    { BallTransferStateMgr::TO_SHOOTER, TeleopControl::BALL_TRANSFER_OFF,        BallTransferStateMgr::OFF,        nullptr },
+    { BallTransferStateMgr::OFF,        TeleopControl::BALL_TRANSFER_TO_SHOOTER, BallTransferStateMgr::TO_SHOOTER, nullptr }
+}};
 
 BallTransferStateMgr* BallTransferStateMgr::m_instance = nullptr;
 BallTransferStateMgr* BallTransferStateMgr::GetInstance()
@@ -52,56 +69,24 @@ BallTransferStateMgr* BallTransferStateMgr::GetInstance()
 
 
 /// @brief    initialize the state manager, parse the configuration file and create the states.
-BallTransferStateMgr::BallTransferStateMgr() : m_currentState(),
-                                               m_stateVector(),
-                                               m_currentStateEnum(BALL_TRANSFER_STATE::OFF)
+BallTransferStateMgr::BallTransferStateMgr() : m_stateMachine( ballTransferStateNames, ballTransferTransitions )
 {
-    // Parse the configuration file 
-    auto stateXML = make_unique<StateDataDefn>();
-    vector<MechanismTargetData*> targetData = stateXML.get()->ParseXML( MechanismTypes::MECHANISM_TYPE::BALL_TRANSFER );
-
-    // initialize the xml string to state map
-    map<string, BALL_TRANSFER_STATE> stateMap;
-    stateMap["BALLTRANSFEROFF"] = BALL_TRANSFER_STATE::OFF;
-    stateMap["BALLTRANSFERTOSHOOTER"]  = BALL_TRANSFER_STATE::TO_SHOOTER;
-    m_stateVector.resize(4);
+    // Get the parsed configuration data (parsed in RobotInit)
+    vector<MechanismTargetData*> targetData = StateDataRegistry::GetInstance()->GetTargetData( MechanismTypes::MECHANISM_TYPE::BALL_TRANSFER );
+
     // create the states passing the configuration data
     for ( auto td: targetData )
     {
-        auto stateString = td->GetStateString();
-        auto stateStringToEnumItr = stateMap.find( stateString );
-        if ( stateStringToEnumItr != stateMap.end() )
+        auto stateEnum = m_stateMachine.FindState( td->GetStateString() );
+        if ( stateEnum != MAX_BALL_TRANSFER_STATES )
         {
-            auto stateEnum = stateStringToEnumItr->second;
-            if ( m_stateVector[stateEnum] == nullptr )
+            if ( m_stateMachine.GetState( stateEnum ) == nullptr )
             {
-                auto controlData = td->GetController();
-                auto target = td->GetTarget();
-                switch ( stateEnum )
-                {
-                    case BALL_TRANSFER_STATE::OFF:
-                    {   
-                        auto thisState = new BallTransferState( controlData, target );
-                        m_stateVector[stateEnum] = thisState;
-                        m_currentState = thisState;
-                        m_currentStateEnum = stateEnum;
-                        m_currentState->Init();
-                    }
-                    break;
-
-                    case BALL_TRANSFER_STATE::TO_SHOOTER:
-                    {   
-                        auto thisState = new BallTransferState( controlData, target );
-                        m_stateVector[stateEnum] = thisState;
-                    }
-                    break;
-                   
-                    default:
-                    {
-                        Logger::GetLogger()->LogError( string("BallTransferStateMgr::BallTransferStateMgr"), string("unknown state"));
-                    }
-                    break;
-                }
+                auto thisState = new BallTransferState( td->GetController(), td->GetTarget() );
+                m_stateMachine.SetState( stateEnum, thisState );
+
+                // let dashboard edits to the target reach the state
+                ControlTuner::GetInstance()->AddState( td, thisState );
             }
             else
             {
@@ -113,40 +98,26 @@ BallTransferStateMgr::BallTransferStateMgr() : m_currentState(),
             Logger::GetLogger()->LogError( string("BallTransferStateMgr::BallTransferStateMgr"), string("state not found"));
         }
     }
+
+    m_stateMachine.SetCurrentState( BALL_TRANSFER_STATE::OFF, false, false );
+    m_stateMachine.SetEntryAction( []( BALL_TRANSFER_STATE state, bool ) 
+                                   {
+                                       auto nt = nt::NetworkTableInstance::GetDefault().GetTable(string("Ball Transfer State Manager"));
+                                       nt.get()->PutString("Current State", state == BALL_TRANSFER_STATE::TO_SHOOTER ? "To Shooter" : "Off");
+                                   } );
 }
 
 /// @brief  run the current state
 /// @return void
 void BallTransferStateMgr::RunCurrentState()
 {
-    auto nt = nt::NetworkTableInstance::GetDefault().GetTable(string("Ball Transfer State Manager"));
-
     if ( MechanismFactory::GetMechanismFactory()->GetBallTransfer().get() != nullptr )
     {
         // process teleop/manual interrupts
-        
-        auto controller = TeleopControl::GetInstance();
-        if ( controller != nullptr )
-        {
-            if ( controller->IsButtonPressed( TeleopControl::FUNCTION_IDENTIFIER::BALL_TRANSFER_OFF ) && 
-                m_currentStateEnum != BALL_TRANSFER_STATE::OFF )
-            {
-                SetCurrentState( BALL_TRANSFER_STATE::OFF, false );
-                nt.get()->PutString("Current State", "Off");
-            }
-            else if ( controller->IsButtonPressed( TeleopControl::FUNCTION_IDENTIFIER::BALL_TRANSFER_TO_SHOOTER ) &&
-                    m_currentStateEnum != BALL_TRANSFER_STATE::TO_SHOOTER )
-            {
-                SetCurrentState( BALL_TRANSFER_STATE::TO_SHOOTER, false );
-                nt.get()->PutString("Current State", "To Shooter");
-            }           
-        }
+        m_stateMachine.ProcessEvents( TeleopControl::GetInstance() );
 
         // run the current state
-        if ( m_currentState != nullptr )
-        {
-            m_currentState->Run();
-        }
+        m_stateMachine.Run();
     }
 
 }
@@ -159,36 +130,6 @@ void BallTransferStateMgr::SetCurrentState
     bool                    run
 )
 {
-    auto nt = nt::NetworkTableInstance::GetDefault().GetTable(string("Ball Transfer State Manager"));
-    nt.get()->PutString("Current State", "Off");
-
-    auto state = m_stateVector[stateEnum];
-    if ( state != nullptr && state != m_currentState)
-    {    
-        m_currentState = state;
-        m_currentStateEnum = stateEnum;
-        if ( m_currentStateEnum == BallTransferStateMgr::BALL_TRANSFER_STATE::TO_SHOOTER)
-        {
-            nt.get()->PutString("Current State", "To Shooter");
-        }
-        else
-        {
-            nt.get()->PutString("Current State", "Off");
-        }
-        
-        m_currentState->Init();
-        
-        if ( run )
-        {
-            if ( MechanismFactory::GetMechanismFactory()->GetBallTransfer().get() != nullptr )
-            {
-                m_currentState->Run();
-            }
-        }
-        
-    }
+    auto hasMech = MechanismFactory::GetMechanismFactory()->GetBallTransfer().get() != nullptr;
+    m_stateMachine.SetCurrentState( stateEnum, run && hasMech, false );
 }
-
-
-
-
@@ -17,13 +17,13 @@
 #pragma once
 
 // C++ Includes
-#include <map>
-#include <vector>
+#include <array>
 
 // FRC includes
 
 // Team 302 includes
 #include <states/IState.h>
+#include <states/StateMachine.h>
 
 
 // Third Party Includes
@@ -60,13 +60,11 @@ class BallTransferStateMgr
 
         /// @brief  return the current state
         /// @return BALL_TRANSFER_STATE - the current state
-        inline BALL_TRANSFER_STATE GetCurrentState() const { return m_currentStateEnum; };
+        inline BALL_TRANSFER_STATE GetCurrentState() const { return m_stateMachine.GetCurrentStateEnum(); };
 
     private:
 
-        IState* m_currentState;
-        std::vector<IState*> m_stateVector;
-        BALL_TRANSFER_STATE m_currentStateEnum;
+        StateMachine<BALL_TRANSFER_STATE, MAX_BALL_TRANSFER_STATES> m_stateMachine;
 
         BallTransferStateMgr();
         ~BallTransferStateMgr() = default;
@@ -15,11 +15,14 @@
 
 //C++ Includes
 #include <algorithm>
+#include <functional>
 #include <memory>
 
 //FRC includes
 #include <units/velocity.h>
 #include <units/angular_velocity.h>
+#include <units/angle.h>
+#include <units/math.h>
 
 //Team 302 Includes
 #include <states/chassis/SwerveDrive.h>
@@ -35,20 +38,56 @@
 
 using namespace std;
 
+namespace
+{
+    // the heading is latched once the robot turns slower than this after the rotate stick is released
+    constexpr units::angular_velocity::degrees_per_second_t LATCH_YAW_RATE{10.0};
+}
+
 /// @brief initialize the object and validate the necessary items are not nullptrs
 SwerveDrive::SwerveDrive() : IState(),
                              m_chassis( SwerveChassisFactory::GetSwerveChassisFactory()->GetSwerveChassis() ),
                              m_controller( TeleopControl::GetInstance() ),
-                             m_usePWLinearProfile(false),
-                             m_lastUp(false),
-                             m_lastDown(false),
-                             m_shooterLevel()
+                             m_shooterLevel(nullptr),
+                             m_holdHeading(false),
+                             m_heading(0.0)
                              //m_shooterLevel(new DriveToShooterLevel())
 {
     if ( m_controller == nullptr )
     {
         Logger::GetLogger()->LogError( string("SwerveDrive::SwerveDrive"), string("TeleopControl is nullptr"));
     }
+    else
+    {
+        // these buttons only act when they're pressed, so TeleopControl calls us on the press
+        // instead of Run reading them every cycle
+        OnPress( TeleopControl::REZERO_PIGEON, [this]()
+        {
+            auto factory = PigeonFactory::GetFactory();
+            auto m_pigeon = factory->GetPigeon();
+            m_pigeon->ReZeroPigeon( 0, 0);
+            m_chassis.get()->ZeroAlignSwerveModules();
+            m_holdHeading = false;  // relatch on the new zero
+        } );
+        //OnPress( TeleopControl::DRIVE_FULL, [this]() { m_chassis->SetDriveScaleFactor(1.0); } );
+        OnPress( TeleopControl::DRIVE_FULL,      [this]() { m_chassis->SetDriveScaleFactor(0.1); } );
+        OnPress( TeleopControl::DRIVE_75PERCENT, [this]() { m_chassis->SetDriveScaleFactor(0.75); } );
+        OnPress( TeleopControl::DRIVE_50PERCENT, [this]() { m_chassis->SetDriveScaleFactor(0.50); } );
+        //OnPress( TeleopControl::DRIVE_25PERCENT, [this]() { m_chassis->SetDriveScaleFactor(0.25); } );
+        OnPress( TeleopControl::DRIVE_25PERCENT, [this]() { m_chassis->SetDriveScaleFactor(0.35); } );
+        OnPress( TeleopControl::DRIVE_SHIFT_UP,   [this]() { ShiftDriveScale( 0.25 ); } );
+        OnPress( TeleopControl::DRIVE_SHIFT_DOWN, [this]() { ShiftDriveScale( -0.25 ); } );
+
+        //Want to drive 172 inches backwards / forwards (distance in inches, speed in inches per second)
+        OnPress( TeleopControl::AUTO_DRIVE_TO_YELLOW,       [this]() { StartShooterLevel( -172, 39.7 ); } );
+        OnPress( TeleopControl::AUTO_DRIVE_TO_LOADING_ZONE, [this]() { StartShooterLevel( 172, 39.7 ); } );
+
+        // snap headings are clockwise from away from the driver (like the POV); the yaw is counter clockwise positive
+        OnPress( TeleopControl::HEADING_SNAP_0,   [this]() { SnapToHeading( units::angle::degree_t(0.0) ); } );
+        OnPress( TeleopControl::HEADING_SNAP_90,  [this]() { SnapToHeading( units::angle::degree_t(-90.0) ); } );
+        OnPress( TeleopControl::HEADING_SNAP_180, [this]() { SnapToHeading( units::angle::degree_t(180.0) ); } );
+        OnPress( TeleopControl::HEADING_SNAP_270, [this]() { SnapToHeading( units::angle::degree_t(90.0) ); } );
+    }
 
     if ( m_chassis.get() == nullptr )
     {
@@ -56,34 +95,77 @@ SwerveDrive::SwerveDrive() : IState(),
     }
 }
 
-/// @brief initialize the profiles for the various gamepad inputs
+/// @brief stop listening to the buttons
+SwerveDrive::~SwerveDrive()
+{
+    if ( m_controller != nullptr )
+    {
+        m_controller->Unsubscribe( this );
+    }
+    delete m_shooterLevel;
+}
+
+/// @brief call the action when the function's button is pressed
 /// @return void
-void SwerveDrive::Init()
+void SwerveDrive::OnPress
+(
+    TeleopControl::FUNCTION_IDENTIFIER  button,
+    std::function<void()>               action
+)
 {
-    auto controller = GetController();
-    if ( controller != nullptr )
+    m_controller->Subscribe( button, this, [action]( bool pressed )
     {
-        auto profile = (m_usePWLinearProfile) ? IDragonGamePad::AXIS_PROFILE::PIECEWISE_LINEAR :  IDragonGamePad::AXIS_PROFILE::CUBED; 
-        controller->SetAxisProfile( TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_DRIVE, profile );
-        controller->SetDeadBand(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_DRIVE, IDragonGamePad::AXIS_DEADBAND::APPLY_STANDARD_DEADBAND);
-        controller->SetAxisScaleFactor(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_DRIVE, -2.0);
-        //controller->SetSlewRateLimiter(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_DRIVE, 3.0);
-
-        controller->SetAxisProfile( TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_STEER, profile );
-        controller->SetDeadBand(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_STEER, IDragonGamePad::AXIS_DEADBAND::APPLY_STANDARD_DEADBAND);
-        controller->SetAxisScaleFactor(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_STEER, -2.0);
-        //controller->SetSlewRateLimiter(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_STEER, 3.0);
-
-        controller->SetAxisProfile( TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_ROTATE, profile );
-        controller->SetDeadBand(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_ROTATE, IDragonGamePad::AXIS_DEADBAND::APPLY_STANDARD_DEADBAND);
-        controller->SetAxisScaleFactor(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_ROTATE, 2.0);
-        //controller->SetSlewRateLimiter(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_ROTATE, 3.0);
-        
-        controller->SetAxisProfile( TeleopControl::FUNCTION_IDENTIFIER::DRIVE_TURBO, IDragonGamePad::AXIS_PROFILE::LINEAR );
-        controller->SetAxisProfile( TeleopControl::FUNCTION_IDENTIFIER::DRIVE_BRAKE, IDragonGamePad::AXIS_PROFILE::LINEAR );
+        if ( pressed )
+        {
+            action();
+        }
+    } );
+}
 
-        m_chassis.get()->RunWPIAlgorithm(false);
-   }
+/// @brief shift the drive scale factor up or down, staying within 0.25 to 1.0
+/// @return void
+void SwerveDrive::ShiftDriveScale
+(
+    double      delta
+)
+{
+    auto scale = m_chassis->GetScaleFactor();
+    scale += delta;
+    auto newscale = clamp(scale, 0.25, 1.0);
+    m_chassis->SetDriveScaleFactor(newscale);
+}
+
+/// @brief start driving to a shooter level (replaces one that is in progress)
+/// @return void
+void SwerveDrive::StartShooterLevel
+(
+    double      distance,
+    double      speed
+)
+{
+    delete m_shooterLevel;
+    m_shooterLevel = new DriveToShooterLevel();
+    m_shooterLevel->Init(distance, speed);
+}
+
+/// @brief turn to and hold a field heading until the driver rotates
+/// @return void
+void SwerveDrive::SnapToHeading
+(
+    units::angle::degree_t      heading
+)
+{
+    m_heading = heading;
+    m_holdHeading = true;
+    m_chassis->ResetHeadingController();
+}
+
+/// @brief initialize the chassis for driver control (the gamepad axis profiles come from controls.xml)
+/// @return void
+void SwerveDrive::Init()
+{
+    m_chassis.get()->RunWPIAlgorithm(false);
+    m_holdHeading = false;
 }
 
 
@@ -95,100 +177,40 @@ void SwerveDrive::Run( )
     double drive = 0.0;
     double steer = 0.0;
     double rotate = 0.0;
+    units::angular_velocity::radians_per_second_t headingCorrection(0.0);
     auto controller = GetController();
     if ( controller != nullptr )
     {
-        if ( controller->IsButtonPressed( TeleopControl::FUNCTION_IDENTIFIER::REZERO_PIGEON))
-        {
-            auto factory = PigeonFactory::GetFactory();
-            auto m_pigeon = factory->GetPigeon();
-            m_pigeon->ReZeroPigeon( 0, 0);
-            m_chassis.get()->ZeroAlignSwerveModules();
-            m_lastUp   = false;
-            m_lastDown = false;
-        }
-        else if (controller->IsButtonPressed( TeleopControl::DRIVE_FULL))
-        {
-            //m_chassis->SetDriveScaleFactor(1.0);
-            m_chassis->SetDriveScaleFactor(0.1);
-            m_lastUp   = false;
-            m_lastDown = false;
-        }
-        else if (controller->IsButtonPressed(TeleopControl::DRIVE_75PERCENT))
-        {
-            m_chassis->SetDriveScaleFactor(0.75);
-            m_lastUp   = false;
-            m_lastDown = false;
-        }
-        else if (controller->IsButtonPressed(TeleopControl::DRIVE_50PERCENT))
-        {
-            m_chassis->SetDriveScaleFactor(0.50);
-            m_lastUp   = false;
-            m_lastDown = false;
-        }
-        else if (controller->IsButtonPressed(TeleopControl::DRIVE_25PERCENT))
-        {
-            //m_chassis->SetDriveScaleFactor(0.25);
-            m_chassis->SetDriveScaleFactor(0.35);
-            m_lastUp   = false;
-            m_lastDown = false;
-        }
-        else if (controller->IsButtonPressed(TeleopControl::DRIVE_SHIFT_UP))
-        {
-            if (!m_lastUp)
-            {
-                auto scale = m_chassis->GetScaleFactor();
-                scale += 0.25;
-                auto newscale = clamp(scale, 0.25, 1.0);
-                m_chassis->SetDriveScaleFactor(newscale);
-            }
-            m_lastUp = true;
-        }        
-        else if (controller->IsButtonPressed(TeleopControl::DRIVE_SHIFT_DOWN))
+        //Auto shooter level driving logic
+        if (m_shooterLevel != nullptr)
         {
-            if (!m_lastDown)
+            m_shooterLevel->Run();
+            if(m_shooterLevel->IsDone())
             {
-                auto scale = m_chassis->GetScaleFactor();
-                scale -= 0.25;
-                auto newscale = clamp(scale, 0.25, 1.0);
-                m_chassis->SetDriveScaleFactor(newscale);
+                delete m_shooterLevel;
+                m_shooterLevel = nullptr;
             }
-            m_lastDown = true;
         }
-        else if (controller->IsButtonPressed(TeleopControl::AUTO_DRIVE_TO_YELLOW))
+        
+        drive  = controller->GetAxisValue(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_DRIVE) ;
+        steer  = controller->GetAxisValue(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_STEER);
+        rotate = controller->GetAxisValue(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_ROTATE);
+        rotate = abs(rotate)<0.3 ? 0.0 : rotate;
+
+        // hold the heading while the rotate stick is released, latching it once the robot stops turning
+        if ( rotate != 0.0 )
         {
-            //Want to drive 172 inches backwards
-            //m_shooterLevel->DriveToLevel(-172, 39.7);  //First arg is distance in inches, second is speed in inches per second 
-            m_shooterLevel = new DriveToShooterLevel();
-            m_shooterLevel->Init(-172, 39.7);
+            m_holdHeading = false;
         }
-        else if (controller->IsButtonPressed(TeleopControl::AUTO_DRIVE_TO_LOADING_ZONE))
+        else if ( !m_holdHeading && units::math::abs( m_chassis->GetYawRate() ) < LATCH_YAW_RATE )
         {
-            //Want to drive 172 inches forwards
-            //m_shooterLevel->DriveToLevel(172, 39.7);  //First arg is distance in inches, second is speed in inches per second
-            m_shooterLevel = new DriveToShooterLevel();
-            m_shooterLevel->Init(172, 39.7);
+            SnapToHeading( m_chassis->GetYaw() );
         }
-        else
-        {
-            m_lastUp   = false;
-            m_lastDown = false;
 
-            //Auto shooter level driving logic
-            if (m_shooterLevel != nullptr)
-            {
-                m_shooterLevel->Run();
-                if(m_shooterLevel->IsDone())
-                {
-                    delete m_shooterLevel;
-                }
-            }
+        if ( m_holdHeading )
+        {
+            headingCorrection = m_chassis->CalcHeadingCorrection( m_heading );
         }
-        
-        drive  = controller->GetAxisValue(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_DRIVE) ;
-        steer  = controller->GetAxisValue(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_STEER);
-        rotate = controller->GetAxisValue(TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_ROTATE);
-        rotate = abs(rotate)<0.3 ? 0.0 : rotate;
 
         auto boost = controller->GetAxisValue(TeleopControl::FUNCTION_IDENTIFIER::DRIVE_TURBO);
         boost *= 0.50;
@@ -207,7 +229,7 @@ void SwerveDrive::Run( )
     Logger::GetLogger()->ToNtTable("Swerve Drive", "rotate", rotate);
     **/
    
-    m_chassis.get()->Drive(drive, steer, rotate, true);
+    m_chassis.get()->Drive(drive, steer, rotate, headingCorrection, true);
 }
 
 /// @brief indicates that we are not at our target
@@ -16,8 +16,12 @@
 #pragma once
 
 //C++ Libraries
+#include <functional>
 #include <memory>
 
+//FRC includes
+#include <units/angle.h>
+
 //Team 302 includes
 #include <subsys/SwerveChassis.h>
 #include <gamepad/TeleopControl.h>
@@ -30,7 +34,7 @@ class SwerveDrive : public IState
     public:
 
         SwerveDrive();
-        ~SwerveDrive() = default;
+        ~SwerveDrive();
 
         void Init() override;
 
@@ -40,10 +44,32 @@ class SwerveDrive : public IState
 
     private:
         inline TeleopControl* GetController() const { return m_controller; }
+
+        void OnPress
+        (
+            TeleopControl::FUNCTION_IDENTIFIER  button,
+            std::function<void()>               action
+        );
+
+        void ShiftDriveScale
+        (
+            double                              delta
+        );
+
+        void StartShooterLevel
+        (
+            double                              distance,
+            double                              speed
+        );
+
+        void SnapToHeading
+        (
+            units::angle::degree_t              heading
+        );
+
         std::shared_ptr<SwerveChassis>      m_chassis;
         TeleopControl*                      m_controller;
-        bool                                m_usePWLinearProfile;
-        bool                                m_lastUp;
-        bool                                m_lastDown;
         DriveToShooterLevel*                m_shooterLevel;
+        bool                                m_holdHeading;      // true - the heading controller is holding m_heading
+        units::angle::degree_t              m_heading;
 };
\ No newline at end of file
@@ -14,7 +14,7 @@
 //====================================================================================================================================================
 
 // C++ Includes
-#include <map>
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -22,8 +22,10 @@
 
 // Team 302 includes
 #include <states/IState.h>
+#include <states/StateMachine.h>
 #include <states/intake/IntakeStateMgr.h>
-#include <xmlmechdata/StateDataDefn.h>
+#include <xmlmechdata/StateDataRegistry.h>
+#include <controllers/ControlTuner.h>
 #include <controllers/MechanismTargetData.h>
 #include <utils/Logger.h>
 #include <gamepad/TeleopControl.h>
@@ -37,6 +39,18 @@
 
 using namespace std;
 
+using IntakeStateMachine = StateMachine<IntakeStateMgr::INTAKE_STATE, IntakeStateMgr::MAX_INTAKE_STATES>;
+
+/// @brief  xml state identifiers (indexed by INTAKE_STATE)
+constexpr array<const char*, IntakeStateMgr::MAX_INTAKE_STATES> intakeStateNames = 
+{
+    "INTAKEOFF",
+    "INTAKEON"
+};
+
+/// @brief  the intake is set by the cycle primitives, so it has no button transitions
+constexpr array<IntakeStateMachine::Transition, 0> intakeTransitions = {};
+
 IntakeStateMgr* IntakeStateMgr::m_instance = nullptr;
 IntakeStateMgr* IntakeStateMgr::GetInstance()
 {
@@ -48,62 +62,24 @@ IntakeStateMgr* IntakeStateMgr::GetInstance()
 }
 
 /// @brief    initialize the state manager, parse the configuration file and create the states.
-IntakeStateMgr::IntakeStateMgr() : m_states(),
-                                   m_currentState()
+IntakeStateMgr::IntakeStateMgr() : m_stateMachine( intakeStateNames, intakeTransitions )
 {
-    // Parse the configuration file 
-    auto stateXML = make_unique<StateDataDefn>();
-    vector<MechanismTargetData*> targetData = stateXML.get()->ParseXML( MechanismTypes::MECHANISM_TYPE::INTAKE );
-
-    // initialize the xml string to state map
-    map<string, INTAKE_STATE> stateStringToEnumMap;
-    stateStringToEnumMap["INTAKEOFF"] = INTAKE_STATE::OFF;
-    stateStringToEnumMap["INTAKEON"]  = INTAKE_STATE::ON;
+    // Get the parsed configuration data (parsed in RobotInit)
+    vector<MechanismTargetData*> targetData = StateDataRegistry::GetInstance()->GetTargetData( MechanismTypes::MECHANISM_TYPE::INTAKE );
 
-    for (auto inx=0; inx<MAX_INTAKE_STATES; ++inx)
-    {
-       m_states[inx] = nullptr;
-    }
-    
     // create the states passing the configuration data
     for ( auto td: targetData )
     {
-        auto stateString = td->GetStateString();
-        auto stateStringToEnumItr = stateStringToEnumMap.find( stateString );
-        if ( stateStringToEnumItr != stateStringToEnumMap.end() )
+        auto stateEnum = m_stateMachine.FindState( td->GetStateString() );
+        if ( stateEnum != MAX_INTAKE_STATES )
         {
-            auto stateEnum = stateStringToEnumItr->second;
-            if ( m_states[stateEnum] == nullptr )
+            if ( m_stateMachine.GetState( stateEnum ) == nullptr )
             {
-                auto controlData = td->GetController();
-                auto controlData2 = td->GetController2();
-                auto target1 = td->GetTarget();
-                auto target2 = td->GetSecondTarget();
-                switch ( stateEnum )
-                {
-                    case INTAKE_STATE::ON:
-                    {   
-                        auto thisState = new IntakeState(controlData, controlData2, target1, target2);
-                        m_states[stateEnum] = thisState;
-                    }
-                    break;
-
-                    case INTAKE_STATE::OFF:
-                    {   
-                        auto thisState = new IntakeState(controlData, controlData2, target1, target2);
-                        m_states[stateEnum] = thisState;
-                        m_currentState = thisState;
-                        m_currentStateEnum = stateEnum;
-                        m_currentState->Init();
-                    }
-                    break;
-
-                    default:
-                    {
-                        Logger::GetLogger()->LogError( string("IntakeStateMgr::IntakeStateMgr"), string("unknown state"));
-                    }
-                    break;
-                }
+                auto thisState = new IntakeState( td->GetController(), td->GetController2(), td->GetTarget(), td->GetSecondTarget() );
+                m_stateMachine.SetState( stateEnum, thisState );
+
+                // let dashboard edits to the target reach the state
+                ControlTuner::GetInstance()->AddState( td, thisState );
             }
             else
             {
@@ -115,6 +91,8 @@ IntakeStateMgr::IntakeStateMgr() : m_states(),
             Logger::GetLogger()->LogError( string("IntakeStateMgr::IntakeStateMgr"), string("state not found"));
         }
     }
+
+    m_stateMachine.SetCurrentState( INTAKE_STATE::OFF, false, false );
 }
 
 /// @brief  run the current state
@@ -123,22 +101,10 @@ void IntakeStateMgr::RunCurrentState()
 {
     if ( MechanismFactory::GetMechanismFactory()->GetIntake().get() != nullptr )
     {
-            if ( m_currentStateEnum == INTAKE_STATE::ON)
-            {
-                SetCurrentState( INTAKE_STATE::ON, false );
-            }
-            else if ( m_currentStateEnum == INTAKE_STATE::OFF)
-            {
-                SetCurrentState( INTAKE_STATE::OFF, false );
-            }
-
-        Logger::GetLogger()->OnDash(string("Intake State"), to_string(m_currentStateEnum));
+        Logger::GetLogger()->OnDash(string("Intake State"), to_string(GetCurrentState()));
 
         // run the current state
-        if ( m_currentState != nullptr )
-        {
-            m_currentState->Run();
-        }
+        m_stateMachine.Run();
     }
 }
 
@@ -150,21 +116,6 @@ void IntakeStateMgr::SetCurrentState
     bool            run
 )
 {
-    auto state = m_states[stateEnum];
-    if ( state != nullptr && state != m_currentState )
-    {
-        m_currentState = state;
-        m_currentStateEnum = stateEnum;
-        m_currentState->Init();
-        if ( run )
-        {
-            if ( MechanismFactory::GetMechanismFactory()->GetIntake().get() != nullptr )
-            {
-                m_currentState->Run();
-            }
-        }
-        
-    }
+    auto hasMech = MechanismFactory::GetMechanismFactory()->GetIntake().get() != nullptr;
+    m_stateMachine.SetCurrentState( stateEnum, run && hasMech, false );
 }
-
-
@@ -16,13 +16,13 @@
 #pragma once
 
 // C++ Includes
-#include <map>
-#include <vector>
+#include <array>
 
 // FRC includes
 
 // Team 302 includes
 #include <states/IState.h>
+#include <states/StateMachine.h>
 
 // Third Party Includes
 
@@ -58,13 +58,11 @@ class IntakeStateMgr
 
         /// @brief  return the current state
         /// @return INTAKE_STATE - the current state
-        inline INTAKE_STATE GetCurrentState() const { return m_currentStateEnum; };
+        inline INTAKE_STATE GetCurrentState() const { return m_stateMachine.GetCurrentStateEnum(); };
 
     private:
 
-        std::array<IState*,MAX_INTAKE_STATES> m_states;
-        IState* m_currentState;
-        INTAKE_STATE m_currentStateEnum;
+        StateMachine<INTAKE_STATE, MAX_INTAKE_STATES> m_stateMachine;
 
         IntakeStateMgr();
         ~IntakeStateMgr() = default;
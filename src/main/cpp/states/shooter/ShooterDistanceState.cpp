@@ -0,0 +1,75 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <memory>
+
+// FRC includes
+
+// Team 302 includes
+#include <controllers/ControlData.h>
+#include <states/shooter/ShooterDistanceState.h>
+#include <states/shooter/ShooterDistanceTable.h>
+#include <states/shooter/ShooterState.h>
+#include <subsys/MechanismFactory.h>
+#include <utils/GoalDetection.h>
+#include <utils/ShotSolver.h>
+#include <xmlmechdata/StateDataRegistry.h>
+
+// Third Party Includes
+
+using namespace std;
+
+ShooterDistanceState::ShooterDistanceState
+(
+    ControlData*                    controlData,
+    ControlData*                    controlData2,
+    double                          target1,
+    double                          target2
+) : ShooterState( controlData, controlData2, target1, target2 ),
+    m_shooter( MechanismFactory::GetMechanismFactory()->GetShooter() ),
+    m_table( StateDataRegistry::GetInstance()->GetShooterDistanceTable() )
+{
+}
+
+/// @brief  look up the wheel targets for the current distance to the goal and update the shooter.  Setting
+///         the targets runs the shooter's update, so this logs what Mech2MotorState::Run would, with the
+///         looked up targets, instead of calling it and updating the shooter a second time.
+/// @return void
+void ShooterDistanceState::Run()
+{
+    auto primary   = GetPrimaryTarget();
+    auto secondary = GetSecondaryTarget();
+
+    // use the solver's shooter distance when the turret is leading a moving shot:  the distance to the
+    // virtual goal, compensated for the robot's radial velocity
+    auto goal   = GoalDetection::GetInstance();
+    auto solver = ShotSolver::GetInstance();
+    auto hasTable = m_table != nullptr && m_table->IsValid();
+    if ( hasTable && solver->HasSolution() )
+    {
+        m_table->GetTargets( solver->GetShooterDistance(), primary, secondary );
+    }
+    else if ( hasTable && goal->SeeOuterGoal() )
+    {
+        m_table->GetTargets( goal->GetDistanceToOuterGoal().to<double>(), primary, secondary );
+    }
+
+    if ( m_shooter.get() != nullptr )
+    {
+        m_shooter.get()->UpdateTargets( primary, secondary );
+        LogTargets( primary, secondary );
+    }
+}
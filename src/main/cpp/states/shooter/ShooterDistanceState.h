@@ -0,0 +1,54 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <memory>
+
+// FRC includes
+
+// Team 302 includes
+#include <states/shooter/ShooterState.h>
+#include <states/shooter/ShooterDistanceTable.h>
+#include <subsys/Shooter.h>
+
+// Third Party Includes
+
+class ControlData;
+
+/// @brief  Shooter state that sets the wheel targets from the distance to the goal each cycle.  The
+///         state data targets are used while the goal isn't seen.  The calibration table is parsed
+///         with the rest of the state data in RobotInit.
+class ShooterDistanceState : public ShooterState
+{
+    public:
+        ShooterDistanceState
+        (
+            ControlData*                    controlData,
+            ControlData*                    controlData2,
+            double                          target1,
+            double                          target2
+        );
+
+        ShooterDistanceState() = delete;
+        ~ShooterDistanceState() = default;
+
+        void Run() override;
+
+    private:
+        std::shared_ptr<Shooter>                m_shooter;
+        const ShooterDistanceTable*             m_table;        ///< owned by the StateDataRegistry
+};
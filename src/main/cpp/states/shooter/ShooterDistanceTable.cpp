@@ -0,0 +1,127 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <states/shooter/ShooterDistanceTable.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+
+using namespace std;
+
+// grid cells per table segment; more cells means fewer steps past the cell's segment on a lookup
+constexpr unsigned int GRID_CELLS_PER_SEGMENT = 4;
+
+/// @brief  Create the table from calibration points (in any order)
+/// @param [in] std::vector<CalibrationPoint> - calibration points
+ShooterDistanceTable::ShooterDistanceTable
+(
+    vector<CalibrationPoint>    points
+) : m_points( move( points ) ),
+    m_gridSegment(),
+    m_minDistance( 0.0 ),
+    m_maxDistance( 0.0 ),
+    m_gridScale( 0.0 )
+{
+    sort( m_points.begin(), m_points.end(), []( const CalibrationPoint& a, const CalibrationPoint& b ) { return a.distance < b.distance; } );
+
+    // two points at the same distance would make a zero length segment
+    auto dup = unique( m_points.begin(), m_points.end(), []( const CalibrationPoint& a, const CalibrationPoint& b ) { return a.distance == b.distance; } );
+    if ( dup != m_points.end() )
+    {
+        Logger::GetLogger()->LogError( string("ShooterDistanceTable::ShooterDistanceTable"), string("duplicate distances ignored") );
+        m_points.erase( dup, m_points.end() );
+    }
+
+    if ( m_points.size() > 1 )
+    {
+        m_minDistance = m_points.front().distance;
+        m_maxDistance = m_points.back().distance;
+
+        auto segments = m_points.size() - 1;
+        auto cells    = segments * GRID_CELLS_PER_SEGMENT;
+        m_gridScale   = cells / ( m_maxDistance - m_minDistance );
+
+        // each cell holds the segment containing the cell's starting distance
+        m_gridSegment.resize( cells );
+        unsigned int seg = 0;
+        for ( unsigned int cell = 0; cell < cells; ++cell )
+        {
+            auto start = m_minDistance + cell / m_gridScale;
+            while ( seg < segments - 1 && start >= m_points[seg+1].distance )
+            {
+                ++seg;
+            }
+            m_gridSegment[cell] = seg;
+        }
+    }
+    else if ( m_points.size() == 1 )
+    {
+        m_minDistance = m_points.front().distance;
+        m_maxDistance = m_minDistance;
+    }
+}
+
+/// @brief      Interpolate the wheel targets for a distance
+/// @param [in] double - distance to the goal in inches
+/// @param [out] double - primary wheel target (unchanged if the distance is NaN)
+/// @param [out] double - secondary wheel target (unchanged if the distance is NaN)
+/// @return     void
+void ShooterDistanceTable::GetTargets
+(
+    double          distance,
+    double&         primary,
+    double&         secondary
+) const
+{
+    if ( m_gridSegment.empty() )
+    {
+        primary   = m_points.empty() ? 0.0 : m_points.front().primary;
+        secondary = m_points.empty() ? 0.0 : m_points.front().secondary;
+        return;
+    }
+
+    // a NaN distance (e.g. from a bad goal estimate) leaves the targets alone; infinities go to the ends
+    // of the table.  Either would be undefined when converted to a cell index.
+    if ( !std::isfinite( distance ) )
+    {
+        if ( std::isnan( distance ) )
+        {
+            return;
+        }
+        distance = ( distance > 0.0 ) ? m_maxDistance : m_minDistance;
+    }
+
+    distance  = clamp( distance, m_minDistance, m_maxDistance );
+    auto cell = min( static_cast<size_t>( ( distance - m_minDistance ) * m_gridScale ), m_gridSegment.size() - 1 );
+    auto seg  = m_gridSegment[cell];
+    while ( seg < m_points.size() - 2 && distance > m_points[seg+1].distance )
+    {
+        ++seg;
+    }
+
+    auto& lo = m_points[seg];
+    auto& hi = m_points[seg+1];
+    auto  t  = ( distance - lo.distance ) / ( hi.distance - lo.distance );
+    primary   = lo.primary + t * ( hi.primary - lo.primary );
+    secondary = lo.secondary + t * ( hi.secondary - lo.secondary );
+}
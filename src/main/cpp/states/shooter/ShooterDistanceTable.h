@@ -0,0 +1,79 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+//========================================================================================================
+/// ShooterDistanceTable.h
+//========================================================================================================
+///
+/// File Description:
+///     Calibration table of shooter wheel speeds by distance to the goal.  The points are sorted by
+///     distance and a uniform grid over the distance range maps a distance to its table segment, so a
+///     lookup is a multiply, an index and a linear interpolation.  Distances outside the table are
+///     clamped to the first/last point.
+///
+//========================================================================================================
+class ShooterDistanceTable
+{
+    public:
+        struct CalibrationPoint
+        {
+            double  distance;       // inches
+            double  primary;        // primary wheel target
+            double  secondary;      // secondary wheel target
+        };
+
+        /// @brief  Create the table from calibration points (in any order)
+        /// @param [in] std::vector<CalibrationPoint> - calibration points
+        ShooterDistanceTable
+        (
+            std::vector<CalibrationPoint>   points
+        );
+        ShooterDistanceTable() = delete;
+        ~ShooterDistanceTable() = default;
+
+        /// @brief  Indicates whether there are any calibration points
+        /// @return bool - true if the table can be used
+        bool IsValid() const { return !m_points.empty(); }
+
+        /// @brief      Interpolate the wheel targets for a distance
+        /// @param [in] double - distance to the goal in inches
+        /// @param [out] double - primary wheel target (unchanged if the distance is NaN)
+        /// @param [out] double - secondary wheel target (unchanged if the distance is NaN)
+        /// @return     void
+        void GetTargets
+        (
+            double          distance,
+            double&         primary,
+            double&         secondary
+        ) const;
+
+    private:
+        std::vector<CalibrationPoint>   m_points;
+        std::vector<unsigned int>       m_gridSegment;
+        double                          m_minDistance;
+        double                          m_maxDistance;
+        double                          m_gridScale;
+};
@@ -14,7 +14,7 @@
 //====================================================================================================================================================
 
 // C++ Includes
-#include <map>
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -27,12 +27,16 @@
 #include <hw/factories/LimelightFactory.h>
 #include <hw/DragonLimelight.h>
 #include <states/IState.h>
+#include <states/StateMachine.h>
 #include <states/balltransfer/BallTransferStateMgr.h>
 #include <states/ballhopper/BallHopperStateMgr.h>
 #include <states/shooter/ShooterStateMgr.h>
 #include <states/shooter/ShooterState.h>
+#include <states/shooter/ShooterDistanceState.h>
 #include <states/turret/TurretStateMgr.h>
-#include <xmlmechdata/StateDataDefn.h>
+#include <utils/GoalDetection.h>
+#include <xmlmechdata/StateDataRegistry.h>
+#include <controllers/ControlTuner.h>
 #include <controllers/MechanismTargetData.h>
 #include <utils/Logger.h>
 #include <gamepad/TeleopControl.h>
@@ -44,6 +48,34 @@
 
 using namespace std;
 
+using ShooterStateMachine = StateMachine<ShooterStateMgr::SHOOTER_STATE, ShooterStateMgr::MAX_SHOOTER_STATES>;
+
+/// @brief  xml state identifiers (indexed by SHOOTER_STATE)
+constexpr array<const char*, ShooterStateMgr::MAX_SHOOTER_STATES> shooterStateNames = 
+{
+    "SHOOTEROFF",
+    "SHOOTERSHOOTGREEN",
+    "SHOOTERSHOOTYELLOW",
+    "SHOOTERSHOOTBLUE",
+    "SHOOTERSHOOTRED",
+    "SHOOTERON",
+    "SHOOTERSHOOTDISTANCE"
+};
+
+/// @brief  button transitions (from any state); earlier entries have priority.
+///         The prepare buttons are edge triggered:  a press enters its state once (re-entering it if it is
+///         already current) instead of re-initializing it, and the hopper, transfer and turret states, on
+///         every cycle the button is held as the old button chain did.  So holding a prepare button no
+///         longer holds the balls against the shoot button.  Shoot is still level based (OnShootButton).
+constexpr array<ShooterStateMachine::Transition, 5> shooterTransitions = 
+{{
+    { ShooterStateMgr::MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_GREEN,  ShooterStateMgr::GET_READY_SHOOTGREEN,  nullptr },
+    { ShooterStateMgr::MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_YELLOW, ShooterStateMgr::GET_READY_SHOOTYELLOW, nullptr },
+    { ShooterStateMgr::MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_BLUE,   ShooterStateMgr::GET_READY_SHOOTBLUE,   nullptr },
+    { ShooterStateMgr::MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_RED,    ShooterStateMgr::GET_READY_SHOOTRED,    nullptr },
+    { ShooterStateMgr::MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_DISTANCE, ShooterStateMgr::GET_READY_SHOOTDISTANCE, nullptr }
+}};
+
 ShooterStateMgr* ShooterStateMgr::m_instance = nullptr;
 ShooterStateMgr* ShooterStateMgr::GetInstance()
 {
@@ -59,8 +91,7 @@ ShooterStateMgr* ShooterStateMgr::GetInstance()
 }
 
 /// @brief    initialize the state manager, parse the configuration file and create the states.
-ShooterStateMgr::ShooterStateMgr() : m_states(),
-                                     m_currentState(),
+ShooterStateMgr::ShooterStateMgr() : m_stateMachine( shooterStateNames, shooterTransitions ),
                                      m_prevStateEnum(ShooterStateMgr::SHOOTER_STATE::OFF),
                                      m_nt(nt::NetworkTableInstance::GetDefault().GetTable(string("Shooter State Manager")))    
 {
@@ -70,98 +101,30 @@ ShooterStateMgr::ShooterStateMgr() : m_states(),
         m_nt = nt::NetworkTableInstance::GetDefault().GetTable("fred");
     }
 
-    // Parse the configuration file 
-    auto stateXML = make_unique<StateDataDefn>();
-    vector<MechanismTargetData*> targetData = stateXML.get()->ParseXML( MechanismTypes::MECHANISM_TYPE::SHOOTER );
+    // Get the parsed configuration data (parsed in RobotInit)
+    vector<MechanismTargetData*> targetData = StateDataRegistry::GetInstance()->GetTargetData( MechanismTypes::MECHANISM_TYPE::SHOOTER );
 
-    // initialize the xml string to state map
-    map<string, SHOOTER_STATE> stateStringToEnumMap;
-    stateStringToEnumMap["SHOOTEROFF"] = SHOOTER_STATE::OFF;
-    stateStringToEnumMap["SHOOTERON"] = SHOOTER_STATE::SHOOT;
-    stateStringToEnumMap["SHOOTERSHOOTGREEN"] = SHOOTER_STATE::GET_READY_SHOOTGREEN;
-    stateStringToEnumMap["SHOOTERSHOOTYELLOW"] = SHOOTER_STATE::GET_READY_SHOOTYELLOW;
-    stateStringToEnumMap["SHOOTERSHOOTBLUE"] = SHOOTER_STATE::GET_READY_SHOOTBLUE;
-    stateStringToEnumMap["SHOOTERSHOOTRED"] = SHOOTER_STATE::GET_READY_SHOOTRED;
-
-    Logger::GetLogger()->ToNtTable(m_nt, string("SHOOTEROFF"), string("not created"));
-    Logger::GetLogger()->ToNtTable(m_nt, "SHOOTERON", "not created");
-    Logger::GetLogger()->ToNtTable(m_nt, "SHOOTERSHOOTGREEN", "not created");
-    Logger::GetLogger()->ToNtTable(m_nt, "SHOOTERSHOOTYELLOW", "not created");
-    Logger::GetLogger()->ToNtTable(m_nt, "SHOOTERSHOOTBLUE", "not created");
-    Logger::GetLogger()->ToNtTable(m_nt, "SHOOTERSHOOTRED", "not created");
-    for (auto inx=0; inx<MAX_SHOOTER_STATES; ++inx)
+    for ( auto name : shooterStateNames )
     {
-       m_states[inx] = nullptr;
+        Logger::GetLogger()->ToNtTable(m_nt, name, "not created");
     }
 
     // create the states passing the configuration data
     for ( auto td: targetData )
     {
-        auto stateString = td->GetStateString();
-        auto stateStringToEnumMapItr = stateStringToEnumMap.find( stateString );
-        if ( stateStringToEnumMapItr != stateStringToEnumMap.end() )
+        auto stateEnum = m_stateMachine.FindState( td->GetStateString() );
+        if ( stateEnum != MAX_SHOOTER_STATES )
         {
-            auto stateEnum = stateStringToEnumMapItr->second;
-            if ( m_states[stateEnum] == nullptr )
+            if ( m_stateMachine.GetState( stateEnum ) == nullptr )
             {
-                auto controlData = td->GetController();
-                auto controlData2 = td->GetController2();
-                auto target1 = td->GetTarget();
-                auto target2 = td->GetSecondTarget();
-
-                switch ( stateEnum )
-                {
-                    case SHOOTER_STATE::OFF:
-                    {   
-                        m_states[stateEnum] = new ShooterState( controlData, controlData2, target1, target2 );
-                        m_currentState = m_states[SHOOTER_STATE::OFF];
-                        m_currentStateEnum = stateEnum;
-                        m_currentState->Init();
-                        Logger::GetLogger()->ToNtTable(m_nt, "SHOOTEROFF", "created");
-                    }
-                    break;
-
-                    case SHOOTER_STATE::SHOOT:
-                    {   
-                        m_states[stateEnum] = new ShooterState( controlData, controlData2, target1, target2 );
-                        Logger::GetLogger()->ToNtTable(m_nt, "SHOOTERON", "created");
-                    }
-                    break;
+                auto thisState = ( stateEnum == GET_READY_SHOOTDISTANCE ) ?
+                                    new ShooterDistanceState( td->GetController(), td->GetController2(), td->GetTarget(), td->GetSecondTarget() ) :
+                                    new ShooterState( td->GetController(), td->GetController2(), td->GetTarget(), td->GetSecondTarget() );
+                m_stateMachine.SetState( stateEnum, thisState );
+                Logger::GetLogger()->ToNtTable(m_nt, shooterStateNames[stateEnum], "created");
 
-                    case SHOOTER_STATE::GET_READY_SHOOTGREEN:
-                    {   
-                        m_states[stateEnum] = new ShooterState( controlData, controlData2, target1, target2 );
-                        Logger::GetLogger()->ToNtTable(m_nt, "SHOOTERSHOOTGREEN", "created");
-                    }
-                    break;
-
-                    case SHOOTER_STATE::GET_READY_SHOOTYELLOW:
-                    {   
-                        m_states[stateEnum] = new ShooterState( controlData, controlData2, target1, target2 );
-                        Logger::GetLogger()->ToNtTable(m_nt, "SHOOTERSHOOTYELLOW", "created");
-                    }
-                    break;
-
-                    case SHOOTER_STATE::GET_READY_SHOOTBLUE:
-                    {   
-                        m_states[stateEnum] = new ShooterState( controlData, controlData2, target1, target2 );
-                        Logger::GetLogger()->ToNtTable(m_nt, "SHOOTERSHOOTBLUE", "created");
-                    }
-                    break;
-                    
-                    case SHOOTER_STATE::GET_READY_SHOOTRED:
-                    {   
-                        m_states[stateEnum] = new ShooterState( controlData, controlData2, target1, target2 );
-                        Logger::GetLogger()->ToNtTable(m_nt, "SHOOTERSHOOTRED", "created");
-                    }
-                    break;
-
-                    default:
-                    {
-                        Logger::GetLogger()->LogError( string("ShooterStateMgr::ShooterStateMgr"), string("unknown state"));
-                    }
-                    break;
-                }
+                // let dashboard edits to the target reach the state
+                ControlTuner::GetInstance()->AddState( td, thisState );
             }
             else
             {
@@ -173,6 +136,17 @@ ShooterStateMgr::ShooterStateMgr() : m_states(),
             Logger::GetLogger()->LogError( string("ShooterStateMgr::ShooterStateMgr"), string("state not found"));
         }
     }
+
+    // start in the off state; the other mechanisms are set up by the entry action once it is hooked up
+    m_stateMachine.SetCurrentState( SHOOTER_STATE::OFF, false, false );
+    m_stateMachine.SetEntryAction( [this]( SHOOTER_STATE state, bool run ) { OnEntry( state, run ); } );
+
+    // shoot while the button is held; this runs only when the button changes
+    auto controller = TeleopControl::GetInstance();
+    if ( controller != nullptr )
+    {
+        controller->Subscribe( TeleopControl::FUNCTION_IDENTIFIER::SHOOTER_SHOOT, this, [this]( bool pressed ) { OnShootButton( pressed ); } );
+    }
 }
 
 /// @brief  run the current state
@@ -182,88 +156,62 @@ void ShooterStateMgr::RunCurrentState()
     auto controller = TeleopControl::GetInstance();
     if (controller != nullptr)
     {
-        auto cam = LimelightFactory::GetLimelightFactory()->GetLimelight();
-        
-        if ( controller->IsButtonPressed( TeleopControl::FUNCTION_IDENTIFIER::SHOOTER_SHOOT ))
-        {
-            Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot");
-            BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::RAPID_RELEASE, false);
-            TurretStateMgr::GetInstance()->SetCurrentState(TurretStateMgr::TURRET_STATE::HOLD, false);
-        }
-        else if ( m_currentStateEnum==ShooterStateMgr::SHOOTER_STATE::OFF)
-        {
-                // keep everything the same
-        }
-        else    // revert to holding the ball
-        {
-            Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot");
-            BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::HOLD, false);
-        }
-
-        if ( controller->IsButtonPressed( TeleopControl::FUNCTION_IDENTIFIER::SHOOTER_PREPARE_TO_SHOOT_GREEN ))
-        {
-            Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Green");
-            if ( cam != nullptr )
-            {
-                cam->SetPipeline(1);
-            }
-            SetCurrentState( SHOOTER_STATE::GET_READY_SHOOTGREEN, false );
-            BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::HOLD, false);
-            BallTransferStateMgr::GetInstance()->SetCurrentState( BallTransferStateMgr::BALL_TRANSFER_STATE::TO_SHOOTER, false );
-            TurretStateMgr::GetInstance()->SetCurrentState(TurretStateMgr::TURRET_STATE::LIMELIGHT_AIM, false);
-        }
-        else if ( controller->IsButtonPressed( TeleopControl::FUNCTION_IDENTIFIER::SHOOTER_PREPARE_TO_SHOOT_YELLOW ))
+        // prepare to shoot buttons (only the transitions out of the current state are checked)
+        auto previous = GetCurrentState();
+        if ( m_stateMachine.ProcessEvents( controller ) )
         {
-            Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Yellow");
-            if ( cam != nullptr )
-            {
-                cam->SetPipeline(2);
-            }
-            SetCurrentState( SHOOTER_STATE::GET_READY_SHOOTYELLOW, false );
-            BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::HOLD, false);
-            BallTransferStateMgr::GetInstance()->SetCurrentState( BallTransferStateMgr::BALL_TRANSFER_STATE::TO_SHOOTER, false );
-            TurretStateMgr::GetInstance()->SetCurrentState(TurretStateMgr::TURRET_STATE::LIMELIGHT_AIM, false);
-        }
-        else if ( controller->IsButtonPressed( TeleopControl::FUNCTION_IDENTIFIER::SHOOTER_PREPARE_TO_SHOOT_BLUE ))
-        {
-            Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Blue");
-            if ( cam != nullptr )
-            {
-                cam->SetPipeline(3);
-            }
-            SetCurrentState( SHOOTER_STATE::GET_READY_SHOOTBLUE, false );
-            BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::HOLD, false);
-            BallTransferStateMgr::GetInstance()->SetCurrentState( BallTransferStateMgr::BALL_TRANSFER_STATE::TO_SHOOTER, false );
-            TurretStateMgr::GetInstance()->SetCurrentState(TurretStateMgr::TURRET_STATE::LIMELIGHT_AIM, false);
+            m_prevStateEnum = previous;
         }
-        else if ( controller->IsButtonPressed( TeleopControl::FUNCTION_IDENTIFIER::SHOOTER_PREPARE_TO_SHOOT_RED ))
-        {
-            Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Red");
-            if ( cam != nullptr )
-            {
-                cam->SetPipeline(4);
-            }
-            SetCurrentState( SHOOTER_STATE::GET_READY_SHOOTRED, false );
-            BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::HOLD, false);
-            BallTransferStateMgr::GetInstance()->SetCurrentState( BallTransferStateMgr::BALL_TRANSFER_STATE::TO_SHOOTER, false );
-            TurretStateMgr::GetInstance()->SetCurrentState(TurretStateMgr::TURRET_STATE::LIMELIGHT_AIM, false);
-        }
-//        else
-//        {
-//            SetCurrentState( m_prevStateEnum, false);
-//        }
     }
 
+    // hold the next ball while the aim isn't good enough to hit
+    UpdateRelease();
+
     // run the current state
-    if ( m_currentState != nullptr )
-    {
-        m_currentState->Run();
-    }
+    m_stateMachine.Run();
     BallHopperStateMgr::GetInstance()->RunCurrentState();
     BallTransferStateMgr::GetInstance()->RunCurrentState();
     TurretStateMgr::GetInstance()->RunCurrentState();
 }
 
+/// @brief  shoot button handler:  release the balls when it is pressed and hold them again when it is released.
+///         The balls go through the slow release, which feeds each one only when the flywheels are ready.
+/// @param [in]     bool - true the button was pressed, false it was released
+/// @return void
+void ShooterStateMgr::OnShootButton
+(
+    bool            pressed
+)
+{
+    if ( pressed )
+    {
+        Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot");
+        UpdateRelease();
+        BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::SLOW_RELEASE, false);
+        TurretStateMgr::GetInstance()->SetCurrentState(TurretStateMgr::TURRET_STATE::HOLD, false);
+    }
+    else if ( GetCurrentState() != ShooterStateMgr::SHOOTER_STATE::OFF )
+    {
+        BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::HOLD, false);
+    }
+}
+
+/// @brief  distance based shots depend on the goal estimate, so they wait until it is good enough to hit
+/// @return bool - true if the balls can be released for the current state
+bool ShooterStateMgr::IsAimReady() const
+{
+    return GetCurrentState() != ShooterStateMgr::SHOOTER_STATE::GET_READY_SHOOTDISTANCE ||
+           GoalDetection::GetInstance()->IsAimConfident();
+}
+
+/// @brief  let the slow release feed balls only while the aim is ready.  The hopper stays in the slow release
+///         as the aim confidence changes, so it keeps the shot it is waiting for rather than restarting.
+/// @return void
+void ShooterStateMgr::UpdateRelease()
+{
+    BallHopperStateMgr::GetInstance()->SetReleaseAllowed( IsAimReady() );
+}
+
 /// @brief  set the current state, initialize it and run it
 /// @return void
 void ShooterStateMgr::SetCurrentState
@@ -272,75 +220,72 @@ void ShooterStateMgr::SetCurrentState
     bool            run
 )
 {
-    auto state = m_states[stateEnum];
-    if ( state != nullptr )
+    auto previous = GetCurrentState();
+    if ( m_stateMachine.SetCurrentState( stateEnum, run, true ) )
+    {
+        m_prevStateEnum = ( previous == stateEnum ) ? m_prevStateEnum : previous;
+    }
+    else
     {
-        Logger::GetLogger()->ToNtTable(m_nt, "Current State", "none");
-        
-        m_prevStateEnum = (m_currentStateEnum == stateEnum) ? m_prevStateEnum : m_currentStateEnum;
+        Logger::GetLogger()->ToNtTable(m_nt, "state", "nullptr" );
+    }
+}
 
-        auto limelight = LimelightFactory::GetLimelightFactory()->GetLimelight();
-        m_currentState = state;
-        m_currentStateEnum = stateEnum;
-        m_currentState->Init();
-        if ( stateEnum == SHOOTER_STATE::SHOOT )
+/// @brief  entry action:  point the limelight at the goal and set the other shooting mechanisms' states
+/// @param [in]     SHOOTER_STATE - state that was entered
+/// @param [in]     run - true means run the other mechanisms' states, false just initialize them
+/// @return void
+void ShooterStateMgr::OnEntry
+(
+    SHOOTER_STATE   stateEnum,
+    bool            run
+)
+{
+    Logger::GetLogger()->ToNtTable(m_nt, "Current State", "none");
+
+    auto limelight = LimelightFactory::GetLimelightFactory()->GetLimelight();
+    if ( stateEnum == SHOOTER_STATE::SHOOT )
+    {
+        if ( limelight != nullptr )
         {
-            if ( limelight != nullptr )
-            {
-                limelight->SetPipeline(1);
-            }
-            Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot");
-            BallTransferStateMgr::GetInstance()->SetCurrentState( BallTransferStateMgr::BALL_TRANSFER_STATE::TO_SHOOTER, run );
-            BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::RAPID_RELEASE, run);
-            TurretStateMgr::GetInstance()->SetCurrentState(TurretStateMgr::TURRET_STATE::HOLD, run);
+            limelight->SetPipeline(1);
         }
-        else if ( stateEnum == SHOOTER_STATE::GET_READY_SHOOTBLUE || stateEnum == SHOOTER_STATE::GET_READY_SHOOTGREEN ||
-                  stateEnum == SHOOTER_STATE::GET_READY_SHOOTRED  || stateEnum == SHOOTER_STATE::GET_READY_SHOOTYELLOW )
+        Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot");
+        BallTransferStateMgr::GetInstance()->SetCurrentState( BallTransferStateMgr::BALL_TRANSFER_STATE::TO_SHOOTER, run );
+        UpdateRelease();
+        BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::SLOW_RELEASE, run);
+        TurretStateMgr::GetInstance()->SetCurrentState(TurretStateMgr::TURRET_STATE::HOLD, run);
+    }
+    else if ( stateEnum == SHOOTER_STATE::GET_READY_SHOOTBLUE || stateEnum == SHOOTER_STATE::GET_READY_SHOOTGREEN ||
+              stateEnum == SHOOTER_STATE::GET_READY_SHOOTRED  || stateEnum == SHOOTER_STATE::GET_READY_SHOOTYELLOW ||
+              stateEnum == SHOOTER_STATE::GET_READY_SHOOTDISTANCE )
+    {
+        if ( limelight != nullptr )
         {
-            if ( limelight != nullptr )
-            {
-                limelight->SetPipeline(1);
-            }
-            BallTransferStateMgr::GetInstance()->SetCurrentState( BallTransferStateMgr::BALL_TRANSFER_STATE::TO_SHOOTER, run );
-            BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::HOLD, run);
-            TurretStateMgr::GetInstance()->SetCurrentState(TurretStateMgr::TURRET_STATE::LIMELIGHT_AIM, run);
-            if ( stateEnum == SHOOTER_STATE::GET_READY_SHOOTBLUE)
-            {
-                Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Blue");
-            }
-            else if ( stateEnum == SHOOTER_STATE::GET_READY_SHOOTGREEN)
-            {
-                Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Green");
-            }
-            else if ( stateEnum == SHOOTER_STATE::GET_READY_SHOOTRED)
-            {
-                Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Red");
-            }
-            else
-            {
-                Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Yellow");
-            }
+            limelight->SetPipeline(1);
         }
-        /**
-        else
+        BallTransferStateMgr::GetInstance()->SetCurrentState( BallTransferStateMgr::BALL_TRANSFER_STATE::TO_SHOOTER, run );
+        BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::HOLD, run);
+        TurretStateMgr::GetInstance()->SetCurrentState(TurretStateMgr::TURRET_STATE::LIMELIGHT_AIM, run);
+        if ( stateEnum == SHOOTER_STATE::GET_READY_SHOOTBLUE)
         {
-            ShooterStateMgr::GetInstance()->SetCurrentState(ShooterStateMgr::SHOOTER_STATE::OFF, run);
-            BallTransferStateMgr::GetInstance()->SetCurrentState( BallTransferStateMgr::BALL_TRANSFER_STATE::TO_SHOOTER, run );
-            BallHopperStateMgr::GetInstance()->SetCurrentState( BallHopperStateMgr::HOLD, run);
-            TurretStateMgr::GetInstance()->SetCurrentState(TurretStateMgr::TURRET_STATE::HOLD, run);
+            Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Blue");
         }
-        **/
-        
-        if ( run )
+        else if ( stateEnum == SHOOTER_STATE::GET_READY_SHOOTGREEN)
         {
-            m_currentState->Run();
+            Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Green");
+        }
+        else if ( stateEnum == SHOOTER_STATE::GET_READY_SHOOTRED)
+        {
+            Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Red");
+        }
+        else if ( stateEnum == SHOOTER_STATE::GET_READY_SHOOTDISTANCE)
+        {
+            Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Distance");
+        }
+        else
+        {
+            Logger::GetLogger()->ToNtTable(m_nt, "Current State", "Shoot Yellow");
         }
     }
-    else
-    {
-        Logger::GetLogger()->ToNtTable(m_nt, "state", "nullptr" );
-    }
-    
 }
-
-
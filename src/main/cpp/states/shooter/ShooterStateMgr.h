@@ -16,8 +16,8 @@
 #pragma once
 
 // C++ Includes
-#include <map>
-#include <vector>
+#include <array>
+#include <memory>
 
 // FRC includes
 #include <networktables/NetworkTableInstance.h>
@@ -26,6 +26,7 @@
 
 // Team 302 includes
 #include <states/IState.h>
+#include <states/StateMachine.h>
 
 // Third Party Includes
 
@@ -41,6 +42,7 @@ class ShooterStateMgr
             GET_READY_SHOOTBLUE,
             GET_READY_SHOOTRED,
             SHOOT,
+            GET_READY_SHOOTDISTANCE,
             MAX_SHOOTER_STATES
         };
 
@@ -67,12 +69,25 @@ class ShooterStateMgr
 
         /// @brief  return the current state
         /// @return SHOOTER_STATE - the current state
-        inline SHOOTER_STATE GetCurrentState() const { return m_currentStateEnum; };
+        inline SHOOTER_STATE GetCurrentState() const { return m_stateMachine.GetCurrentStateEnum(); };
 
     private:
-        std::array<IState*,MAX_SHOOTER_STATES> m_states;
-        IState* m_currentState;
-        SHOOTER_STATE m_currentStateEnum;
+        void OnEntry
+        (
+            SHOOTER_STATE   state,
+            bool            run
+        );
+
+        void OnShootButton
+        (
+            bool            pressed
+        );
+
+        bool IsAimReady() const;
+
+        void UpdateRelease();
+
+        StateMachine<SHOOTER_STATE, MAX_SHOOTER_STATES> m_stateMachine;
         SHOOTER_STATE m_prevStateEnum;
         std::shared_ptr<nt::NetworkTable> m_nt;
 
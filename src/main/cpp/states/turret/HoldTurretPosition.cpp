@@ -39,12 +39,13 @@ void HoldTurretPosition::Init()
 {
     Mech1MotorState::Init();
     
+    // hold the current direction on the field, not the current encoder position
     auto cd = GetControlData();
-    if (cd->GetMode()==ControlModes::CONTROL_TYPE::POSITION_DEGREES)
+    if (cd->GetMode()==ControlModes::CONTROL_TYPE::POSITION_DEGREES || cd->GetMode()==ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES)
     {
         auto turret = MechanismFactory::GetMechanismFactory()->GetTurret();
         auto pos = turret.get()->GetPosition();
-        turret.get()->UpdateTarget(pos);
+        turret.get()->SetFieldLockedTarget(pos);
     }
 }
 
@@ -29,6 +29,7 @@
 #include <subsys/Turret.h>
 #include <utils/GoalDetection.h>
 #include <utils/Logger.h>
+#include <utils/ShotSolver.h>
 
 // Third Party Includes
 
@@ -38,12 +39,9 @@ LimelightAim::LimelightAim
 (
     ControlData*    control, 
     double          target
-) : IState(),
-    m_motorState( make_unique<Mech1MotorState>(MechanismFactory::GetMechanismFactory()->GetTurret().get(), control, target)),
+) : Mech1MotorState( MechanismFactory::GetMechanismFactory()->GetTurret().get(), control, target ),
     m_turret(MechanismFactory::GetMechanismFactory()->GetTurret()),
-    m_controlData(control),
     m_atTarget(false),
-    m_target(target),
     m_targetPosition(0.0),
     m_start(false)
 {
@@ -51,7 +49,7 @@ LimelightAim::LimelightAim
 
 void LimelightAim::Init()
 {
-    m_turret.get()->SetControlConstants(0, m_controlData);
+    m_turret.get()->SetControlConstants(0, GetControlData());
 }
 
 void LimelightAim::Run()
@@ -103,49 +101,45 @@ void LimelightAim::Run()
         **/
 
         /** **/
-        auto targetHorizontalOffset = goal->GetHorizontalAngleToInnerGoal();
-        //m_turret.get()->UpdateTarget((currentPosition + targetHorizontalOffset + 2.0));
-        m_targetPosition = currentPosition + targetHorizontalOffset.to<double>();
+        // aim at the virtual goal so shots taken while driving still go in
+        auto solver = ShotSolver::GetInstance();
+        solver->Solve( currentPosition );
+        m_targetPosition = solver->GetTurretAngle();
         /** **/
     }
     else
     {
+        // search: the state target is the step per cycle
+        auto increment = GetTarget();
         double target = m_targetPosition;
         if (currentPosition > m_min && currentPosition < m_max)
         {
             if (target >= 0.0)
             {
-                target += m_increment;
+                target += increment;
             }
             else if (target < 0.0)
             {
-                target -= m_increment;
+                target -= increment;
             }
             m_targetPosition = clamp(target, m_min, m_max);
         }
-        else if (currentPosition <= m_min+m_increment)
+        else if (currentPosition <= m_min+increment)
         {
-            m_targetPosition = m_increment;
+            m_targetPosition = increment;
         }
-        else if (currentPosition >= m_max-m_increment)
+        else if (currentPosition >= m_max-increment)
         {
-            m_targetPosition = -1.0 * m_increment;
+            m_targetPosition = -1.0 * increment;
         }
     }
     Logger::GetLogger()->ToNtTable("LimelightAim", "target Pos", m_targetPosition);
-    m_turret.get()->UpdateTarget(m_targetPosition);
-    m_turret.get()->Update();
+
+    // the turret profiles to the new target and counter-rotates against the chassis until the next frame
+    m_turret.get()->SetFieldLockedTarget(m_targetPosition);
 }
 
 bool LimelightAim::AtTarget() const
 {
     return m_atTarget;
 }
-
-void LimelightAim::UpdateTarget
-( 
-    double target
-)
-{
-    m_target = target;
-}
\ No newline at end of file
@@ -23,7 +23,10 @@
 class ControlData;
 
 
-class LimelightAim : public IState
+/// @brief  Aim the turret at the goal; while the goal isn't seen the turret searches back and forth.
+///         The state's target is the search step (degrees per cycle), so it can be tuned like the
+///         other mechanism targets.
+class LimelightAim : public Mech1MotorState
 {
     public:
         LimelightAim
@@ -34,15 +37,11 @@ class LimelightAim : public IState
         void Init() override;
         void Run() override;
         bool AtTarget() const override;
-        void UpdateTarget( double target );
     private:
-        std::unique_ptr<Mech1MotorState>    m_motorState;
         std::shared_ptr<Turret>             m_turret;
         //DragonLimelight*                    m_limelight;
 
-        ControlData* m_controlData;
         bool m_atTarget;
-        double m_target;
         double m_targetPosition;
         bool m_start;
 
@@ -53,5 +52,4 @@ class LimelightAim : public IState
         const double m_min    = -20.0;
         const double m_max    = 20.0;
         const double m_zero   = 0.0;
-        const double m_increment = 1.0;
 };
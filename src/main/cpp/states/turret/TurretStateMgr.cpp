@@ -14,7 +14,7 @@
 //====================================================================================================================================================
 
 
-#include <map>
+#include <array>
 #include <vector>
 
 #include <networktables/NetworkTableInstance.h>
@@ -23,8 +23,10 @@
 
 
 #include <states/turret/TurretStateMgr.h>
+#include <controllers/ControlTuner.h>
 #include <states/IState.h>
-#include <xmlmechdata/StateDataDefn.h>
+#include <states/StateMachine.h>
+#include <xmlmechdata/StateDataRegistry.h>
 #include <controllers/MechanismTargetData.h>
 #include <utils/Logger.h>
 #include <gamepad/TeleopControl.h>
@@ -38,6 +40,21 @@
 
 using namespace std;
 
+using TurretStateMachine = StateMachine<TurretStateMgr::TURRET_STATE, TurretStateMgr::MAX_TURRET_STATES>;
+
+/// @brief  xml state identifiers (indexed by TURRET_STATE)
+constexpr array<const char*, TurretStateMgr::MAX_TURRET_STATES> turretStateNames = 
+{
+    "TURRETHOLD",
+    "TURRETAUTOAIM"
+};
+
+/// @brief  button transitions
+constexpr array<TurretStateMachine::Transition, 1> turretTransitions = 
+{{
+    { TurretStateMgr::HOLD, TeleopControl::TURRET_LIMELIGHT_AIM, TurretStateMgr::LIMELIGHT_AIM, nullptr }
+}};
+
 TurretStateMgr* TurretStateMgr::m_instance = nullptr;
 TurretStateMgr* TurretStateMgr::GetInstance()
 {
@@ -48,8 +65,7 @@ TurretStateMgr* TurretStateMgr::GetInstance()
 	return TurretStateMgr::m_instance;
 }
 
-TurretStateMgr::TurretStateMgr() : m_states(),
-                                   m_currentState(),
+TurretStateMgr::TurretStateMgr() : m_stateMachine( turretStateNames, turretTransitions ),
                                    m_approxTargetAngle( 0.0 ),
                                    m_nt(nt::NetworkTableInstance::GetDefault().GetTable(string("Turret State Manager")))    
 {
@@ -61,61 +77,57 @@ TurretStateMgr::TurretStateMgr() : m_states(),
     }
 
 
-    // Parse the configuration file 
-    auto stateXML = make_unique<StateDataDefn>();
-    vector<MechanismTargetData*> targetData = stateXML.get()->ParseXML( MechanismTypes::MECHANISM_TYPE::TURRET );
+    // Get the parsed configuration data (parsed in RobotInit)
+    vector<MechanismTargetData*> targetData = StateDataRegistry::GetInstance()->GetTargetData( MechanismTypes::MECHANISM_TYPE::TURRET );
 
     Logger::GetLogger()->ToNtTable(m_nt, "statemgr: Turret Hold", "not created");
     Logger::GetLogger()->ToNtTable(m_nt, "statemgr: Limelight Aim", "not created");
-    map<string, TURRET_STATE> stateMap;
-    stateMap["TURRETHOLD"] = TURRET_STATE::HOLD;
-    stateMap["TURRETAUTOAIM"] = TURRET_STATE::LIMELIGHT_AIM;
-    for (auto inx=0; inx<MAX_TURRET_STATES; ++inx)
-    {
-       m_states[inx] = nullptr;
-    }
 
     for ( auto td: targetData )
     {
-        auto stateString = td->GetStateString();
-        auto stateItr = stateMap.find( stateString );
-        if ( stateItr != stateMap.end() )
+        auto stateEnum = m_stateMachine.FindState( td->GetStateString() );
+        if ( stateEnum != MAX_TURRET_STATES && m_stateMachine.GetState( stateEnum ) == nullptr )
         {
-            auto stateEnum = stateItr->second;
-            if ( m_states[stateEnum] == nullptr )
+            auto controlData = td->GetController();
+            auto target = td->GetTarget();
+            switch ( stateEnum )
             {
-                auto controlData = td->GetController();
-                auto target = td->GetTarget();
-                switch ( stateEnum )
+                case TURRET_STATE::HOLD:
                 {
-                    case TURRET_STATE::HOLD:
-                    {
-                        auto thisState = new HoldTurretPosition(controlData, m_approxTargetAngle);
-                        m_states[stateEnum] = thisState;
-                        m_currentState = thisState;
-                        m_currentStateEnum = stateEnum;
-                        m_currentState->Init();
-                        Logger::GetLogger()->ToNtTable(m_nt, "statemgr: Turret Hold", "created");
-                    }
-                    break;
-
-                    case TURRET_STATE::LIMELIGHT_AIM:
-                    {
-                        auto thisState = new LimelightAim(controlData, target);
-                        m_states[stateEnum] = thisState;
-                        Logger::GetLogger()->ToNtTable(m_nt, "statemgr: Limelight Aim", "created");
-                    }
-                    break;
-
-                    default:
-                    {
-                        Logger::GetLogger()->LogError( string("TurretHoodStateMgr::TurretHoodStateMgr"), string("unknown state"));
-                    }
-                    break;
+                    auto thisState = new HoldTurretPosition(controlData, m_approxTargetAngle);
+                    m_stateMachine.SetState( stateEnum, thisState );
+                    Logger::GetLogger()->ToNtTable(m_nt, "statemgr: Turret Hold", "created");
+
+                    // let dashboard edits to the target reach the state
+                    ControlTuner::GetInstance()->AddState( td, thisState );
                 }
+                break;
+
+                case TURRET_STATE::LIMELIGHT_AIM:
+                {
+                    auto thisState = new LimelightAim(controlData, target);
+                    m_stateMachine.SetState( stateEnum, thisState );
+                    Logger::GetLogger()->ToNtTable(m_nt, "statemgr: Limelight Aim", "created");
+
+                    // let dashboard edits to the target (search step) reach the state
+                    ControlTuner::GetInstance()->AddState( td, thisState );
+                }
+                break;
+
+                default:
+                {
+                    Logger::GetLogger()->LogError( string("TurretHoodStateMgr::TurretHoodStateMgr"), string("unknown state"));
+                }
+                break;
             }
         }
     }
+
+    m_stateMachine.SetCurrentState( TURRET_STATE::HOLD, false, false );
+    m_stateMachine.SetEntryAction( [this]( TURRET_STATE state, bool ) 
+                                   {
+                                       Logger::GetLogger()->ToNtTable(m_nt, "statemgr: Current State", state == LIMELIGHT_AIM ? "Limelight Aim" : "Hold Position");
+                                   } );
 }
 
 void TurretStateMgr::RunCurrentState()
@@ -123,18 +135,8 @@ void TurretStateMgr::RunCurrentState()
     if ( MechanismFactory::GetMechanismFactory()->GetTurret().get() != nullptr )
     {
         // process teleop/manual interrupts
-        auto controller = TeleopControl::GetInstance();
-        if ( controller != nullptr )
-        {
-            if (controller->IsButtonPressed( TeleopControl::FUNCTION_IDENTIFIER::TURRET_LIMELIGHT_AIM))
-            {
-                SetCurrentState( TURRET_STATE::LIMELIGHT_AIM, false);
-            }
-        }
-        if ( m_currentState != nullptr )
-        {
-            m_currentState->Run();
-        }
+        m_stateMachine.ProcessEvents( TeleopControl::GetInstance() );
+        m_stateMachine.Run();
     }
 }
 void TurretStateMgr::SetCurrentState
@@ -143,36 +145,6 @@ void TurretStateMgr::SetCurrentState
     bool         run
 )
 {
-    auto state = m_states[stateEnum];
-    if ( state != nullptr && state != m_currentState )
-    {
-        m_currentState = state;
-        m_currentStateEnum = stateEnum;
-        m_currentState->Init();
-        if ( stateEnum == LIMELIGHT_AIM )
-        {
-            Logger::GetLogger()->ToNtTable(m_nt, "statemgr: Current State", "Limelight Aim");
-            /**
-            auto llAim = dynamic_cast<LimelightAim*>(m_currentState);
-            if ( llAim != nullptr )
-            {
-                llAim->UpdateTarget( m_approxTargetAngle );
-            }
-            **/
-        }
-        else if (stateEnum==HOLD)
-        {
-            Logger::GetLogger()->ToNtTable(m_nt, "statemgr: Current State", "Hold Position");
-        }
-
-        
-        if ( run )
-        {
-            if ( MechanismFactory::GetMechanismFactory()->GetTurret().get() != nullptr )
-            {
-                m_currentState->Run();
-            }
-        }
-        
-    }
+    auto hasMech = MechanismFactory::GetMechanismFactory()->GetTurret().get() != nullptr;
+    m_stateMachine.SetCurrentState( stateEnum, run && hasMech, false );
 }
\ No newline at end of file
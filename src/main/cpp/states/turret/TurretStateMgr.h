@@ -16,14 +16,15 @@
 
 #pragma once
 
-#include <map>
-#include <vector>
+#include <array>
+#include <memory>
 
 #include <networktables/NetworkTableInstance.h>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableEntry.h>
 
 #include <states/IState.h>
+#include <states/StateMachine.h>
 
 class TurretStateMgr {
   public:
@@ -55,15 +56,13 @@ class TurretStateMgr {
 
         /// @brief  return the current state
         
-        inline TURRET_STATE GetCurrentState() const { return m_currentStateEnum; };
+        inline TURRET_STATE GetCurrentState() const { return m_stateMachine.GetCurrentStateEnum(); };
         
         inline void SetApproxTargetAngle( double angle ) { m_approxTargetAngle = angle; }
 
     private:
 
-        std::array<IState*, MAX_TURRET_STATES> m_states;
-        IState* m_currentState;
-        TURRET_STATE m_currentStateEnum;
+        StateMachine<TURRET_STATE, MAX_TURRET_STATES> m_stateMachine;
         double m_approxTargetAngle;
         std::shared_ptr<nt::NetworkTable> m_nt;
 
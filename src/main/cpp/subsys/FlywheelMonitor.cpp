@@ -0,0 +1,99 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <algorithm>
+#include <cmath>
+
+// FRC includes
+
+// Team 302 includes
+#include <subsys/FlywheelMonitor.h>
+
+// Third Party Includes
+
+using namespace std;
+
+namespace
+{
+    // a wheel is within tolerance when its error is inside this fraction of the target (or the minimum band)
+    constexpr double TOLERANCE_PERCENT      = 0.03;
+    constexpr double MIN_TOLERANCE_RPS      = 0.5;
+    // a drop of this fraction of the target from a settled wheel is a ball going through the shooter
+    constexpr double SHOT_DIP_PERCENT       = 0.06;
+    // consecutive cycles inside tolerance before a wheel is settled
+    constexpr int    SETTLE_CYCLES          = 3;
+}
+
+FlywheelMonitor::FlywheelMonitor() : m_lastTarget( 0.0 ),
+                                     m_cyclesInTolerance( 0 ),
+                                     m_armed( false ),
+                                     m_recovering( false ),
+                                     m_ready( false )
+{
+}
+
+/// @brief      Track the wheel for one cycle
+/// @param [in] bool - true if the wheel is running a velocity loop
+/// @param [in] double - target (revolutions per second)
+/// @param [in] double - measured speed (revolutions per second)
+/// @return     bool - true if a shot was detected this cycle
+bool FlywheelMonitor::Update
+(
+    bool        closedLoop,
+    double      target,
+    double      speed
+)
+{
+    auto isVelocity = closedLoop && target > 0.0;
+    auto tolerance  = max( target * TOLERANCE_PERCENT, MIN_TOLERANCE_RPS );
+
+    // open loop (or stopped) there is nothing to recover and no speed to be ready at, and a new setpoint is a
+    // spin up rather than a shot
+    if ( !isVelocity || abs( target - m_lastTarget ) > tolerance )
+    {
+        m_lastTarget        = target;
+        m_cyclesInTolerance = 0;
+        m_armed             = false;
+        m_recovering        = false;
+        m_ready             = false;
+        if ( !isVelocity )
+        {
+            return false;
+        }
+    }
+
+    auto shot  = false;
+    auto error = target - speed;
+    if ( m_recovering )
+    {
+        m_recovering = error >= tolerance;
+    }
+    else if ( m_armed && error > max( target * SHOT_DIP_PERCENT, tolerance ) )
+    {
+        shot                = true;
+        m_recovering        = true;
+        m_armed             = false;
+        m_cyclesInTolerance = 0;
+    }
+
+    if ( !m_recovering )
+    {
+        m_cyclesInTolerance = ( abs( error ) < tolerance ) ? m_cyclesInTolerance + 1 : 0;
+        m_armed = m_armed || m_cyclesInTolerance >= SETTLE_CYCLES;
+    }
+    m_ready = !m_recovering && m_cyclesInTolerance >= SETTLE_CYCLES;
+    return shot;
+}
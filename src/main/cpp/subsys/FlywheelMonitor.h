@@ -0,0 +1,72 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+//========================================================================================================
+/// FlywheelMonitor.h
+//========================================================================================================
+///
+/// File Description:
+///     Tracks one shooter flywheel in a velocity loop.  A wheel that has settled inside tolerance
+///     and then dips more than 6% below its target has had a ball go through it; the wheel is then
+///     recovering until it is back inside tolerance, and ready for the next ball once it has stayed
+///     there for three cycles.  A new setpoint is a spin up, not a shot.
+///
+///     The monitor only sees the target and the measured speed, so the Shooter applies the recovery
+///     boost and counts the shots.
+///
+//========================================================================================================
+class FlywheelMonitor
+{
+    public:
+        FlywheelMonitor();
+        ~FlywheelMonitor() = default;
+
+        /// @brief      Track the wheel for one cycle
+        /// @param [in] bool - true if the wheel is running a velocity loop
+        /// @param [in] double - target (revolutions per second)
+        /// @param [in] double - measured speed (revolutions per second)
+        /// @return     bool - true if a shot was detected this cycle
+        bool Update
+        (
+            bool        closedLoop,
+            double      target,
+            double      speed
+        );
+
+        /// @brief  Indicates the wheel is recovering from a shot
+        /// @return bool - true from the speed dip until the wheel is back inside tolerance
+        bool IsRecovering() const { return m_recovering; }
+
+        /// @brief  Indicates the wheel is settled at its target and not recovering
+        /// @return bool - true when the next ball can go through the wheel (never in open loop)
+        bool IsReady() const { return m_ready; }
+
+    private:
+        double  m_lastTarget;
+        int     m_cyclesInTolerance;
+        bool    m_armed;
+        bool    m_recovering;
+        bool    m_ready;
+};
@@ -0,0 +1,140 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <algorithm>
+#include <cmath>
+
+// FRC includes
+
+// Team 302 includes
+#include <subsys/ImuOdometryFilter.h>
+
+// Third Party Includes
+
+using namespace std;
+
+namespace
+{
+    constexpr double ACCEL_VARIANCE = 0.25;         // (meters per second squared)^2 of the accelerometer noise and mounting error
+    constexpr double WHEEL_VARIANCE = 0.0004;       // (meters per second)^2 of the module velocity when every module agrees
+    constexpr double MIN_WHEEL_CONFIDENCE = 0.05;
+    constexpr double OUTLIER_GATE = 13.8;           // squared Mahalanobis distance (99.9% for 2 degrees of freedom)
+    constexpr double MAX_PERIOD = 0.1;              // seconds; restart the velocity after a longer gap
+    constexpr double STATIONARY_SPEED = 0.02;       // meters per second
+    constexpr double STATIONARY_YAW_RATE = 0.02;    // radians per second
+    constexpr double STATIONARY_ACCEL = 0.5;        // meters per second squared from the bias
+    constexpr double BIAS_GAIN = 0.02;              // fraction of the bias error removed per stationary update
+    constexpr double BIAS_TRACKING_GAIN = 0.5;      // bias (meters per second squared) removed per meter per second of accepted correction
+}
+
+ImuOdometryFilter::ImuOdometryFilter() : m_initialized( false ),
+                                         m_x( 0.0 ),
+                                         m_y( 0.0 ),
+                                         m_vx( 0.0 ),
+                                         m_vy( 0.0 ),
+                                         m_p( 0.0 ),
+                                         m_biasX( 0.0 ),
+                                         m_biasY( 0.0 )
+{
+}
+
+/// @brief      Restart the filter at a field position; the velocity is taken from the next update
+/// @param [in] double - field x (meters)
+/// @param [in] double - field y (meters)
+/// @return     void
+void ImuOdometryFilter::Reset
+(
+    double      x,
+    double      y
+)
+{
+    m_initialized = false;
+    m_x = x;
+    m_y = y;
+}
+
+/// @brief      Advance the filter one step
+/// @return     void
+void ImuOdometryFilter::Update
+(
+    double      wheelVx,
+    double      wheelVy,
+    double      wheelConfidence,
+    double      ax,
+    double      ay,
+    double      yaw,
+    double      yawRate,
+    double      dt
+)
+{
+    // learn the accelerometer bias while nothing is moving
+    if ( hypot( wheelVx, wheelVy ) < STATIONARY_SPEED && 
+         abs( yawRate ) < STATIONARY_YAW_RATE &&
+         hypot( ax - m_biasX, ay - m_biasY ) < STATIONARY_ACCEL )
+    {
+        m_biasX += BIAS_GAIN * ( ax - m_biasX );
+        m_biasY += BIAS_GAIN * ( ay - m_biasY );
+    }
+
+    auto cosYaw = cos( yaw );
+    auto sinYaw = sin( yaw );
+    auto zx = wheelVx * cosYaw - wheelVy * sinYaw;
+    auto zy = wheelVx * sinYaw + wheelVy * cosYaw;
+    auto r  = WHEEL_VARIANCE / max( wheelConfidence, MIN_WHEEL_CONFIDENCE );
+
+    if ( !m_initialized || dt <= 0.0 || dt > MAX_PERIOD )
+    {
+        m_vx = zx;
+        m_vy = zy;
+        m_p  = r;
+        m_initialized = true;
+        return;
+    }
+
+    // predict with the accelerometer at the heading half way through the step
+    auto midYaw = yaw - 0.5 * yawRate * dt;
+    auto cosMid = cos( midYaw );
+    auto sinMid = sin( midYaw );
+    auto bx = ax - m_biasX;
+    auto by = ay - m_biasY;
+
+    auto prevVx = m_vx;
+    auto prevVy = m_vy;
+    m_vx += ( bx * cosMid - by * sinMid ) * dt;
+    m_vy += ( bx * sinMid + by * cosMid ) * dt;
+
+    m_p  += ACCEL_VARIANCE * dt * dt;
+
+    // correct with the modules unless they are an outlier (e.g. every wheel spinning at once);
+    // the variance keeps growing while they are rejected, so they are accepted again if they stay put
+    auto ex = zx - m_vx;
+    auto ey = zy - m_vy;
+    auto s  = m_p + r;
+    if ( ( ex * ex + ey * ey ) / s < OUTLIER_GATE )
+    {
+        auto k = m_p / s;
+        m_vx += k * ex;
+        m_vy += k * ey;
+        m_p  *= ( 1.0 - k );
+
+        // what the modules keep correcting while moving is mostly bias the stationary learning missed
+        m_biasX -= BIAS_TRACKING_GAIN * (  ex * cosMid + ey * sinMid );
+        m_biasY -= BIAS_TRACKING_GAIN * ( -ex * sinMid + ey * cosMid );
+    }
+
+    m_x += 0.5 * ( prevVx + m_vx ) * dt;
+    m_y += 0.5 * ( prevVy + m_vy ) * dt;
+}
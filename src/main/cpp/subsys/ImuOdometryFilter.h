@@ -0,0 +1,102 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+//========================================================================================================
+/// ImuOdometryFilter.h
+//========================================================================================================
+///
+/// File Description:
+///     Kalman filter for the chassis field velocity and position.  The pigeon accelerometer
+///     (less its bias, rotated to the field by the yaw at the middle of the step) predicts the
+///     velocity; the slip weighted module velocity corrects it.  A module measurement that is too
+///     far from the prediction for its covariance, such as all of the wheels spinning at once, is
+///     rejected and the accelerometer carries the velocity until the modules agree again.  The accelerometer bias is learned while the
+///     chassis is stationary and trimmed by the accepted module corrections while it moves.  Both axes
+///     share one variance, so every update is the same fixed amount of arithmetic.
+///
+///     Units are meters, seconds and radians; the accelerometer is assumed to be near the center
+///     of rotation with x forward and y to the left.
+///
+//========================================================================================================
+class ImuOdometryFilter
+{
+    public:
+        ImuOdometryFilter();
+        ~ImuOdometryFilter() = default;
+
+        /// @brief      Restart the filter at a field position; the velocity is taken from the next update
+        /// @param [in] double - field x (meters)
+        /// @param [in] double - field y (meters)
+        /// @return     void
+        void Reset
+        (
+            double      x,
+            double      y
+        );
+
+        /// @brief      Advance the filter one step
+        /// @param [in] double - module velocity forward (meters per second, robot frame)
+        /// @param [in] double - module velocity left (meters per second, robot frame)
+        /// @param [in] double - fraction of the modules that agree with each other (0.0 to 1.0)
+        /// @param [in] double - acceleration forward (meters per second squared, robot frame)
+        /// @param [in] double - acceleration left (meters per second squared, robot frame)
+        /// @param [in] double - field heading (radians, counter clockwise positive)
+        /// @param [in] double - rotation rate (radians per second, counter clockwise positive)
+        /// @param [in] double - time since the last update (seconds)
+        /// @return     void
+        void Update
+        (
+            double      wheelVx,
+            double      wheelVy,
+            double      wheelConfidence,
+            double      ax,
+            double      ay,
+            double      yaw,
+            double      yawRate,
+            double      dt
+        );
+
+        /// @brief  Estimated field x (meters)
+        double GetX() const { return m_x; }
+
+        /// @brief  Estimated field y (meters)
+        double GetY() const { return m_y; }
+
+        /// @brief  Estimated field x velocity (meters per second)
+        double GetVx() const { return m_vx; }
+
+        /// @brief  Estimated field y velocity (meters per second)
+        double GetVy() const { return m_vy; }
+
+    private:
+        bool    m_initialized;
+        double  m_x;
+        double  m_y;
+        double  m_vx;
+        double  m_vy;
+        double  m_p;
+        double  m_biasX;
+        double  m_biasY;
+};
@@ -25,8 +25,11 @@
 
 // Team 302 includes
 #include <controllers/ControlData.h>
+#include <controllers/ControlModes.h>
+#include <controllers/RoboRIOControlEngine.h>
 #include <subsys/Mech1IndMotor.h>
 #include <subsys/interfaces/IMech1IndMotor.h>
+#include <subsys/PowerManager.h>
 #include <hw/interfaces/IDragonMotorController.h>
 #include <utils/Logger.h>
 
@@ -52,7 +55,8 @@ Mech1IndMotor::Mech1IndMotor
     m_controlFile(controlFileName),
     m_ntName(networkTableName),
     m_motor( motorController ),
-    m_target( 0.0 )
+    m_target( 0.0 ),
+    m_controlData( nullptr )
 {
     if (m_motor.get() == nullptr )
     {
@@ -93,7 +97,14 @@ void Mech1IndMotor::Update()
     {
         auto ntName = GetNetworkTableName();
         auto table = nt::NetworkTableInstance::GetDefault().GetTable(ntName);
-        m_motor.get()->Set( table, m_target );
+        if ( IsRoboRIOControlled() )
+        {
+            RoboRIOControlEngine::GetInstance()->SetTarget( m_motor.get(), m_target );
+        }
+        else
+        {
+            m_motor.get()->Set( table, PowerManager::GetInstance()->ScaleOpenLoopTarget( m_controlData, m_target ) );
+        }
     }
 }
 
@@ -106,6 +117,18 @@ void Mech1IndMotor::UpdateTarget
     Update();
 }
 
+/// @brief  Re-send an open loop target with the latest PowerManager output scale (closed loop
+///         targets are left alone)
+/// @return void
+void Mech1IndMotor::ApplyOutputScale()
+{
+    if ( m_motor.get() != nullptr && PowerManager::IsOpenLoop( m_controlData ) )
+    {
+        auto table = nt::NetworkTableInstance::GetDefault().GetTable( GetNetworkTableName() );
+        m_motor.get()->Set( table, PowerManager::GetInstance()->ScaleOpenLoopTarget( m_controlData, m_target ) );
+    }
+}
+
 
 double Mech1IndMotor::GetPosition() const
 
@@ -131,9 +154,21 @@ void Mech1IndMotor::SetControlConstants
     ControlData*                                pid                 
 )
 {
+    m_controlData = pid;
     if ( m_motor.get() != nullptr )
     {
+        // stop the control engine's loop (waits for a running cycle) before the motor's mode
+        // changes, so the engine never writes to the motor in its new mode
+        auto engine = RoboRIOControlEngine::GetInstance();
+        engine->Stop( m_motor.get() );
         m_motor.get()->SetControlConstants( slot, pid );
+
+        // roboRIO loops run on the control engine; the motor just gets percent output
+        if ( IsRoboRIOControlled() )
+        {
+            engine->Start( m_motor, pid );
+            engine->SetTarget( m_motor.get(), m_target );
+        }
     }
 }
 
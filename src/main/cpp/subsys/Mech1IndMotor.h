@@ -24,6 +24,8 @@
 #include <frc2/Timer.h>
 
 // Team 302 includes
+#include <controllers/ControlData.h>
+#include <controllers/ControlModes.h>
 #include <subsys/interfaces/IMech1IndMotor.h>
 #include <subsys/MechanismTypes.h>
 
@@ -80,6 +82,11 @@ class Mech1IndMotor : public IMech1IndMotor
             double      target
         ) override;
 
+        /// @brief  Re-send an open loop target with the latest PowerManager output scale, so a target
+        ///         a state only sets in its Init still follows the scale.  Call every cycle.
+        /// @return void
+        void ApplyOutputScale();
+
         /// @brief  Return the current position of the mechanism.  The value is in inches or degrees.
         /// @return double	position in inches (translating mechanisms) or degrees (rotating mechanisms)
         double GetPosition() const override;
@@ -97,8 +104,16 @@ class Mech1IndMotor : public IMech1IndMotor
             ControlData*                                pid                 
         ) override;
 
+        /// @brief  Get the control constants last sent to the motor
+        /// @return ControlData* - control constants (nullptr if none were set)
+        ControlData* GetControlData() const { return m_controlData; }
+
     protected:
         double GetTarget() const { return m_target; }
+        std::shared_ptr<IDragonMotorController> GetMotor() const { return m_motor; }
+
+        /// @brief  Indicates whether the current control constants run on the roboRIO
+        bool IsRoboRIOControlled() const { return m_controlData != nullptr && m_controlData->GetRunLoc() == ControlModes::CONTROL_RUN_LOCS::ROBORIO; }
 
     private:
         MechanismTypes::MECHANISM_TYPE              m_type;
@@ -110,6 +125,7 @@ class Mech1IndMotor : public IMech1IndMotor
         std::unique_ptr<frc2::Timer>                m_timer;
         std::shared_ptr<IDragonMotorController>     m_motor;
         double                                      m_target;
+        ControlData*                                m_controlData;
 };
 
 
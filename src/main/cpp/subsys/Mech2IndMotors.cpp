@@ -29,7 +29,10 @@
 #include <subsys/Mech1IndMotor.h>
 #include <subsys/Mech2IndMotors.h>
 #include <subsys/interfaces/IMech2IndMotors.h>
+#include <subsys/PowerManager.h>
 #include <controllers/ControlData.h>
+#include <controllers/ControlModes.h>
+#include <controllers/RoboRIOControlEngine.h>
 #include <hw/interfaces/IDragonMotorController.h>
 #include <utils/Logger.h>
 
@@ -60,7 +63,9 @@ Mech2IndMotors::Mech2IndMotors
     m_primary( primaryMotor),
     m_secondary( secondaryMotor),
     m_primaryTarget(0.0),
-    m_secondaryTarget(0.0)
+    m_secondaryTarget(0.0),
+    m_primaryControlData(nullptr),
+    m_secondaryControlData(nullptr)
 {
     if ( m_primary.get() == nullptr )
     {
@@ -117,13 +122,29 @@ void Mech2IndMotors::Update()
 {
     auto ntName = GetNetworkTableName();
     auto table = nt::NetworkTableInstance::GetDefault().GetTable(ntName);
+    auto engine = RoboRIOControlEngine::GetInstance();
+    auto power = PowerManager::GetInstance();
     if ( m_primary.get() != nullptr )
     {
-        m_primary.get()->Set(table, m_primaryTarget);
+        if ( IsRoboRIOControlled( m_primaryControlData ) )
+        {
+            engine->SetTarget( m_primary.get(), m_primaryTarget );
+        }
+        else
+        {
+            m_primary.get()->Set(table, power->ScaleOpenLoopTarget( m_primaryControlData, m_primaryTarget ));
+        }
     }
     if ( m_secondary.get() != nullptr )
     {
-        m_secondary.get()->Set(table, m_secondaryTarget);
+        if ( IsRoboRIOControlled( m_secondaryControlData ) )
+        {
+            engine->SetTarget( m_secondary.get(), m_secondaryTarget );
+        }
+        else
+        {
+            m_secondary.get()->Set(table, power->ScaleOpenLoopTarget( m_secondaryControlData, m_secondaryTarget ));
+        }
     }
 
     LogData();
@@ -141,6 +162,23 @@ void Mech2IndMotors::UpdateTargets
     Update();
 }
 
+/// @brief  Re-send open loop targets with the latest PowerManager output scale (closed loop
+///         targets are left alone)
+/// @return void
+void Mech2IndMotors::ApplyOutputScale()
+{
+    auto table = nt::NetworkTableInstance::GetDefault().GetTable( GetNetworkTableName() );
+    auto power = PowerManager::GetInstance();
+    if ( m_primary.get() != nullptr && PowerManager::IsOpenLoop( m_primaryControlData ) )
+    {
+        m_primary.get()->Set( table, power->ScaleOpenLoopTarget( m_primaryControlData, m_primaryTarget ) );
+    }
+    if ( m_secondary.get() != nullptr && PowerManager::IsOpenLoop( m_secondaryControlData ) )
+    {
+        m_secondary.get()->Set( table, power->ScaleOpenLoopTarget( m_secondaryControlData, m_secondaryTarget ) );
+    }
+}
+
 
 /// @brief  Return the current position of the primary motor in the mechanism.  The value is in inches or degrees.
 /// @return double	position in inches (translating mechanisms) or degrees (rotating mechanisms)
@@ -179,9 +217,12 @@ void Mech2IndMotors::SetControlConstants
     ControlData*                                pid                 
 ) 
 {
+    m_primaryControlData = pid;
     if ( m_primary.get() != nullptr )
     {
+        RoboRIOControlEngine::GetInstance()->Stop( m_primary.get() );
         m_primary.get()->SetControlConstants(slot, pid);
+        UpdateRoboRIOControl( m_primary, pid, m_primaryTarget );
     }
 }
 void Mech2IndMotors::SetSecondaryControlConstants
@@ -190,12 +231,40 @@ void Mech2IndMotors::SetSecondaryControlConstants
     ControlData*                                pid                 
 ) 
 {
+    m_secondaryControlData = pid;
     if ( m_secondary.get() != nullptr )
     {
+        RoboRIOControlEngine::GetInstance()->Stop( m_secondary.get() );
         m_secondary.get()->SetControlConstants(slot, pid);
+        UpdateRoboRIOControl( m_secondary, pid, m_secondaryTarget );
     }    
 }
 
+/// @brief  Start the roboRIO control loop for a motor if its control constants run on the roboRIO.
+///         The caller stops the motor's loop before changing its control constants, so the engine
+///         isn't driving it in any other mode.
+void Mech2IndMotors::UpdateRoboRIOControl
+(
+    shared_ptr<IDragonMotorController>          motor,
+    ControlData*                                pid,
+    double                                      target
+)
+{
+    auto engine = RoboRIOControlEngine::GetInstance();
+    if ( IsRoboRIOControlled( pid ) )
+    {
+        engine->Start( motor, pid );
+        engine->SetTarget( motor.get(), target );
+    }
+}
 
+/// @brief  Indicates whether control constants run on the roboRIO
+bool Mech2IndMotors::IsRoboRIOControlled
+(
+    ControlData*                                pid
+) const
+{
+    return pid != nullptr && pid->GetRunLoc() == ControlModes::CONTROL_RUN_LOCS::ROBORIO;
+}
 
 
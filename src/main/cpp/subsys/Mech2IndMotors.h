@@ -80,6 +80,11 @@ class Mech2IndMotors : public IMech2IndMotors
             double      secondary
         ) override;
 
+        /// @brief  Re-send open loop targets with the latest PowerManager output scale, so targets
+        ///         a state only sets in its Init still follow the scale.  Call every cycle.
+        /// @return void
+        void ApplyOutputScale();
+
         /// @brief  Return the current position of the primary motor in the mechanism.  The value is in inches or degrees.
         /// @return double	position in inches (translating mechanisms) or degrees (rotating mechanisms)
         double GetPrimaryPosition() const override;
@@ -113,7 +118,28 @@ class Mech2IndMotors : public IMech2IndMotors
         double GetPrimaryTarget() const { return m_primaryTarget; }
         double GetSecondaryTarget() const { return m_secondaryTarget; }
 
+        /// @brief  Get the control constants last sent to each motor
+        /// @return ControlData* - control constants (nullptr if none were set)
+        ControlData* GetPrimaryControlData() const { return m_primaryControlData; }
+        ControlData* GetSecondaryControlData() const { return m_secondaryControlData; }
+
+    protected:
+        std::shared_ptr<IDragonMotorController> GetPrimaryMotor() const { return m_primary; }
+        std::shared_ptr<IDragonMotorController> GetSecondaryMotor() const { return m_secondary; }
+
     private: 
+        void UpdateRoboRIOControl
+        (
+            std::shared_ptr<IDragonMotorController>     motor,
+            ControlData*                                pid,
+            double                                      target
+        );
+
+        bool IsRoboRIOControlled
+        (
+            ControlData*                                pid
+        ) const;
+
         MechanismTypes::MECHANISM_TYPE              m_type;
         std::string                                 m_controlFile;
         std::string                                 m_ntName;
@@ -121,6 +147,8 @@ class Mech2IndMotors : public IMech2IndMotors
         std::shared_ptr<IDragonMotorController>     m_secondary;
         double                                      m_primaryTarget;
         double                                      m_secondaryTarget;
+        ControlData*                                m_primaryControlData;
+        ControlData*                                m_secondaryControlData;
         
 };
 
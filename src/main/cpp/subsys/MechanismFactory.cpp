@@ -88,6 +88,8 @@ MechanismFactory::MechanismFactory()  : m_balltransfer(),
 /// @param [in] 
 /// @param [in] 
 /// @param [in] 
+/// @param [in] double minAngle - minimum travel (degrees) for rotating mechanisms
+/// @param [in] double maxAngle - maximum travel (degrees) for rotating mechanisms
 /// @return  IMech*  pointer to the mechanism or nullptr if mechanism couldn't be created.
 void  MechanismFactory::CreateIMechanism
 (
@@ -95,7 +97,9 @@ void  MechanismFactory::CreateIMechanism
 	const IDragonMotorControllerMap&        motorControllers,   // <I> - Motor Controllers
 	const ServoMap&						    servos,
 	const DigitalInputMap&					digitalInputs,
-	shared_ptr<CANCoder>					canCoder
+	shared_ptr<CANCoder>					canCoder,
+	double									minAngle,
+	double									maxAngle
 )
 {
 	bool found = false;
@@ -210,7 +214,7 @@ void  MechanismFactory::CreateIMechanism
 					motor.get()->SetFramePeriodPriority( IDragonMotorController::MOTOR_PRIORITY::MEDIUM);
 					//motor.get()->UpdateFramePeriods(StatusFrameEnhanced::Status_1_General, 60);
 					//m_turret = make_shared<Turret>(motor, minTurn, maxTurn);
-					m_turret = make_shared<Turret>(motor);
+					m_turret = make_shared<Turret>(motor, minAngle, maxAngle);
 					Logger::GetLogger()->ToNtTable(string("MechanismFactory"), string("Turret"), string("created"));
 				}
 			}
@@ -77,7 +77,9 @@ class MechanismFactory
 			const IDragonMotorControllerMap&        				motorControllers,   // <I> - Motor Controllers
 			const ServoMap&						    				servos,
 			const DigitalInputMap&									digitalInputs,
-			std::shared_ptr<ctre::phoenix::sensors::CANCoder>		canCoder
+			std::shared_ptr<ctre::phoenix::sensors::CANCoder>		canCoder,
+			double													minAngle,			// <I> - travel limits (degrees) for rotating mechanisms
+			double													maxAngle
 		);
 
 		inline std::shared_ptr<Intake> GetIntake() const { return m_intake;};
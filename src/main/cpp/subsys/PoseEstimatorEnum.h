@@ -22,5 +22,6 @@ enum PoseEstimationMethod
     EULER_AT_CHASSIS,
     EULER_USING_MODULES,
     POSE_EST_AT_CHASSIS,
-    POSE_EST_USING_MODULES
+    POSE_EST_USING_MODULES,
+    IMU_FUSED
 };
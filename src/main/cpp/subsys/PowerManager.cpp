@@ -0,0 +1,246 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <algorithm>
+#include <string>
+
+// FRC includes
+#include <frc2/Timer.h>
+
+// Team 302 includes
+#include <controllers/ControlData.h>
+#include <controllers/ControlModes.h>
+#include <hw/DragonPDP.h>
+#include <subsys/PowerManager.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+
+using namespace std;
+
+namespace
+{
+    constexpr double SAMPLE_PERIOD = 0.04;          // seconds; the PDP status frames update about every 25 ms
+    constexpr double MAX_SAMPLE_GAP = 0.5;          // seconds; longer gaps (e.g. after a pause) restart the current trend
+    constexpr double SAFE_VOLTAGE = 7.5;            // volts; roboRIO brownout starts at 6.8 volts
+    constexpr double LOOKAHEAD = 0.1;               // seconds the current trend is extrapolated
+    constexpr double RATE_FILTER = 0.3;             // weight of the newest current rate sample
+    constexpr double MIN_SCALE = 0.3;
+    constexpr double RECOVERY_RATE = 0.5;           // scale per second
+    constexpr double MIN_VOLTAGE = 4.0;             // volts; lower readings mean there is no PDP
+    constexpr double NOMINAL_RESISTANCE = 0.02;     // ohms; battery, main breaker and wiring
+    constexpr double MIN_RESISTANCE = 0.01;         // ohms
+    constexpr double MAX_RESISTANCE = 0.05;         // ohms
+    constexpr double MIN_OPEN_CIRCUIT = 10.0;       // volts
+    constexpr double MAX_OPEN_CIRCUIT = 13.5;       // volts
+    constexpr double FORGETTING_FACTOR = 0.995;     // about 8 seconds of memory at the sample rate
+    constexpr double MAX_COVARIANCE = 100.0;        // bounds the covariance while the current doesn't change
+    constexpr double MEASUREMENT_VARIANCE = 0.01;   // volts squared
+    const string NT_NAME = string( "Power Manager" );
+}
+
+PowerManager* PowerManager::m_instance = nullptr;
+
+PowerManager* PowerManager::GetInstance()
+{
+    if ( PowerManager::m_instance == nullptr )
+    {
+        PowerManager::m_instance = new PowerManager();
+    }
+    return PowerManager::m_instance;
+}
+
+PowerManager::PowerManager() : m_initialized( false ),
+                               m_lastSampleTime( 0.0 ),
+                               m_lastCurrent( 0.0 ),
+                               m_currentRate( 0.0 ),
+                               m_openCircuitVoltage( 12.5 ),
+                               m_resistance( NOMINAL_RESISTANCE ),
+                               m_p00( 1.0 ),
+                               m_p01( 0.0 ),
+                               m_p11( 1.0e-4 ),
+                               m_scale( 1.0 ),
+                               m_voltage( 0.0 ),
+                               m_current( 0.0 ),
+                               m_predictedCurrent( 0.0 ),
+                               m_predictedVoltage( 0.0 ),
+                               m_budget( 0.0 ),
+                               m_decision( string("waiting for the first sample") )
+{
+}
+
+/// @brief  Sample the PDP (when the sample period has passed), update the battery model and
+///         recompute the output scale; the decision is logged every call
+/// @return void
+void PowerManager::Update()
+{
+    auto now = frc2::Timer::GetFPGATimestamp().to<double>();
+    auto dt  = now - m_lastSampleTime;
+    if ( m_initialized && dt < SAMPLE_PERIOD )
+    {
+        m_decision = string("holding between samples");
+    }
+    else
+    {
+        Sample( now, dt );
+    }
+    LogDecision();
+}
+
+/// @brief      Read the PDP, update the battery model and recompute the output scale
+/// @param [in] double - FPGA time (seconds)
+/// @param [in] double - time since the last sample (seconds)
+/// @return     void
+void PowerManager::Sample
+(
+    double      now,
+    double      dt
+)
+{
+    auto pdp = DragonPDP::GetInstance();
+    pdp->Sample();
+    m_voltage = pdp->GetVoltage();
+    m_current = pdp->GetTotalCurrent();
+    if ( m_voltage < MIN_VOLTAGE )
+    {
+        m_scale = 1.0;
+        m_decision = string("no PDP reading; full output");
+        return;
+    }
+
+    if ( !m_initialized || dt > MAX_SAMPLE_GAP )
+    {
+        if ( !m_initialized )
+        {
+            m_openCircuitVoltage = clamp( m_voltage + m_resistance * m_current, MIN_OPEN_CIRCUIT, MAX_OPEN_CIRCUIT );
+        }
+        m_initialized    = true;
+        m_lastSampleTime = now;
+        m_lastCurrent    = m_current;
+        m_currentRate    = 0.0;
+        m_decision = string("restarting the current trend");
+        return;
+    }
+
+    UpdateBatteryModel( m_voltage, m_current );
+
+    m_currentRate += RATE_FILTER * ( ( m_current - m_lastCurrent ) / dt - m_currentRate );
+    m_lastCurrent    = m_current;
+    m_lastSampleTime = now;
+
+    // only a rising current makes the sag worse; a falling one is not counted on
+    m_predictedCurrent = m_current + max( m_currentRate, 0.0 ) * LOOKAHEAD;
+    m_predictedVoltage = m_openCircuitVoltage - m_resistance * m_predictedCurrent;
+    m_budget = max( ( m_openCircuitVoltage - SAFE_VOLTAGE ) / m_resistance, 0.0 );
+
+    // the measured current is drawn at the current scale, so the scale that fits the budget is proportional
+    auto target = ( m_predictedCurrent > m_budget && m_predictedCurrent > 0.0 ) ? m_scale * m_budget / m_predictedCurrent : 1.0;
+    target = clamp( target, MIN_SCALE, 1.0 );
+    if ( target < m_scale )
+    {
+        m_scale = target;
+        m_decision = string("cutting output to the current budget");
+    }
+    else if ( m_scale < 1.0 )
+    {
+        m_scale = min( target, m_scale + RECOVERY_RATE * dt );
+        m_decision = string("recovering output");
+    }
+    else
+    {
+        m_decision = string("full output");
+    }
+}
+
+/// @brief  Log the last sample, the battery model and what was decided
+/// @return void
+void PowerManager::LogDecision() const
+{
+    auto logger = Logger::GetLogger();
+    logger->ToNtTable( NT_NAME, string("decision"), m_decision );
+    logger->ToNtTable( NT_NAME, string("voltage"), m_voltage );
+    logger->ToNtTable( NT_NAME, string("current"), m_current );
+    logger->ToNtTable( NT_NAME, string("open circuit voltage"), m_openCircuitVoltage );
+    logger->ToNtTable( NT_NAME, string("resistance"), m_resistance );
+    logger->ToNtTable( NT_NAME, string("predicted current"), m_predictedCurrent );
+    logger->ToNtTable( NT_NAME, string("predicted voltage"), m_predictedVoltage );
+    logger->ToNtTable( NT_NAME, string("current budget"), m_budget );
+    logger->ToNtTable( NT_NAME, string("output scale"), m_scale );
+}
+
+/// @brief      Indicates whether a mechanism output is open loop (percent output or voltage) on the motor controller
+/// @param [in] ControlData* - control constants the target is used with (may be nullptr)
+/// @return     bool - true if the output is scaled
+bool PowerManager::IsOpenLoop
+(
+    ControlData*    controlData
+)
+{
+    return controlData != nullptr &&
+           controlData->GetRunLoc() == ControlModes::CONTROL_RUN_LOCS::MOTOR_CONTROLLER &&
+           ( controlData->GetMode() == ControlModes::CONTROL_TYPE::PERCENT_OUTPUT ||
+             controlData->GetMode() == ControlModes::CONTROL_TYPE::VOLTAGE );
+}
+
+/// @brief      Scale a mechanism target if it is an open loop (percent output or voltage) output
+/// @param [in] ControlData* - control constants the target is used with (may be nullptr)
+/// @param [in] double - target
+/// @return     double - target to send to the motor
+double PowerManager::ScaleOpenLoopTarget
+(
+    ControlData*    controlData,
+    double          target
+) const
+{
+    return IsOpenLoop( controlData ) ? target * m_scale : target;
+}
+
+/// @brief      Recursive least squares update of voltage = openCircuitVoltage - resistance * current
+/// @param [in] double - battery voltage
+/// @param [in] double - total current
+/// @return     void
+void PowerManager::UpdateBatteryModel
+(
+    double      voltage,
+    double      current
+)
+{
+    // regressor h = [1, -current], parameters [openCircuitVoltage, resistance]
+    auto h0 = 1.0;
+    auto h1 = -current;
+    auto ph0 = m_p00 * h0 + m_p01 * h1;
+    auto ph1 = m_p01 * h0 + m_p11 * h1;
+    auto s   = FORGETTING_FACTOR * MEASUREMENT_VARIANCE + h0 * ph0 + h1 * ph1;
+    auto k0  = ph0 / s;
+    auto k1  = ph1 / s;
+    auto error = voltage - ( m_openCircuitVoltage * h0 + m_resistance * h1 );
+
+    m_openCircuitVoltage = clamp( m_openCircuitVoltage + k0 * error, MIN_OPEN_CIRCUIT, MAX_OPEN_CIRCUIT );
+    m_resistance         = clamp( m_resistance + k1 * error, MIN_RESISTANCE, MAX_RESISTANCE );
+
+    m_p00 = ( m_p00 - k0 * ph0 ) / FORGETTING_FACTOR;
+    m_p01 = ( m_p01 - k0 * ph1 ) / FORGETTING_FACTOR;
+    m_p11 = ( m_p11 - k1 * ph1 ) / FORGETTING_FACTOR;
+
+    // without a change in current the covariance would grow without bound
+    if ( m_p00 + m_p11 > MAX_COVARIANCE )
+    {
+        auto shrink = MAX_COVARIANCE / ( m_p00 + m_p11 );
+        m_p00 *= shrink;
+        m_p01 *= shrink;
+        m_p11 *= shrink;
+    }
+}
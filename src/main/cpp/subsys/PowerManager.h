@@ -0,0 +1,120 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <string>
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+class ControlData;
+
+//========================================================================================================
+/// PowerManager.h
+//========================================================================================================
+///
+/// File Description:
+///     Keeps the battery above the roboRIO brownout voltage.  At a fixed sample rate it reads the
+///     PDP battery voltage and current and fits a battery model
+///         voltage = openCircuitVoltage - resistance * current
+///     with recursive least squares, so the model follows the battery that is in the robot.  The
+///     current, extrapolated a short time ahead, predicts the sag; when the prediction drops below
+///     a safe voltage the output scale is cut to the current the battery can supply at that voltage.
+///     The scale drops right away and recovers slowly so the robot doesn't oscillate at the limit.
+///
+///     The swerve modules multiply their speed by the scale and mechanisms multiply their open
+///     loop outputs by it (closed loop targets like the shooter speed are left alone).
+///
+///     Update() must be called once per robot loop; it logs its decision to the "Power Manager"
+///     table every call, even between samples.
+///
+//========================================================================================================
+class PowerManager
+{
+    public:
+        static PowerManager* GetInstance();
+
+        /// @brief  Sample the PDP (when the sample period has passed), update the battery model and
+        ///         recompute the output scale; the decision is logged every call
+        /// @return void
+        void Update();
+
+        /// @brief  Fraction of the requested output the drive and mechanisms may use
+        /// @return double - scale between the minimum scale and 1.0
+        double GetOutputScale() const { return m_scale; }
+
+        /// @brief      Scale a mechanism target if it is an open loop (percent output or voltage) output
+        /// @param [in] ControlData* - control constants the target is used with (may be nullptr)
+        /// @param [in] double - target
+        /// @return     double - target to send to the motor
+        double ScaleOpenLoopTarget
+        (
+            ControlData*    controlData,
+            double          target
+        ) const;
+
+        /// @brief      Indicates whether a mechanism output is open loop (percent output or voltage) on the motor controller
+        /// @param [in] ControlData* - control constants the target is used with (may be nullptr)
+        /// @return     bool - true if the output is scaled
+        static bool IsOpenLoop
+        (
+            ControlData*    controlData
+        );
+
+    private:
+        PowerManager();
+        ~PowerManager() = default;
+
+        void Sample
+        (
+            double      now,
+            double      dt
+        );
+        void LogDecision() const;
+        void UpdateBatteryModel
+        (
+            double      voltage,
+            double      current
+        );
+
+        static PowerManager*    m_instance;
+
+        bool                    m_initialized;
+        double                  m_lastSampleTime;
+        double                  m_lastCurrent;
+        double                  m_currentRate;      // filtered, amps per second
+
+        // battery model and its recursive least squares covariance
+        double                  m_openCircuitVoltage;
+        double                  m_resistance;
+        double                  m_p00;
+        double                  m_p01;
+        double                  m_p11;
+
+        double                  m_scale;
+
+        // last sample and decision, logged every call
+        double                  m_voltage;
+        double                  m_current;
+        double                  m_predictedCurrent;
+        double                  m_predictedVoltage;
+        double                  m_budget;
+        std::string             m_decision;
+};
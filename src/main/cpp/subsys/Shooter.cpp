@@ -14,19 +14,93 @@
 //====================================================================================================================================================
 
 #include <memory>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include <frc/RobotController.h>
+
 #include <subsys/Shooter.h>
 #include <hw/interfaces/IDragonMotorController.h>
 #include <subsys/MechanismTypes.h>
+#include <controllers/ControlData.h>
 #include <controllers/ControlModes.h>
+#include <utils/Logger.h>
 
 using namespace std;
 
+namespace
+{
+    // voltage added on top of the velocity loop while a wheel recovers from a shot
+    constexpr double RECOVERY_BOOST_VOLTS   = 3.0;
+}
+
 Shooter::Shooter
 (
     std::shared_ptr<IDragonMotorController> motor1,
     std::shared_ptr<IDragonMotorController> motor2
-) : Mech2IndMotors( MechanismTypes::MECHANISM_TYPE::SHOOTER, string( "shooter.xml") , string("ShooterNT"), motor1, motor2 )
+) : Mech2IndMotors( MechanismTypes::MECHANISM_TYPE::SHOOTER, string( "shooter.xml") , string("ShooterNT"), motor1, motor2 ),
+    m_primaryWheel(),
+    m_secondaryWheel(),
+    m_shotCount( 0 )
+{
+
+}
+
+/// @brief run the flywheel recovery logic and then update the motor outputs
+/// @return void
+void Shooter::Update()
 {
+    // one ball dips both wheels, so only count a shot when the first wheel starts recovering
+    auto wasRecovering = m_primaryWheel.IsRecovering() || m_secondaryWheel.IsRecovering();
 
+    UpdateFlywheel( GetPrimaryMotor(), GetPrimaryControlData(), GetPrimaryTarget(), GetPrimarySpeed(), m_primaryWheel );
+    UpdateFlywheel( GetSecondaryMotor(), GetSecondaryControlData(), GetSecondaryTarget(), GetSecondarySpeed(), m_secondaryWheel );
+
+    if ( !wasRecovering && ( m_primaryWheel.IsRecovering() || m_secondaryWheel.IsRecovering() ) )
+    {
+        m_shotCount++;
+    }
+
+    auto ntName = GetNetworkTableName();
+    Logger::GetLogger()->ToNtTable( ntName, string("Ready To Fire"), IsReadyToFire() ? 1.0 : 0.0 );
+    Logger::GetLogger()->ToNtTable( ntName, string("Shot Count"), m_shotCount );
+
+    Mech2IndMotors::Update();
+}
+
+/// @brief  Indicates both flywheels are in closed loop, settled at their targets and not recovering from a shot
+/// @return bool - true when the next ball can be fed into the shooter (never in open loop)
+bool Shooter::IsReadyToFire() const
+{
+    return GetPrimaryMotor().get() != nullptr && m_primaryWheel.IsReady() &&
+           ( GetSecondaryMotor().get() == nullptr || m_secondaryWheel.IsReady() );
 }
 
+/// @brief  Track one flywheel and boost its output from the speed dip of a shot until it is back inside tolerance
+void Shooter::UpdateFlywheel
+(
+    shared_ptr<IDragonMotorController>      motor,
+    ControlData*                            pid,
+    double                                  target,
+    double                                  speed,
+    FlywheelMonitor&                        wheel
+)
+{
+    if ( motor.get() == nullptr )
+    {
+        return;
+    }
+
+    auto wasRecovering = wheel.IsRecovering();
+    auto isVelocity = pid != nullptr && pid->GetMode() == ControlModes::CONTROL_TYPE::VELOCITY_RPS;
+    if ( wheel.Update( isVelocity, target, speed ) )
+    {
+        auto volts = frc::RobotController::GetInputVoltage();
+        motor.get()->SetArbitraryFeedForward( volts > 0.0 ? min( RECOVERY_BOOST_VOLTS / volts, 1.0 ) : 0.0 );
+    }
+    else if ( wasRecovering && !wheel.IsRecovering() )
+    {
+        motor.get()->SetArbitraryFeedForward( 0.0 );
+    }
+}
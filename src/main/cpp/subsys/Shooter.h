@@ -15,10 +15,15 @@
 
 #pragma once
 
+#include <memory>
+
+#include <subsys/FlywheelMonitor.h>
 #include <subsys/Mech2IndMotors.h>
 
 #include <hw/interfaces/IDragonMotorController.h>
 
+class ControlData;
+
 class Shooter : public Mech2IndMotors
  {
     public:
@@ -30,4 +35,30 @@ class Shooter : public Mech2IndMotors
 
         Shooter() = delete;
         virtual ~Shooter() = default;
+
+        /// @brief run the flywheel recovery logic and then update the motor outputs
+        /// @return void
+        void Update() override;
+
+        /// @brief  Indicates both flywheels are in closed loop, settled at their targets and not recovering from a shot
+        /// @return bool - true when the next ball can be fed into the shooter (never in open loop)
+        bool IsReadyToFire() const;
+
+        /// @brief  Number of shots detected from flywheel speed dips
+        /// @return int - shot count
+        int GetShotCount() const { return m_shotCount; }
+
+    private:
+        void UpdateFlywheel
+        (
+            std::shared_ptr<IDragonMotorController>     motor,
+            ControlData*                                pid,
+            double                                      target,
+            double                                      speed,
+            FlywheelMonitor&                            wheel
+        );
+
+        FlywheelMonitor m_primaryWheel;
+        FlywheelMonitor m_secondaryWheel;
+        int             m_shotCount;
 };
@@ -0,0 +1,263 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <map>
+#include <string>
+
+// FRC includes
+
+// Team 302 includes
+#include <subsys/SwerveCalibration.h>
+#include <subsys/SwerveModule.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+#include <pugixml/pugixml.hpp>
+
+using namespace pugi;
+using namespace std;
+
+namespace
+{
+    // outside of the deploy directory so it survives deploying code
+    const string CALIBRATION_FILE = string( "/home/lvuser/swervecalibration.xml" );
+
+    const map<string, SwerveModule::ModuleID> MODULE_NAMES = { { string("LEFT_FRONT"),  SwerveModule::ModuleID::LEFT_FRONT },
+                                                               { string("RIGHT_FRONT"), SwerveModule::ModuleID::RIGHT_FRONT },
+                                                               { string("LEFT_BACK"),   SwerveModule::ModuleID::LEFT_BACK },
+                                                               { string("RIGHT_BACK"),  SwerveModule::ModuleID::RIGHT_BACK } };
+}
+
+SwerveCalibration* SwerveCalibration::m_instance = nullptr;
+
+SwerveCalibration* SwerveCalibration::GetInstance()
+{
+    if ( SwerveCalibration::m_instance == nullptr )
+    {
+        SwerveCalibration::m_instance = new SwerveCalibration();
+    }
+    return SwerveCalibration::m_instance;
+}
+
+SwerveCalibration::SwerveCalibration() : m_modules()
+{
+    for ( auto& module : m_modules )
+    {
+        module.calibrated    = false;
+        module.angleOffset   = units::angle::degree_t( 0.0 );
+        module.wheelDiameter = units::length::inch_t( 0.0 );
+        module.characterized = false;
+        module.kS            = 0.0;
+        module.kV            = 0.0;
+        module.kA            = 0.0;
+    }
+    Load();
+}
+
+/// @brief      Indicates there is a saved calibration for the module
+/// @param [in] SwerveModule::ModuleID - module
+/// @return     bool - true if the module has been calibrated
+bool SwerveCalibration::HasCalibration
+(
+    SwerveModule::ModuleID  module
+) const
+{
+    return m_modules[module].calibrated;
+}
+
+/// @brief      Angle to subtract from the turn sensor reading so zero is the wheel pointing forward
+/// @param [in] SwerveModule::ModuleID - module
+/// @return     units::angle::degree_t - offset (zero if not calibrated)
+units::angle::degree_t SwerveCalibration::GetAngleOffset
+(
+    SwerveModule::ModuleID  module
+) const
+{
+    return m_modules[module].angleOffset;
+}
+
+/// @brief      Effective diameter of the drive wheel
+/// @param [in] SwerveModule::ModuleID - module
+/// @return     units::length::inch_t - diameter (zero if not calibrated)
+units::length::inch_t SwerveCalibration::GetWheelDiameter
+(
+    SwerveModule::ModuleID  module
+) const
+{
+    return m_modules[module].wheelDiameter;
+}
+
+/// @brief      Replace a module's calibration (call Save to keep it)
+/// @return     void
+void SwerveCalibration::SetCalibration
+(
+    SwerveModule::ModuleID  module,
+    units::angle::degree_t  angleOffset,
+    units::length::inch_t   wheelDiameter
+)
+{
+    m_modules[module].calibrated    = true;
+    m_modules[module].angleOffset   = angleOffset;
+    m_modules[module].wheelDiameter = wheelDiameter;
+}
+
+/// @brief      Indicates there is a saved drive motor feedforward for the module
+/// @param [in] SwerveModule::ModuleID - module
+/// @return     bool - true if the module's drive motor has been characterized
+bool SwerveCalibration::HasFeedforward
+(
+    SwerveModule::ModuleID  module
+) const
+{
+    return m_modules[module].characterized;
+}
+
+/// @brief      Static friction term of the drive motor feedforward
+/// @param [in] SwerveModule::ModuleID - module
+/// @return     double - kS in volts (zero if not characterized)
+double SwerveCalibration::GetKs
+(
+    SwerveModule::ModuleID  module
+) const
+{
+    return m_modules[module].kS;
+}
+
+/// @brief      Velocity term of the drive motor feedforward
+/// @param [in] SwerveModule::ModuleID - module
+/// @return     double - kV in volts per meter per second (zero if not characterized)
+double SwerveCalibration::GetKv
+(
+    SwerveModule::ModuleID  module
+) const
+{
+    return m_modules[module].kV;
+}
+
+/// @brief      Acceleration term of the drive motor feedforward
+/// @param [in] SwerveModule::ModuleID - module
+/// @return     double - kA in volts per meter per second squared (zero if not characterized)
+double SwerveCalibration::GetKa
+(
+    SwerveModule::ModuleID  module
+) const
+{
+    return m_modules[module].kA;
+}
+
+/// @brief      Replace a module's drive motor feedforward (call Save to keep it)
+/// @return     void
+void SwerveCalibration::SetFeedforward
+(
+    SwerveModule::ModuleID  module,
+    double                  kS,
+    double                  kV,
+    double                  kA
+)
+{
+    m_modules[module].characterized = true;
+    m_modules[module].kS            = kS;
+    m_modules[module].kV            = kV;
+    m_modules[module].kA            = kA;
+}
+
+/// @brief  Write the calibration file
+/// @return bool - true if the file was written
+bool SwerveCalibration::Save() const
+{
+    xml_document doc;
+    auto root = doc.append_child( "swervecalibration" );
+    for ( auto& name : MODULE_NAMES )
+    {
+        auto& module = m_modules[name.second];
+        if ( !module.calibrated && !module.characterized )
+        {
+            continue;
+        }
+
+        auto node = root.append_child( "module" );
+        node.append_attribute( "id" ) = name.first.c_str();
+        if ( module.calibrated )
+        {
+            node.append_attribute( "angleOffset" ) = module.angleOffset.to<double>();
+            node.append_attribute( "wheelDiameter" ) = module.wheelDiameter.to<double>();
+        }
+        if ( module.characterized )
+        {
+            node.append_attribute( "kS" ) = module.kS;
+            node.append_attribute( "kV" ) = module.kV;
+            node.append_attribute( "kA" ) = module.kA;
+        }
+    }
+
+    auto saved = doc.save_file( CALIBRATION_FILE.c_str() );
+    if ( !saved )
+    {
+        Logger::GetLogger()->LogError( string("SwerveCalibration::Save"), string("unable to write ") + CALIBRATION_FILE );
+    }
+    return saved;
+}
+
+/// @brief  Read the calibration file; a missing file just means nothing has been calibrated yet
+/// @return void
+void SwerveCalibration::Load()
+{
+    xml_document doc;
+    xml_parse_result result = doc.load_file( CALIBRATION_FILE.c_str() );
+    if ( !result )
+    {
+        Logger::GetLogger()->LogError( Logger::LOGGER_LEVEL::PRINT, string("SwerveCalibration::Load"), string("no swerve module calibration: ") + result.description() );
+        return;
+    }
+
+    for ( auto node : doc.child( "swervecalibration" ).children( "module" ) )
+    {
+        auto itr = MODULE_NAMES.find( node.attribute( "id" ).as_string() );
+        if ( itr == MODULE_NAMES.end() )
+        {
+            Logger::GetLogger()->LogError( string("SwerveCalibration::Load"), string("invalid module entry") );
+            continue;
+        }
+
+        if ( node.attribute( "wheelDiameter" ) )
+        {
+            auto diameter = node.attribute( "wheelDiameter" ).as_double();
+            if ( diameter > 0.0 )
+            {
+                SetCalibration( itr->second, 
+                                units::angle::degree_t( node.attribute( "angleOffset" ).as_double() ), 
+                                units::length::inch_t( diameter ) );
+            }
+            else
+            {
+                Logger::GetLogger()->LogError( string("SwerveCalibration::Load"), itr->first + string(" invalid wheel diameter") );
+            }
+        }
+
+        if ( node.attribute( "kV" ) )
+        {
+            auto kV = node.attribute( "kV" ).as_double();
+            if ( kV > 0.0 )
+            {
+                SetFeedforward( itr->second, node.attribute( "kS" ).as_double(), kV, node.attribute( "kA" ).as_double() );
+            }
+            else
+            {
+                Logger::GetLogger()->LogError( string("SwerveCalibration::Load"), itr->first + string(" invalid feedforward") );
+            }
+        }
+    }
+}
@@ -0,0 +1,154 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <array>
+
+// FRC includes
+#include <units/angle.h>
+#include <units/length.h>
+
+// Team 302 includes
+#include <subsys/SwerveModule.h>
+
+// Third Party Includes
+
+//========================================================================================================
+/// SwerveCalibration.h
+//========================================================================================================
+///
+/// File Description:
+///     Measured swerve module calibration that is kept in a file outside of the deploy directory,
+///     so deploying code doesn't wipe it, and is read the first time it is needed:
+///       - turn sensor angle offset and effective drive wheel diameter (CalibrateModules primitive);
+///         modules without a calibration use the robot.xml values
+///       - drive motor feedforward, volts = kS * sign(v) + kV * v + kA * a with v in meters per second
+///         and a in meters per second squared (CharacterizeDrive primitive); modules without one
+///         drive open loop
+///
+//========================================================================================================
+class SwerveCalibration
+{
+    public:
+        static SwerveCalibration* GetInstance();
+
+        /// @brief      Indicates there is a saved calibration for the module
+        /// @param [in] SwerveModule::ModuleID - module
+        /// @return     bool - true if the module has been calibrated
+        bool HasCalibration
+        (
+            SwerveModule::ModuleID  module
+        ) const;
+
+        /// @brief      Angle to subtract from the turn sensor reading so zero is the wheel pointing forward
+        /// @param [in] SwerveModule::ModuleID - module
+        /// @return     units::angle::degree_t - offset (zero if not calibrated)
+        units::angle::degree_t GetAngleOffset
+        (
+            SwerveModule::ModuleID  module
+        ) const;
+
+        /// @brief      Effective diameter of the drive wheel
+        /// @param [in] SwerveModule::ModuleID - module
+        /// @return     units::length::inch_t - diameter (zero if not calibrated)
+        units::length::inch_t GetWheelDiameter
+        (
+            SwerveModule::ModuleID  module
+        ) const;
+
+        /// @brief      Replace a module's calibration (call Save to keep it)
+        /// @param [in] SwerveModule::ModuleID - module
+        /// @param [in] units::angle::degree_t - turn sensor angle offset
+        /// @param [in] units::length::inch_t - effective drive wheel diameter
+        /// @return     void
+        void SetCalibration
+        (
+            SwerveModule::ModuleID  module,
+            units::angle::degree_t  angleOffset,
+            units::length::inch_t   wheelDiameter
+        );
+
+        /// @brief      Indicates there is a saved drive motor feedforward for the module
+        /// @param [in] SwerveModule::ModuleID - module
+        /// @return     bool - true if the module's drive motor has been characterized
+        bool HasFeedforward
+        (
+            SwerveModule::ModuleID  module
+        ) const;
+
+        /// @brief      Static friction term of the drive motor feedforward
+        /// @param [in] SwerveModule::ModuleID - module
+        /// @return     double - kS in volts (zero if not characterized)
+        double GetKs
+        (
+            SwerveModule::ModuleID  module
+        ) const;
+
+        /// @brief      Velocity term of the drive motor feedforward
+        /// @param [in] SwerveModule::ModuleID - module
+        /// @return     double - kV in volts per meter per second (zero if not characterized)
+        double GetKv
+        (
+            SwerveModule::ModuleID  module
+        ) const;
+
+        /// @brief      Acceleration term of the drive motor feedforward
+        /// @param [in] SwerveModule::ModuleID - module
+        /// @return     double - kA in volts per meter per second squared (zero if not characterized)
+        double GetKa
+        (
+            SwerveModule::ModuleID  module
+        ) const;
+
+        /// @brief      Replace a module's drive motor feedforward (call Save to keep it)
+        /// @param [in] SwerveModule::ModuleID - module
+        /// @param [in] double - kS in volts
+        /// @param [in] double - kV in volts per meter per second
+        /// @param [in] double - kA in volts per meter per second squared
+        /// @return     void
+        void SetFeedforward
+        (
+            SwerveModule::ModuleID  module,
+            double                  kS,
+            double                  kV,
+            double                  kA
+        );
+
+        /// @brief  Write the calibration file
+        /// @return bool - true if the file was written
+        bool Save() const;
+
+    private:
+        SwerveCalibration();
+        ~SwerveCalibration() = default;
+
+        void Load();
+
+        struct ModuleCalibration
+        {
+            bool                    calibrated;
+            units::angle::degree_t  angleOffset;
+            units::length::inch_t   wheelDiameter;
+            bool                    characterized;
+            double                  kS;
+            double                  kV;
+            double                  kA;
+        };
+
+        static SwerveCalibration*           m_instance;
+        std::array<ModuleCalibration, 4>    m_modules;
+};
@@ -15,14 +15,18 @@
 //====================================================================================================================================================
 
 // C++ Includes
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <cmath>
+#include <string>
 
 // FRC includes
 #include <units/acceleration.h>
 #include <units/angular_acceleration.h>
 #include <units/angular_velocity.h>
 #include <units/length.h>
+#include <units/math.h>
 #include <units/velocity.h>
 
 // Team 302 includes
@@ -35,6 +39,34 @@
 using namespace std;
 using namespace frc;
 
+namespace
+{
+    // heading lock / snap gains; the error is in degrees and the output is in degrees per second
+    constexpr double HEADING_KP = 10.0;
+    constexpr double HEADING_KD = 0.7;
+    constexpr double MAX_HEADING_CORRECTION = 180.0;
+
+    // drive setpoint generator
+    constexpr double MAX_STEER_RATE = 4.0 * wpi::math::pi;     // radians per second a module can turn
+    constexpr double MIN_STEER_SPEED = 0.05;                    // meters per second; slower modules can point anywhere
+    constexpr double NOMINAL_PERIOD = 0.02;                     // seconds
+    constexpr double STALE_PERIOD = 0.1;                        // seconds; restart from rest after a longer gap
+    constexpr int    STEER_SEARCH_STEPS = 8;
+
+    // slip detection; a module's residual is how far its velocity is from the rigid body fit
+    // of the other modules, it gets full weight up to the tolerance and none at SLIP_REJECT_RATIO times it
+    constexpr double SLIP_TOLERANCE = 0.1;                      // meters per second
+    constexpr double SLIP_TOLERANCE_RATIO = 0.1;                // fraction of the fitted speed added to the tolerance
+    constexpr double SLIP_REJECT_RATIO = 3.0;
+    constexpr double MOVING_SPEED = 0.05;                       // meters per second
+    constexpr double MOVING_YAW_RATE = 2.0;                     // degrees per second
+
+    // slip detection network table entries (FL, FR, BL, BR), built once instead of every cycle
+    const std::string SLIP_TABLE = "Slip Detection";
+    const std::array<std::string, 4> RESIDUAL_NAMES { "FL residual", "FR residual", "BL residual", "BR residual" };
+    const std::array<std::string, 4> WEIGHT_NAMES { "FL weight", "FR weight", "BL weight", "BR weight" };
+}
+
 /// @brief Construct a swerve chassis
 /// @param [in] std::shared_ptr<SwerveModule>           frontleft:          front left swerve module
 /// @param [in] std::shared_ptr<SwerveModule>           frontright:         front right swerve module
@@ -76,7 +108,6 @@ SwerveChassis::SwerveChassis
     m_maxAcceleration(maxAcceleration),
     m_maxAngularAcceleration(maxAngularAcceleration),
     m_pigeon(PigeonFactory::GetFactory()->GetPigeon()),
-    m_accel(BuiltInAccelerometer()),
     m_isMoving(false),
     m_scale(1.0),
     m_boost(0.0),
@@ -86,9 +117,17 @@ SwerveChassis::SwerveChassis
     m_pose(),
     m_offsetPoseAngle(0_deg),
     m_timer(),
+    m_imuFilter(),
+    m_moduleConfidence(1.0),
+    m_moduleWeights{ { 1.0, 1.0, 1.0, 1.0 } },
+    m_modulePositions(),
+    m_modulePositionsValid(false),
     m_drive(units::velocity::meters_per_second_t(0.0)),
     m_steer(units::velocity::meters_per_second_t(0.0)),
     m_rotate(units::angular_velocity::radians_per_second_t(0.0)),
+    m_headingController(HEADING_KP, 0.0, HEADING_KD),
+    m_setpoint(),
+    m_setpointTime(0.0),
     m_frontLeftLocation(wheelBase/2.0, track/2.0),
     m_frontRightLocation(wheelBase/2.0, -1.0*track/2.0),
     m_backLeftLocation(-1.0*wheelBase/2.0, track/2.0),
@@ -97,6 +136,9 @@ SwerveChassis::SwerveChassis
     m_timer.Reset();
     m_timer.Start();
 
+    // the pigeon yaw keeps counting past +/-180, so go the short way around
+    m_headingController.EnableContinuousInput( -180.0, 180.0 );
+
     frontLeft.get()->Init( wheelDiameter, maxSpeed, maxAngularSpeed, maxAcceleration, maxAngularAcceleration, m_frontLeftLocation );
     frontRight.get()->Init( wheelDiameter, maxSpeed, maxAngularSpeed, maxAcceleration, maxAngularAcceleration, m_frontRightLocation );
     backLeft.get()->Init( wheelDiameter, maxSpeed, maxAngularSpeed, maxAcceleration, maxAngularAcceleration, m_backLeftLocation );
@@ -169,7 +211,6 @@ void SwerveChassis::Drive( units::meters_per_second_t xSpeed,
         m_drive = units::velocity::meters_per_second_t(0.0);
         m_steer = units::velocity::meters_per_second_t(0.0);
         m_rotate = units::angular_velocity::radians_per_second_t(0.0);
-        m_isMoving = false;
     }
     else
     {   
@@ -193,11 +234,6 @@ void SwerveChassis::Drive( units::meters_per_second_t xSpeed,
             m_frontRight.get()->SetDesiredState(fr);
             m_backLeft.get()->SetDesiredState(bl);
             m_backRight.get()->SetDesiredState(br); 
-            auto ax = m_accel.GetX();
-            auto ay = m_accel.GetY();
-            auto az = m_accel.GetZ();
-
-            m_isMoving = (abs(ax) > 0.0 || abs(ay) > 0.0 || abs(az) > 0.0 );
         }
         else
         {
@@ -214,12 +250,6 @@ void SwerveChassis::Drive( units::meters_per_second_t xSpeed,
             m_frontRight.get()->SetDesiredState(m_frState);
             m_backLeft.get()->SetDesiredState(m_blState);
             m_backRight.get()->SetDesiredState(m_brState);
-
-            auto ax = m_accel.GetX();
-            auto ay = m_accel.GetY();
-            auto az = m_accel.GetZ();
-
-            m_isMoving = (abs(ax) > 0.0 || abs(ay) > 0.0 || abs(az) > 0.0 );
         }
     }
 }
@@ -241,17 +271,32 @@ void SwerveChassis::Drive( ChassisSpeeds speeds, bool fieldRelative)
 ///                                     false: direction is based on robot front/back
 void SwerveChassis::Drive( double drive, double steer, double rotate, bool fieldRelative )
 {
-    if ( abs(drive)  < m_deadband && 
-         abs(steer)  < m_deadband && 
-         abs(rotate) < m_deadband )
-    {
-        // feed the motors
-        m_frontLeft.get()->StopMotors();
-        m_frontRight.get()->StopMotors();
-        m_backLeft.get()->StopMotors();
-        m_backRight.get()->StopMotors();       
-    }
-    else
+    Drive( drive, steer, rotate, units::angular_velocity::radians_per_second_t(0.0), fieldRelative );
+}
+
+/// @brief Drive the chassis while a heading controller adds its correction
+/// @param [in] double  drivePercent:   forward/reverse percent output (positive is forward)
+/// @param [in] double  steerPercent:   left/right percent output (positive is left)
+/// @param [in] double  rotatePercent:  Rotation percent output around the vertical (Z) axis; (positive is counter clockwise)
+/// @param [in] units::angular_velocity::radians_per_second_t headingCorrection: rotation rate (counter clockwise positive) that
+///                                     isn't rate limited or changed by the drive scale, boost or brake
+/// @param [in] bool    fieldRelative:  true: movement is based on the field (e.g., push it goes away from the driver regardless of the robot orientation),
+///                                     false: direction is based on robot front/back
+void SwerveChassis::Drive
+(
+    double                                          drive,
+    double                                          steer,
+    double                                          rotate,
+    units::angular_velocity::radians_per_second_t   headingCorrection,
+    bool                                            fieldRelative
+)
+{
+    // released sticks ask for a stop; the setpoint generator slows down to it and Drive 
+    // stops the motors once the setpoint is inside its deadband
+    ChassisSpeeds target;
+    if ( abs(drive)  >= m_deadband || 
+         abs(steer)  >= m_deadband || 
+         abs(rotate) >= m_deadband )
     {    
         // scale joystick values to velocities using max chassis values
         auto maxSpeed = GetMaxSpeed();
@@ -260,12 +305,130 @@ void SwerveChassis::Drive( double drive, double steer, double rotate, bool field
         Logger::GetLogger()->ToNtTable("Swerve Chassis", "MaxSpeed", maxSpeed.to<double>() );
         Logger::GetLogger()->ToNtTable("Swerve Chassis", "maxRotation", maxRotation.to<double>() );
 
-        units::velocity::meters_per_second_t            driveSpeed = drive * maxSpeed;
-        units::velocity::meters_per_second_t            steerSpeed = steer * maxSpeed;
-        units::angular_velocity::radians_per_second_t   rotateSpeed = rotate * maxRotation;
+        target.vx    = drive * maxSpeed;
+        target.vy    = steer * maxSpeed;
+        target.omega = rotate * maxRotation;
+    }
+
+    // limit the rates in field coordinates, so turning doesn't look like a translation change
+    units::angle::radian_t yaw = GetYaw();
+    if ( !fieldRelative )
+    {
+        auto cosYaw = cos(yaw.to<double>());
+        auto sinYaw = sin(yaw.to<double>());
+        target = ChassisSpeeds{ target.vx*cosYaw - target.vy*sinYaw, target.vx*sinYaw + target.vy*cosYaw, target.omega };
+    }
+
+    auto setpoint = GenerateSetpoint( target, yaw );
 
-        Drive( driveSpeed, steerSpeed, rotateSpeed, fieldRelative );
+    // the modules multiply every wheel speed by the drive scale, so divide the correction by it
+    // to turn the chassis at the rate the heading controller asked for
+    auto scale = clamp( m_scale + m_boost - m_brake, 0.0, 1.0 );
+    if ( scale > 0.0 )
+    {
+        setpoint.omega += headingCorrection / scale;
+    }
+    Drive( setpoint.vx, setpoint.vy, setpoint.omega, true );
+}
+
+/// @brief Step the drive setpoint toward the target as far as the acceleration and module steering
+///        limits allow.  Every component moves by the same fraction of the change, so the
+///        commanded direction is kept.
+/// @param [in] frc::ChassisSpeeds      target:     field relative speeds to reach
+/// @param [in] units::angle::radian_t  yaw:        current robot heading
+/// @return frc::ChassisSpeeds  new field relative setpoint
+ChassisSpeeds SwerveChassis::GenerateSetpoint
+(
+    ChassisSpeeds           target,
+    units::angle::radian_t  yaw
+)
+{
+    auto now = frc2::Timer::GetFPGATimestamp();
+    auto dt = (now - m_setpointTime).to<double>();
+    m_setpointTime = now;
+    if ( dt <= 0.0 || dt > STALE_PERIOD )
+    {
+        // the joysticks weren't driving (e.g. auton or disabled), so start from rest
+        m_setpoint = ChassisSpeeds();
+        dt = NOMINAL_PERIOD;
+    }
+
+    auto dvx = (target.vx - m_setpoint.vx).to<double>();
+    auto dvy = (target.vy - m_setpoint.vy).to<double>();
+    auto dw  = (target.omega - m_setpoint.omega).to<double>();
+
+    // largest fraction of the change the acceleration limits allow
+    auto s = 1.0;
+    auto dv = hypot(dvx, dvy);
+    auto maxDv = m_maxAcceleration.to<double>() * dt;
+    if ( dv > maxDv )
+    {
+        s = maxDv / dv;
+    }
+    auto maxDw = m_maxAngularAcceleration.to<double>() * dt;
+    if ( abs(dw) * s > maxDw )
+    {
+        s = maxDw / abs(dw);
     }
+
+    // module velocities are in robot coordinates
+    auto cosYaw = cos(yaw.to<double>());
+    auto sinYaw = sin(yaw.to<double>());
+    array<Translation2d, 4> locations { m_frontLeftLocation, m_frontRightLocation, m_backLeftLocation, m_backRightLocation };
+    auto vx0 = m_setpoint.vx.to<double>()*cosYaw + m_setpoint.vy.to<double>()*sinYaw;
+    auto vy0 = -m_setpoint.vx.to<double>()*sinYaw + m_setpoint.vy.to<double>()*cosYaw;
+    auto w0  = m_setpoint.omega.to<double>();
+    auto dvxRobot = dvx*cosYaw + dvy*sinYaw;
+    auto dvyRobot = -dvx*sinYaw + dvy*cosYaw;
+    auto maxSteer = MAX_STEER_RATE * dt;
+
+    // true if no module has to turn more than maxSteer to take the step (a module can reverse instead of turning past 90 degrees)
+    auto steerWithinLimit = [&]( double step )
+    {
+        for ( const auto& location : locations )
+        {
+            auto x = location.X().to<double>();
+            auto y = location.Y().to<double>();
+            auto mx0 = vx0 - w0*y;
+            auto my0 = vy0 + w0*x;
+            auto mx1 = mx0 + step*( dvxRobot - dw*y );
+            auto my1 = my0 + step*( dvyRobot + dw*x );
+            if ( hypot(mx0, my0) < MIN_STEER_SPEED || hypot(mx1, my1) < MIN_STEER_SPEED )
+            {
+                continue;
+            }
+            auto turn = abs( atan2( mx0*my1 - my0*mx1, mx0*mx1 + my0*my1 ) );
+            if ( min( turn, wpi::math::pi - turn ) > maxSteer )
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if ( !steerWithinLimit( s ) )
+    {
+        auto low = 0.0;
+        auto high = s;
+        for ( auto inx=0; inx<STEER_SEARCH_STEPS; ++inx )
+        {
+            auto mid = ( low + high ) / 2.0;
+            if ( steerWithinLimit( mid ) )
+            {
+                low = mid;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        s = low;
+    }
+
+    m_setpoint.vx    += units::velocity::meters_per_second_t( s * dvx );
+    m_setpoint.vy    += units::velocity::meters_per_second_t( s * dvy );
+    m_setpoint.omega += units::angular_velocity::radians_per_second_t( s * dw );
+    return m_setpoint;
 }
 
 Pose2d SwerveChassis::GetPose() const
@@ -289,6 +452,15 @@ void SwerveChassis::UpdateOdometry()
     Rotation2d rot2d {yaw+m_offsetPoseAngle};
     Rotation2d realAngle {yaw};
 
+    // only the methods that use the module speeds need the slip detection; the others just need to know
+    // whether the robot is moving
+    auto usesModules = m_poseOpt == PoseEstimationMethod::EULER_USING_MODULES ||
+                       m_poseOpt == PoseEstimationMethod::IMU_FUSED ||
+                       m_poseOpt == PoseEstimationMethod::POSE_EST_USING_MODULES;
+    auto measured = usesModules ? CalcMeasuredSpeeds() : GetChassisSpeeds();
+    m_isMoving = units::math::hypot( measured.vx, measured.vy ).to<double>() > MOVING_SPEED ||
+                 units::math::abs( GetYawRate() ).to<double>() > MOVING_YAW_RATE;
+
     if (m_poseOpt == PoseEstimationMethod::WPI)
     {
         auto currentPose = m_poseEstimator.GetEstimatedPosition();
@@ -323,6 +495,8 @@ void SwerveChassis::UpdateOdometry()
         auto vx = m_drive * cosAng + m_steer * sinAng;
         auto vy = m_drive * sinAng + m_steer * cosAng;
 
+        // these are the commanded speeds, so the compliance coefficient (robot.xml) stays until the
+        // module calibration feeds this path
         units::length::meter_t currentX = startX + m_odometryComplianceCoefficient*(vx * deltaT);
         units::length::meter_t currentY = startY + m_odometryComplianceCoefficient*(vy * deltaT);
 
@@ -330,16 +504,82 @@ void SwerveChassis::UpdateOdometry()
         auto trans = currPose - m_pose;
         m_pose += trans;
     }
-    else if (m_poseOpt==PoseEstimationMethod::EULER_USING_MODULES ||
-             m_poseOpt==PoseEstimationMethod::POSE_EST_USING_MODULES)
+    else if (m_poseOpt==PoseEstimationMethod::EULER_USING_MODULES)
+    {
+        // get change in time
+        auto deltaT = m_timer.Get();
+        m_timer.Reset();
+
+        // integrate the slip weighted module speeds in the field frame
+        units::angle::radian_t rads = yaw;
+        double cosAng = cos(rads.to<double>());
+        double sinAng = sin(rads.to<double>());
+        auto vx = measured.vx * cosAng - measured.vy * sinAng;
+        auto vy = measured.vx * sinAng + measured.vy * cosAng;
+
+        units::length::meter_t currentX = m_pose.X() + vx * deltaT;
+        units::length::meter_t currentY = m_pose.Y() + vy * deltaT;
+
+        Pose2d currPose{currentX, currentY, rot2d};
+        auto trans = currPose - m_pose;
+        m_pose += trans;
+    }
+    else if (m_poseOpt==PoseEstimationMethod::IMU_FUSED)
+    {
+        // get change in time
+        auto deltaT = m_timer.Get();
+        m_timer.Reset();
+
+        units::angle::radian_t rads = yaw;
+        units::radians_per_second_t yawRate = GetYawRate();
+        m_imuFilter.Update( measured.vx.to<double>(), 
+                            measured.vy.to<double>(), 
+                            m_moduleConfidence,
+                            m_pigeon->GetAccelX(), 
+                            m_pigeon->GetAccelY(), 
+                            rads.to<double>(), 
+                            yawRate.to<double>(), 
+                            deltaT.to<double>() );
+
+        Pose2d currPose{units::length::meter_t(m_imuFilter.GetX()), units::length::meter_t(m_imuFilter.GetY()), rot2d};
+        auto trans = currPose - m_pose;
+        m_pose += trans;
+    }
+    else if (m_poseOpt==PoseEstimationMethod::POSE_EST_USING_MODULES)
     {
-        auto flPose = m_frontLeft.get()->GetCurrentPose(m_poseOpt);
-        auto frPose = m_frontRight.get()->GetCurrentPose(m_poseOpt);
-        auto blPose = m_backLeft.get()->GetCurrentPose(m_poseOpt);
-        auto brPose = m_backRight.get()->GetCurrentPose(m_poseOpt);
+        const array<Translation2d, 4> positions { m_frontLeft.get()->GetCurrentPose(m_poseOpt).Translation(),
+                                                  m_frontRight.get()->GetCurrentPose(m_poseOpt).Translation(),
+                                                  m_backLeft.get()->GetCurrentPose(m_poseOpt).Translation(),
+                                                  m_backRight.get()->GetCurrentPose(m_poseOpt).Translation() };
+        const array<Translation2d, 4> locations { m_frontLeftLocation, 
+                                                  m_frontRightLocation, 
+                                                  m_backLeftLocation, 
+                                                  m_backRightLocation };
+
+        // move the chassis by the slip weighted average of the module displacements (less the part the
+        // rotation explains), so a slipping module's error doesn't move the chassis; the first update
+        // after a reset or a method change only records where the modules are
+        auto chassisX = m_pose.X();
+        auto chassisY = m_pose.Y();
+        if ( m_modulePositionsValid )
+        {
+            double dx = 0.0;
+            double dy = 0.0;
+            double sumWeights = 0.0;
+            for ( size_t i=0; i<positions.size(); ++i )
+            {
+                auto turn = locations[i].RotateBy( rot2d ) - locations[i].RotateBy( m_pose.Rotation() );
+                auto move = positions[i] - m_modulePositions[i] - turn;
+                dx += m_moduleWeights[i] * move.X().to<double>();
+                dy += m_moduleWeights[i] * move.Y().to<double>();
+                sumWeights += m_moduleWeights[i];
+            }
+            chassisX += units::length::meter_t( dx / sumWeights );
+            chassisY += units::length::meter_t( dy / sumWeights );
+        }
+        m_modulePositions = positions;
+        m_modulePositionsValid = true;
 
-        auto chassisX = (flPose.X() + frPose.X() + blPose.X() + brPose.X()) / 4.0;
-        auto chassisY = (flPose.Y() + frPose.Y() + blPose.Y() + brPose.Y()) / 4.0;
         Pose2d currPose{chassisX, chassisY, rot2d};
         auto trans = currPose - m_pose;
         m_pose += trans;
@@ -391,6 +631,78 @@ ChassisSpeeds SwerveChassis::GetChassisSpeeds() const
                                           m_backRight.get()->GetState() });
 }
 
+/// @brief Measure the chassis speed from the swerve modules and the pigeon, down-weighting any
+///        module that doesn't agree with the rigid body motion of the other modules
+/// @return frc::ChassisSpeeds  robot relative measured speeds
+ChassisSpeeds SwerveChassis::CalcMeasuredSpeeds()
+{
+    const array<SwerveModuleState, 4> states { m_frontLeft.get()->GetState(), 
+                                               m_frontRight.get()->GetState(),
+                                               m_backLeft.get()->GetState(),
+                                               m_backRight.get()->GetState() };
+    const array<Translation2d, 4> locations { m_frontLeftLocation, 
+                                              m_frontRightLocation, 
+                                              m_backLeftLocation, 
+                                              m_backRightLocation };
+
+    units::radians_per_second_t omega = GetYawRate();
+    auto w = omega.to<double>();
+
+    // each module's velocity less the rotation about its location is its estimate of the chassis velocity
+    array<double, 4> ux;
+    array<double, 4> uy;
+    double sumX = 0.0;
+    double sumY = 0.0;
+    for ( size_t i=0; i<states.size(); ++i )
+    {
+        auto speed = states[i].speed.to<double>();
+        ux[i] = speed * states[i].angle.Cos() + w * locations[i].Y().to<double>();
+        uy[i] = speed * states[i].angle.Sin() - w * locations[i].X().to<double>();
+        sumX += ux[i];
+        sumY += uy[i];
+    }
+
+    // compare each module against the fit from the other three
+    array<double, 4> residuals;
+    array<double, 4> weights;
+    double sumWeights = 0.0;
+    for ( size_t i=0; i<states.size(); ++i )
+    {
+        auto fitX = ( sumX - ux[i] ) / 3.0;
+        auto fitY = ( sumY - uy[i] ) / 3.0;
+        residuals[i] = hypot( ux[i] - fitX, uy[i] - fitY );
+
+        auto tolerance = SLIP_TOLERANCE + SLIP_TOLERANCE_RATIO * hypot( fitX, fitY );
+        weights[i] = clamp( ( SLIP_REJECT_RATIO * tolerance - residuals[i] ) / ( ( SLIP_REJECT_RATIO - 1.0 ) * tolerance ), 0.0, 1.0 );
+        sumWeights += weights[i];
+
+        Logger::GetLogger()->ToNtTable( SLIP_TABLE, RESIDUAL_NAMES[i], residuals[i] );
+        Logger::GetLogger()->ToNtTable( SLIP_TABLE, WEIGHT_NAMES[i], weights[i] );
+    }
+
+    m_moduleConfidence = sumWeights / 4.0;
+
+    // if nothing agrees there is no way to tell which modules are slipping, so use them all
+    if ( sumWeights <= 0.0 )
+    {
+        weights.fill( 1.0 );
+        sumWeights = 4.0;
+    }
+    m_moduleWeights = weights;
+
+    double vx = 0.0;
+    double vy = 0.0;
+    for ( size_t i=0; i<states.size(); ++i )
+    {
+        vx += weights[i] * ux[i];
+        vy += weights[i] * uy[i];
+    }
+
+    return ChassisSpeeds{ units::velocity::meters_per_second_t( vx / sumWeights ),
+                          units::velocity::meters_per_second_t( vy / sumWeights ),
+                          omega };
+}
+
 /// @brief Reset the current chassis pose based on the provided pose and rotation
 /// @param [in] const Pose2d&       pose        Current XY position
 /// @param [in] const Rotation2d&   angle       Current rotation angle
@@ -403,6 +715,8 @@ void SwerveChassis::ResetPosition
     m_poseEstimator.ResetPosition(pose, angle);
     auto trans = pose - m_pose;
     m_pose += trans;
+    m_imuFilter.Reset(pose.X().to<double>(), pose.Y().to<double>());
+    m_modulePositionsValid = false;
 
     m_offsetPoseAngle = units::angle::degree_t(m_pigeon->GetYaw()) - angle.Degrees();
 
@@ -434,6 +748,49 @@ void SwerveChassis::ResetPosition
     ResetPosition(pose, angle);
 }
 
+/// @brief Select how the pose is estimated (robot.xml poseEstimation).  IMU_FUSED starts its filter from
+///        the current pose and speeds up the pigeon accelerometer frame; other methods slow it back down.
+/// @param [in] PoseEstimationMethod    opt:    pose estimation method
+void SwerveChassis::SetPoseEstOption
+(
+    PoseEstimationMethod    opt
+)
+{
+    auto fused = opt == PoseEstimationMethod::IMU_FUSED;
+    if ( fused && m_poseOpt != PoseEstimationMethod::IMU_FUSED )
+    {
+        m_imuFilter.Reset(m_pose.X().to<double>(), m_pose.Y().to<double>());
+    }
+    m_pigeon->SetFastAccelerometer( fused );
+    m_modulePositionsValid = false;
+    m_poseOpt = opt;
+}
+
+/// @brief Get the field heading from the pigeon (counter clockwise positive)
+units::angle::degree_t SwerveChassis::GetYaw() const
+{
+    return units::angle::degree_t( m_pigeon->GetYaw() );
+}
+
+/// @brief Get the rotation rate from the pigeon (counter clockwise positive)
+units::angular_velocity::degrees_per_second_t SwerveChassis::GetYawRate() const
+{
+    return units::angular_velocity::degrees_per_second_t( m_pigeon->GetYawRate() );
+}
+
+/// @brief Calculate the rotation rate that turns the chassis toward a field heading;
+///        pass it to Drive as the headingCorrection
+/// @param [in] units::angle::degree_t  heading:    field heading to hold (counter clockwise positive)
+/// @return units::angular_velocity::radians_per_second_t  rotation rate (counter clockwise positive)
+units::angular_velocity::radians_per_second_t SwerveChassis::CalcHeadingCorrection
+(
+    units::angle::degree_t  heading
+)
+{
+    auto correction = m_headingController.Calculate( m_pigeon->GetYaw(), heading.to<double>() );
+    return units::angular_velocity::degrees_per_second_t( clamp( correction, -MAX_HEADING_CORRECTION, MAX_HEADING_CORRECTION ) );
+}
+
 ChassisSpeeds SwerveChassis::GetFieldRelativeSpeeds
 (
     units::meters_per_second_t xSpeed,
@@ -15,10 +15,11 @@
 //====================================================================================================================================================
 
 #pragma once
+#include <array>
 #include <memory>
 
 #include <frc/AnalogGyro.h>
-#include <frc/BuiltInAccelerometer.h>
+#include <frc/controller/PIDController.h>
 #include <frc/estimator/SwerveDrivePoseEstimator.h>
 #include <frc/geometry/Pose2d.h>
 #include <frc/geometry/Translation2d.h>
@@ -29,15 +30,18 @@
 #include <frc2/Timer.h>
 
 #include <units/acceleration.h>
+#include <units/angle.h>
 #include <units/angular_acceleration.h>
 #include <units/angular_velocity.h>
 #include <units/length.h>
+#include <units/time.h>
 #include <units/velocity.h>
 
 #include <wpi/math>
 
 #include <hw/factories/PigeonFactory.h>
 #include <hw/DragonPigeon.h>
+#include <subsys/ImuOdometryFilter.h>
 #include <subsys/SwerveModule.h>
 #include <subsys/PoseEstimatorEnum.h>
 
@@ -95,6 +99,23 @@ class SwerveChassis
         ///                                     false: direction is based on robot front/back
         void Drive(double drivePercent, double steerPercent, double rotatePercent, bool fieldRelative );
 
+        /// @brief Drive the chassis while a heading controller adds its correction
+        /// @param [in] double  drivePercent:   forward/reverse percent output (positive is forward)
+        /// @param [in] double  steerPercent:   left/right percent output (positive is left)
+        /// @param [in] double  rotatePercent:  Rotation percent output around the vertical (Z) axis; (positive is counter clockwise)
+        /// @param [in] units::angular_velocity::radians_per_second_t headingCorrection: rotation rate (counter clockwise positive) that
+        ///                                     isn't rate limited or changed by the drive scale, boost or brake
+        /// @param [in] bool    fieldRelative:  true: movement is based on the field (e.g., push it goes away from the driver regardless of the robot orientation),
+        ///                                     false: direction is based on robot front/back
+        void Drive
+        (
+            double                                          drivePercent,
+            double                                          steerPercent,
+            double                                          rotatePercent,
+            units::angular_velocity::radians_per_second_t   headingCorrection,
+            bool                                            fieldRelative
+        );
+
         /// @brief Drive the chassis
         /// @param [in] frc::ChassisSpeeds  speeds:         kinematics for how to move the chassis
         /// @param [in] bool                fieldRelative:  true: movement is based on the field (e.g., push it goes away from the driver regardless of the robot orientation),
@@ -150,9 +171,30 @@ class SwerveChassis
         void SetBoost( double boost );
         void SetBrake( double brake );
         void RunWPIAlgorithm(bool runWPI ) { m_runWPI = runWPI; }
-        void SetPoseEstOption(PoseEstimationMethod opt ) { m_poseOpt = opt; }
+        /// @brief Select how the pose is estimated (robot.xml poseEstimation).  IMU_FUSED starts its filter from
+        ///        the current pose and speeds up the pigeon accelerometer frame; other methods slow it back down.
+        /// @param [in] PoseEstimationMethod    opt:    pose estimation method
+        void SetPoseEstOption(PoseEstimationMethod opt );
         double GetScaleFactor() const {return m_scale;}
         bool IsMoving() const { return m_isMoving;}
+
+        /// @brief Get the field heading from the pigeon (counter clockwise positive)
+        units::angle::degree_t GetYaw() const;
+
+        /// @brief Get the rotation rate from the pigeon (counter clockwise positive)
+        units::angular_velocity::degrees_per_second_t GetYawRate() const;
+
+        /// @brief Calculate the rotation rate that turns the chassis toward a field heading;
+        ///        pass it to Drive as the headingCorrection
+        /// @param [in] units::angle::degree_t  heading:    field heading to hold (counter clockwise positive)
+        /// @return units::angular_velocity::radians_per_second_t  rotation rate (counter clockwise positive)
+        units::angular_velocity::radians_per_second_t CalcHeadingCorrection
+        (
+            units::angle::degree_t  heading
+        );
+
+        /// @brief Clear the heading controller's history (call when the held heading changes)
+        void ResetHeadingController() { m_headingController.Reset(); }
         double GetodometryComplianceCoefficient() const { return m_odometryComplianceCoefficient; }
 
     private:
@@ -168,6 +210,24 @@ class SwerveChassis
             frc::ChassisSpeeds 
         );
 
+        /// @brief Step the drive setpoint toward the target as far as the acceleration and module steering
+        ///        limits allow.  Every component moves by the same fraction of the change, so the
+        ///        commanded direction is kept.
+        /// @param [in] frc::ChassisSpeeds      target:     field relative speeds to reach
+        /// @param [in] units::angle::radian_t  yaw:        current robot heading
+        /// @return frc::ChassisSpeeds  new field relative setpoint
+        frc::ChassisSpeeds GenerateSetpoint
+        (
+            frc::ChassisSpeeds      target,
+            units::angle::radian_t  yaw
+        );
+
+        /// @brief Measure the chassis speed from the swerve modules and the pigeon.  Each module is compared
+        ///        to the rigid body motion fit to the other modules and the gyro; a slipping or skidding
+        ///        module is down-weighted or rejected.  The weights are kept for POSE_EST_USING_MODULES.
+        /// @return frc::ChassisSpeeds  robot relative measured speeds
+        frc::ChassisSpeeds CalcMeasuredSpeeds();
+
         std::shared_ptr<SwerveModule>                               m_frontLeft;
         std::shared_ptr<SwerveModule>                               m_frontRight;
         std::shared_ptr<SwerveModule>                               m_backLeft;
@@ -188,7 +248,6 @@ class SwerveChassis
         units::angular_acceleration::radians_per_second_squared_t   m_maxAngularAcceleration;
 
         DragonPigeon*                                               m_pigeon;
-        frc::BuiltInAccelerometer                                   m_accel;
         bool                                                        m_isMoving;
         double                                                      m_scale;
         double                                                      m_boost;
@@ -198,11 +257,19 @@ class SwerveChassis
         frc::Pose2d                                                 m_pose;
         units::angle::degree_t                                      m_offsetPoseAngle;
         frc2::Timer                                                 m_timer;
+        ImuOdometryFilter                                           m_imuFilter;
+        double                                                      m_moduleConfidence; // fraction of the modules that aren't slipping
+        std::array<double, 4>                                       m_moduleWeights;    // slip weights (FL, FR, BL, BR) from CalcMeasuredSpeeds
+        std::array<frc::Translation2d, 4>                           m_modulePositions;  // module poses at the last POSE_EST_USING_MODULES update
+        bool                                                        m_modulePositionsValid;
         units::velocity::meters_per_second_t                        m_drive;
         units::velocity::meters_per_second_t                        m_steer;
         units::angular_velocity::radians_per_second_t               m_rotate;
 
         const double                                                m_deadband = 0.1;
+        frc2::PIDController                                         m_headingController;
+        frc::ChassisSpeeds                                          m_setpoint;         // field relative
+        units::time::second_t                                       m_setpointTime;
         
         frc::Translation2d m_frontLeftLocation;
         frc::Translation2d m_frontRightLocation;
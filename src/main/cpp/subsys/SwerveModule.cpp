@@ -22,11 +22,14 @@
 #include <frc/geometry/Rotation2d.h>
 #include <frc/trajectory/TrapezoidProfile.h>
 #include <frc/controller/PIDController.h>
+#include <frc/RobotController.h>
+#include <frc2/Timer.h>
 #include <networktables/NetworkTableInstance.h>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableEntry.h>
 #include <units/angle.h>
 #include <units/velocity.h>
+#include <units/voltage.h>
 #include <wpi/math>
 
 // Team 302 includes
@@ -34,6 +37,8 @@
 #include <controllers/ControlModes.h>
 
 #include <subsys/PoseEstimatorEnum.h>
+#include <subsys/PowerManager.h>
+#include <subsys/SwerveCalibration.h>
 #include <subsys/SwerveChassis.h>
 #include <subsys/SwerveChassisFactory.h>
 #include <subsys/SwerveModule.h>
@@ -52,6 +57,13 @@ using namespace ctre::phoenix::motorcontrol::can;
 using namespace ctre::phoenix::sensors;
 using namespace wpi::math;
 
+namespace
+{
+    constexpr double DRIVE_P = 0.01;
+    constexpr double DRIVE_F = 0.5;                 // only used without a measured feedforward
+    constexpr double MAX_FEEDFORWARD_PERIOD = 0.1;  // seconds; longer gaps restart the acceleration term
+}
+
 /// @brief Constructs a Swerve Module.  This is assuming 2 TalonFX (Falcons) with a CanCoder for the turn angle
 /// @param [in] ModuleID                                                type:           Which Swerve Module is it
 /// @param [in] shared_ptr<IDragonMotorController>                      driveMotor:     Motor that makes the robot move  
@@ -77,6 +89,7 @@ SwerveModule::SwerveModule
     m_turnMotor(turnMotor), 
     m_turnSensor(canCoder), 
     m_wheelDiameter(0.0),
+    m_angleOffset(0.0),
     m_nt(),
     m_activeState(),
     m_currentPose(),
@@ -84,6 +97,12 @@ SwerveModule::SwerveModule
     m_currentRotations(0.0),
     //m_timer(),
     m_maxVelocity(1_mps),
+    m_maxAcceleration(0.0),
+    m_kS(0.0),
+    m_kV(0.0),
+    m_kA(0.0),
+    m_lastDriveTarget(0_mps),
+    m_lastDriveTime(0.0),
     m_scale(1.0),
     m_boost(0.0),
     m_brake(0.0),
@@ -103,8 +122,9 @@ SwerveModule::SwerveModule
     auto motor = m_driveMotor.get()->GetSpeedController();
     auto fx = dynamic_cast<WPI_TalonFX*>(motor.get());
 
-    fx->ConfigOpenloopRamp(0.4, 0);
-    fx->ConfigClosedloopRamp(0.4, 0);
+    // no per-module ramps; SwerveChassis limits the acceleration of the whole chassis so the modules stay in step
+    fx->ConfigOpenloopRamp(0.0, 0);
+    fx->ConfigClosedloopRamp(0.0, 0);
 
     fx->ConfigSelectedFeedbackSensor( ctre::phoenix::motorcontrol::FeedbackDevice::IntegratedSensor, 0, 10 );
     fx->ConfigIntegratedSensorInitializationStrategy(BootToZero);
@@ -183,19 +203,24 @@ void SwerveModule::Init
 {
     m_wheelDiameter = wheelDiameter;
     m_maxVelocity = maxVelocity;
-    auto driveCData = make_shared<ControlData>( ControlModes::CONTROL_TYPE::VELOCITY_RPS,
-                                                ControlModes::CONTROL_RUN_LOCS::MOTOR_CONTROLLER,
-                                                string("DriveSpeed"),
-                                                0.01,  // 0.01
-                                                0.0,
-                                                0.0,
-                                                0.5,  // 0.5
-                                                0.0,
-                                                maxAcceleration.to<double>(),
-                                                maxVelocity.to<double>(),
-                                                maxVelocity.to<double>(),
-                                                0.0 );
-    m_driveMotor.get()->SetControlConstants( 0, driveCData.get() );
+    m_maxAcceleration = maxAcceleration;
+
+    // measured values from the last calibration replace the nominal ones
+    auto calibration = SwerveCalibration::GetInstance();
+    if ( calibration->HasCalibration( m_type ) )
+    {
+        SetCalibration( calibration->GetAngleOffset( m_type ), calibration->GetWheelDiameter( m_type ) );
+    }
+
+    // with a measured feedforward the drive runs closed loop; otherwise it stays open loop
+    if ( calibration->HasFeedforward( m_type ) )
+    {
+        SetDriveFeedforward( calibration->GetKs( m_type ), calibration->GetKv( m_type ), calibration->GetKa( m_type ) );
+    }
+    else
+    {
+        SetDriveControlConstants();
+    }
 
     //auto trans = Transform2d(offsetFromCenterOfRobot, Rotation2d() );
     //m_currentPose = m_currentPose + trans;
@@ -230,6 +255,79 @@ void SwerveModule::ZeroAlignModule()
 }
 
 
+/// @brief Apply a measured turn sensor offset and drive wheel diameter
+/// @param [in] units::angle::degree_t  angleOffset:    angle to subtract from the turn sensor so zero is forward
+/// @param [in] units::length::inch_t   wheelDiameter:  effective diameter of the drive wheel
+/// @returns void
+void SwerveModule::SetCalibration
+(
+    units::angle::degree_t  angleOffset,
+    units::length::inch_t   wheelDiameter
+)
+{
+    m_angleOffset   = angleOffset;
+    m_wheelDiameter = wheelDiameter;
+}
+
+/// @brief Use a measured drive motor feedforward and run the drive motor closed loop velocity
+/// @param [in] double  kS: static friction in volts
+/// @param [in] double  kV: volts per meter per second
+/// @param [in] double  kA: volts per meter per second squared
+/// @returns void
+void SwerveModule::SetDriveFeedforward
+(
+    double  kS,
+    double  kV,
+    double  kA
+)
+{
+    m_kS = kS;
+    m_kV = kV;
+    m_kA = kA;
+    m_runClosedLoopDrive = true;
+    SetDriveControlConstants();
+}
+
+/// @brief Send the drive velocity PIDF to the motor controller; the F term is only used
+///        when the feedforward hasn't been measured
+/// @returns void
+void SwerveModule::SetDriveControlConstants()
+{
+    auto driveCData = make_shared<ControlData>( ControlModes::CONTROL_TYPE::VELOCITY_RPS,
+                                                ControlModes::CONTROL_RUN_LOCS::MOTOR_CONTROLLER,
+                                                string("DriveSpeed"),
+                                                DRIVE_P,
+                                                0.0,
+                                                0.0,
+                                                m_kV > 0.0 ? 0.0 : DRIVE_F,
+                                                0.0,
+                                                m_maxAcceleration.to<double>(),
+                                                m_maxVelocity.to<double>(),
+                                                m_maxVelocity.to<double>(),
+                                                0.0 );
+    m_driveMotor.get()->SetControlConstants( 0, driveCData.get() );
+}
+
+/// @brief Run the drive motor open loop at a voltage (drive characterization); the turn motor isn't changed
+/// @param [in] units::voltage::volt_t  volts:  drive motor voltage
+/// @returns void
+void SwerveModule::SetDriveVoltage
+(
+    units::voltage::volt_t  volts
+)
+{
+    m_driveMotor.get()->SetArbitraryFeedForward( 0.0 );
+    m_driveMotor.get()->SetControlMode( ControlModes::CONTROL_TYPE::VOLTAGE );
+    m_driveMotor.get()->Set( m_nt, volts.to<double>() );
+}
+
+/// @brief Get the wheel angle from the turn sensor with the calibration offset removed
+/// @returns units::angle::degree_t angle between -180 and 180 degrees
+units::angle::degree_t SwerveModule::GetTurnAngle() const
+{
+    return AngleUtils::GetEquivAngle( units::angle::degree_t(m_turnSensor.get()->GetAbsolutePosition()) - m_angleOffset );
+}
+
 /// @brief Get the current state of the module (speed of the wheel and angle of the wheel)
 /// @returns SwerveModuleState
 SwerveModuleState SwerveModule::GetState() const 
@@ -239,7 +337,7 @@ SwerveModuleState SwerveModule::GetState() const
     auto mps = units::velocity::meters_per_second_t(mpr.to<double>() * m_driveMotor.get()->GetRPS());
 
     // Get the Module Current Rotation Angle
-    Rotation2d angle {units::angle::degree_t(m_turnSensor.get()->GetAbsolutePosition())};
+    Rotation2d angle {GetTurnAngle()};
 
     // Create the state and return it
     SwerveModuleState state{mps,angle};
@@ -259,7 +357,7 @@ void SwerveModule::SetDesiredState
     // If the desired angle is less than 90 degrees from the target angle (e.g., -90 to 90 is the amount of turn), just use the angle and speed values
     // if it is more than 90 degrees (90 to 270), the can turn the opposite direction -- increase the angle by 180 degrees -- and negate the wheel speed
     // finally, get the value between -90 and 90
-    Rotation2d currAngle = Rotation2d(units::angle::degree_t(m_turnSensor.get()->GetAbsolutePosition()));
+    Rotation2d currAngle = Rotation2d(GetTurnAngle());
    auto optimizedState = Optimize(targetState, currAngle);
    // auto optimizedState = SwerveModuleState::Optimize(targetState, currAngle);
    // auto optimizedState = targetState;
@@ -353,13 +451,16 @@ void SwerveModule::SetDriveSpeed( units::velocity::meters_per_second_t speed )
 
     if (m_runClosedLoopDrive)
     {
+        auto scaledSpeed = m_activeState.speed * clamp((m_scale + m_boost - m_brake), 0.0, 1.0);
+        scaledSpeed *= PowerManager::GetInstance()->GetOutputScale();
+
         // convert mps to unitless rps by taking the speed and dividing by the circumference of the wheel
-        auto driveTarget = m_activeState.speed.to<double>() / (units::length::meter_t(m_wheelDiameter).to<double>() * wpi::math::pi);  
+        auto driveTarget = scaledSpeed.to<double>() / (units::length::meter_t(m_wheelDiameter).to<double>() * wpi::math::pi);  
         driveTarget /= m_driveMotor.get()->GetGearRatio();
-        driveTarget *= clamp((m_scale + m_boost - m_brake), 0.0, 1.0);
         
         Logger::GetLogger()->ToNtTable(m_nt, string("drive target - rps"), driveTarget );
         
+        m_driveMotor.get()->SetArbitraryFeedForward( CalcDriveFeedforward( scaledSpeed ) );
         m_driveMotor.get()->SetControlMode(ControlModes::CONTROL_TYPE::VELOCITY_RPS);
         m_driveMotor.get()->Set(m_nt, driveTarget);
     }
@@ -367,6 +468,7 @@ void SwerveModule::SetDriveSpeed( units::velocity::meters_per_second_t speed )
     {
         auto percent = m_activeState.speed / m_maxVelocity;
         percent *= clamp((m_scale + m_boost - m_brake), 0.0, 1.0);
+        percent *= PowerManager::GetInstance()->GetOutputScale();
 
         Logger::GetLogger()->ToNtTable(m_nt, string("drive target - percent"), percent );
 
@@ -375,6 +477,32 @@ void SwerveModule::SetDriveSpeed( units::velocity::meters_per_second_t speed )
     }
 }
 
+/// @brief Calculate the drive motor feedforward for a speed from the measured kS, kV and kA;
+///        the acceleration is the change in the speed target since the last call
+/// @param [in] units::velocity::meters_per_second_t    speed:  target wheel speed
+/// @returns double feedforward in percent output of the current battery voltage
+double SwerveModule::CalcDriveFeedforward
+(
+    units::velocity::meters_per_second_t    speed
+)
+{
+    auto now = frc2::Timer::GetFPGATimestamp();
+    auto dt  = (now - m_lastDriveTime).to<double>();
+    auto accel = ( dt > 0.0 && dt < MAX_FEEDFORWARD_PERIOD ) ? (speed - m_lastDriveTarget).to<double>() / dt : 0.0;
+    accel = clamp( accel, -m_maxAcceleration.to<double>(), m_maxAcceleration.to<double>() );
+    m_lastDriveTarget = speed;
+    m_lastDriveTime   = now;
+
+    auto v     = speed.to<double>();
+    auto sign  = v > 0.0 ? 1.0 : ( v < 0.0 ? -1.0 : 0.0 );
+    auto volts = m_kS * sign + m_kV * v + m_kA * accel;
+    auto battery = frc::RobotController::GetInputVoltage();
+
+    Logger::GetLogger()->ToNtTable(m_nt, string("drive feedforward - volts"), volts );
+
+    return battery > 0.0 ? clamp( volts / battery, -1.0, 1.0 ) : 0.0;
+}
+
 /// @brief Turn the swerve module to a specified angle
 /// @param [in] units::angle::degree_t the target angle to turn the wheel to
 /// @returns void
@@ -385,7 +513,7 @@ void SwerveModule::SetTurnAngle( units::angle::degree_t targetAngle )
     Logger::GetLogger()->ToNtTable(m_nt, string("turn motor id"), m_turnMotor.get()->GetID() );
     Logger::GetLogger()->ToNtTable(m_nt, string("target angle"), targetAngle.to<double>() );
 
-    auto currAngle  = units::angle::degree_t(m_turnSensor.get()->GetAbsolutePosition());
+    auto currAngle  = GetTurnAngle();
     auto deltaAngle = AngleUtils::GetDeltaAngle(currAngle, targetAngle);
 
     Logger::GetLogger()->ToNtTable(m_nt, string("current angle"), currAngle.to<double>() );
@@ -442,7 +570,7 @@ frc::Pose2d SwerveModule::GetCurrentPose(PoseEstimationMethod opt)
 
     // read sensor info (cancoder, encoders) for current speed and angle of the module
     // calculate the average from the last 
-    auto currentAngle   = units::angle::radian_t(units::angle::degree_t(m_turnSensor.get()->GetPosition()));
+    auto currentAngle   = units::angle::radian_t(GetTurnAngle());
     //auto avgAngle       = (currentAngle - startAngle) / 2.0;
     auto currentRotations = m_driveMotor.get()->GetRotations();
     //auto currentSpeed   = units::angular_velocity::revolutions_per_minute_t(m_driveMotor.get()->GetRPS()*60.0);
@@ -559,5 +687,5 @@ void SwerveModule::UpdateCurrPose
 )
 {
     m_currentPose += { Translation2d{x,y}, 
-                        Rotation2d{units::angle::degree_t(m_turnSensor.get()->GetPosition())}};
+                        Rotation2d{GetTurnAngle()}};
 }
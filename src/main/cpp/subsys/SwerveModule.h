@@ -27,6 +27,7 @@
 #include <frc/kinematics/SwerveModuleState.h>
 
 #include <units/acceleration.h>
+#include <units/angle.h>
 #include <units/angular_acceleration.h>
 #include <units/angular_velocity.h>
 #include <units/time.h>
@@ -111,6 +112,38 @@ class SwerveModule
         /// @returns ModuleID
         ModuleID GetType() {return m_type;}
         units::length::inch_t GetWheelDiameter() const {return m_wheelDiameter;}
+        units::angle::degree_t GetAngleOffset() const {return m_angleOffset;}
+
+        /// @brief Get the angle the turn sensor measures, less the offset, so zero is forward
+        /// @returns units::angle::degree_t - measured module angle (-180 to 180)
+        units::angle::degree_t GetTurnAngle() const;
+
+        /// @brief Apply a measured turn sensor offset and drive wheel diameter
+        /// @param [in] units::angle::degree_t  angleOffset:    angle to subtract from the turn sensor so zero is forward
+        /// @param [in] units::length::inch_t   wheelDiameter:  effective diameter of the drive wheel
+        /// @returns void
+        void SetCalibration
+        (
+            units::angle::degree_t  angleOffset,
+            units::length::inch_t   wheelDiameter
+        );
+
+        /// @brief Use a measured drive motor feedforward and run the drive motor closed loop velocity
+        /// @param [in] double  kS: static friction in volts
+        /// @param [in] double  kV: volts per meter per second
+        /// @param [in] double  kA: volts per meter per second squared
+        /// @returns void
+        void SetDriveFeedforward
+        (
+            double  kS,
+            double  kV,
+            double  kA
+        );
+
+        /// @brief Run the drive motor open loop at a voltage (drive characterization); the turn motor isn't changed
+        /// @param [in] units::voltage::volt_t  volts:  drive motor voltage
+        /// @returns void
+        void SetDriveVoltage( units::voltage::volt_t volts );
 
         void SetDriveScale(double scale) { m_scale = scale; }
         void SetBoost(double boost) { m_boost=boost;}
@@ -137,6 +170,8 @@ class SwerveModule
 
 
         void SetDriveSpeed( units::velocity::meters_per_second_t speed );
+        void SetDriveControlConstants();
+        double CalcDriveFeedforward( units::velocity::meters_per_second_t speed );
         void SetTurnAngle( units::angle::degree_t angle );
 
 
@@ -147,6 +182,7 @@ class SwerveModule
         std::shared_ptr<ctre::phoenix::sensors::CANCoder>   m_turnSensor;
 
         units::length::inch_t                               m_wheelDiameter;
+        units::angle::degree_t                              m_angleOffset;
 
         std::shared_ptr<nt::NetworkTable>                   m_nt;     
 
@@ -159,6 +195,13 @@ class SwerveModule
 
 
         units::velocity::meters_per_second_t                m_maxVelocity;
+        units::acceleration::meters_per_second_squared_t    m_maxAcceleration;
+
+        double                                              m_kS;
+        double                                              m_kV;
+        double                                              m_kA;
+        units::velocity::meters_per_second_t                m_lastDriveTarget;
+        units::time::second_t                               m_lastDriveTime;
 
         double                                              m_scale;
         double                                              m_boost;
@@ -14,32 +14,165 @@
 //====================================================================================================================================================
 
 // C++ Includes
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <mutex>
 #include <string>
 // FRC includes
+#include <frc/Notifier.h>
+#include <units/angle.h>
+#include <units/time.h>
 
 // Team 302 includes
 #include <subsys/Mech1IndMotor.h>
 #include <subsys/Turret.h>
 #include <subsys/MechanismTypes.h>
+#include <hw/DragonPigeon.h>
+#include <hw/factories/PigeonFactory.h>
+#include <hw/interfaces/IDragonMotorController.h>
+#include <utils/AngleUtils.h>
 
 // Third Party Includes
 
 
 using namespace std;
 
-/// @brief Create the BallTransfer mechanism
-/// @param [in] IDragonMotorController* the motor controller that will run the ball transfer
+namespace
+{
+    // field lock loop period (200 Hz)
+    constexpr units::second_t   FIELD_LOCK_PERIOD   = units::second_t( 0.005 );
+    // don't resend targets that moved less than this (degrees)
+    constexpr double            OUTPUT_THRESHOLD    = 0.05;
+}
+
+/// @brief Create the Turret mechanism
+/// @param [in] IDragonMotorController* the motor controller that will run the turret
+/// @param [in] double minAngle - minimum turret travel (degrees) from the mechanism definition
+/// @param [in] double maxAngle - maximum turret travel (degrees) from the mechanism definition
 Turret::Turret
 (
-    shared_ptr<IDragonMotorController>      motorController//,
+    shared_ptr<IDragonMotorController>      motorController,
+    double                                  minAngle,
+    double                                  maxAngle//,
 //    shared_ptr<DragonDigitalInput>          minTurnSensor,
 //    shared_ptr<DragonDigitalInput>          maxTurnSensor
 ) : Mech1IndMotor( MechanismTypes::MECHANISM_TYPE::TURRET, 
                     string("turret.xml"), 
                     string("turretNT"), 
-                    motorController )
+                    motorController ),
+    m_pigeon( PigeonFactory::GetFactory()->GetPigeon() ),
+    m_mutex(),
+    m_fieldLocked( false ),
+    m_lockTarget( 0.0 ),
+    m_lockYaw( 0.0 ),
+    m_lastOutput( 0.0 ),
+    m_minAngle( minAngle ),
+    m_maxAngle( maxAngle ),
+    m_notifier( make_unique<frc::Notifier>( [this] { FieldLockUpdate(); } ) )
+{
+}
+
+/// @brief update the output to the mechanism using the current controller and target value(s).
+///        While the turret is field locked, the field lock loop owns the motor output.
+/// @return void 
+void Turret::Update()
 {
+    if ( !m_fieldLocked )
+    {
+        Mech1IndMotor::Update();
+    }
+}
+
+/// @brief  Set a robot relative target (degrees).  This turns off the field lock.
+/// @param [in] double - target angle in degrees
+/// @return void
+void Turret::UpdateTarget
+(
+    double      target
+)
+{
+    StopFieldLock();
+    Mech1IndMotor::UpdateTarget( target );
+}
+
+/// @brief  Set the control constants (e.g. PIDF values).  This turns off the field lock first so
+///         the field lock loop can't send a target in the old control mode.
+/// @param [in] int          slot: the PID slot
+/// @param [in] ControlData* pid:  the control constants
+/// @return void
+void Turret::SetControlConstants
+(
+    int                                         slot,
+    ControlData*                                pid
+)
+{
+    StopFieldLock();
+    Mech1IndMotor::SetControlConstants( slot, pid );
+}
+
+/// @brief  Aim at a robot relative angle (degrees) and keep pointing in that direction on the field
+///         as the chassis rotates.
+/// @param [in] double - target angle in degrees
+/// @return void
+void Turret::SetFieldLockedTarget
+(
+    double      target
+)
+{
+    auto wasLocked = m_fieldLocked.load();
+    {
+        lock_guard<mutex> lock( m_mutex );
+        m_lockTarget  = target;
+        m_lockYaw     = ( m_pigeon != nullptr ) ? m_pigeon->GetYaw() : 0.0;
+        m_lastOutput  = NAN;
+        m_fieldLocked = true;
+    }
+
+    if ( !wasLocked )
+    {
+        m_notifier.get()->StartPeriodic( FIELD_LOCK_PERIOD );
+    }
+    FieldLockUpdate();
+}
+
+/// @brief  turn off the field lock and wait for a field lock update that is already running to finish,
+///         so nothing but the caller drives the motor once this returns
+void Turret::StopFieldLock()
+{
+    if ( m_fieldLocked )
+    {
+        {
+            // FieldLockUpdate holds the mutex while it sends its output
+            lock_guard<mutex> lock( m_mutex );
+            m_fieldLocked = false;
+        }
+        m_notifier.get()->Stop();
+    }
+}
+
+/// @brief  counter-rotate the locked target by how far the chassis has turned since it was set
+void Turret::FieldLockUpdate()
+{
+    lock_guard<mutex> lock( m_mutex );
+    if ( !m_fieldLocked )
+    {
+        return;
+    }
+
+    auto turned = 0.0;
+    if ( m_pigeon != nullptr )
+    {
+        turned = AngleUtils::GetDeltaAngle( units::angle::degree_t( m_lockYaw ), units::angle::degree_t( m_pigeon->GetYaw() ) ).to<double>();
+    }
+
+    auto output = clamp( m_lockTarget - turned, m_minAngle, m_maxAngle );
+    auto motor  = GetMotor();
+    if ( motor.get() != nullptr && !( abs( output - m_lastOutput ) < OUTPUT_THRESHOLD ) )
+    {
+        motor.get()->Set( output );
+        m_lastOutput = output;
+    }
 }
 
 /**
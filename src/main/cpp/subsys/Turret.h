@@ -15,11 +15,15 @@
 #pragma once
 
 // C++ Includes
+#include <atomic>
 #include <memory>
+#include <mutex>
 // FRC includes
+#include <frc/Notifier.h>
 
 // Team 302 includes
 //#include <hw/DragonDigitalInput.h>
+#include <hw/DragonPigeon.h>
 #include <subsys/Mech1IndMotor.h>
 
 // Third Party Includes
@@ -34,9 +38,13 @@ class Turret : public Mech1IndMotor
 
         /// @brief Create the Turret mechanism
         /// @param [in] IDragonMotorController* the motor controller that will run the turret
+        /// @param [in] double minAngle - minimum turret travel (degrees) from the mechanism definition
+        /// @param [in] double maxAngle - maximum turret travel (degrees) from the mechanism definition
         Turret
         (
-            std::shared_ptr<IDragonMotorController>   motorController//,
+            std::shared_ptr<IDragonMotorController>   motorController,
+            double                                    minAngle,
+            double                                    maxAngle//,
 //            std::shared_ptr<DragonDigitalInput>       minTurnSensor,
 //            std::shared_ptr<DragonDigitalInput>       maxTurnSensor
         );
@@ -44,11 +52,62 @@ class Turret : public Mech1IndMotor
         /// @brief Destroy the object and free memory
         ~Turret() override = default;
 
-        /// @brief update the output to the mechanism using the current controller and target value(s)
+        /// @brief update the output to the mechanism using the current controller and target value(s).
+        ///        While the turret is field locked, the field lock loop owns the motor output.
         /// @return void 
-        //void Update() override;
+        void Update() override;
+
+        /// @brief  Set a robot relative target (degrees).  This turns off the field lock.
+        /// @param [in] double - target angle in degrees
+        /// @return void
+        void UpdateTarget
+        (
+            double      target
+        ) override;
+
+        /// @brief  Set the control constants (e.g. PIDF values).  This turns off the field lock first so
+        ///         the field lock loop can't send a target in the old control mode.
+        /// @param [in] int          slot: the PID slot
+        /// @param [in] ControlData* pid:  the control constants
+        /// @return void
+        void SetControlConstants
+        (
+            int                                         slot,
+            ControlData*                                pid
+        ) override;
+
+        /// @brief  Aim at a robot relative angle (degrees) and keep pointing in that direction on the field
+        ///         as the chassis rotates.  The target is counter-rotated by the pigeon yaw at 200 Hz, between
+        ///         calls, until a new target is set or UpdateTarget is called.
+        /// @param [in] double - target angle in degrees
+        /// @return void
+        void SetFieldLockedTarget
+        (
+            double      target
+        );
+
+        /// @brief  Indicates whether the field lock loop is running the turret
+        /// @return bool - true if field locked
+        bool IsFieldLocked() const { return m_fieldLocked; }
+
+        double GetMinAngle() const { return m_minAngle; }
+        double GetMaxAngle() const { return m_maxAngle; }
 
     private:
+        void FieldLockUpdate();
+        void StopFieldLock();
+
+        DragonPigeon*                   m_pigeon;
+        std::mutex                      m_mutex;
+        std::atomic<bool>               m_fieldLocked;
+        double                          m_lockTarget;       // robot relative target when the lock was set
+        double                          m_lockYaw;          // chassis yaw when the lock was set
+        double                          m_lastOutput;
+        double                          m_minAngle;
+        double                          m_maxAngle;
+        // last, so it is destroyed (stopping the field lock callback) before the state the callback uses
+        std::unique_ptr<frc::Notifier>  m_notifier;
+
 //        std::shared_ptr<DragonDigitalInput>             m_min;
 //        std::shared_ptr<DragonDigitalInput>             m_max;
 };
@@ -46,20 +46,61 @@
 //====================================================================================================================================================
 
 // C++ Includes
+#include <cmath>
 #include <memory>
 
 
 // FRC includes
+#include <frc/geometry/Pose2d.h>
+#include <frc2/Timer.h>
+#include <wpi/math>
 
 // Team 302 includes
 #include <hw/DragonLimelight.h>
 #include <hw/factories/LimeLightFactory.h>
+#include <subsys/MechanismFactory.h>
+#include <subsys/SwerveChassis.h>
+#include <subsys/SwerveChassisFactory.h>
+#include <subsys/Turret.h>
+#include <utils/AngleUtils.h>
 #include <utils/GoalDetection.h>
+#include <utils/Logger.h>
 
 // Third Party Includes
 
 using namespace std;
 
+namespace
+{
+    constexpr double DEGREES_PER_RADIAN     = 180.0 / wpi::math::pi;
+    constexpr double INCHES_PER_METER       = 39.3701;
+
+    // time from the image exposure to the pipeline starting (added to the Limelight's reported latency)
+    constexpr double CAPTURE_LATENCY        = 0.011;    // seconds
+
+    // vision noise (one standard deviation)
+    constexpr double ANGLE_NOISE            = 0.5;      // degrees
+    constexpr double DISTANCE_NOISE         = 2.0;      // inches
+    constexpr double DISTANCE_NOISE_PERCENT = 0.03;     // of the distance
+
+    // odometry drift:  variance added per second and per inch driven
+    constexpr double DRIFT_PER_SECOND       = 1.0;      // inches squared
+    constexpr double DRIFT_PER_INCH         = 0.5;      // inches squared
+
+    // the pose moved more than this in one loop, so it was reset and the goal estimate is meaningless
+    constexpr double MAX_POSE_JUMP          = 24.0;     // inches
+
+    // drop the goal when vision hasn't confirmed it for this long
+    constexpr double MAX_COAST_TIME         = 1.0;      // seconds
+
+    // this many outliers in a row means the estimate is wrong rather than the frames
+    constexpr int    MAX_REJECTED_FIXES     = 3;
+
+    // don't shoot when the goal is less certain than this
+    constexpr double MAX_AIM_SIGMA          = 2.0;      // degrees
+    constexpr double MAX_DISTANCE_SIGMA     = 12.0;     // inches
+}
+
 
 GoalDetection* GoalDetection::m_instance = nullptr;
 GoalDetection* GoalDetection::GetInstance()
@@ -72,24 +113,155 @@ GoalDetection* GoalDetection::GetInstance()
 }
 
 GoalDetection::GoalDetection() : m_camera(LimelightFactory::GetLimelightFactory()->GetLimelight()),
-                                 m_queriesSinceLastSeen(100),
-                                 m_lastHor(360_deg),
-                                 m_lastVert(360_deg),
-                                 m_lastDist(units::length::inch_t(360.0))
+                                 m_chassis(SwerveChassisFactory::GetSwerveChassisFactory()->GetSwerveChassis()),
+                                 m_turret(MechanismFactory::GetMechanismFactory()->GetTurret()),
+                                 m_filter(),
+                                 m_history(),
+                                 m_lastFrameTime(0.0),
+                                 m_lastFixTime(0.0),
+                                 m_rejectedFixes(0),
+                                 m_seen(false),
+                                 m_horizontal(360_deg),
+                                 m_vertical(360_deg),
+                                 m_distance(units::length::inch_t(360.0)),
+                                 m_horizontalSigma(360_deg),
+                                 m_distanceSigma(units::length::inch_t(360.0))
 {
-    m_camera->SetPipeline(1);
+    if ( m_camera != nullptr )
+    {
+        m_camera->SetPipeline(1);
+    }
 }
 
-bool GoalDetection::SeeOuterGoal() const
+/// @brief  Predict the goal with odometry and fuse the latest Limelight frame
+/// @return void
+void GoalDetection::Update()
 {
+    auto now = frc2::Timer::GetFPGATimestamp().to<double>();
+
+    PoseHistory::Sample current{ now, 0.0, 0.0, 0.0, 0.0 };
+    if ( m_chassis.get() != nullptr )
+    {
+        auto pose = m_chassis.get()->GetPose();
+        current.x       = pose.X().to<double>() * INCHES_PER_METER;
+        current.y       = pose.Y().to<double>() * INCHES_PER_METER;
+        current.heading = pose.Rotation().Degrees().to<double>();
+    }
+    current.turret = ( m_turret.get() != nullptr ) ? m_turret.get()->GetPosition() : 0.0;
+
+    // the goal doesn't move, but what we know about it relative to the robot degrades as odometry drifts
+    if ( !m_history.IsEmpty() )
+    {
+        const auto& last = m_history.GetLatest();
+        auto travelled = hypot( current.x - last.x, current.y - last.y );
+        if ( travelled > MAX_POSE_JUMP )
+        {
+            m_filter.Reset();
+            m_history.Reset();
+        }
+        else
+        {
+            m_filter.Predict( DRIFT_PER_SECOND * ( now - last.time ) + DRIFT_PER_INCH * travelled );
+        }
+    }
+    m_history.Add( current );
+
+    if ( m_camera != nullptr )
+    {
+        auto frame = m_camera->GetFrame();
+        if ( frame.timestamp > m_lastFrameTime )
+        {
+            m_lastFrameTime = frame.timestamp;
+            if ( frame.hasTarget )
+            {
+                Correct( frame );
+            }
+        }
+    }
+
+    if ( m_filter.IsInitialized() && ( now - m_lastFixTime ) > MAX_COAST_TIME )
+    {
+        m_filter.Reset();
+    }
+
+    // report the goal as seen from where the robot and turret are now
+    auto dx   = m_filter.GetX() - current.x;
+    auto dy   = m_filter.GetY() - current.y;
+    auto dist = hypot( dx, dy );
+    m_seen = m_filter.IsInitialized() && dist > 1.0;
+    if ( m_seen )
+    {
+        auto ux = dx / dist;
+        auto uy = dy / dist;
+
+        m_horizontal      = AngleUtils::GetEquivAngle( units::angle::degree_t( atan2( dy, dx ) * DEGREES_PER_RADIAN - current.heading - current.turret ) );
+        m_distance        = units::length::inch_t( dist );
+        m_horizontalSigma = units::angle::degree_t( sqrt( m_filter.GetVariance( -uy, ux ) ) / dist * DEGREES_PER_RADIAN );
+        m_distanceSigma   = units::length::inch_t( sqrt( m_filter.GetVariance( ux, uy ) ) );
+
+        if ( m_camera != nullptr )
+        {
+            auto height = ( m_camera->GetTargetHeight() - m_camera->GetMountingHeight() ).to<double>();
+            m_vertical  = units::angle::degree_t( atan2( height, dist ) * DEGREES_PER_RADIAN - m_camera->GetMountingAngle().to<double>() );
+        }
+    }
+
     Logger::GetLogger()->ToNtTable(string("Goal Detection"), string("camera"), m_camera != nullptr ? "true" : "false");
-    Logger::GetLogger()->ToNtTable(string("Goal Detection"), string("target"), m_camera != nullptr ? (m_camera->HasTarget() ? "true" : "false") : "false");
-    
-    auto seen =  (m_camera != nullptr && m_camera->HasTarget() );
-    m_queriesSinceLastSeen = seen ? 0 : m_queriesSinceLastSeen+1;
+    Logger::GetLogger()->ToNtTable(string("Goal Detection"), string("target"), m_seen ? "true" : "false");
+    Logger::GetLogger()->ToNtTable(string("Goal Detection"), string("angle sigma"), m_horizontalSigma.to<double>());
+    Logger::GetLogger()->ToNtTable(string("Goal Detection"), string("distance sigma"), m_distanceSigma.to<double>());
+}
+
+/// @brief  Fuse one Limelight frame, measured from the pose the robot had when the image was taken
+/// @return void
+void GoalDetection::Correct
+(
+    const DragonLimelight::Frame&   frame
+)
+{
+    PoseHistory::Sample pose;
+    auto imageTime = frame.timestamp - frame.tl / 1000.0 - CAPTURE_LATENCY;
+    if ( !m_history.Get( imageTime, pose ) )
+    {
+        return;
+    }
+
+    auto distance = m_camera->EstimateTargetDistance( frame ).to<double>();
+    if ( !( distance > 0.0 ) )
+    {
+        return;
+    }
+    auto rad = ( pose.heading + pose.turret - m_camera->GetTargetHorizontalOffset( frame ).to<double>() ) / DEGREES_PER_RADIAN;
+    auto c   = cos( rad );
+    auto s   = sin( rad );
+
+    // range and bearing noise rotated into field x/y
+    auto radial     = DISTANCE_NOISE + DISTANCE_NOISE_PERCENT * distance;
+    auto tangential = ANGLE_NOISE / DEGREES_PER_RADIAN * distance;
+    auto rr  = radial * radial;
+    auto tt  = tangential * tangential;
+    auto rxx = c * c * rr + s * s * tt;
+    auto rxy = c * s * ( rr - tt );
+    auto ryy = s * s * rr + c * c * tt;
+
+    auto x = pose.x + distance * c;
+    auto y = pose.y + distance * s;
+    if ( !m_filter.Correct( x, y, rxx, rxy, ryy ) )
+    {
+        if ( ++m_rejectedFixes < MAX_REJECTED_FIXES )
+        {
+            return;
+        }
+        m_filter.Reset();
+        m_filter.Correct( x, y, rxx, rxy, ryy );
+    }
+    m_rejectedFixes = 0;
+    m_lastFixTime   = frame.timestamp;
+}
 
-    seen = m_queriesSinceLastSeen < 5 && !seen ? true : seen;
-    return seen;
+bool GoalDetection::SeeOuterGoal() const
+{
+    return m_seen;
 }
 bool GoalDetection::SeeInnerGoal() const
 {
@@ -98,14 +270,7 @@ bool GoalDetection::SeeInnerGoal() const
 
 units::angle::degree_t GoalDetection::GetHorizontalAngleToOuterGoal() const
 {
-    auto seen =  (m_camera != nullptr && m_camera->HasTarget() );
-    auto angle = m_lastHor;
-    if ( seen )
-    {
-        angle = -1.0 * m_camera->GetTargetHorizontalOffset();
-        m_lastHor = angle;
-    }
-    return angle;   
+    return m_horizontal;
 }
 units::angle::degree_t GoalDetection::GetHorizontalAngleToInnerGoal() const
 {
@@ -114,14 +279,7 @@ units::angle::degree_t GoalDetection::GetHorizontalAngleToInnerGoal() const
 
 units::angle::degree_t GoalDetection::GetVerticalAngleToOuterGoal() const
 {
-    auto seen =  (m_camera != nullptr && m_camera->HasTarget() );
-    auto angle = m_lastVert;
-    if ( seen )
-    {
-        angle = m_camera->GetTargetVerticalOffset();
-        m_lastVert = angle;
-    }
-    return angle;   
+    return m_vertical;
 }
 units::angle::degree_t GoalDetection::GetVerticalAngleToInnerGoal() const
 {
@@ -136,17 +294,31 @@ units::angle::degree_t GoalDetection::GetVerticalAngleToInnerGoal() const
 
 units::length::inch_t GoalDetection::GetDistanceToOuterGoal() const
 {
-    auto seen =  (m_camera != nullptr && m_camera->HasTarget() );
-    auto dist = m_lastDist;
-    if ( seen )
-    {
-        dist = m_camera->EstimateTargetDistance();
-        m_lastDist = dist;
-    }
-    return dist;   
+    return m_distance;
 }
 
 units::length::inch_t GoalDetection::GetDistanceToInnerGoal() const
 {
     return GetDistanceToOuterGoal();
 }
+
+/// @brief  One standard deviation of the horizontal angle to the goal
+units::angle::degree_t GoalDetection::GetHorizontalAngleUncertainty() const
+{
+    return m_horizontalSigma;
+}
+
+/// @brief  One standard deviation of the distance to the goal
+units::length::inch_t GoalDetection::GetDistanceUncertainty() const
+{
+    return m_distanceSigma;
+}
+
+/// @brief  Indicates the goal estimate is good enough to shoot at
+/// @return bool - true if the goal is tracked and its uncertainty is small
+bool GoalDetection::IsAimConfident() const
+{
+    return m_seen &&
+           m_horizontalSigma.to<double>() < MAX_AIM_SIGMA &&
+           m_distanceSigma.to<double>() < MAX_DISTANCE_SIGMA;
+}
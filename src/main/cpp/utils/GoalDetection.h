@@ -17,22 +17,45 @@
 #pragma once
 
 // C++ Includes
-
+#include <memory>
 
 // FRC includes
 
 // Team 302 includes
 #include <hw/DragonLimelight.h>
 #include <hw/factories/LimeLightFactory.h>
+#include <utils/GoalFilter.h>
+#include <utils/PoseHistory.h>
 
 // Third Party Includes
 
-
+class SwerveChassis;
+class Turret;
+
+//========================================================================================================
+/// GoalDetection.h
+//========================================================================================================
+///
+/// File Description:
+///     Tracks the power port.  Each Limelight frame is converted to a field position using the
+///     odometry pose and turret angle from when the image was taken and fused into a Kalman filter.
+///     The getters report the goal as seen from the current pose, so the goal bearing is predicted
+///     through vision dropouts while the robot drives.  The filter covariance tells callers how much
+///     to trust the prediction.
+///
+///     Update() must be called once per robot loop after the odometry update; the getters only
+///     return what the last Update() computed.
+///
+//========================================================================================================
 class GoalDetection
 {
     public:
 	    static GoalDetection* GetInstance();
 
+        /// @brief  Predict the goal with odometry and fuse the latest Limelight frame
+        /// @return void
+        void Update();
+
         bool SeeOuterGoal() const;
         bool SeeInnerGoal() const;
 
@@ -45,15 +68,39 @@ class GoalDetection
         units::length::inch_t GetDistanceToOuterGoal() const;
         units::length::inch_t GetDistanceToInnerGoal() const;
 
+        /// @brief  One standard deviation of the horizontal angle to the goal
+        units::angle::degree_t GetHorizontalAngleUncertainty() const;
+
+        /// @brief  One standard deviation of the distance to the goal
+        units::length::inch_t GetDistanceUncertainty() const;
+
+        /// @brief  Indicates the goal estimate is good enough to shoot at
+        /// @return bool - true if the goal is tracked and its uncertainty is small
+        bool IsAimConfident() const;
+
     private:
         static GoalDetection* m_instance;
         GoalDetection();
         ~GoalDetection() = default;
 
-        DragonLimelight*                m_camera;
-        mutable int                     m_queriesSinceLastSeen;
-        mutable units::angle::degree_t  m_lastHor;
-        mutable units::angle::degree_t  m_lastVert;
-        mutable units::length::inch_t   m_lastDist;
-
-};
\ No newline at end of file
+        void Correct
+        (
+            const DragonLimelight::Frame&   frame
+        );
+
+        DragonLimelight*                    m_camera;
+        std::shared_ptr<SwerveChassis>      m_chassis;
+        std::shared_ptr<Turret>             m_turret;
+        GoalFilter                          m_filter;
+        PoseHistory                         m_history;     // inches
+        double                              m_lastFrameTime;
+        double                              m_lastFixTime;
+        int                                 m_rejectedFixes;
+
+        bool                                m_seen;
+        units::angle::degree_t              m_horizontal;
+        units::angle::degree_t              m_vertical;
+        units::length::inch_t               m_distance;
+        units::angle::degree_t              m_horizontalSigma;
+        units::length::inch_t               m_distanceSigma;
+};
@@ -0,0 +1,135 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+
+// FRC includes
+
+// Team 302 includes
+#include <utils/GoalFilter.h>
+
+// Third Party Includes
+
+namespace
+{
+    // squared Mahalanobis distance above which a fix is an outlier (99.9% for 2 degrees of freedom)
+    constexpr double OUTLIER_GATE = 13.8;
+}
+
+GoalFilter::GoalFilter() : m_initialized( false ),
+                           m_x( 0.0 ),
+                           m_y( 0.0 ),
+                           m_pxx( 0.0 ),
+                           m_pxy( 0.0 ),
+                           m_pyy( 0.0 )
+{
+}
+
+/// @brief  Forget the target
+/// @return void
+void GoalFilter::Reset()
+{
+    m_initialized = false;
+}
+
+/// @brief      Grow the covariance by the odometry drift since the last prediction
+/// @param [in] double - variance to add to each axis (inches squared)
+/// @return     void
+void GoalFilter::Predict
+(
+    double      processVariance
+)
+{
+    if ( m_initialized )
+    {
+        m_pxx += processVariance;
+        m_pyy += processVariance;
+    }
+}
+
+/// @brief      Fuse a vision fix.  The first fix seeds the filter.
+/// @return     bool - false if the fix was rejected as an outlier
+bool GoalFilter::Correct
+(
+    double      x,
+    double      y,
+    double      rxx,
+    double      rxy,
+    double      ryy
+)
+{
+    if ( !m_initialized )
+    {
+        m_x   = x;
+        m_y   = y;
+        m_pxx = rxx;
+        m_pxy = rxy;
+        m_pyy = ryy;
+        m_initialized = true;
+        return true;
+    }
+
+    // innovation and its covariance (the measurement is the state, so H is the identity)
+    auto vx  = x - m_x;
+    auto vy  = y - m_y;
+    auto sxx = m_pxx + rxx;
+    auto sxy = m_pxy + rxy;
+    auto syy = m_pyy + ryy;
+    auto det = sxx * syy - sxy * sxy;
+    if ( det <= 0.0 )
+    {
+        return false;
+    }
+    auto ixx =  syy / det;
+    auto ixy = -sxy / det;
+    auto iyy =  sxx / det;
+
+    if ( vx * ( ixx * vx + ixy * vy ) + vy * ( ixy * vx + iyy * vy ) > OUTLIER_GATE )
+    {
+        return false;
+    }
+
+    // gain K = P S^-1
+    auto kxx = m_pxx * ixx + m_pxy * ixy;
+    auto kxy = m_pxx * ixy + m_pxy * iyy;
+    auto kyx = m_pxy * ixx + m_pyy * ixy;
+    auto kyy = m_pxy * ixy + m_pyy * iyy;
+
+    m_x += kxx * vx + kxy * vy;
+    m_y += kyx * vx + kyy * vy;
+
+    // P = (I - K) P, kept symmetric
+    auto pxx = ( 1.0 - kxx ) * m_pxx - kxy * m_pxy;
+    auto pxy = ( 1.0 - kxx ) * m_pxy - kxy * m_pyy;
+    auto pyy = -kyx * m_pxy + ( 1.0 - kyy ) * m_pyy;
+    m_pxx = pxx;
+    m_pxy = pxy;
+    m_pyy = pyy;
+    return true;
+}
+
+/// @brief      Variance of the estimate along a direction
+/// @param [in] double - unit vector x
+/// @param [in] double - unit vector y
+/// @return     double - variance (inches squared)
+double GoalFilter::GetVariance
+(
+    double      ux,
+    double      uy
+) const
+{
+    return ux * ux * m_pxx + 2.0 * ux * uy * m_pxy + uy * uy * m_pyy;
+}
@@ -0,0 +1,100 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+//========================================================================================================
+/// GoalFilter.h
+//========================================================================================================
+///
+/// File Description:
+///     Kalman filter for the field position of one stationary vision target.  The state is the
+///     target's field x/y (inches) and its 2x2 covariance.  The target doesn't move, so prediction
+///     only grows the covariance by the odometry drift; a vision fix (already converted to field
+///     coordinates) shrinks it.  Fixes that are too far from the estimate for its covariance are
+///     rejected so one bad frame can't drag the estimate.
+///
+//========================================================================================================
+class GoalFilter
+{
+    public:
+        GoalFilter();
+        ~GoalFilter() = default;
+
+        /// @brief  Forget the target
+        /// @return void
+        void Reset();
+
+        /// @brief  Indicates the filter has been seeded with a fix
+        /// @return bool - true if there is an estimate
+        bool IsInitialized() const { return m_initialized; }
+
+        /// @brief      Grow the covariance by the odometry drift since the last prediction
+        /// @param [in] double - variance to add to each axis (inches squared)
+        /// @return     void
+        void Predict
+        (
+            double      processVariance
+        );
+
+        /// @brief      Fuse a vision fix.  The first fix seeds the filter.
+        /// @param [in] double - measured target x (inches)
+        /// @param [in] double - measured target y (inches)
+        /// @param [in] double - measurement covariance xx
+        /// @param [in] double - measurement covariance xy
+        /// @param [in] double - measurement covariance yy
+        /// @return     bool - false if the fix was rejected as an outlier
+        bool Correct
+        (
+            double      x,
+            double      y,
+            double      rxx,
+            double      rxy,
+            double      ryy
+        );
+
+        /// @brief  Estimated target field x (inches)
+        double GetX() const { return m_x; }
+
+        /// @brief  Estimated target field y (inches)
+        double GetY() const { return m_y; }
+
+        /// @brief      Variance of the estimate along a direction
+        /// @param [in] double - unit vector x
+        /// @param [in] double - unit vector y
+        /// @return     double - variance (inches squared)
+        double GetVariance
+        (
+            double      ux,
+            double      uy
+        ) const;
+
+    private:
+        bool    m_initialized;
+        double  m_x;
+        double  m_y;
+        double  m_pxx;
+        double  m_pxy;
+        double  m_pyy;
+};
@@ -0,0 +1,92 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+
+// FRC includes
+#include <units/angle.h>
+
+// Team 302 includes
+#include <utils/AngleUtils.h>
+#include <utils/PoseHistory.h>
+
+// Third Party Includes
+
+PoseHistory::PoseHistory() : m_history(),
+                             m_count( 0 ),
+                             m_head( 0 )
+{
+}
+
+/// @brief  Forget every sample (e.g. when the odometry is reset)
+/// @return void
+void PoseHistory::Reset()
+{
+    m_count = 0;
+}
+
+/// @brief      Add the newest sample
+/// @param [in] const Sample& - pose at this loop (times must increase)
+/// @return     void
+void PoseHistory::Add
+(
+    const Sample&       sample
+)
+{
+    m_head = ( m_head + 1 ) % POSE_HISTORY;
+    m_history[m_head] = sample;
+    m_count = ( m_count < POSE_HISTORY ) ? m_count + 1 : POSE_HISTORY;
+}
+
+/// @brief      Interpolate the pose at a time
+/// @return     bool - false if the time is older than the history
+bool PoseHistory::Get
+(
+    double              time,
+    Sample&             sample
+) const
+{
+    if ( m_count == 0 )
+    {
+        return false;
+    }
+
+    auto newer = m_history[m_head];
+    if ( time >= newer.time )
+    {
+        sample = newer;
+        return true;
+    }
+
+    for ( auto inx=1U; inx<m_count; ++inx )
+    {
+        const auto& older = m_history[( m_head + POSE_HISTORY - inx ) % POSE_HISTORY];
+        if ( time >= older.time )
+        {
+            auto span = newer.time - older.time;
+            auto t    = ( span > 0.0 ) ? ( time - older.time ) / span : 0.0;
+            auto turn = AngleUtils::GetEquivAngle( units::angle::degree_t( newer.heading - older.heading ) ).to<double>();
+            sample.time    = time;
+            sample.x       = older.x + t * ( newer.x - older.x );
+            sample.y       = older.y + t * ( newer.y - older.y );
+            sample.heading = older.heading + t * turn;
+            sample.turret  = older.turret + t * ( newer.turret - older.turret );
+            return true;
+        }
+        newer = older;
+    }
+    return false;
+}
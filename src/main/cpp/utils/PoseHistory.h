@@ -0,0 +1,90 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <array>
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+//========================================================================================================
+/// PoseHistory.h
+//========================================================================================================
+///
+/// File Description:
+///     Fixed-size history of the robot pose (and turret angle) from the last POSE_HISTORY loops, so
+///     a camera result can be placed on the field using the pose from when its image was taken
+///     instead of the pose when the result arrived.  Lengths are in whatever unit the caller adds
+///     them in; angles are degrees.  No allocation.
+///
+//========================================================================================================
+class PoseHistory
+{
+    public:
+        /// @brief  Robot pose and turret angle at one loop
+        struct Sample
+        {
+            double  time;       // seconds
+            double  x;
+            double  y;
+            double  heading;    // degrees
+            double  turret;     // degrees
+        };
+
+        static constexpr unsigned int POSE_HISTORY = 32;
+
+        PoseHistory();
+        ~PoseHistory() = default;
+
+        /// @brief  Forget every sample (e.g. when the odometry is reset)
+        /// @return void
+        void Reset();
+
+        /// @brief      Add the newest sample
+        /// @param [in] const Sample& - pose at this loop (times must increase)
+        /// @return     void
+        void Add
+        (
+            const Sample&       sample
+        );
+
+        /// @brief  Indicates there are no samples
+        bool IsEmpty() const { return m_count == 0; }
+
+        /// @brief  Newest sample; only valid when the history isn't empty
+        const Sample& GetLatest() const { return m_history[m_head]; }
+
+        /// @brief      Interpolate the pose at a time.  Times newer than the latest sample get the
+        ///             latest sample.
+        /// @param [in] double - time (seconds)
+        /// @param [out] Sample& - interpolated pose
+        /// @return     bool - false if the time is older than the history
+        bool Get
+        (
+            double              time,
+            Sample&             sample
+        ) const;
+
+    private:
+        std::array<Sample, POSE_HISTORY>    m_history;
+        unsigned int                        m_count;
+        unsigned int                        m_head;
+};
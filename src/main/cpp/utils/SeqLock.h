@@ -0,0 +1,104 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+//========================================================================================================
+/// SeqLock.h
+//========================================================================================================
+///
+/// File Description:
+///     Single writer / many reader sequence lock.  The writer never waits and readers never block
+///     the writer; a reader that overlaps a write simply retries.  Used to hand a complete sensor
+///     frame from a network table listener thread to the robot loop without a mutex.
+///
+///     The value is kept in atomic words so a torn read is detected (and retried) rather than
+///     being a data race.  T must be trivially copyable.
+///
+//========================================================================================================
+template <typename T>
+class SeqLock
+{
+    static_assert( std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable type" );
+
+    public:
+        SeqLock() : m_sequence( 0 )
+        {
+            Write( T() );
+        }
+
+        /// @brief      Publish a new value.  Only one thread may write.
+        /// @param [in] const T& - value to publish
+        /// @return     void
+        void Write
+        (
+            const T&    value
+        )
+        {
+            uint64_t words[WORDS] = {};
+            std::memcpy( words, &value, sizeof( T ) );
+
+            auto seq = m_sequence.load( std::memory_order_relaxed );
+            m_sequence.store( seq + 1, std::memory_order_relaxed );     // odd:  write in progress
+            std::atomic_thread_fence( std::memory_order_release );
+            for ( auto inx=0U; inx<WORDS; ++inx )
+            {
+                m_data[inx].store( words[inx], std::memory_order_relaxed );
+            }
+            m_sequence.store( seq + 2, std::memory_order_release );     // even: value is complete
+        }
+
+        /// @brief  Read a consistent copy of the last published value
+        /// @return T - last published value
+        T Read() const
+        {
+            uint64_t words[WORDS];
+            uint32_t before = 0;
+            uint32_t after  = 0;
+            do
+            {
+                before = m_sequence.load( std::memory_order_acquire );
+                for ( auto inx=0U; inx<WORDS; ++inx )
+                {
+                    words[inx] = m_data[inx].load( std::memory_order_relaxed );
+                }
+                std::atomic_thread_fence( std::memory_order_acquire );
+                after = m_sequence.load( std::memory_order_relaxed );
+            } while ( ( before & 1U ) != 0U || before != after );
+
+            T value;
+            std::memcpy( &value, words, sizeof( T ) );
+            return value;
+        }
+
+    private:
+        static constexpr unsigned int WORDS = ( sizeof( T ) + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t );
+
+        std::atomic<uint32_t>   m_sequence;
+        std::atomic<uint64_t>   m_data[WORDS];
+};
@@ -0,0 +1,180 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+// FRC includes
+#include <frc/kinematics/ChassisSpeeds.h>
+#include <frc2/Timer.h>
+#include <wpi/math>
+
+// Team 302 includes
+#include <hw/DragonPigeon.h>
+#include <hw/factories/PigeonFactory.h>
+#include <subsys/SwerveChassis.h>
+#include <subsys/SwerveChassisFactory.h>
+#include <utils/GoalDetection.h>
+#include <utils/ShotSolver.h>
+
+// Third Party Includes
+
+using namespace std;
+
+namespace
+{
+    constexpr double DEGREES_PER_RADIAN     = 180.0 / wpi::math::pi;
+    constexpr double INCHES_PER_METER       = 39.3701;
+
+    // the turret gets to a new target about one robot loop later, so lead the robot's motion by that much too
+    constexpr double CONTROL_PERIOD         = 0.02;     // seconds
+
+    // ball flight time is modeled as a fixed time to leave the shooter plus the horizontal travel
+    constexpr double BALL_EXIT_TIME         = 0.10;     // seconds
+    constexpr double BALL_HORIZONTAL_SPEED  = 500.0;    // inches per second
+
+    // the virtual goal depends on the flight time, which depends on the distance to the virtual goal; each
+    // iteration shrinks the error by about the robot speed over the ball speed, so iterate until the distance
+    // settles (a few iterations at low speed, about eight at the chassis top speed)
+    constexpr int    MAX_LEAD_ITERATIONS    = 12;
+    constexpr double LEAD_TOLERANCE         = 0.05;     // inches
+
+    // the flywheel velocity loops take about this long to follow a change in target, so lead the shooter
+    // distance by the radial velocity over this time
+    constexpr double FLYWHEEL_RESPONSE_TIME = 0.15;     // seconds
+
+    // solutions older than this aren't used
+    constexpr double MAX_SOLUTION_AGE       = 0.1;      // seconds
+
+    /// @brief  Ball time of flight to a goal at a distance
+    double TimeOfFlight
+    (
+        double      distance
+    )
+    {
+        return BALL_EXIT_TIME + distance / BALL_HORIZONTAL_SPEED;
+    }
+}
+
+ShotSolver* ShotSolver::m_instance = nullptr;
+ShotSolver* ShotSolver::GetInstance()
+{
+    if ( ShotSolver::m_instance == nullptr )
+    {
+        ShotSolver::m_instance = new ShotSolver();
+    }
+    return ShotSolver::m_instance;
+}
+
+ShotSolver::ShotSolver() : m_chassis( SwerveChassisFactory::GetSwerveChassisFactory()->GetSwerveChassis() ),
+                           m_pigeon( PigeonFactory::GetFactory()->GetPigeon() ),
+                           m_turretAngle( 0.0 ),
+                           m_virtualDistance( 0.0 ),
+                           m_radialVelocity( 0.0 ),
+                           m_shooterDistance( 0.0 ),
+                           m_solveTime( -1.0 )
+{
+}
+
+/// @brief      Compute the virtual goal from the current goal detection.  Call only when the goal is seen.
+/// @param [in] double - current turret angle in degrees
+/// @return     void
+void ShotSolver::Solve
+(
+    double      turretAngle
+)
+{
+    auto goal     = GoalDetection::GetInstance();
+    auto bearing  = turretAngle + goal->GetHorizontalAngleToOuterGoal().to<double>();
+    auto distance = goal->GetDistanceToOuterGoal().to<double>();
+    auto yawRate  = ( m_pigeon != nullptr ) ? m_pigeon->GetYawRate() : 0.0;
+
+    auto vx = 0.0;
+    auto vy = 0.0;
+    if ( m_chassis.get() != nullptr )
+    {
+        auto speeds = m_chassis.get()->GetChassisSpeeds();
+        vx = speeds.vx.to<double>() * INCHES_PER_METER;
+        vy = speeds.vy.to<double>() * INCHES_PER_METER;
+    }
+
+    auto solution = Lead( bearing, distance, vx, vy, yawRate );
+    m_turretAngle     = solution.turretAngle;
+    m_virtualDistance = solution.virtualDistance;
+    m_radialVelocity  = solution.radialVelocity;
+    m_shooterDistance = solution.shooterDistance;
+    m_solveTime       = frc2::Timer::GetFPGATimestamp().to<double>();
+}
+
+/// @brief      Lead a goal for the robot's motion
+/// @param [in] double - robot relative bearing to the goal in degrees
+/// @param [in] double - distance to the goal in inches
+/// @param [in] double - robot velocity forward in inches per second
+/// @param [in] double - robot velocity left in inches per second
+/// @param [in] double - yaw rate in degrees per second (counter-clockwise positive)
+/// @return     Solution - virtual goal and shooter distance
+ShotSolver::Solution ShotSolver::Lead
+(
+    double      bearing,
+    double      distance,
+    double      vx,
+    double      vy,
+    double      yawRate
+)
+{
+    // goal detection already reports the goal as of this loop, only the turret lag is left
+    auto latency = CONTROL_PERIOD;
+
+    // the turret lags:  account for the robot turning and moving in the meantime
+    bearing -= yawRate * latency;
+    auto rad = bearing / DEGREES_PER_RADIAN;
+    auto gx  = distance * cos( rad ) - vx * latency;
+    auto gy  = distance * sin( rad ) - vy * latency;
+
+    // the ball keeps the robot's velocity, so aim where the goal would be if it moved the other way
+    auto tx = gx;
+    auto ty = gy;
+    auto virtualDistance = hypot( gx, gy );
+    for ( auto inx=0; inx<MAX_LEAD_ITERATIONS; ++inx )
+    {
+        auto tof = TimeOfFlight( virtualDistance );
+        tx = gx - vx * tof;
+        ty = gy - vy * tof;
+        auto previous = virtualDistance;
+        virtualDistance = hypot( tx, ty );
+        if ( abs( virtualDistance - previous ) < LEAD_TOLERANCE )
+        {
+            break;
+        }
+    }
+
+    // moving along the shot line changes the distance by the radial velocity every second; the wheels get to
+    // a new speed one response time later, so set them for the distance the shot will be at by then
+    Solution solution;
+    solution.radialVelocity  = ( virtualDistance > 0.0 ) ? ( vx * tx + vy * ty ) / virtualDistance : 0.0;
+    solution.shooterDistance = max( virtualDistance - solution.radialVelocity * FLYWHEEL_RESPONSE_TIME, 0.0 );
+    solution.turretAngle     = atan2( ty, tx ) * DEGREES_PER_RADIAN;
+    solution.virtualDistance = virtualDistance;
+    return solution;
+}
+
+/// @brief  Indicates a solution was computed recently enough to use
+/// @return bool - true if the solution is current
+bool ShotSolver::HasSolution() const
+{
+    return m_solveTime >= 0.0 && ( frc2::Timer::GetFPGATimestamp().to<double>() - m_solveTime ) < MAX_SOLUTION_AGE;
+}
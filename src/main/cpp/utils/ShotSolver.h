@@ -0,0 +1,119 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <memory>
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+class DragonPigeon;
+class SwerveChassis;
+
+//========================================================================================================
+/// ShotSolver.h
+//========================================================================================================
+///
+/// File Description:
+///     Shoot on the move.  Combines the tracked goal vector with the chassis velocity and the
+///     pigeon yaw rate to find a virtual goal:  the point to aim at so that the ball, which carries
+///     the robot's velocity for its time of flight, ends up in the real goal.  The turret aims at the
+///     virtual goal.  The shooter speeds come from the distance to it, led by the robot's radial
+///     velocity (along the shot line) over the flywheel response time, because while the robot drives
+///     toward or away from the goal the distance keeps changing as the wheels settle on a new target.
+///
+///     All angles are robot relative in degrees (counter-clockwise positive, 0 is forward) and all
+///     distances are in inches.
+///
+//========================================================================================================
+class ShotSolver
+{
+    public:
+        /// @brief  where to aim and the distance to set the shooter for
+        struct Solution
+        {
+            double  turretAngle;        ///< degrees
+            double  virtualDistance;    ///< inches
+            double  radialVelocity;     ///< inches per second, positive toward the goal
+            double  shooterDistance;    ///< inches
+        };
+
+        static ShotSolver* GetInstance();
+
+        /// @brief      Lead a goal for the robot's motion
+        /// @param [in] double - robot relative bearing to the goal in degrees
+        /// @param [in] double - distance to the goal in inches
+        /// @param [in] double - robot velocity forward in inches per second
+        /// @param [in] double - robot velocity left in inches per second
+        /// @param [in] double - yaw rate in degrees per second (counter-clockwise positive)
+        /// @return     Solution - virtual goal and shooter distance
+        static Solution Lead
+        (
+            double      bearing,
+            double      distance,
+            double      vx,
+            double      vy,
+            double      yawRate
+        );
+
+        /// @brief      Compute the virtual goal from the current goal detection.  Call only when the goal is seen.
+        /// @param [in] double - current turret angle in degrees
+        /// @return     void
+        void Solve
+        (
+            double      turretAngle
+        );
+
+        /// @brief  Indicates a solution was computed recently enough to use
+        /// @return bool - true if the solution is current
+        bool HasSolution() const;
+
+        /// @brief  Turret angle that points at the virtual goal
+        /// @return double - angle in degrees
+        double GetTurretAngle() const { return m_turretAngle; }
+
+        /// @brief  Distance to the virtual goal
+        /// @return double - distance in inches
+        double GetVirtualDistance() const { return m_virtualDistance; }
+
+        /// @brief  Robot velocity along the shot line
+        /// @return double - inches per second, positive toward the goal
+        double GetRadialVelocity() const { return m_radialVelocity; }
+
+        /// @brief  Distance to use for the shooter speeds:  the virtual distance compensated for the
+        ///         radial velocity over the flywheel response time
+        /// @return double - distance in inches
+        double GetShooterDistance() const { return m_shooterDistance; }
+
+    private:
+        ShotSolver();
+        ~ShotSolver() = default;
+
+        static ShotSolver*              m_instance;
+
+        std::shared_ptr<SwerveChassis>  m_chassis;
+        DragonPigeon*                   m_pigeon;
+
+        double                          m_turretAngle;
+        double                          m_virtualDistance;
+        double                          m_radialVelocity;
+        double                          m_shooterDistance;
+        double                          m_solveTime;
+};
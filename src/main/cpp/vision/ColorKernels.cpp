@@ -0,0 +1,491 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <algorithm>
+#include <cstdint>
+
+// FRC includes
+
+// Team 302 includes
+#include <vision/ColorKernels.h>
+
+// Third Party Includes
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define COLOR_KERNELS_NEON
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define COLOR_KERNELS_SSE2
+#elif defined(__arm__)
+// the roboRIO's Cortex-A9 has NEON; build.gradle passes -mfpu=neon for it
+#error "ColorKernels: ARM build without NEON, add -mfpu=neon to the compiler args"
+#endif
+
+using namespace std;
+
+namespace
+{
+    constexpr int VECTOR_PIXELS = 16;
+
+    /// @brief  Reference HSV for one pixel
+    inline void HSVPixel
+    (
+        int         b,
+        int         g,
+        int         r,
+        uint8_t&    hue,
+        uint8_t&    saturation,
+        uint8_t&    value
+    )
+    {
+        auto mx   = max( b, max( g, r ) );
+        auto mn   = min( b, min( g, r ) );
+        auto diff = mx - mn;
+
+        // position around the color wheel in units of diff/60 degrees (0 to 6*diff)
+        int hue60 = 0;
+        if ( mx == r )
+        {
+            hue60 = g - b;
+            hue60 += ( hue60 < 0 ) ? 6 * diff : 0;
+        }
+        else if ( mx == g )
+        {
+            hue60 = b - r + 2 * diff;
+        }
+        else
+        {
+            hue60 = r - g + 4 * diff;
+        }
+
+        auto h = ( diff > 0 ) ? ( 30 * hue60 + diff / 2 ) / diff : 0;
+        hue        = static_cast<uint8_t>( h >= 180 ? h - 180 : h );
+        saturation = static_cast<uint8_t>( ( mx > 0 ) ? ( 255 * diff + mx / 2 ) / mx : 0 );
+        value      = static_cast<uint8_t>( mx );
+    }
+
+    /// @brief  Continue run-length encoding over [from, to)
+    /// @return bool - false once maxRuns runs have been found
+    inline bool ScanRuns
+    (
+        const uint8_t*  mask,
+        int             from,
+        int             to,
+        bool&           inside,
+        int&            start,
+        int16_t*        starts,
+        int16_t*        ends,
+        int&            runs,
+        int             maxRuns
+    )
+    {
+        for ( auto col=from; col<to; ++col )
+        {
+            auto set = mask[col] != 0;
+            if ( set && !inside )
+            {
+                inside = true;
+                start  = col;
+            }
+            else if ( !set && inside )
+            {
+                inside       = false;
+                starts[runs] = static_cast<int16_t>( start );
+                ends[runs]   = static_cast<int16_t>( col );
+                if ( ++runs == maxRuns )
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+#if defined(COLOR_KERNELS_NEON)
+    /// @brief  Exact n / d for 16 bit lanes (d > 0):  reciprocal estimate, then fix the last bit in integer math
+    inline uint16x8_t Divide
+    (
+        uint16x8_t  n,
+        uint16x8_t  d
+    )
+    {
+        uint32x4_t q[2];
+        for ( auto half=0; half<2; ++half )
+        {
+            auto n32 = vmovl_u16( half == 0 ? vget_low_u16( n ) : vget_high_u16( n ) );
+            auto d32 = vmovl_u16( half == 0 ? vget_low_u16( d ) : vget_high_u16( d ) );
+            auto df  = vcvtq_f32_u32( d32 );
+            auto rcp = vrecpeq_f32( df );
+            rcp = vmulq_f32( vrecpsq_f32( df, rcp ), rcp );
+            rcp = vmulq_f32( vrecpsq_f32( df, rcp ), rcp );
+            auto qi  = vcvtq_u32_f32( vmulq_f32( vcvtq_f32_u32( n32 ), rcp ) );
+
+            auto rem = vsubq_s32( vreinterpretq_s32_u32( n32 ), vreinterpretq_s32_u32( vmulq_u32( qi, d32 ) ) );
+            qi = vsubq_u32( qi, vcgeq_s32( rem, vreinterpretq_s32_u32( d32 ) ) );      // remainder too big:  +1
+            qi = vaddq_u32( qi, vcltq_s32( rem, vdupq_n_s32( 0 ) ) );                 // went negative:      -1
+            q[half] = qi;
+        }
+        return vcombine_u16( vmovn_u32( q[0] ), vmovn_u32( q[1] ) );
+    }
+
+    /// @brief  HSV for 8 pixels widened to 16 bits
+    inline void HSV8
+    (
+        uint16x8_t  b,
+        uint16x8_t  g,
+        uint16x8_t  r,
+        uint8x8_t&  hue,
+        uint8x8_t&  saturation,
+        uint8x8_t&  value
+    )
+    {
+        auto mx   = vmaxq_u16( b, vmaxq_u16( g, r ) );
+        auto mn   = vminq_u16( b, vminq_u16( g, r ) );
+        auto diff = vsubq_u16( mx, mn );
+
+        auto sb = vreinterpretq_s16_u16( b );
+        auto sg = vreinterpretq_s16_u16( g );
+        auto sr = vreinterpretq_s16_u16( r );
+        auto sd = vreinterpretq_s16_u16( diff );
+
+        auto hr = vsubq_s16( sg, sb );
+        hr = vaddq_s16( hr, vandq_s16( vreinterpretq_s16_u16( vcltq_s16( hr, vdupq_n_s16( 0 ) ) ), vmulq_n_s16( sd, 6 ) ) );
+        auto hg = vaddq_s16( vsubq_s16( sb, sr ), vshlq_n_s16( sd, 1 ) );
+        auto hb = vaddq_s16( vsubq_s16( sr, sg ), vshlq_n_s16( sd, 2 ) );
+
+        auto hue60 = vbslq_s16( vceqq_u16( mx, r ), hr, vbslq_s16( vceqq_u16( mx, g ), hg, hb ) );
+
+        auto one = vdupq_n_u16( 1 );
+        auto h = Divide( vmlaq_n_u16( vshrq_n_u16( diff, 1 ), vreinterpretq_u16_s16( hue60 ), 30 ), vmaxq_u16( diff, one ) );
+        h = vsubq_u16( h, vandq_u16( vcgeq_u16( h, vdupq_n_u16( 180 ) ), vdupq_n_u16( 180 ) ) );
+        auto s = Divide( vmlaq_n_u16( vshrq_n_u16( mx, 1 ), diff, 255 ), vmaxq_u16( mx, one ) );
+
+        hue        = vmovn_u16( h );
+        saturation = vmovn_u16( s );
+        value      = vmovn_u16( mx );
+    }
+
+    /// @brief  True if every byte of the block is zero (or every byte is non-zero)
+    inline bool AllZero
+    (
+        uint8x16_t  block
+    )
+    {
+        auto m = vorr_u8( vget_low_u8( block ), vget_high_u8( block ) );
+        m = vpmax_u8( m, m );
+        m = vpmax_u8( m, m );
+        m = vpmax_u8( m, m );
+        return vget_lane_u8( m, 0 ) == 0;
+    }
+#elif defined(COLOR_KERNELS_SSE2)
+    /// @brief  Exact n / d for 16 bit lanes (d > 0).  Single precision division is correctly rounded
+    ///         and n < 2^16, so truncating the float quotient gives the exact integer quotient.
+    inline __m128i Divide
+    (
+        __m128i     n,
+        __m128i     d
+    )
+    {
+        auto zero = _mm_setzero_si128();
+        auto qlo  = _mm_cvttps_epi32( _mm_div_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( n, zero ) ),
+                                                  _mm_cvtepi32_ps( _mm_unpacklo_epi16( d, zero ) ) ) );
+        auto qhi  = _mm_cvttps_epi32( _mm_div_ps( _mm_cvtepi32_ps( _mm_unpackhi_epi16( n, zero ) ),
+                                                  _mm_cvtepi32_ps( _mm_unpackhi_epi16( d, zero ) ) ) );
+        return _mm_packs_epi32( qlo, qhi );     // quotients are at most 255
+    }
+
+    inline __m128i Select
+    (
+        __m128i     mask,
+        __m128i     a,
+        __m128i     b
+    )
+    {
+        return _mm_or_si128( _mm_and_si128( mask, a ), _mm_andnot_si128( mask, b ) );
+    }
+
+    /// @brief  HSV for 8 pixels widened to 16 bits
+    inline void HSV8
+    (
+        __m128i     b,
+        __m128i     g,
+        __m128i     r,
+        __m128i&    hue,
+        __m128i&    saturation,
+        __m128i&    value
+    )
+    {
+        auto mx   = _mm_max_epi16( b, _mm_max_epi16( g, r ) );
+        auto mn   = _mm_min_epi16( b, _mm_min_epi16( g, r ) );
+        auto diff = _mm_sub_epi16( mx, mn );
+
+        auto hr = _mm_sub_epi16( g, b );
+        hr = _mm_add_epi16( hr, _mm_and_si128( _mm_cmplt_epi16( hr, _mm_setzero_si128() ), _mm_mullo_epi16( diff, _mm_set1_epi16( 6 ) ) ) );
+        auto hg = _mm_add_epi16( _mm_sub_epi16( b, r ), _mm_slli_epi16( diff, 1 ) );
+        auto hb = _mm_add_epi16( _mm_sub_epi16( r, g ), _mm_slli_epi16( diff, 2 ) );
+
+        auto hue60 = Select( _mm_cmpeq_epi16( mx, r ), hr, Select( _mm_cmpeq_epi16( mx, g ), hg, hb ) );
+
+        auto one = _mm_set1_epi16( 1 );
+        auto h = Divide( _mm_add_epi16( _mm_mullo_epi16( hue60, _mm_set1_epi16( 30 ) ), _mm_srli_epi16( diff, 1 ) ), _mm_max_epi16( diff, one ) );
+        h = _mm_sub_epi16( h, _mm_and_si128( _mm_cmpgt_epi16( h, _mm_set1_epi16( 179 ) ), _mm_set1_epi16( 180 ) ) );
+        auto s = Divide( _mm_add_epi16( _mm_mullo_epi16( diff, _mm_set1_epi16( 255 ) ), _mm_srli_epi16( mx, 1 ) ), _mm_max_epi16( mx, one ) );
+
+        hue        = h;
+        saturation = s;
+        value      = mx;
+    }
+
+    /// @brief  a <= x <= b for unsigned bytes
+    inline __m128i Between
+    (
+        __m128i     x,
+        __m128i     low,
+        __m128i     high
+    )
+    {
+        return _mm_and_si128( _mm_cmpeq_epi8( _mm_max_epu8( x, low ), x ), _mm_cmpeq_epi8( _mm_min_epu8( x, high ), x ) );
+    }
+#endif
+}
+
+/// @brief  Which version of the kernels this build runs
+const char* ColorKernels::GetImplementation()
+{
+#if defined(COLOR_KERNELS_NEON)
+    return "NEON";
+#elif defined(COLOR_KERNELS_SSE2)
+    return "SSE2";
+#else
+    return "reference";
+#endif
+}
+
+/// @brief      Convert interleaved BGR pixels to H, S and V planes
+void ColorKernels::BGRToHSV
+(
+    const uint8_t*  bgr,
+    uint8_t*        hue,
+    uint8_t*        saturation,
+    uint8_t*        value,
+    int             count
+)
+{
+    auto inx = 0;
+#if defined(COLOR_KERNELS_NEON)
+    for ( ; inx + VECTOR_PIXELS <= count; inx += VECTOR_PIXELS )
+    {
+        auto pixels = vld3q_u8( bgr + 3 * inx );
+        uint8x8_t h[2];
+        uint8x8_t s[2];
+        uint8x8_t v[2];
+        HSV8( vmovl_u8( vget_low_u8( pixels.val[0] ) ), vmovl_u8( vget_low_u8( pixels.val[1] ) ), vmovl_u8( vget_low_u8( pixels.val[2] ) ), h[0], s[0], v[0] );
+        HSV8( vmovl_u8( vget_high_u8( pixels.val[0] ) ), vmovl_u8( vget_high_u8( pixels.val[1] ) ), vmovl_u8( vget_high_u8( pixels.val[2] ) ), h[1], s[1], v[1] );
+        vst1q_u8( hue + inx, vcombine_u8( h[0], h[1] ) );
+        vst1q_u8( saturation + inx, vcombine_u8( s[0], s[1] ) );
+        vst1q_u8( value + inx, vcombine_u8( v[0], v[1] ) );
+    }
+#elif defined(COLOR_KERNELS_SSE2)
+    alignas(16) uint8_t planes[3][VECTOR_PIXELS];
+    auto zero = _mm_setzero_si128();
+    for ( ; inx + VECTOR_PIXELS <= count; inx += VECTOR_PIXELS )
+    {
+        // SSE2 has no byte shuffle, so deinterleave through the stack (stays in L1)
+        const auto* pixel = bgr + 3 * inx;
+        for ( auto p=0; p<VECTOR_PIXELS; ++p )
+        {
+            planes[0][p] = pixel[3*p];
+            planes[1][p] = pixel[3*p+1];
+            planes[2][p] = pixel[3*p+2];
+        }
+        auto b = _mm_load_si128( reinterpret_cast<const __m128i*>( planes[0] ) );
+        auto g = _mm_load_si128( reinterpret_cast<const __m128i*>( planes[1] ) );
+        auto r = _mm_load_si128( reinterpret_cast<const __m128i*>( planes[2] ) );
+
+        __m128i h[2];
+        __m128i s[2];
+        __m128i v[2];
+        HSV8( _mm_unpacklo_epi8( b, zero ), _mm_unpacklo_epi8( g, zero ), _mm_unpacklo_epi8( r, zero ), h[0], s[0], v[0] );
+        HSV8( _mm_unpackhi_epi8( b, zero ), _mm_unpackhi_epi8( g, zero ), _mm_unpackhi_epi8( r, zero ), h[1], s[1], v[1] );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( hue + inx ), _mm_packus_epi16( h[0], h[1] ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( saturation + inx ), _mm_packus_epi16( s[0], s[1] ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( value + inx ), _mm_packus_epi16( v[0], v[1] ) );
+    }
+#endif
+    BGRToHSVReference( bgr + 3 * inx, hue + inx, saturation + inx, value + inx, count - inx );
+}
+
+/// @brief      Set the mask to 255 where every channel is inside its range, 0 elsewhere
+void ColorKernels::InRange
+(
+    const uint8_t*  hue,
+    const uint8_t*  saturation,
+    const uint8_t*  value,
+    const uint8_t*  low,
+    const uint8_t*  high,
+    uint8_t*        mask,
+    int             count
+)
+{
+    auto inx = 0;
+#if defined(COLOR_KERNELS_NEON)
+    auto hLow  = vdupq_n_u8( low[0] );
+    auto sLow  = vdupq_n_u8( low[1] );
+    auto vLow  = vdupq_n_u8( low[2] );
+    auto hHigh = vdupq_n_u8( high[0] );
+    auto sHigh = vdupq_n_u8( high[1] );
+    auto vHigh = vdupq_n_u8( high[2] );
+    for ( ; inx + VECTOR_PIXELS <= count; inx += VECTOR_PIXELS )
+    {
+        auto h = vld1q_u8( hue + inx );
+        auto s = vld1q_u8( saturation + inx );
+        auto v = vld1q_u8( value + inx );
+        auto m = vandq_u8( vcgeq_u8( h, hLow ), vcleq_u8( h, hHigh ) );
+        m = vandq_u8( m, vandq_u8( vcgeq_u8( s, sLow ), vcleq_u8( s, sHigh ) ) );
+        m = vandq_u8( m, vandq_u8( vcgeq_u8( v, vLow ), vcleq_u8( v, vHigh ) ) );
+        vst1q_u8( mask + inx, m );
+    }
+#elif defined(COLOR_KERNELS_SSE2)
+    auto hLow  = _mm_set1_epi8( static_cast<char>( low[0] ) );
+    auto sLow  = _mm_set1_epi8( static_cast<char>( low[1] ) );
+    auto vLow  = _mm_set1_epi8( static_cast<char>( low[2] ) );
+    auto hHigh = _mm_set1_epi8( static_cast<char>( high[0] ) );
+    auto sHigh = _mm_set1_epi8( static_cast<char>( high[1] ) );
+    auto vHigh = _mm_set1_epi8( static_cast<char>( high[2] ) );
+    for ( ; inx + VECTOR_PIXELS <= count; inx += VECTOR_PIXELS )
+    {
+        auto h = _mm_loadu_si128( reinterpret_cast<const __m128i*>( hue + inx ) );
+        auto s = _mm_loadu_si128( reinterpret_cast<const __m128i*>( saturation + inx ) );
+        auto v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( value + inx ) );
+        auto m = _mm_and_si128( Between( h, hLow, hHigh ), _mm_and_si128( Between( s, sLow, sHigh ), Between( v, vLow, vHigh ) ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( mask + inx ), m );
+    }
+#endif
+    InRangeReference( hue + inx, saturation + inx, value + inx, low, high, mask + inx, count - inx );
+}
+
+/// @brief      Run-length encode the set pixels of a mask row.  Blocks that are entirely inside or
+///             entirely outside the current run are skipped 16 pixels at a time.
+int ColorKernels::FindRuns
+(
+    const uint8_t*  mask,
+    int             count,
+    int16_t*        starts,
+    int16_t*        ends,
+    int             maxRuns
+)
+{
+    if ( maxRuns <= 0 )
+    {
+        return 0;
+    }
+
+    auto inside = false;
+    auto start  = 0;
+    auto runs   = 0;
+    auto inx    = 0;
+#if defined(COLOR_KERNELS_NEON) || defined(COLOR_KERNELS_SSE2)
+    for ( ; inx + VECTOR_PIXELS <= count; inx += VECTOR_PIXELS )
+    {
+#if defined(COLOR_KERNELS_NEON)
+        auto block   = vld1q_u8( mask + inx );
+        auto allZero = AllZero( block );
+        auto allSet  = AllZero( vceqq_u8( block, vdupq_n_u8( 0 ) ) );
+#else
+        auto zeros   = _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>( mask + inx ) ), _mm_setzero_si128() ) );
+        auto allZero = zeros == 0xFFFF;
+        auto allSet  = zeros == 0;
+#endif
+        if ( ( inside && allSet ) || ( !inside && allZero ) )
+        {
+            continue;
+        }
+        if ( !ScanRuns( mask, inx, inx + VECTOR_PIXELS, inside, start, starts, ends, runs, maxRuns ) )
+        {
+            return runs;
+        }
+    }
+#endif
+    if ( ScanRuns( mask, inx, count, inside, start, starts, ends, runs, maxRuns ) && inside )
+    {
+        starts[runs] = static_cast<int16_t>( start );
+        ends[runs]   = static_cast<int16_t>( count );
+        ++runs;
+    }
+    return runs;
+}
+
+void ColorKernels::BGRToHSVReference
+(
+    const uint8_t*  bgr,
+    uint8_t*        hue,
+    uint8_t*        saturation,
+    uint8_t*        value,
+    int             count
+)
+{
+    for ( auto inx=0; inx<count; ++inx )
+    {
+        HSVPixel( bgr[3*inx], bgr[3*inx+1], bgr[3*inx+2], hue[inx], saturation[inx], value[inx] );
+    }
+}
+
+void ColorKernels::InRangeReference
+(
+    const uint8_t*  hue,
+    const uint8_t*  saturation,
+    const uint8_t*  value,
+    const uint8_t*  low,
+    const uint8_t*  high,
+    uint8_t*        mask,
+    int             count
+)
+{
+    for ( auto inx=0; inx<count; ++inx )
+    {
+        auto in = hue[inx] >= low[0] && hue[inx] <= high[0] &&
+                  saturation[inx] >= low[1] && saturation[inx] <= high[1] &&
+                  value[inx] >= low[2] && value[inx] <= high[2];
+        mask[inx] = in ? 255 : 0;
+    }
+}
+
+int ColorKernels::FindRunsReference
+(
+    const uint8_t*  mask,
+    int             count,
+    int16_t*        starts,
+    int16_t*        ends,
+    int             maxRuns
+)
+{
+    if ( maxRuns <= 0 )
+    {
+        return 0;
+    }
+
+    auto inside = false;
+    auto start  = 0;
+    auto runs   = 0;
+    if ( ScanRuns( mask, 0, count, inside, start, starts, ends, runs, maxRuns ) && inside )
+    {
+        starts[runs] = static_cast<int16_t>( start );
+        ends[runs]   = static_cast<int16_t>( count );
+        ++runs;
+    }
+    return runs;
+}
@@ -0,0 +1,135 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <cstdint>
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+//========================================================================================================
+/// ColorKernels.h
+//========================================================================================================
+///
+/// File Description:
+///     Per-pixel kernels for color segmentation, one image row at a time.  Each kernel has a
+///     scalar reference version and a vectorized version (NEON on the roboRIO, SSE2 on x86) that
+///     produces exactly the same bytes; builds without either fall back to the reference.
+///
+///     HSV uses the OpenCV 8-bit ranges (H 0-179, S and V 0-255) and is written as three planes
+///     so the threshold step can compare whole vectors of one channel.
+///
+///         V = max(b,g,r)
+///         S = round( 255 * (V - min) / V )
+///         H = round( 30 * hue60 / (V - min) ), where hue60 is 0 - 6*(V - min) around the color wheel
+///
+//========================================================================================================
+class ColorKernels
+{
+    public:
+        /// @brief  Which version of the kernels this build runs
+        /// @return const char* - "NEON", "SSE2" or "reference"
+        static const char* GetImplementation();
+
+        /// @brief      Convert interleaved BGR pixels to H, S and V planes
+        /// @param [in] const uint8_t* - BGR pixels (3 * count bytes)
+        /// @param [out] uint8_t*      - hue plane (count bytes)
+        /// @param [out] uint8_t*      - saturation plane (count bytes)
+        /// @param [out] uint8_t*      - value plane (count bytes)
+        /// @param [in] int            - number of pixels
+        /// @return     void
+        static void BGRToHSV
+        (
+            const uint8_t*  bgr,
+            uint8_t*        hue,
+            uint8_t*        saturation,
+            uint8_t*        value,
+            int             count
+        );
+
+        /// @brief      Set the mask to 255 where every channel is inside its range, 0 elsewhere
+        /// @param [in] const uint8_t* - hue, saturation and value planes
+        /// @param [in] const uint8_t* - inclusive lower bounds (H, S, V)
+        /// @param [in] const uint8_t* - inclusive upper bounds (H, S, V)
+        /// @param [out] uint8_t*      - mask (count bytes)
+        /// @param [in] int            - number of pixels
+        /// @return     void
+        static void InRange
+        (
+            const uint8_t*  hue,
+            const uint8_t*  saturation,
+            const uint8_t*  value,
+            const uint8_t*  low,
+            const uint8_t*  high,
+            uint8_t*        mask,
+            int             count
+        );
+
+        /// @brief      Run-length encode the set pixels of a mask row
+        /// @param [in] const uint8_t* - mask (0 or 255 per pixel)
+        /// @param [in] int            - number of pixels
+        /// @param [out] int16_t*      - first column of each run
+        /// @param [out] int16_t*      - one past the last column of each run
+        /// @param [in] int            - maximum number of runs to return
+        /// @return     int - number of runs
+        static int FindRuns
+        (
+            const uint8_t*  mask,
+            int             count,
+            int16_t*        starts,
+            int16_t*        ends,
+            int             maxRuns
+        );
+
+        // scalar reference versions (the vectorized versions must match these exactly)
+        static void BGRToHSVReference
+        (
+            const uint8_t*  bgr,
+            uint8_t*        hue,
+            uint8_t*        saturation,
+            uint8_t*        value,
+            int             count
+        );
+
+        static void InRangeReference
+        (
+            const uint8_t*  hue,
+            const uint8_t*  saturation,
+            const uint8_t*  value,
+            const uint8_t*  low,
+            const uint8_t*  high,
+            uint8_t*        mask,
+            int             count
+        );
+
+        static int FindRunsReference
+        (
+            const uint8_t*  mask,
+            int             count,
+            int16_t*        starts,
+            int16_t*        ends,
+            int             maxRuns
+        );
+
+    private:
+        ColorKernels() = delete;
+        ~ColorKernels() = delete;
+};
@@ -0,0 +1,248 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <cmath>
+
+// FRC includes
+
+// Team 302 includes
+#include <vision/ColorKernels.h>
+#include <vision/PowerCellPipeline.h>
+
+// Third Party Includes
+#include <opencv2/imgproc/imgproc.hpp>
+
+using namespace std;
+
+namespace
+{
+    constexpr double DEGREES_PER_RADIAN = 57.2957795131;
+
+    // power cell yellow (hue is 0-179)
+    constexpr uint8_t HUE_MIN           = 20;
+    constexpr uint8_t HUE_MAX           = 35;
+    constexpr uint8_t SATURATION_MIN    = 120;
+    constexpr uint8_t VALUE_MIN         = 80;
+
+    constexpr double BALL_DIAMETER      = 0.178;    // meters
+
+    // blobs that can't be a power cell
+    constexpr int    MIN_AREA           = 20;       // pixels
+    constexpr double MIN_ASPECT         = 0.5;      // width / height
+    constexpr double MAX_ASPECT         = 2.0;
+    constexpr double MIN_FILL           = 0.5;      // area / bounding box (a circle is 0.785)
+}
+
+/// @brief      Create the pipeline and allocate its buffers
+/// @param [in] int    - image width in pixels
+/// @param [in] int    - image height in pixels
+/// @param [in] double - camera horizontal field of view in degrees
+PowerCellPipeline::PowerCellPipeline
+(
+    int         width,
+    int         height,
+    double      horizontalFOV
+) : m_width( width ),
+    m_height( height ),
+    m_focalLength( ( width / 2.0 ) / tan( horizontalFOV / 2.0 / DEGREES_PER_RADIAN ) ),
+    m_low{ HUE_MIN, SATURATION_MIN, VALUE_MIN },
+    m_high{ HUE_MAX, 255, 255 },
+    m_resized( height, width, CV_8UC3 ),
+    m_mask( height, width, CV_8UC1 ),
+    m_hue( width ),
+    m_saturation( width ),
+    m_value( width ),
+    m_runStarts( width / 2 + 1 ),
+    m_runEnds( width / 2 + 1 ),
+    m_runs(),
+    m_rowStart( height + 1, 0 ),
+    m_blobs(),
+    m_cells(),
+    m_cellCount( 0 )
+{
+    m_runs.reserve( MAX_RUNS );
+    m_blobs.reserve( MAX_BLOBS );
+}
+
+/// @brief      Find the power cells in an image
+/// @param [in] const cv::Mat& - BGR image (resized if it isn't the pipeline size)
+/// @return     unsigned int - number of power cells found
+unsigned int PowerCellPipeline::Process
+(
+    const cv::Mat&  image
+)
+{
+    const cv::Mat* bgr = &image;
+    if ( image.cols != m_width || image.rows != m_height )
+    {
+        cv::resize( image, m_resized, m_resized.size() );
+        bgr = &m_resized;
+    }
+
+    FindRuns( *bgr );
+    JoinRuns();
+    FindPowerCells();
+    return m_cellCount;
+}
+
+/// @brief  Threshold each row and collect its runs of set pixels
+void PowerCellPipeline::FindRuns
+(
+    const cv::Mat&  bgr
+)
+{
+    m_runs.clear();
+    for ( auto row=0; row<m_height; ++row )
+    {
+        m_rowStart[row] = static_cast<int>( m_runs.size() );
+
+        auto* mask = m_mask.ptr<uint8_t>( row );
+        ColorKernels::BGRToHSV( bgr.ptr<uint8_t>( row ), m_hue.data(), m_saturation.data(), m_value.data(), m_width );
+        ColorKernels::InRange( m_hue.data(), m_saturation.data(), m_value.data(), m_low, m_high, mask, m_width );
+
+        auto room  = static_cast<int>( MAX_RUNS - m_runs.size() );
+        auto count = ColorKernels::FindRuns( mask, m_width, m_runStarts.data(), m_runEnds.data(), min( room, static_cast<int>( m_runStarts.size() ) ) );
+        for ( auto inx=0; inx<count; ++inx )
+        {
+            auto run = static_cast<int32_t>( m_runs.size() );
+            m_runs.push_back( Run{ static_cast<int16_t>( row ), m_runStarts[inx], m_runEnds[inx], run, -1 } );
+        }
+    }
+    m_rowStart[m_height] = static_cast<int>( m_runs.size() );
+}
+
+/// @brief  Join runs that touch the run above them into blobs
+void PowerCellPipeline::JoinRuns()
+{
+    for ( auto row=1; row<m_height; ++row )
+    {
+        auto above    = m_rowStart[row-1];
+        auto aboveEnd = m_rowStart[row];
+        auto current  = m_rowStart[row];
+        auto end      = m_rowStart[row+1];
+        while ( above < aboveEnd && current < end )
+        {
+            const auto& a = m_runs[above];
+            const auto& c = m_runs[current];
+            if ( a.start < c.end && c.start < a.end )
+            {
+                auto rootA = FindRoot( above );
+                auto rootC = FindRoot( current );
+                if ( rootA < rootC )
+                {
+                    m_runs[rootC].parent = rootA;
+                }
+                else if ( rootC < rootA )
+                {
+                    m_runs[rootA].parent = rootC;
+                }
+            }
+
+            // step past whichever run ends first
+            if ( a.end < c.end )
+            {
+                ++above;
+            }
+            else
+            {
+                ++current;
+            }
+        }
+    }
+
+    // a root is always the lowest index in its set, so it is visited before the rest of its blob
+    m_blobs.clear();
+    auto count = static_cast<int>( m_runs.size() );
+    for ( auto inx=0; inx<count; ++inx )
+    {
+        auto& run  = m_runs[inx];
+        auto  root = FindRoot( inx );
+        if ( root == inx )
+        {
+            run.blob = -1;
+            if ( m_blobs.size() < MAX_BLOBS )
+            {
+                run.blob = static_cast<int32_t>( m_blobs.size() );
+                m_blobs.push_back( Blob{ run.start, run.end - 1, run.row, run.row, 0 } );
+            }
+        }
+
+        auto blob = m_runs[root].blob;
+        if ( blob >= 0 )
+        {
+            auto& b = m_blobs[blob];
+            b.minX  = min( b.minX, static_cast<int>( run.start ) );
+            b.maxX  = max( b.maxX, run.end - 1 );
+            b.maxY  = max( b.maxY, static_cast<int>( run.row ) );
+            b.area += run.end - run.start;
+        }
+    }
+}
+
+/// @brief  Union-find root with path halving
+int PowerCellPipeline::FindRoot
+(
+    int         run
+)
+{
+    while ( m_runs[run].parent != run )
+    {
+        m_runs[run].parent = m_runs[m_runs[run].parent].parent;
+        run = m_runs[run].parent;
+    }
+    return run;
+}
+
+/// @brief  Keep the blobs shaped like a power cell, nearest first
+void PowerCellPipeline::FindPowerCells()
+{
+    m_cellCount = 0;
+    for ( const auto& blob : m_blobs )
+    {
+        auto width  = blob.maxX - blob.minX + 1;
+        auto height = blob.maxY - blob.minY + 1;
+        auto aspect = static_cast<double>( width ) / height;
+        auto fill   = static_cast<double>( blob.area ) / ( width * height );
+        if ( blob.area < MIN_AREA || aspect < MIN_ASPECT || aspect > MAX_ASPECT || fill < MIN_FILL )
+        {
+            continue;
+        }
+
+        PowerCell cell;
+        cell.centerX  = ( blob.minX + blob.maxX ) / 2;
+        cell.centerY  = ( blob.minY + blob.maxY ) / 2;
+        cell.width    = width;
+        cell.height   = height;
+        cell.bearing  = atan( ( m_width / 2.0 - ( blob.minX + blob.maxX + 1 ) / 2.0 ) / m_focalLength ) * DEGREES_PER_RADIAN;
+        cell.distance = BALL_DIAMETER * m_focalLength / width;
+
+        // insertion sort by distance, dropping the farthest when full
+        auto inx = ( m_cellCount < MAX_CELLS ) ? m_cellCount++ : MAX_CELLS;
+        while ( inx > 0 && m_cells[inx-1].distance > cell.distance )
+        {
+            if ( inx < MAX_CELLS )
+            {
+                m_cells[inx] = m_cells[inx-1];
+            }
+            --inx;
+        }
+        if ( inx < MAX_CELLS )
+        {
+            m_cells[inx] = cell;
+        }
+    }
+}
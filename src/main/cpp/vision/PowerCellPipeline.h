@@ -0,0 +1,144 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+#include <opencv2/core/core.hpp>
+
+//========================================================================================================
+/// PowerCellPipeline.h
+//========================================================================================================
+///
+/// File Description:
+///     Finds power cells in a BGR image:  HSV threshold, row runs of the mask, runs joined into
+///     blobs, blobs filtered by size and shape, then bearing and distance from the blob width.
+///     The per-pixel steps use the vectorized ColorKernels one row at a time, so the HSV row stays
+///     in cache.  Every buffer is sized in the constructor, so processing a frame doesn't touch
+///     the heap.
+///
+///     Only depends on OpenCV so it can be run on the desktop against recorded images.
+///
+//========================================================================================================
+class PowerCellPipeline
+{
+    public:
+        /// @brief  One detected power cell
+        struct PowerCell
+        {
+            double  bearing;    // degrees, counter-clockwise (left of the image center) positive
+            double  distance;   // meters from the camera
+            int     centerX;    // pixels
+            int     centerY;    // pixels
+            int     width;      // pixels
+            int     height;     // pixels
+        };
+
+        static constexpr unsigned int MAX_CELLS = 8;
+        static constexpr unsigned int MAX_RUNS  = 8192;
+        static constexpr unsigned int MAX_BLOBS = 256;
+
+        /// @brief      Create the pipeline and allocate its buffers
+        /// @param [in] int    - image width in pixels
+        /// @param [in] int    - image height in pixels
+        /// @param [in] double - camera horizontal field of view in degrees
+        PowerCellPipeline
+        (
+            int         width,
+            int         height,
+            double      horizontalFOV
+        );
+        PowerCellPipeline() = delete;
+        ~PowerCellPipeline() = default;
+
+        /// @brief      Find the power cells in an image
+        /// @param [in] const cv::Mat& - BGR image (resized if it isn't the pipeline size)
+        /// @return     unsigned int - number of power cells found
+        unsigned int Process
+        (
+            const cv::Mat&  image
+        );
+
+        /// @brief  Power cells from the last Process call, nearest first
+        const std::array<PowerCell, MAX_CELLS>& GetPowerCells() const { return m_cells; }
+        unsigned int GetPowerCellCount() const { return m_cellCount; }
+
+        /// @brief  Threshold mask from the last Process call (for debugging)
+        const cv::Mat& GetMask() const { return m_mask; }
+
+    private:
+        /// @brief  Horizontal run of set mask pixels
+        struct Run
+        {
+            int16_t row;
+            int16_t start;      // first column
+            int16_t end;        // one past the last column
+            int32_t parent;     // union-find parent (always a lower index)
+            int32_t blob;       // blob index, set on the root run
+        };
+
+        /// @brief  Bounding box and area of a set of joined runs
+        struct Blob
+        {
+            int     minX;
+            int     maxX;
+            int     minY;
+            int     maxY;
+            int     area;
+        };
+
+        void FindRuns
+        (
+            const cv::Mat&  bgr
+        );
+        void JoinRuns();
+        void FindPowerCells();
+
+        int FindRoot
+        (
+            int         run
+        );
+
+        int                                 m_width;
+        int                                 m_height;
+        double                              m_focalLength;      // pixels
+        uint8_t                             m_low[3];
+        uint8_t                             m_high[3];
+
+        cv::Mat                             m_resized;
+        cv::Mat                             m_mask;
+        std::vector<uint8_t>                m_hue;              // one row of each HSV plane
+        std::vector<uint8_t>                m_saturation;
+        std::vector<uint8_t>                m_value;
+        std::vector<int16_t>                m_runStarts;        // one row of runs
+        std::vector<int16_t>                m_runEnds;
+
+        std::vector<Run>                    m_runs;
+        std::vector<int>                    m_rowStart;         // index of the first run in each row
+        std::vector<Blob>                   m_blobs;
+
+        std::array<PowerCell, MAX_CELLS>    m_cells;
+        unsigned int                        m_cellCount;
+};
@@ -0,0 +1,234 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// FRC includes
+#include <cameraserver/CameraServer.h>
+#include <frc/RobotBase.h>
+#include <frc2/Timer.h>
+#include <networktables/NetworkTableInstance.h>
+#include <wpi/ArrayRef.h>
+
+// Team 302 includes
+#include <utils/Logger.h>
+#include <vision/ColorKernels.h>
+#include <vision/PowerCellVision.h>
+
+// Third Party Includes
+#include <opencv2/imgcodecs/imgcodecs.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+using namespace std;
+
+namespace
+{
+    constexpr double HORIZONTAL_FOV     = 61.0;     // degrees (Lifecam HD-3000)
+    constexpr double NO_CELL            = 999.9;    // GalacticSearchFinder's "nothing read" value
+
+    // simulation reads the test images instead of the camera (relative to the project directory);
+    // they aren't under src/main/deploy so they don't get deployed to the roboRIO
+    const string     RECORDED_IMAGES    = string( "src/test/cpp/vision/images" );
+}
+
+PowerCellVision* PowerCellVision::m_instance = nullptr;
+PowerCellVision* PowerCellVision::GetInstance()
+{
+    if ( PowerCellVision::m_instance == nullptr )
+    {
+        PowerCellVision::m_instance = new PowerCellVision();
+    }
+    return PowerCellVision::m_instance;
+}
+
+PowerCellVision::PowerCellVision() : m_pipeline( WIDTH, HEIGHT, HORIZONTAL_FOV ),
+                                     m_overlay(),
+                                     m_frame( HEIGHT, WIDTH, CV_8UC3 ),
+                                     m_frameTime( 0.0 ),
+                                     m_fps( 30 ),
+                                     m_useCamera( true ),
+                                     m_camera(),
+                                     m_sink(),
+                                     m_output(),
+                                     m_recorded(),
+                                     m_recordedIndex( 0 ),
+                                     m_angleValues(),
+                                     m_distanceValues(),
+                                     m_detections(),
+                                     m_running( false ),
+                                     m_thread()
+{
+    auto table = nt::NetworkTableInstance::GetDefault().GetTable( "visionTable" );
+    m_nearestAngle    = table->GetEntry( "NearestCellHorizontalAngle" );
+    m_nearestDistance = table->GetEntry( "NearestCellDistance" );
+    m_angles          = table->GetEntry( "CellHorizontalAngles" );
+    m_distances       = table->GetEntry( "CellDistances" );
+}
+
+PowerCellVision::~PowerCellVision()
+{
+    Stop();
+}
+
+/// @brief  Open the frame source and start the vision thread
+/// @param [in] int - USB camera id
+/// @param [in] int - frames per second
+/// @return void
+void PowerCellVision::Start
+(
+    int     cameraID,
+    int     fps
+)
+{
+    if ( m_running )
+    {
+        return;
+    }
+
+    m_fps       = ( fps > 0 ) ? fps : 30;
+    m_useCamera = frc::RobotBase::IsReal();
+    if ( m_useCamera )
+    {
+        m_camera = frc::CameraServer::GetInstance()->StartAutomaticCapture( cameraID );
+        m_camera.SetResolution( WIDTH, HEIGHT );
+        m_camera.SetFPS( m_fps );
+        m_sink   = frc::CameraServer::GetInstance()->GetVideo( m_camera );
+        m_output = frc::CameraServer::GetInstance()->PutVideo( "Power Cells", WIDTH, HEIGHT );
+    }
+    else
+    {
+        // load the recorded images up front so the loop doesn't read files
+        vector<cv::String> files;
+        vector<cv::String> pngFiles;
+        cv::glob( RECORDED_IMAGES + "/*.jpg", files, false );
+        cv::glob( RECORDED_IMAGES + "/*.png", pngFiles, false );
+        files.insert( files.end(), pngFiles.begin(), pngFiles.end() );
+        m_recorded.clear();
+        for ( const auto& file : files )
+        {
+            auto image = cv::imread( file, cv::IMREAD_COLOR );
+            if ( !image.empty() )
+            {
+                cv::Mat resized( HEIGHT, WIDTH, CV_8UC3 );
+                cv::resize( image, resized, resized.size() );
+                m_recorded.emplace_back( resized );
+            }
+        }
+        if ( m_recorded.empty() )
+        {
+            Logger::GetLogger()->LogError( string( "PowerCellVision::Start" ), string( "no recorded images in " ) + RECORDED_IMAGES );
+            return;
+        }
+        m_recordedIndex = 0;
+    }
+
+    Logger::GetLogger()->ToNtTable( string( "PowerCellVision" ), string( "kernels" ), string( ColorKernels::GetImplementation() ) );
+
+    m_running = true;
+    m_thread  = thread( &PowerCellVision::Run, this );
+}
+
+/// @brief  Stop the vision thread and wait for it to finish
+/// @return void
+void PowerCellVision::Stop()
+{
+    m_running = false;
+    if ( m_thread.joinable() )
+    {
+        m_thread.join();
+    }
+}
+
+/// @brief  Vision thread:  grab, process and publish until stopped
+void PowerCellVision::Run()
+{
+    auto width  = WIDTH;
+    auto height = HEIGHT;
+    while ( m_running )
+    {
+        if ( !GrabFrame() )
+        {
+            continue;
+        }
+
+        auto count = m_pipeline.Process( m_frame );
+        Publish();
+
+        if ( m_useCamera )
+        {
+            const auto& cells = m_pipeline.GetPowerCells();
+            for ( auto inx=0U; inx<count; ++inx )
+            {
+                cv::Rect box( cells[inx].centerX - cells[inx].width / 2, cells[inx].centerY - cells[inx].height / 2, cells[inx].width, cells[inx].height );
+                cv::rectangle( m_frame, box, cv::Scalar( 0, 255, 0 ), 2 );
+            }
+            m_overlay.showCross( m_frame, width, height );
+            m_output.PutFrame( m_frame );
+        }
+    }
+}
+
+/// @brief  Copy the next frame into the frame buffer
+/// @return bool - false if no frame was available
+bool PowerCellVision::GrabFrame()
+{
+    if ( m_useCamera )
+    {
+        // blocks until the next frame (or the timeout); reuses the buffer since the size doesn't change
+        auto time = m_sink.GrabFrame( m_frame );
+        if ( time == 0 )
+        {
+            Logger::GetLogger()->LogError( string( "PowerCellVision::GrabFrame" ), m_sink.GetError() );
+            return false;
+        }
+        m_frameTime = time / 1000000.0;     // microseconds on the FPGA clock
+        return true;
+    }
+
+    // recorded images play back at the camera frame rate
+    this_thread::sleep_for( chrono::milliseconds( 1000 / m_fps ) );
+    m_recorded[m_recordedIndex].copyTo( m_frame );
+    m_recordedIndex = ( m_recordedIndex + 1 ) % m_recorded.size();
+    m_frameTime = frc2::Timer::GetFPGATimestamp().to<double>();
+    return true;
+}
+
+/// @brief  Publish the power cells, nearest first
+void PowerCellVision::Publish()
+{
+    const auto& cells = m_pipeline.GetPowerCells();
+    auto count = m_pipeline.GetPowerCellCount();
+
+    Detections detections{};
+    detections.timestamp = m_frameTime;
+    detections.count     = count;
+    for ( auto inx=0U; inx<count; ++inx )
+    {
+        m_angleValues[inx]    = cells[inx].bearing;
+        m_distanceValues[inx] = cells[inx].distance;
+        detections.cells[inx] = cells[inx];
+    }
+    m_detections.Write( detections );
+
+    m_nearestAngle.SetDouble( count > 0 ? cells[0].bearing : NO_CELL );
+    m_nearestDistance.SetDouble( count > 0 ? cells[0].distance : NO_CELL );
+    m_angles.SetDoubleArray( wpi::ArrayRef<double>( m_angleValues.data(), count ) );
+    m_distances.SetDoubleArray( wpi::ArrayRef<double>( m_distanceValues.data(), count ) );
+}
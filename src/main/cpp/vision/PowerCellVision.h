@@ -0,0 +1,119 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// FRC includes
+#include <cameraserver/CameraServer.h>
+#include <networktables/NetworkTableEntry.h>
+
+// Team 302 includes
+#include <hw/DragonVision.h>
+#include <utils/SeqLock.h>
+#include <vision/PowerCellPipeline.h>
+
+// Third Party Includes
+#include <opencv2/core/core.hpp>
+
+//========================================================================================================
+/// PowerCellVision.h
+//========================================================================================================
+///
+/// File Description:
+///     Runs the power cell pipeline on its own thread.  It only runs when robot.xml has a camera
+///     with usage="POWER_CELLS".  On the robot the frames come from that USB camera (320x240 at the
+///     camera's fps); in simulation they come from the rendered test images in
+///     src/test/cpp/vision/images, so the pipeline can be checked on the desktop.  Results are published
+///     to "visionTable" with the keys GalacticSearchFinder reads, so galactic search no longer
+///     needs a coprocessor, and handed to the robot loop with the frame time through a seqlock.
+///
+//========================================================================================================
+class PowerCellVision
+{
+    public:
+        /// @brief  Power cells from one frame
+        struct Detections
+        {
+            double                          timestamp;      // FPGA time the image was captured (seconds)
+            unsigned int                    count;
+            PowerCellPipeline::PowerCell    cells[PowerCellPipeline::MAX_CELLS];
+        };
+
+        static PowerCellVision* GetInstance();
+
+        /// @brief  Latest detections (O(1), safe to call from the robot loop)
+        Detections GetDetections() const { return m_detections.Read(); }
+
+        /// @brief  Open the frame source and start the vision thread
+        /// @param [in] int - USB camera id
+        /// @param [in] int - frames per second
+        /// @return void
+        void Start
+        (
+            int     cameraID,
+            int     fps
+        );
+
+        /// @brief  Stop the vision thread and wait for it to finish
+        /// @return void
+        void Stop();
+
+    private:
+        PowerCellVision();
+        ~PowerCellVision();
+
+        void Run();
+
+        bool GrabFrame();
+
+        void Publish();
+
+        static PowerCellVision*     m_instance;
+
+        static constexpr int        WIDTH   = 320;
+        static constexpr int        HEIGHT  = 240;
+
+        PowerCellPipeline           m_pipeline;
+        DragonVision                m_overlay;
+        cv::Mat                     m_frame;
+        double                      m_frameTime;
+        int                         m_fps;
+
+        bool                        m_useCamera;
+        cs::UsbCamera               m_camera;
+        cs::CvSink                  m_sink;
+        cs::CvSource                m_output;
+        std::vector<cv::Mat>        m_recorded;
+        unsigned int                m_recordedIndex;
+
+        nt::NetworkTableEntry       m_nearestAngle;
+        nt::NetworkTableEntry       m_nearestDistance;
+        nt::NetworkTableEntry       m_angles;
+        nt::NetworkTableEntry       m_distances;
+        std::array<double, PowerCellPipeline::MAX_CELLS>   m_angleValues;
+        std::array<double, PowerCellPipeline::MAX_CELLS>   m_distanceValues;
+        SeqLock<Detections>         m_detections;
+
+        std::atomic<bool>           m_running;
+        std::thread                 m_thread;
+};
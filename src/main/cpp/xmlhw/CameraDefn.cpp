@@ -31,6 +31,7 @@
 
 // Team302 includes
 #include <utils/Logger.h>
+#include <vision/PowerCellVision.h>
 #include <xmlhw/CameraDefn.h>
 
 // Third Party includes
@@ -63,13 +64,14 @@ cs::UsbCamera CameraDefn::ParseXML
 	int 					  width = 640;
 	int 				     height = 480;
 	int 				        fps = 30;
+	bool				 powerCells = false;
 
 	// todo: integrate the DragonCamera + separate thread logic from Destination Deep Space
 
 	//Parse/validate xml
 	for(pugi::xml_attribute attr = cameraNode.first_attribute(); attr && !hasError; attr = attr.next_attribute() )
 	{
-		if ( strcmp( attr.name(), "ID") == 0 )
+		if ( strcmp( attr.name(), "ID") == 0 || strcmp( attr.name(), "id") == 0 )
 		{
 			id = attr.as_int();
 		}
@@ -121,6 +123,21 @@ cs::UsbCamera CameraDefn::ParseXML
 		{
 			fps = attr.as_int();
 		}
+		else if (strcmp(attr.name(), "usage") == 0)
+		{
+			string usage = attr.as_string();
+			if ( usage.compare( "POWER_CELLS" ) == 0 )
+			{
+				powerCells = true;
+			}
+			else if ( usage.compare( "DRIVER" ) != 0 )
+			{
+				string msg = "unknown camera usage ";
+				msg += usage;
+				Logger::GetLogger()->LogError( "CameraDefn::ParseXML", msg );
+				hasError = true;
+			}
+		}
 		else
 		{
             string msg = "unknown attribute ";
@@ -131,7 +148,12 @@ cs::UsbCamera CameraDefn::ParseXML
 
 	}
 
-	if (!hasError)
+	if ( !hasError && powerCells )
+	{
+		// the power cell pipeline owns this camera and sets its own resolution
+		PowerCellVision::GetInstance()->Start( id, fps );
+	}
+	else if (!hasError)
 	{
 		CameraServer* server = CameraServer::GetInstance();
 		if ( server != nullptr )
@@ -0,0 +1,285 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// FRC includes
+#include <frc/DriverStation.h>
+#include <frc/GenericHID.h>
+
+// Team 302 includes
+#include <gamepad/FunctionMap.h>
+#include <gamepad/IDragonGamePad.h>
+#include <gamepad/TeleopControl.h>
+#include <xmlhw/ControlsDefn.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+#include <pugixml/pugixml.hpp>
+
+using namespace frc;
+using namespace pugi;
+using namespace std;
+
+/// @brief      Parse the driver input mapping file
+/// @param [in] std::string - full path to the file
+/// @return     std::vector<FunctionMap> - function bindings (empty if the file couldn't be parsed)
+vector<FunctionMap> ControlsDefn::ParseXML
+(
+    const string&       filename
+)
+{
+    vector<FunctionMap> functions;
+
+    map<string, TeleopControl::FUNCTION_IDENTIFIER> functionMap;
+    functionMap[string("SWERVE_DRIVE_DRIVE")]                  = TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_DRIVE;
+    functionMap[string("SWERVE_DRIVE_ROTATE")]                 = TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_ROTATE;
+    functionMap[string("SWERVE_DRIVE_STEER")]                  = TeleopControl::FUNCTION_IDENTIFIER::SWERVE_DRIVE_STEER;
+    functionMap[string("DRIVE_FULL")]                          = TeleopControl::FUNCTION_IDENTIFIER::DRIVE_FULL;
+    functionMap[string("DRIVE_75PERCENT")]                     = TeleopControl::FUNCTION_IDENTIFIER::DRIVE_75PERCENT;
+    functionMap[string("DRIVE_50PERCENT")]                     = TeleopControl::FUNCTION_IDENTIFIER::DRIVE_50PERCENT;
+    functionMap[string("DRIVE_25PERCENT")]                     = TeleopControl::FUNCTION_IDENTIFIER::DRIVE_25PERCENT;
+    functionMap[string("DRIVE_SHIFT_UP")]                      = TeleopControl::FUNCTION_IDENTIFIER::DRIVE_SHIFT_UP;
+    functionMap[string("DRIVE_SHIFT_DOWN")]                    = TeleopControl::FUNCTION_IDENTIFIER::DRIVE_SHIFT_DOWN;
+    functionMap[string("DRIVE_TURBO")]                         = TeleopControl::FUNCTION_IDENTIFIER::DRIVE_TURBO;
+    functionMap[string("DRIVE_BRAKE")]                         = TeleopControl::FUNCTION_IDENTIFIER::DRIVE_BRAKE;
+    functionMap[string("BALL_TRANSFER_OFF")]                   = TeleopControl::FUNCTION_IDENTIFIER::BALL_TRANSFER_OFF;
+    functionMap[string("BALL_TRANSFER_TO_SHOOTER")]            = TeleopControl::FUNCTION_IDENTIFIER::BALL_TRANSFER_TO_SHOOTER;
+    functionMap[string("SHOOTER_PREPARE_TO_SHOOT_GREEN")]      = TeleopControl::FUNCTION_IDENTIFIER::SHOOTER_PREPARE_TO_SHOOT_GREEN;
+    functionMap[string("SHOOTER_PREPARE_TO_SHOOT_YELLOW")]     = TeleopControl::FUNCTION_IDENTIFIER::SHOOTER_PREPARE_TO_SHOOT_YELLOW;
+    functionMap[string("SHOOTER_PREPARE_TO_SHOOT_BLUE")]       = TeleopControl::FUNCTION_IDENTIFIER::SHOOTER_PREPARE_TO_SHOOT_BLUE;
+    functionMap[string("SHOOTER_PREPARE_TO_SHOOT_RED")]        = TeleopControl::FUNCTION_IDENTIFIER::SHOOTER_PREPARE_TO_SHOOT_RED;
+    functionMap[string("SHOOTER_PREPARE_TO_SHOOT_DISTANCE")]   = TeleopControl::FUNCTION_IDENTIFIER::SHOOTER_PREPARE_TO_SHOOT_DISTANCE;
+    functionMap[string("SHOOTER_SHOOT")]                       = TeleopControl::FUNCTION_IDENTIFIER::SHOOTER_SHOOT;
+    functionMap[string("TURRET_LIMELIGHT_AIM")]                = TeleopControl::FUNCTION_IDENTIFIER::TURRET_LIMELIGHT_AIM;
+    functionMap[string("REZERO_PIGEON")]                       = TeleopControl::FUNCTION_IDENTIFIER::REZERO_PIGEON;
+    functionMap[string("AUTO_DRIVE_TO_YELLOW")]                = TeleopControl::FUNCTION_IDENTIFIER::AUTO_DRIVE_TO_YELLOW;
+    functionMap[string("AUTO_DRIVE_TO_LOADING_ZONE")]          = TeleopControl::FUNCTION_IDENTIFIER::AUTO_DRIVE_TO_LOADING_ZONE;
+    functionMap[string("HEADING_SNAP_0")]                      = TeleopControl::FUNCTION_IDENTIFIER::HEADING_SNAP_0;
+    functionMap[string("HEADING_SNAP_90")]                     = TeleopControl::FUNCTION_IDENTIFIER::HEADING_SNAP_90;
+    functionMap[string("HEADING_SNAP_180")]                    = TeleopControl::FUNCTION_IDENTIFIER::HEADING_SNAP_180;
+    functionMap[string("HEADING_SNAP_270")]                    = TeleopControl::FUNCTION_IDENTIFIER::HEADING_SNAP_270;
+
+    map<string, IDragonGamePad::AXIS_IDENTIFIER> axisMap;
+    axisMap[string("LEFT_JOYSTICK_X")]          = IDragonGamePad::AXIS_IDENTIFIER::LEFT_JOYSTICK_X;
+    axisMap[string("LEFT_JOYSTICK_Y")]          = IDragonGamePad::AXIS_IDENTIFIER::LEFT_JOYSTICK_Y;
+    axisMap[string("RIGHT_JOYSTICK_X")]         = IDragonGamePad::AXIS_IDENTIFIER::RIGHT_JOYSTICK_X;
+    axisMap[string("RIGHT_JOYSTICK_Y")]         = IDragonGamePad::AXIS_IDENTIFIER::RIGHT_JOYSTICK_Y;
+    axisMap[string("LEFT_TRIGGER")]             = IDragonGamePad::AXIS_IDENTIFIER::LEFT_TRIGGER;
+    axisMap[string("RIGHT_TRIGGER")]            = IDragonGamePad::AXIS_IDENTIFIER::RIGHT_TRIGGER;
+    axisMap[string("GAMEPAD_AXIS_16")]          = IDragonGamePad::AXIS_IDENTIFIER::GAMEPAD_AXIS_16;
+    axisMap[string("GAMEPAD_AXIS_17")]          = IDragonGamePad::AXIS_IDENTIFIER::GAMEPAD_AXIS_17;
+    axisMap[string("LEFT_ANALOG_BUTTON_AXIS")]  = IDragonGamePad::AXIS_IDENTIFIER::LEFT_ANALOG_BUTTON_AXIS;
+    axisMap[string("RIGHT_ANALOG_BUTTON_AXIS")] = IDragonGamePad::AXIS_IDENTIFIER::RIGHT_ANALOG_BUTTON_AXIS;
+    axisMap[string("DIAL_ANALOG_BUTTON_AXIS")]  = IDragonGamePad::AXIS_IDENTIFIER::DIAL_ANALOG_BUTTON_AXIS;
+
+    map<string, IDragonGamePad::BUTTON_IDENTIFIER> buttonMap;
+    buttonMap[string("A_BUTTON")]               = IDragonGamePad::BUTTON_IDENTIFIER::A_BUTTON;
+    buttonMap[string("B_BUTTON")]               = IDragonGamePad::BUTTON_IDENTIFIER::B_BUTTON;
+    buttonMap[string("X_BUTTON")]               = IDragonGamePad::BUTTON_IDENTIFIER::X_BUTTON;
+    buttonMap[string("Y_BUTTON")]               = IDragonGamePad::BUTTON_IDENTIFIER::Y_BUTTON;
+    buttonMap[string("LEFT_BUMPER")]            = IDragonGamePad::BUTTON_IDENTIFIER::LEFT_BUMPER;
+    buttonMap[string("RIGHT_BUMPER")]           = IDragonGamePad::BUTTON_IDENTIFIER::RIGHT_BUMPER;
+    buttonMap[string("BACK_BUTTON")]            = IDragonGamePad::BUTTON_IDENTIFIER::BACK_BUTTON;
+    buttonMap[string("SELECT_BUTTON")]          = IDragonGamePad::BUTTON_IDENTIFIER::SELECT_BUTTON;
+    buttonMap[string("START_BUTTON")]           = IDragonGamePad::BUTTON_IDENTIFIER::START_BUTTON;
+    buttonMap[string("LEFT_STICK_PRESSED")]     = IDragonGamePad::BUTTON_IDENTIFIER::LEFT_STICK_PRESSED;
+    buttonMap[string("RIGHT_STICK_PRESSED")]    = IDragonGamePad::BUTTON_IDENTIFIER::RIGHT_STICK_PRESSED;
+    buttonMap[string("LEFT_TRIGGER_PRESSED")]   = IDragonGamePad::BUTTON_IDENTIFIER::LEFT_TRIGGER_PRESSED;
+    buttonMap[string("RIGHT_TRIGGER_PRESSED")]  = IDragonGamePad::BUTTON_IDENTIFIER::RIGHT_TRIGGER_PRESSED;
+    buttonMap[string("POV_0")]                  = IDragonGamePad::BUTTON_IDENTIFIER::POV_0;
+    buttonMap[string("POV_45")]                 = IDragonGamePad::BUTTON_IDENTIFIER::POV_45;
+    buttonMap[string("POV_90")]                 = IDragonGamePad::BUTTON_IDENTIFIER::POV_90;
+    buttonMap[string("POV_135")]                = IDragonGamePad::BUTTON_IDENTIFIER::POV_135;
+    buttonMap[string("POV_180")]                = IDragonGamePad::BUTTON_IDENTIFIER::POV_180;
+    buttonMap[string("POV_225")]                = IDragonGamePad::BUTTON_IDENTIFIER::POV_225;
+    buttonMap[string("POV_270")]                = IDragonGamePad::BUTTON_IDENTIFIER::POV_270;
+    buttonMap[string("POV_315")]                = IDragonGamePad::BUTTON_IDENTIFIER::POV_315;
+    buttonMap[string("GAMEPAD_SWITCH_18")]      = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_SWITCH_18;
+    buttonMap[string("GAMEPAD_SWITCH_19")]      = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_SWITCH_19;
+    buttonMap[string("GAMEPAD_SWITCH_20")]      = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_SWITCH_20;
+    buttonMap[string("GAMEPAD_SWITCH_21")]      = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_SWITCH_21;
+    buttonMap[string("GAMEPAD_BUTTON_14_UP")]   = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_14_UP;
+    buttonMap[string("GAMEPAD_BUTTON_14_DOWN")] = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_14_DOWN;
+    buttonMap[string("GAMEPAD_BUTTON_15_UP")]   = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_15_UP;
+    buttonMap[string("GAMEPAD_BUTTON_15_DOWN")] = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_15_DOWN;
+    buttonMap[string("GAMEPAD_BUTTON_1")]       = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_1;
+    buttonMap[string("GAMEPAD_BUTTON_2")]       = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_2;
+    buttonMap[string("GAMEPAD_BUTTON_3")]       = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_3;
+    buttonMap[string("GAMEPAD_BUTTON_4")]       = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_4;
+    buttonMap[string("GAMEPAD_BUTTON_5")]       = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_5;
+    buttonMap[string("GAMEPAD_BUTTON_6")]       = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_6;
+    buttonMap[string("GAMEPAD_BUTTON_7")]       = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_7;
+    buttonMap[string("GAMEPAD_BUTTON_8")]       = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_8;
+    buttonMap[string("GAMEPAD_BUTTON_9")]       = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_9;
+    buttonMap[string("GAMEPAD_BUTTON_10")]      = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_10;
+    buttonMap[string("GAMEPAD_BUTTON_11")]      = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_11;
+    buttonMap[string("GAMEPAD_BUTTON_12")]      = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_12;
+    buttonMap[string("GAMEPAD_BUTTON_13")]      = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BUTTON_13;
+    buttonMap[string("GAMEPAD_DIAL_22")]        = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_DIAL_22;
+    buttonMap[string("GAMEPAD_DIAL_23")]        = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_DIAL_23;
+    buttonMap[string("GAMEPAD_DIAL_24")]        = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_DIAL_24;
+    buttonMap[string("GAMEPAD_DIAL_25")]        = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_DIAL_25;
+    buttonMap[string("GAMEPAD_DIAL_26")]        = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_DIAL_26;
+    buttonMap[string("GAMEPAD_DIAL_27")]        = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_DIAL_27;
+    buttonMap[string("GAMEPAD_BIG_RED_BUTTON")] = IDragonGamePad::BUTTON_IDENTIFIER::GAMEPAD_BIG_RED_BUTTON;
+
+    map<string, IDragonGamePad::AXIS_DEADBAND> deadbandMap;
+    deadbandMap[string("NONE")]                     = IDragonGamePad::AXIS_DEADBAND::NONE;
+    deadbandMap[string("APPLY_STANDARD_DEADBAND")]  = IDragonGamePad::AXIS_DEADBAND::APPLY_STANDARD_DEADBAND;
+    deadbandMap[string("APPLY_SCALED_DEADBAND")]    = IDragonGamePad::AXIS_DEADBAND::APPLY_SCALED_DEADBAND;
+
+    map<string, IDragonGamePad::AXIS_PROFILE> profileMap;
+    profileMap[string("LINEAR")]            = IDragonGamePad::AXIS_PROFILE::LINEAR;
+    profileMap[string("SQUARED")]           = IDragonGamePad::AXIS_PROFILE::SQUARED;
+    profileMap[string("CUBED")]             = IDragonGamePad::AXIS_PROFILE::CUBED;
+    profileMap[string("PIECEWISE_LINEAR")]  = IDragonGamePad::AXIS_PROFILE::PIECEWISE_LINEAR;
+
+    map<string, IDragonGamePad::BUTTON_MODE> modeMap;
+    modeMap[string("STANDARD")] = IDragonGamePad::BUTTON_MODE::STANDARD;
+    modeMap[string("TOGGLE")]   = IDragonGamePad::BUTTON_MODE::TOGGLE;
+
+    xml_document doc;
+    xml_parse_result result = doc.load_file( filename.c_str() );
+    if ( result )
+    {
+        auto ds = &DriverStation::GetInstance();
+
+        // get the root node <controls>
+        xml_node parent = doc.root();
+        for ( xml_node node = parent.first_child(); node; node = node.next_sibling() )
+        {
+            for ( xml_node controllerNode = node.first_child(); controllerNode; controllerNode = controllerNode.next_sibling() )
+            {
+                if ( strcmp( controllerNode.name(), "controller" ) != 0 )
+                {
+                    string msg = "unknown child ";
+                    msg += controllerNode.name();
+                    Logger::GetLogger()->LogError( string("ControlsDefn::ParseXML"), msg );
+                    continue;
+                }
+
+                // attributes and their defaults must match controls.dtd
+                auto port = controllerNode.attribute( "port" ).as_int( -1 );
+                auto type = string( controllerNode.attribute( "type" ).as_string( "xbox" ) );
+                if ( port < 0 || port >= DriverStation::kJoystickPorts )
+                {
+                    string msg = "invalid port ";
+                    msg += to_string( port );
+                    Logger::GetLogger()->LogError( string("ControlsDefn::ParseXML"), msg );
+                    continue;
+                }
+
+                // same checks TeleopControl uses to create the controller
+                auto isXbox    = ds->GetJoystickIsXbox( port );
+                auto isGamepad = !isXbox && ds->GetJoystickType( port ) == GenericHID::kHID1stPerson;
+                if ( ( type.compare( "xbox" ) == 0 && !isXbox ) || ( type.compare( "gamepad" ) == 0 && !isGamepad ) )
+                {
+                    string msg = "no ";
+                    msg += type;
+                    msg += " controller plugged into port ";
+                    msg += to_string( port );
+                    Logger::GetLogger()->LogError( string("ControlsDefn::ParseXML"), msg );
+                    continue;
+                }
+
+                for ( xml_node child = controllerNode.first_child(); child; child = child.next_sibling() )
+                {
+                    auto function = TeleopControl::FUNCTION_IDENTIFIER::UNKNOWN_FUNCTION;
+                    auto functionItr = functionMap.find( string( child.attribute( "function" ).value() ) );
+                    if ( functionItr != functionMap.end() )
+                    {
+                        function = functionItr->second;
+                    }
+
+                    auto axis     = IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS;
+                    auto deadband = IDragonGamePad::AXIS_DEADBAND::NONE;
+                    auto profile  = IDragonGamePad::AXIS_PROFILE::LINEAR;
+                    auto scale    = 1.0;
+                    auto button   = IDragonGamePad::BUTTON_IDENTIFIER::UNDEFINED_BUTTON;
+                    auto mode     = IDragonGamePad::BUTTON_MODE::STANDARD;
+
+                    if ( strcmp( child.name(), "axis" ) == 0 )
+                    {
+                        auto axisItr = axisMap.find( string( child.attribute( "id" ).value() ) );
+                        if ( axisItr != axisMap.end() )
+                        {
+                            axis = axisItr->second;
+                        }
+                        auto deadbandItr = deadbandMap.find( string( child.attribute( "deadband" ).as_string( "NONE" ) ) );
+                        if ( deadbandItr != deadbandMap.end() )
+                        {
+                            deadband = deadbandItr->second;
+                        }
+                        auto profileItr = profileMap.find( string( child.attribute( "profile" ).as_string( "LINEAR" ) ) );
+                        if ( profileItr != profileMap.end() )
+                        {
+                            profile = profileItr->second;
+                        }
+                        scale = child.attribute( "scale" ).as_double( 1.0 );
+                    }
+                    else if ( strcmp( child.name(), "button" ) == 0 )
+                    {
+                        auto buttonItr = buttonMap.find( string( child.attribute( "id" ).value() ) );
+                        if ( buttonItr != buttonMap.end() )
+                        {
+                            button = buttonItr->second;
+                        }
+                        auto modeItr = modeMap.find( string( child.attribute( "mode" ).as_string( "STANDARD" ) ) );
+                        if ( modeItr != modeMap.end() )
+                        {
+                            mode = modeItr->second;
+                        }
+                    }
+
+                    if ( function != TeleopControl::FUNCTION_IDENTIFIER::UNKNOWN_FUNCTION &&
+                         ( axis != IDragonGamePad::AXIS_IDENTIFIER::UNDEFINED_AXIS || button != IDragonGamePad::BUTTON_IDENTIFIER::UNDEFINED_BUTTON ) )
+                    {
+                        functions.emplace_back( FunctionMap( function, port, axis, deadband, profile, scale, button, mode ) );
+                    }
+                    else
+                    {
+                        string msg = "invalid ";
+                        msg += child.name();
+                        msg += " ";
+                        msg += child.attribute( "function" ).value();
+                        msg += " on port ";
+                        msg += to_string( port );
+                        Logger::GetLogger()->LogError( string("ControlsDefn::ParseXML"), msg );
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        string msg = "XML [";
+        msg += filename;
+        msg += "] parsed with errors";
+        Logger::GetLogger()->LogError( string("ControlsDefn::ParseXML (1) "), msg );
+        msg = "Error description: ";
+        msg += result.description();
+        Logger::GetLogger()->LogError( string("ControlsDefn::ParseXML (2) "), msg );
+        msg = "Error offset: ";
+        msg += to_string( result.offset );
+        Logger::GetLogger()->LogError( string("ControlsDefn::ParseXML (3) "), msg );
+    }
+
+    return functions;
+}
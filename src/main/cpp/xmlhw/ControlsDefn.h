@@ -0,0 +1,54 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <string>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <gamepad/FunctionMap.h>
+
+// Third Party Includes
+
+//========================================================================================================
+/// ControlsDefn.h
+//========================================================================================================
+///
+/// File Description:
+///     Parse the driver input mapping file (controls.xml) into the function bindings TeleopControl
+///     uses.  Bindings for a port are skipped when the controller plugged into that port isn't the
+///     type the file describes.
+///
+///     This parsing leverages the 3rd party Open Source Pugixml library (https://pugixml.org/).
+///
+//========================================================================================================
+class ControlsDefn
+{
+    public:
+        ControlsDefn() = default;
+        ~ControlsDefn() = default;
+
+        /// @brief      Parse the driver input mapping file
+        /// @param [in] std::string - full path to the file
+        /// @return     std::vector<FunctionMap> - function bindings (empty if the file couldn't be parsed)
+        std::vector<FunctionMap> ParseXML
+        (
+            const std::string&      filename
+        );
+};
@@ -20,6 +20,7 @@
 //========================================================================================================
 
 // C++ Includes
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -68,6 +69,8 @@ void MechanismDefn::ParseXML
 
     // initialize attributes
     MechanismTypes::MECHANISM_TYPE type = MechanismTypes::UNKNOWN_MECHANISM;
+    double minAngle = numeric_limits<double>::lowest();
+    double maxAngle = numeric_limits<double>::max();
 
     bool hasError       = false;
 
@@ -107,6 +110,14 @@ void MechanismDefn::ParseXML
                     hasError = true;
             }
         }
+        else if ( strcmp( attr.name(), "minAngle" ) == 0 )
+        {
+            minAngle = attr.as_double();
+        }
+        else if ( strcmp( attr.name(), "maxAngle" ) == 0 )
+        {
+            maxAngle = attr.as_double();
+        }
         else
         {
             string msg = "invalid attribute ";
@@ -116,6 +127,12 @@ void MechanismDefn::ParseXML
         }
     }
 
+    if ( minAngle > maxAngle )
+    {
+        Logger::GetLogger()->LogError( "MechanismDefn::ParseXML", "minAngle is greater than maxAngle" );
+        hasError = true;
+    }
+
     // Parse/validate subobject xml
     unique_ptr<MotorDefn> motorXML = make_unique<MotorDefn>();
     unique_ptr<DigitalInputDefn> digitalXML = make_unique<DigitalInputDefn>();
@@ -170,6 +187,6 @@ void MechanismDefn::ParseXML
     if ( !hasError )
     {
         MechanismFactory* factory =  MechanismFactory::GetMechanismFactory();
-        factory->CreateIMechanism( type, motors, servos, digitalInputs, canCoder );
+        factory->CreateIMechanism( type, motors, servos, digitalInputs, canCoder, minAngle, maxAngle );
     }
 }
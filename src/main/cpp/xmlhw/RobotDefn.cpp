@@ -63,6 +63,9 @@ using namespace std;
 void RobotDefn::ParseXML()
 {
     // set the file to parse
+    // (this isn't in the StateDataCache: each element is handed straight to a factory that creates and
+    // configures the device, so the time goes to configuring CAN devices rather than parsing, and
+    // there is no parsed data to save between boots)
     const char* filename = "/home/lvuser/config/robot.xml";
 
     // load the xml file into memory (parse it)
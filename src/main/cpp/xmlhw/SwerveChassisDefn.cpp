@@ -36,6 +36,7 @@
 // Team302 includes
 #include <hw/interfaces/IDragonMotorController.h>
 #include <hw/usages/IDragonMotorControllerMap.h>
+#include <subsys/PoseEstimatorEnum.h>
 #include <subsys/SwerveChassis.h>
 #include <subsys/SwerveChassisFactory.h>
 
@@ -72,6 +73,7 @@ shared_ptr<SwerveChassis> SwerveChassisDefn::ParseXML
     units::radians_per_second_t maxAngularSpeed(0.0);
     units::acceleration::meters_per_second_squared_t maxAcceleration(0.0);
     units::angular_acceleration::radians_per_second_squared_t maxAngularAcceleration(0.0);
+    PoseEstimationMethod poseEstimation = PoseEstimationMethod::EULER_AT_CHASSIS;
     bool hasError 		    = false;
 
     Logger::GetLogger()->OnDash(string("RobotXML Parsing"), string("Swerve Chassis"));
@@ -124,6 +126,27 @@ shared_ptr<SwerveChassis> SwerveChassisDefn::ParseXML
         {
             odometryComplianceCoefficient = attr.as_double();
         }
+        else if (  attrName.compare("poseEstimation") == 0 )
+        {
+            map<string, PoseEstimationMethod> methods{ { string("WPI"),                    PoseEstimationMethod::WPI },
+                                                       { string("EULER_AT_CHASSIS"),       PoseEstimationMethod::EULER_AT_CHASSIS },
+                                                       { string("EULER_USING_MODULES"),    PoseEstimationMethod::EULER_USING_MODULES },
+                                                       { string("POSE_EST_AT_CHASSIS"),    PoseEstimationMethod::POSE_EST_AT_CHASSIS },
+                                                       { string("POSE_EST_USING_MODULES"), PoseEstimationMethod::POSE_EST_USING_MODULES },
+                                                       { string("IMU_FUSED"),              PoseEstimationMethod::IMU_FUSED } };
+            auto it = methods.find( string( attr.value() ) );
+            if ( it != methods.end() )
+            {
+                poseEstimation = it->second;
+            }
+            else
+            {
+                string msg = "unknown pose estimation ";
+                msg += attr.value();
+                Logger::GetLogger()->LogError( string("SwerveChassisDefn::ParseXML"), msg );
+                hasError = true;
+            }
+        }
         else   // log errors
         {
             string msg = "unknown attribute ";
@@ -198,6 +221,10 @@ shared_ptr<SwerveChassis> SwerveChassisDefn::ParseXML
                                                                                         maxAngularSpeed, 
                                                                                         maxAcceleration,
                                                                                         maxAngularAcceleration  );
+        if ( chassis.get() != nullptr )
+        {
+            chassis.get()->SetPoseEstOption( poseEstimation );
+        }
     }
     return chassis;
 }
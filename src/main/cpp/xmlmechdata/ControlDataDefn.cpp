@@ -67,6 +67,7 @@ ControlData* ControlDataDefn::ParseXML
 	modeMap[string("VOLTAGE")] = ControlModes::CONTROL_TYPE::VOLTAGE;
     modeMap[string("CURRENT")] = ControlModes::CONTROL_TYPE::CURRENT;
 	modeMap[string("TRAPEZOID")] = ControlModes::CONTROL_TYPE::TRAPEZOID;
+	modeMap[string("TRAPEZOID_DEGREES")] = ControlModes::CONTROL_TYPE::TRAPEZOID_DEGREES;
 	modeMap[string("MOTION_PROFILE")] = ControlModes::CONTROL_TYPE::MOTION_PROFILE;
     modeMap[string("MOTION_PROFILE_ARC")] = ControlModes::CONTROL_TYPE::MOTION_PROFILE_ARC;
 	modeMap[string("PERCENT_OUTPUT")] = ControlModes::CONTROL_TYPE::PERCENT_OUTPUT;
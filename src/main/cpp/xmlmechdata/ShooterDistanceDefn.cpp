@@ -0,0 +1,104 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <cstring>
+#include <string>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <states/shooter/ShooterDistanceTable.h>
+#include <xmlmechdata/ShooterDistanceDefn.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+#include <pugixml/pugixml.hpp>
+
+using namespace pugi;
+using namespace std;
+
+/// @brief      Parse the shooter distance calibration file
+/// @param [in] std::string - full path to the file
+/// @return     ShooterDistanceTable* - calibration table (empty if the file couldn't be parsed)
+ShooterDistanceTable* ShooterDistanceDefn::ParseXML
+(
+    const string&       filename
+)
+{
+    vector<ShooterDistanceTable::CalibrationPoint> points;
+
+    xml_document doc;
+    xml_parse_result result = doc.load_file( filename.c_str() );
+    if ( result )
+    {
+        // get the root node <shooterdistance>
+        xml_node parent = doc.root();
+        for ( xml_node node = parent.first_child(); node; node = node.next_sibling() )
+        {
+            for ( xml_node child = node.first_child(); child; child = child.next_sibling() )
+            {
+                if ( strcmp( child.name(), "calibrationPoint" ) == 0 )
+                {
+                    ShooterDistanceTable::CalibrationPoint point = { 0.0, 0.0, 0.0 };
+                    for ( xml_attribute attr = child.first_attribute(); attr; attr = attr.next_attribute() )
+                    {
+                        if ( strcmp( attr.name(), "distance" ) == 0 )
+                        {
+                            point.distance = attr.as_double();
+                        }
+                        else if ( strcmp( attr.name(), "value" ) == 0 )
+                        {
+                            point.primary = attr.as_double();
+                        }
+                        else if ( strcmp( attr.name(), "secondValue" ) == 0 )
+                        {
+                            point.secondary = attr.as_double();
+                        }
+                        else
+                        {
+                            string msg = "unknown attribute ";
+                            msg += attr.name();
+                            Logger::GetLogger()->LogError( string("ShooterDistanceDefn::ParseXML"), msg );
+                        }
+                    }
+                    points.emplace_back( point );
+                }
+                else
+                {
+                    string msg = "unknown child ";
+                    msg += child.name();
+                    Logger::GetLogger()->LogError( string("ShooterDistanceDefn::ParseXML"), msg );
+                }
+            }
+        }
+    }
+    else
+    {
+        string msg = "XML [";
+        msg += filename;
+        msg += "] parsed with errors";
+        Logger::GetLogger()->LogError( string("ShooterDistanceDefn::ParseXML (1) "), msg );
+        msg = "Error description: ";
+        msg += result.description();
+        Logger::GetLogger()->LogError( string("ShooterDistanceDefn::ParseXML (2) "), msg );
+        msg = "Error offset: ";
+        msg += to_string( result.offset );
+        Logger::GetLogger()->LogError( string("ShooterDistanceDefn::ParseXML (3) "), msg );
+    }
+
+    return new ShooterDistanceTable( points );
+}
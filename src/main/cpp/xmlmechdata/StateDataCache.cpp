@@ -0,0 +1,442 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// StateDataCache.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Binary cache of the parsed mechanism state data files.
+///
+///     File layout (native byte order, the cache is only ever read by the robot that wrote it):
+///         header:   "T302", uint32 version, uint32 number of sections
+///         section:  int32 mechanism, uint32 byte count, bytes
+///     Section bytes:
+///         uint64 key of the xml file (size and modification time), uint64 schema key,
+///         uint32 count, ControlData records,
+///         uint32 count, MechanismTargetData records
+///     Strings are stored as a uint16 length followed by the characters.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+// FRC includes
+
+// Team 302 includes
+#include <controllers/ControlData.h>
+#include <controllers/ControlModes.h>
+#include <controllers/MechanismTargetData.h>
+#include <subsys/MechanismTypes.h>
+#include <utils/Logger.h>
+#include <xmlmechdata/StateDataCache.h>
+
+// Third Party Includes
+
+using namespace std;
+
+namespace
+{
+    const char*     CACHE_FILE      = "/home/lvuser/statedata.bin";
+    const char*     CACHE_TEMP_FILE = "/home/lvuser/statedata.tmp";
+    const char      MAGIC[4]        = { 'T', '3', '0', '2' };
+    const char*     SCHEMA_FILE     = "/home/lvuser/deploy/stateData.dtd";
+    const uint32_t  VERSION         = 3;
+
+    // Layout of the serialized records.  It is part of the schema key, so changing what the parser
+    // stores (and updating this description) invalidates the old sections without touching VERSION.
+    const char*     RECORD_LAYOUT   = "ControlData:i32 mode,i32 runLoc,str id,f64 p,i,d,f,izone,maxAccel,cruiseVel,peak,nominal;"
+                                      "MechanismTargetData:str state,str controller,str controller2,f64 target,i32 solenoid,f64 secondTarget";
+
+    const uint64_t  FNV_OFFSET      = 14695981039346656037ULL;
+    const uint64_t  FNV_PRIME       = 1099511628211ULL;
+
+    uint64_t HashBytes( const char* data, size_t size, uint64_t hash = FNV_OFFSET )
+    {
+        for ( size_t inx=0; inx<size; ++inx )
+        {
+            hash ^= static_cast<uint8_t>( data[inx] );
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    class CacheWriter
+    {
+        public:
+            explicit CacheWriter( vector<char>& buffer ) : m_buffer( buffer ) {}
+
+            template <typename T> void Put( T value )
+            {
+                auto bytes = reinterpret_cast<const char*>( &value );
+                m_buffer.insert( m_buffer.end(), bytes, bytes + sizeof(T) );
+            }
+
+            void PutString( const string& value )
+            {
+                Put<uint16_t>( static_cast<uint16_t>( value.size() ) );
+                m_buffer.insert( m_buffer.end(), value.begin(), value.end() );
+            }
+
+        private:
+            vector<char>&   m_buffer;
+    };
+
+    class CacheReader
+    {
+        public:
+            CacheReader( const char* data, size_t size ) : m_data( data ), m_remaining( size ) {}
+
+            template <typename T> bool Get( T& value )
+            {
+                if ( m_remaining < sizeof(T) )
+                {
+                    return false;
+                }
+                memcpy( &value, m_data, sizeof(T) );
+                m_data += sizeof(T);
+                m_remaining -= sizeof(T);
+                return true;
+            }
+
+            bool GetString( string& value )
+            {
+                uint16_t len = 0;
+                if ( !Get( len ) || m_remaining < len )
+                {
+                    return false;
+                }
+                value.assign( m_data, len );
+                m_data += len;
+                m_remaining -= len;
+                return true;
+            }
+
+            const char* Current() const { return m_data; }
+            bool Skip( size_t len )
+            {
+                if ( m_remaining < len )
+                {
+                    return false;
+                }
+                m_data += len;
+                m_remaining -= len;
+                return true;
+            }
+
+        private:
+            const char*     m_data;
+            size_t          m_remaining;
+    };
+}
+
+StateDataCache* StateDataCache::m_instance = nullptr;
+StateDataCache* StateDataCache::GetInstance()
+{
+    if ( StateDataCache::m_instance == nullptr )
+    {
+        StateDataCache::m_instance = new StateDataCache();
+    }
+    return StateDataCache::m_instance;
+}
+
+StateDataCache::StateDataCache() : m_sections(),
+                                   m_schemaKey( 0 ),
+                                   m_mutex()
+{
+    // the schema key covers the deployed DTD and the record layout the parser writes
+    auto layoutHash = HashBytes( RECORD_LAYOUT, strlen( RECORD_LAYOUT ) );
+    m_schemaKey = FileKey( SCHEMA_FILE, layoutHash );
+    Load();
+}
+
+/// @brief  Key for a file from its size and modification time (0 if the file doesn't exist).  A deploy
+///         writes a new file, so its modification time changes even when the contents don't; that only
+///         costs one extra parse, while reading and hashing every file on every boot costs the whole parse.
+uint64_t StateDataCache::FileKey
+(
+    const string&   file,
+    uint64_t        seed
+)
+{
+    struct stat info;
+    if ( stat( file.c_str(), &info ) != 0 )
+    {
+        return 0;
+    }
+
+    int64_t stamp[3] = { static_cast<int64_t>( info.st_size ),
+                         static_cast<int64_t>( info.st_mtim.tv_sec ),
+                         static_cast<int64_t>( info.st_mtim.tv_nsec ) };
+    return HashBytes( reinterpret_cast<const char*>( stamp ), sizeof(stamp), seed );
+}
+
+/// @brief  read the cache file with one read and split it into the mechanism sections
+void StateDataCache::Load()
+{
+    auto file = fopen( CACHE_FILE, "rb" );
+    if ( file == nullptr )
+    {
+        Logger::GetLogger()->LogError( string("StateDataCache::Load"), string("no cache file"));
+        return;
+    }
+
+    vector<char> buffer;
+    if ( fseek( file, 0, SEEK_END ) == 0 )
+    {
+        auto size = ftell( file );
+        if ( size > 0 && fseek( file, 0, SEEK_SET ) == 0 )
+        {
+            buffer.resize( static_cast<size_t>( size ) );
+            if ( fread( buffer.data(), 1, buffer.size(), file ) != buffer.size() )
+            {
+                buffer.clear();
+            }
+        }
+    }
+    fclose( file );
+
+    CacheReader reader( buffer.data(), buffer.size() );
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t nSections = 0;
+    if ( !reader.Get( magic ) || memcmp( magic, MAGIC, sizeof(MAGIC) ) != 0 ||
+         !reader.Get( version ) || version != VERSION || !reader.Get( nSections ) )
+    {
+        Logger::GetLogger()->LogError( string("StateDataCache::Load"), string("invalid cache file"));
+        return;
+    }
+
+    for ( uint32_t inx=0; inx<nSections; ++inx )
+    {
+        int32_t mech = MechanismTypes::UNKNOWN_MECHANISM;
+        uint32_t len = 0;
+        if ( !reader.Get( mech ) || !reader.Get( len ) )
+        {
+            break;
+        }
+        auto start = reader.Current();
+        if ( !reader.Skip( len ) )
+        {
+            break;
+        }
+        if ( mech >= 0 && mech < MechanismTypes::MAX_MECHANISM_TYPES )
+        {
+            m_sections[mech].assign( start, start + len );
+        }
+    }
+}
+
+/// @brief  write all of the sections to a temporary file and then move it over the cache file
+void StateDataCache::Save() const
+{
+    vector<char> buffer;
+    CacheWriter writer( buffer );
+    buffer.insert( buffer.end(), MAGIC, MAGIC + sizeof(MAGIC) );
+    writer.Put<uint32_t>( VERSION );
+
+    uint32_t nSections = 0;
+    for ( auto& section : m_sections )
+    {
+        nSections += section.empty() ? 0 : 1;
+    }
+    writer.Put<uint32_t>( nSections );
+
+    for ( auto inx=0; inx<MechanismTypes::MAX_MECHANISM_TYPES; ++inx )
+    {
+        if ( !m_sections[inx].empty() )
+        {
+            writer.Put<int32_t>( inx );
+            writer.Put<uint32_t>( static_cast<uint32_t>( m_sections[inx].size() ) );
+            buffer.insert( buffer.end(), m_sections[inx].begin(), m_sections[inx].end() );
+        }
+    }
+
+    auto file = fopen( CACHE_TEMP_FILE, "wb" );
+    if ( file == nullptr )
+    {
+        Logger::GetLogger()->LogError( string("StateDataCache::Save"), string("unable to write cache"));
+        return;
+    }
+    auto written = fwrite( buffer.data(), 1, buffer.size(), file );
+    fclose( file );
+    if ( written != buffer.size() || rename( CACHE_TEMP_FILE, CACHE_FILE ) != 0 )
+    {
+        Logger::GetLogger()->LogError( string("StateDataCache::Save"), string("unable to write cache"));
+        remove( CACHE_TEMP_FILE );
+    }
+}
+
+/// @brief      Build the state data for a mechanism from the cache
+/// @param [in] MechanismTypes::MECHANISM_TYPE - mechanism that the states are for
+/// @param [in] const std::string& - XML file the states were parsed from
+/// @param [out] std::vector<MechanismTargetData*>& - state data
+/// @return     bool - true if the cache was current for this mechanism and targetData was filled in
+bool StateDataCache::GetTargetData
+(
+    MechanismTypes::MECHANISM_TYPE          mechanism,
+    const string&                           xmlFile,
+    vector<MechanismTargetData*>&           targetData
+)
+{
+    lock_guard<mutex> lock( m_mutex );
+    if ( mechanism < 0 || mechanism >= MechanismTypes::MAX_MECHANISM_TYPES || m_sections[mechanism].empty() )
+    {
+        return false;
+    }
+
+    auto& section = m_sections[mechanism];
+    CacheReader reader( section.data(), section.size() );
+
+    // a different size or modification time means a new xml file was deployed; a different schema key
+    // means the DTD or the record layout changed since the section was written
+    auto xmlKey = FileKey( xmlFile, FNV_OFFSET );
+    uint64_t cachedXmlKey = 0;
+    uint64_t cachedSchemaKey = 0;
+    if ( !reader.Get( cachedXmlKey ) || !reader.Get( cachedSchemaKey ) || xmlKey == 0 ||
+         cachedXmlKey != xmlKey || cachedSchemaKey != m_schemaKey )
+    {
+        Logger::GetLogger()->LogError( string("StateDataCache::GetTargetData"), xmlFile + string(" doesn't match the cache"));
+        return false;
+    }
+
+    auto valid = true;
+    vector<ControlData*> controlData;
+    vector<MechanismTargetData*> targets;
+
+    uint32_t nControl = 0;
+    valid = reader.Get( nControl );
+    for ( uint32_t inx=0; valid && inx<nControl; ++inx )
+    {
+        int32_t mode = 0;
+        int32_t server = 0;
+        string identifier;
+        double values[9];
+        valid = reader.Get( mode ) && reader.Get( server ) && reader.GetString( identifier ) && reader.Get( values );
+        if ( valid )
+        {
+            controlData.emplace_back( new ControlData( static_cast<ControlModes::CONTROL_TYPE>( mode ),
+                                                       static_cast<ControlModes::CONTROL_RUN_LOCS>( server ),
+                                                       identifier,
+                                                       values[0], values[1], values[2], values[3], values[4],
+                                                       values[5], values[6], values[7], values[8] ) );
+        }
+    }
+
+    uint32_t nTargets = 0;
+    valid = valid && reader.Get( nTargets );
+    for ( uint32_t inx=0; valid && inx<nTargets; ++inx )
+    {
+        string state;
+        string controller;
+        string controller2;
+        double target = 0.0;
+        int32_t solenoid = MechanismTargetData::SOLENOID::NONE;
+        double secondTarget = 0.0;
+        valid = reader.GetString( state ) && reader.GetString( controller ) && reader.GetString( controller2 ) &&
+                reader.Get( target ) && reader.Get( solenoid ) && reader.Get( secondTarget );
+        if ( valid )
+        {
+            targets.emplace_back( new MechanismTargetData( state, controller, controller2, target,
+                                                           static_cast<MechanismTargetData::SOLENOID>( solenoid ),
+                                                           secondTarget ) );
+        }
+    }
+
+    if ( !valid )
+    {
+        Logger::GetLogger()->LogError( string("StateDataCache::GetTargetData"), string("corrupt cache section"));
+        for ( auto td : targets )
+        {
+            delete td;
+        }
+        for ( auto cd : controlData )
+        {
+            delete cd;
+        }
+        return false;
+    }
+
+    for ( auto td : targets )
+    {
+        td->Update( controlData );
+    }
+    targetData.insert( targetData.end(), targets.begin(), targets.end() );
+    return true;
+}
+
+/// @brief      Replace a mechanism's cached state data and rewrite the cache file
+/// @param [in] MechanismTypes::MECHANISM_TYPE - mechanism that the states are for
+/// @param [in] const std::string& - XML file the states were parsed from
+/// @param [in] const std::vector<ControlData*>& - parsed control data
+/// @param [in] const std::vector<MechanismTargetData*>& - parsed state data
+/// @return     void
+void StateDataCache::Update
+(
+    MechanismTypes::MECHANISM_TYPE              mechanism,
+    const string&                               xmlFile,
+    const vector<ControlData*>&                 controlData,
+    const vector<MechanismTargetData*>&         targetData
+)
+{
+    if ( mechanism < 0 || mechanism >= MechanismTypes::MAX_MECHANISM_TYPES )
+    {
+        return;
+    }
+
+    vector<char> section;
+    CacheWriter writer( section );
+
+    writer.Put<uint64_t>( FileKey( xmlFile, FNV_OFFSET ) );
+    writer.Put<uint64_t>( m_schemaKey );
+
+    writer.Put<uint32_t>( static_cast<uint32_t>( controlData.size() ) );
+    for ( auto cd : controlData )
+    {
+        writer.Put<int32_t>( cd->GetMode() );
+        writer.Put<int32_t>( cd->GetRunLoc() );
+        writer.PutString( cd->GetIdentifier() );
+        writer.Put<double>( cd->GetP() );
+        writer.Put<double>( cd->GetI() );
+        writer.Put<double>( cd->GetD() );
+        writer.Put<double>( cd->GetF() );
+        writer.Put<double>( cd->GetIZone() );
+        writer.Put<double>( cd->GetMaxAcceleration() );
+        writer.Put<double>( cd->GetCruiseVelocity() );
+        writer.Put<double>( cd->GetPeakValue() );
+        writer.Put<double>( cd->GetNominalValue() );
+    }
+
+    writer.Put<uint32_t>( static_cast<uint32_t>( targetData.size() ) );
+    for ( auto td : targetData )
+    {
+        writer.PutString( td->GetStateString() );
+        writer.PutString( td->GetControllerString() );
+        writer.PutString( td->GetController2String() );
+        writer.Put<double>( td->GetTarget() );
+        writer.Put<int32_t>( td->GetSolenoidState() );
+        writer.Put<double>( td->GetSecondTarget() );
+    }
+
+    lock_guard<mutex> lock( m_mutex );
+    m_sections[mechanism] = section;
+    Save();
+}
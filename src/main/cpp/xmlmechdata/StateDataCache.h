@@ -0,0 +1,100 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <controllers/ControlData.h>
+#include <controllers/MechanismTargetData.h>
+#include <subsys/MechanismTypes.h>
+
+// Third Party Includes
+
+//========================================================================================================
+/// StateDataCache.h
+//========================================================================================================
+///
+/// File Description:
+///     Binary cache of the parsed mechanism state data files.  The whole cache file is loaded with a
+///     single read the first time it is needed.  Each mechanism's section records the size and
+///     modification time of the XML file it was built from and a schema key (the size and modification
+///     time of stateData.dtd plus a hash of the record layout), so when a different XML file or DTD is
+///     deployed the section is stale, the XML gets parsed again and the section is rewritten.  Checking
+///     a section only needs a stat of the file; the XML isn't read at all when the cache is current.
+///
+///     The cache file is:  /home/lvuser/statedata.bin  (outside of deploy so a deploy doesn't wipe it)
+///
+//========================================================================================================
+class StateDataCache
+{
+    public:
+        /// @brief  Find or create the cache (loads the cache file)
+        /// @return StateDataCache* - pointer to the cache
+        static StateDataCache* GetInstance();
+
+        /// @brief      Build the state data for a mechanism from the cache
+        /// @param [in] MechanismTypes::MECHANISM_TYPE - mechanism that the states are for
+        /// @param [in] const std::string& - XML file the states were parsed from
+        /// @param [out] std::vector<MechanismTargetData*>& - state data
+        /// @return     bool - true if the cache was current for this mechanism and targetData was filled in
+        bool GetTargetData
+        (
+            MechanismTypes::MECHANISM_TYPE          mechanism,
+            const std::string&                      xmlFile,
+            std::vector<MechanismTargetData*>&      targetData
+        );
+
+        /// @brief      Replace a mechanism's cached state data and rewrite the cache file
+        /// @param [in] MechanismTypes::MECHANISM_TYPE - mechanism that the states are for
+        /// @param [in] const std::string& - XML file the states were parsed from
+        /// @param [in] const std::vector<ControlData*>& - parsed control data
+        /// @param [in] const std::vector<MechanismTargetData*>& - parsed state data
+        /// @return     void
+        void Update
+        (
+            MechanismTypes::MECHANISM_TYPE              mechanism,
+            const std::string&                          xmlFile,
+            const std::vector<ControlData*>&            controlData,
+            const std::vector<MechanismTargetData*>&    targetData
+        );
+
+    private:
+        StateDataCache();
+        ~StateDataCache() = default;
+
+        /// @brief  Key for a file from its size and modification time (0 if the file doesn't exist)
+        static uint64_t FileKey
+        (
+            const std::string&  file,
+            uint64_t            seed
+        );
+
+        void Load();
+        void Save() const;
+
+        static StateDataCache*                                                  m_instance;
+        std::array<std::vector<char>, MechanismTypes::MAX_MECHANISM_TYPES>      m_sections;
+        uint64_t                                                                m_schemaKey;
+        std::mutex                                                              m_mutex;     ///< state data files may be parsed concurrently
+};
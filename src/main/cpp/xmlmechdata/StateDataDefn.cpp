@@ -28,6 +28,9 @@
 ///     The state definition XML files are in:  /home/lvuser/config/states/XXX.xml where the XXX
 ///     is the mechanism name.
 ///
+///     Parsed files are saved in the StateDataCache, so the XML is only parsed again when a newer
+///     file is deployed.
+///
 //========================================================================================================
 
 // C++ Includes
@@ -44,6 +47,7 @@
 #include <controllers/ControlData.h>
 #include <xmlmechdata/ControlDataDefn.h>
 #include <xmlmechdata/MechanismTargetDefn.h>
+#include <xmlmechdata/StateDataCache.h>
 #include <controllers/MechanismTargetData.h>
 
 // Third Party Includes
@@ -74,33 +78,27 @@ vector<MechanismTargetData*> StateDataDefn::ParseXML
     vector<MechanismTargetData*> targetDataVector;
 
     // set the file to parse
-    string filename = "/home/lvuser/deploy/";
-    string mech;
+    string filename = GetFileName( mechanism );
     switch ( mechanism )
     {
         case MechanismTypes::INTAKE:
             Logger::GetLogger()->ToNtTable(string("State Data Defn"), string("intake"), string("about to parse"));
-            mech = string( "intake.xml");
             break;
 
         case MechanismTypes::BALL_HOPPER:
             Logger::GetLogger()->ToNtTable(string("State Data Defn"), string("ball hopper"), string("about to parse"));
-            mech += string( "ballhopper.xml");
             break;
 
         case MechanismTypes::BALL_TRANSFER:
             Logger::GetLogger()->ToNtTable(string("State Data Defn"), string("ball transfer"), string("about to parse"));
-            mech = string( "balltransfer.xml");
             break;
 
         case MechanismTypes::TURRET:
             Logger::GetLogger()->ToNtTable(string("State Data Defn"), string("turret"), string("about to parse"));
-            mech = string( "turret.xml");
             break;
 
         case MechanismTypes::SHOOTER:
             Logger::GetLogger()->ToNtTable(string("State Data Defn"), string("shooter"), string("about to parse"));
-            mech = string( "shooter.xml");
             break;
 
         default:
@@ -111,7 +109,13 @@ vector<MechanismTargetData*> StateDataDefn::ParseXML
 
     if ( !hasError )
     {
-        filename += mech;
+        // use the binary cache if it was built from this xml file
+        auto cache = StateDataCache::GetInstance();
+        if ( cache->GetTargetData( mechanism, filename, targetDataVector ) )
+        {
+            return targetDataVector;
+        }
+
         // load the xml file into memory (parse it)
         xml_document doc;
         xml_parse_result result = doc.load_file(filename.c_str());
@@ -148,9 +152,28 @@ vector<MechanismTargetData*> StateDataDefn::ParseXML
                 }
             }
 
+            auto complete = true;
+            for ( auto cd : controlDataVector )
+            {
+                complete = complete && cd != nullptr;
+            }
+            for ( auto td : targetDataVector )
+            {
+                complete = complete && td != nullptr;
+            }
+
             for ( auto td : targetDataVector )
             {
-                td->Update( controlDataVector );
+                if ( td != nullptr )
+                {
+                    td->Update( controlDataVector );
+                }
+            }
+
+            // only cache files that parsed cleanly, so errors get reported again on the next boot
+            if ( complete )
+            {
+                cache->Update( mechanism, filename, controlDataVector, targetDataVector );
             }
         }
         else
@@ -176,3 +199,41 @@ vector<MechanismTargetData*> StateDataDefn::ParseXML
     }
     return targetDataVector;
 }
+
+/// @brief      Get the deployed mechanismState.xml file for a mechanism
+/// @param [in] MechanismTypes::MECHANISM_TYPE  - mechanism that the states are for
+/// @return     std::string - full path to the file (empty if the mechanism has no state file)
+string StateDataDefn::GetFileName
+(
+    MechanismTypes::MECHANISM_TYPE mechanism
+)
+{
+    string filename = "/home/lvuser/deploy/";
+    switch ( mechanism )
+    {
+        case MechanismTypes::INTAKE:
+            filename += string( "intake.xml" );
+            break;
+
+        case MechanismTypes::BALL_HOPPER:
+            filename += string( "ballhopper.xml" );
+            break;
+
+        case MechanismTypes::BALL_TRANSFER:
+            filename += string( "balltransfer.xml" );
+            break;
+
+        case MechanismTypes::TURRET:
+            filename += string( "turret.xml" );
+            break;
+
+        case MechanismTypes::SHOOTER:
+            filename += string( "shooter.xml" );
+            break;
+
+        default:
+            filename.clear();
+            break;
+    }
+    return filename;
+}
@@ -15,6 +15,7 @@
 //====================================================================================================================================================
 
 #pragma once
+#include <string>
 #include <vector>
 
 #include <subsys/MechanismTypes.h>
@@ -47,4 +48,12 @@ class StateDataDefn
         (
             MechanismTypes::MECHANISM_TYPE mechanism
         );
+
+        /// @brief      Get the deployed mechanismState.xml file for a mechanism
+        /// @param [in] MechanismTypes::MECHANISM_TYPE  - mechanism that the states are for
+        /// @return     std::string - full path to the file (empty if the mechanism has no state file)
+        static std::string GetFileName
+        (
+            MechanismTypes::MECHANISM_TYPE mechanism
+        );
 };
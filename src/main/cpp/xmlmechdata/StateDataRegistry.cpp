@@ -0,0 +1,144 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <controllers/MechanismTargetData.h>
+#include <states/shooter/ShooterDistanceTable.h>
+#include <subsys/MechanismTypes.h>
+#include <utils/Logger.h>
+#include <xmlmechdata/ShooterDistanceDefn.h>
+#include <xmlmechdata/StateDataCache.h>
+#include <xmlmechdata/StateDataDefn.h>
+#include <xmlmechdata/StateDataRegistry.h>
+
+// Third Party Includes
+
+using namespace std;
+
+namespace
+{
+    const char* SHOOTER_DISTANCE_FILE = "/home/lvuser/deploy/shooterdistance.xml";
+}
+
+StateDataRegistry* StateDataRegistry::m_instance = nullptr;
+StateDataRegistry* StateDataRegistry::GetInstance()
+{
+    if ( StateDataRegistry::m_instance == nullptr )
+    {
+        StateDataRegistry::m_instance = new StateDataRegistry();
+    }
+    return StateDataRegistry::m_instance;
+}
+
+StateDataRegistry::StateDataRegistry() : m_targetData(),
+                                         m_parsed(),
+                                         m_shooterDistance()
+{
+    m_parsed.fill( false );
+}
+
+/// @brief  Parse the state data files for all mechanism types and the shooter distance table
+///         concurrently (one task per file)
+/// @return void
+void StateDataRegistry::ParseAll()
+{
+    // create the cache before the tasks start so they share one instance
+    StateDataCache::GetInstance();
+
+    future<ShooterDistanceTable*> distanceTask;
+    if ( m_shooterDistance.get() == nullptr )
+    {
+        distanceTask = async( launch::async, []()
+                                             {
+                                                 auto defn = make_unique<ShooterDistanceDefn>();
+                                                 return defn.get()->ParseXML( string( SHOOTER_DISTANCE_FILE ) );
+                                             } );
+    }
+
+    array<future<vector<MechanismTargetData*>>, MechanismTypes::MAX_MECHANISM_TYPES> tasks;
+    for ( auto inx=0; inx<MechanismTypes::MAX_MECHANISM_TYPES; ++inx )
+    {
+        if ( !m_parsed[inx] )
+        {
+            auto mech = static_cast<MechanismTypes::MECHANISM_TYPE>( inx );
+            tasks[inx] = async( launch::async, [mech]() 
+                                               { 
+                                                   auto stateXML = make_unique<StateDataDefn>();
+                                                   return stateXML.get()->ParseXML( mech ); 
+                                               } );
+        }
+    }
+
+    for ( auto inx=0; inx<MechanismTypes::MAX_MECHANISM_TYPES; ++inx )
+    {
+        if ( tasks[inx].valid() )
+        {
+            m_targetData[inx] = tasks[inx].get();
+            m_parsed[inx] = true;
+        }
+    }
+    if ( distanceTask.valid() )
+    {
+        m_shooterDistance.reset( distanceTask.get() );
+    }
+    Logger::GetLogger()->LogError( string("StateDataRegistry::ParseAll"), string("state data parsed"));
+}
+
+/// @brief      Retrieve the state data for a mechanism.  If ParseAll hasn't been called, the mechanism's
+///             file is parsed now.
+/// @param [in] MechanismTypes::MECHANISM_TYPE - mechanism that the states are for
+/// @return     std::vector<MechanismTargetData*> - state data
+vector<MechanismTargetData*> StateDataRegistry::GetTargetData
+(
+    MechanismTypes::MECHANISM_TYPE  mechanism
+)
+{
+    if ( mechanism < 0 || mechanism >= MechanismTypes::MAX_MECHANISM_TYPES )
+    {
+        Logger::GetLogger()->LogError( string("StateDataRegistry::GetTargetData"), string("invalid mechanism"));
+        return vector<MechanismTargetData*>();
+    }
+
+    if ( !m_parsed[mechanism] )
+    {
+        Logger::GetLogger()->LogError( string("StateDataRegistry::GetTargetData"), string("parsing state data outside of RobotInit"));
+        auto stateXML = make_unique<StateDataDefn>();
+        m_targetData[mechanism] = stateXML.get()->ParseXML( mechanism );
+        m_parsed[mechanism] = true;
+    }
+    return m_targetData[mechanism];
+}
+
+/// @brief      Retrieve the shooter distance calibration table.  If ParseAll hasn't been called,
+///             shooterdistance.xml is parsed now.
+/// @return     const ShooterDistanceTable* - calibration table (empty if the file couldn't be parsed)
+const ShooterDistanceTable* StateDataRegistry::GetShooterDistanceTable()
+{
+    if ( m_shooterDistance.get() == nullptr )
+    {
+        Logger::GetLogger()->LogError( string("StateDataRegistry::GetShooterDistanceTable"), string("parsing shooter distance table outside of RobotInit"));
+        auto defn = make_unique<ShooterDistanceDefn>();
+        m_shooterDistance.reset( defn.get()->ParseXML( string( SHOOTER_DISTANCE_FILE ) ) );
+    }
+    return m_shooterDistance.get();
+}
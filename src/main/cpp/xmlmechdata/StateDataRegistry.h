@@ -0,0 +1,76 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+// C++ Includes
+#include <array>
+#include <memory>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <controllers/MechanismTargetData.h>
+#include <states/shooter/ShooterDistanceTable.h>
+#include <subsys/MechanismTypes.h>
+
+// Third Party Includes
+
+//========================================================================================================
+/// StateDataRegistry.h
+//========================================================================================================
+///
+/// File Description:
+///     Holds the parsed state data for every mechanism type and the shooter distance table.  ParseAll
+///     is called from RobotInit and parses each file on its own task, so the state managers can be
+///     created later (e.g. in TeleopInit) without any file I/O.  After ParseAll the data is read-only.
+///
+//========================================================================================================
+class StateDataRegistry
+{
+    public:
+        /// @brief  Find or create the registry
+        /// @return StateDataRegistry* - pointer to the registry
+        static StateDataRegistry* GetInstance();
+
+        /// @brief  Parse the state data files for all mechanism types and the shooter distance table
+        ///         concurrently (one task per file)
+        /// @return void
+        void ParseAll();
+
+        /// @brief      Retrieve the state data for a mechanism.  If ParseAll hasn't been called, the mechanism's
+        ///             file is parsed now.
+        /// @param [in] MechanismTypes::MECHANISM_TYPE - mechanism that the states are for
+        /// @return     std::vector<MechanismTargetData*> - state data
+        std::vector<MechanismTargetData*> GetTargetData
+        (
+            MechanismTypes::MECHANISM_TYPE  mechanism
+        );
+
+        /// @brief      Retrieve the shooter distance calibration table.  If ParseAll hasn't been called,
+        ///             shooterdistance.xml is parsed now.
+        /// @return     const ShooterDistanceTable* - calibration table (empty if the file couldn't be parsed)
+        const ShooterDistanceTable* GetShooterDistanceTable();
+
+    private:
+        StateDataRegistry();
+        ~StateDataRegistry() = default;
+
+        static StateDataRegistry*                                                               m_instance;
+        std::array<std::vector<MechanismTargetData*>, MechanismTypes::MAX_MECHANISM_TYPES>      m_targetData;
+        std::array<bool, MechanismTypes::MAX_MECHANISM_TYPES>                                   m_parsed;
+        std::unique_ptr<ShooterDistanceTable>                                                   m_shooterDistance;
+};
@@ -0,0 +1,173 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// BallMapTest.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Tests for the galactic search ball map, run on scripted poses and detections:  balls are
+///     confirmed after three sightings and collected by driving over them, and the map is cleared
+///     both by Reset() (what ResetPosition calls when it resets the odometry) and by a pose jump
+///     larger than 0.6 m in one loop.  The robot drives along the field x axis facing +x, and the
+///     one ball sits 2 m ahead of the start.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <cmath>
+
+// FRC includes
+#include <frc/geometry/Pose2d.h>
+#include <frc/geometry/Rotation2d.h>
+#include <units/angle.h>
+#include <units/length.h>
+
+// Team 302 includes
+#include <auton/BallMap.h>
+#include <vision/PowerCellVision.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+namespace
+{
+    constexpr double LOOP    = 0.02;     // seconds
+    constexpr double LATENCY = 0.04;     // image capture to result (seconds)
+    constexpr double BALL_X  = 2.0;      // meters
+
+    frc::Pose2d PoseAt( double x )
+    {
+        return frc::Pose2d( units::length::meter_t( x ), units::length::meter_t( 0.0 ), frc::Rotation2d( units::angle::degree_t( 0.0 ) ) );
+    }
+
+    /// one loop at x; the frame shows the ball as seen from where the robot was when it was captured
+    void Feed
+    (
+        BallMap*    map,
+        double      now,
+        double      x,
+        double      imageX
+    )
+    {
+        PowerCellVision::Detections detections{};
+        detections.timestamp = now - LATENCY;
+        auto distance = BALL_X - imageX;
+        if ( distance > 0.0 )
+        {
+            detections.count = 1;
+            detections.cells[0].bearing  = 0.0;
+            detections.cells[0].distance = distance;
+        }
+        map->Update( now, PoseAt( x ), detections );
+    }
+
+    /// the robot standing at x for a number of loops, starting at the time passed in (returns the time after)
+    double Stand
+    (
+        BallMap*    map,
+        double      now,
+        double      x,
+        int         loops
+    )
+    {
+        for ( auto inx=0; inx<loops; ++inx, now+=LOOP )
+        {
+            Feed( map, now, x, x );
+        }
+        return now;
+    }
+}
+
+TEST( BallMapTest, BallIsConfirmedAfterThreeSightings )
+{
+    auto map = BallMap::GetInstance();
+    map->Reset();
+
+    // the first two frames were captured before the first pose, so they can't be placed
+    auto now = Stand( map, 10.0, 0.0, 4 );
+    EXPECT_EQ( 0U, map->GetRemainingBallCount() );
+
+    Stand( map, now, 0.0, 1 );
+    EXPECT_EQ( 1U, map->GetRemainingBallCount() );
+}
+
+TEST( BallMapTest, DrivingOverTheBallCollectsIt )
+{
+    auto map = BallMap::GetInstance();
+    map->Reset();
+    auto now = Stand( map, 10.0, 0.0, 5 );
+    ASSERT_EQ( 1U, map->GetRemainingBallCount() );
+
+    // 0.1 m per loop is a normal speed (5 m/s); each frame is placed from the pose at its image time,
+    // so it merges into the mapped ball instead of adding one 0.2 m further on
+    auto x = 0.0;
+    for ( ; x < BALL_X - 0.4; x += 0.1, now += LOOP )
+    {
+        Feed( map, now, x, std::max( 0.0, x - 0.2 ) );
+        EXPECT_EQ( 1U, map->GetRemainingBallCount() ) << x;
+    }
+
+    for ( ; x < BALL_X; x += 0.1, now += LOOP )
+    {
+        Feed( map, now, x, x );
+    }
+    EXPECT_EQ( 0U, map->GetRemainingBallCount() );
+}
+
+TEST( BallMapTest, ResetForgetsBallsAndPoses )
+{
+    auto map = BallMap::GetInstance();
+    map->Reset();
+    auto now = Stand( map, 10.0, 0.0, 5 );
+    ASSERT_EQ( 1U, map->GetRemainingBallCount() );
+
+    // ResetPosition moves the odometry to the path's start (1 m back here) and resets the map
+    map->Reset();
+    EXPECT_EQ( 0U, map->GetRemainingBallCount() );
+
+    // frames captured before the reset can't be placed:  there is no pose from then in the new frame
+    for ( auto inx=0; inx<5; ++inx, now+=LOOP )
+    {
+        PowerCellVision::Detections detections{};
+        detections.timestamp = now - 1.0 + inx * LOOP;
+        detections.count = 1;
+        detections.cells[0].bearing  = 0.0;
+        detections.cells[0].distance = BALL_X;
+        map->Update( now, PoseAt( -1.0 ), detections );
+    }
+    EXPECT_EQ( 0U, map->GetRemainingBallCount() );
+
+    // new frames map the ball again in the new frame
+    Stand( map, now, -1.0, 5 );
+    EXPECT_EQ( 1U, map->GetRemainingBallCount() );
+}
+
+TEST( BallMapTest, PoseJumpClearsTheMap )
+{
+    auto map = BallMap::GetInstance();
+    map->Reset();
+    auto now = Stand( map, 10.0, 0.0, 5 );
+    ASSERT_EQ( 1U, map->GetRemainingBallCount() );
+
+    // 0.5 m in one loop is fast but not a reset
+    Feed( map, now, 0.5, 0.5 );
+    now += LOOP;
+    EXPECT_EQ( 1U, map->GetRemainingBallCount() );
+
+    // 0.7 m is an odometry reset that didn't go through Reset()
+    Feed( map, now, -0.2, -0.2 );
+    EXPECT_EQ( 0U, map->GetRemainingBallCount() );
+}
@@ -0,0 +1,158 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// FRC includes
+#include <frc/geometry/Translation2d.h>
+#include <units/length.h>
+
+// Team 302 includes
+#include <auton/GalacticSearchClassifier.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+namespace
+{
+    constexpr double GRID = 0.762;      // meters between grid lines
+
+    /// field position of a grid cell (row A=1 ... E=5)
+    Translation2d Cell( int row, int column )
+    {
+        return Translation2d( units::length::meter_t( column * GRID ), units::length::meter_t( -row * GRID ) );
+    }
+
+    GalacticSearchClassifier::GSResult Classify( const std::vector<Translation2d>& cells )
+    {
+        GalacticSearchClassifier classifier;
+        return classifier.Classify( cells.data(), static_cast<int>( cells.size() ) );
+    }
+}
+
+TEST( GalacticSearchClassifierTest, RedA )
+{
+    auto result = Classify( { Cell( 3, 3 ), Cell( 4, 5 ), Cell( 1, 6 ) } );
+    EXPECT_EQ( GalacticSearchClassifier::RED_A, result.course );
+    EXPECT_EQ( 3, result.matched );
+    EXPECT_GT( result.margin, 0.0 );
+}
+
+TEST( GalacticSearchClassifierTest, BlueA )
+{
+    auto result = Classify( { Cell( 5, 6 ), Cell( 2, 7 ), Cell( 3, 9 ) } );
+    EXPECT_EQ( GalacticSearchClassifier::BLUE_A, result.course );
+    EXPECT_EQ( 3, result.matched );
+}
+
+TEST( GalacticSearchClassifierTest, RedB )
+{
+    auto result = Classify( { Cell( 2, 3 ), Cell( 4, 5 ), Cell( 2, 7 ) } );
+    EXPECT_EQ( GalacticSearchClassifier::RED_B, result.course );
+    EXPECT_EQ( 3, result.matched );
+}
+
+TEST( GalacticSearchClassifierTest, BlueB )
+{
+    auto result = Classify( { Cell( 4, 6 ), Cell( 2, 8 ), Cell( 4, 10 ) } );
+    EXPECT_EQ( GalacticSearchClassifier::BLUE_B, result.course );
+    EXPECT_EQ( 3, result.matched );
+}
+
+TEST( GalacticSearchClassifierTest, NoisyDetectionsWithClutter )
+{
+    // Red B with 0.2 m of position error, one course ball missed and one false detection
+    auto offset = Translation2d( units::length::meter_t( 0.15 ), units::length::meter_t( -0.13 ) );
+    auto result = Classify( { Cell( 2, 3 ) + offset, Cell( 2, 7 ) - offset, Cell( 5, 12 ) } );
+    EXPECT_EQ( GalacticSearchClassifier::RED_B, result.course );
+    EXPECT_EQ( 2, result.matched );
+}
+
+TEST( GalacticSearchClassifierTest, NoDetections )
+{
+    auto result = Classify( {} );
+    EXPECT_EQ( GalacticSearchClassifier::UNKNOWN_COURSE, result.course );
+    EXPECT_EQ( 0, result.matched );
+    EXPECT_EQ( std::string( "" ), GalacticSearchClassifier::GetAutonFile( result.course ) );
+}
+
+TEST( GalacticSearchClassifierTest, NoMatch )
+{
+    // detections, but none near any course ball
+    auto result = Classify( { Cell( 1, 1 ), Cell( 5, 1 ), Cell( 1, 11 ) } );
+    EXPECT_EQ( GalacticSearchClassifier::UNKNOWN_COURSE, result.course );
+    EXPECT_EQ( 0, result.matched );
+}
+
+TEST( GalacticSearchClassifierTest, Tie )
+{
+    // D5 is in both red courses, so seeing only it can't tell them apart
+    auto result = Classify( { Cell( 4, 5 ) } );
+    EXPECT_EQ( GalacticSearchClassifier::UNKNOWN_COURSE, result.course );
+    EXPECT_EQ( 1, result.matched );
+    EXPECT_DOUBLE_EQ( 0.0, result.margin );
+}
+
+TEST( GalacticSearchClassifierTest, ToFieldPositionStraightAhead )
+{
+    // C3 (Red A's first ball) is straight ahead of the camera at the start position
+    auto cell = GalacticSearchClassifier::ToFieldPosition( 0.0, 3.0 * GRID - 0.6096 );
+    EXPECT_NEAR( 3.0 * GRID, cell.X().to<double>(), 1e-9 );
+    EXPECT_NEAR( -2.285, cell.Y().to<double>(), 1e-9 );
+}
+
+TEST( GalacticSearchClassifierTest, ToFieldPositionAngled )
+{
+    // counter-clockwise positive: a reading to the left is toward row A (less negative y)
+    auto left = GalacticSearchClassifier::ToFieldPosition( 24.4, 1.84 );
+    EXPECT_NEAR( Cell( 2, 3 ).X().to<double>(), left.X().to<double>(), 0.02 );
+    EXPECT_NEAR( Cell( 2, 3 ).Y().to<double>(), left.Y().to<double>(), 0.02 );
+
+    auto right = GalacticSearchClassifier::ToFieldPosition( -21.1, 4.25 );
+    EXPECT_NEAR( Cell( 5, 6 ).X().to<double>(), right.X().to<double>(), 0.02 );
+    EXPECT_NEAR( Cell( 5, 6 ).Y().to<double>(), right.Y().to<double>(), 0.02 );
+}
+
+TEST( GalacticSearchClassifierTest, ClassifiesInUnderOneMillisecond )
+{
+    // a full frame: six polar readings converted and classified, averaged over many frames
+    // (the limit is orders of magnitude above the expected time, so a loaded machine won't fail it)
+    const double angles[]    = { -10.9, 7.9, -6.2, 30.0, -35.0, 2.0 };
+    const double distances[] = { 4.04, 5.54, 7.05, 2.5, 3.0, 8.0 };
+    constexpr int FRAMES = 1000;
+
+    GalacticSearchClassifier classifier;
+    auto course = GalacticSearchClassifier::UNKNOWN_COURSE;
+    auto start = std::chrono::steady_clock::now();
+    for ( auto frame=0; frame<FRAMES; ++frame )
+    {
+        Translation2d cells[GalacticSearchClassifier::MAX_DETECTIONS];
+        for ( auto inx=0; inx<GalacticSearchClassifier::MAX_DETECTIONS; ++inx )
+        {
+            cells[inx] = GalacticSearchClassifier::ToFieldPosition( angles[inx], distances[inx] );
+        }
+        course = classifier.Classify( cells, GalacticSearchClassifier::MAX_DETECTIONS ).course;
+    }
+    auto elapsed = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start );
+
+    EXPECT_EQ( GalacticSearchClassifier::BLUE_B, course );
+    EXPECT_LT( elapsed.count() / FRAMES, 1.0 );
+}
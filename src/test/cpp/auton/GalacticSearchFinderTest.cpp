@@ -0,0 +1,89 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <string>
+#include <vector>
+
+// FRC includes
+#include <networktables/NetworkTable.h>
+#include <networktables/NetworkTableInstance.h>
+
+// Team 302 includes
+#include <auton/GalacticSearchFinder.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+namespace
+{
+    /// Publish a frame of power cell readings the way the vision coprocessor does (nearest first)
+    /// and run it through the finder
+    std::string FindPath
+    (
+        const std::vector<double>&  angles,
+        const std::vector<double>&  distances,
+        double                      nearestAngle
+    )
+    {
+        auto table = nt::NetworkTableInstance::GetDefault().GetTable( "visionTable" );
+        table->PutNumberArray( "CellHorizontalAngles", angles );
+        table->PutNumberArray( "CellDistances", distances );
+        table->PutNumber( "NearestCellHorizontalAngle", nearestAngle );
+
+        GalacticSearchFinder finder;
+        return finder.GetGSPathFromVisionTbl_Classifier();
+    }
+}
+
+// Readings are the course balls seen from the start position (angle in degrees counter-clockwise
+// positive, distance in meters) with the distance error the coprocessor typically has
+TEST( GalacticSearchFinderTest, RedA )
+{
+    EXPECT_EQ( std::string( "galactic_red_a.xml" ), FindPath( { 0.4, -13.0, 21.5 }, { 1.71, 3.20, 4.41 }, 0.4 ) );
+}
+
+TEST( GalacticSearchFinderTest, BlueA )
+{
+    EXPECT_EQ( std::string( "galactic_blue_a.xml" ), FindPath( { -21.1, 9.2, -0.4 }, { 4.12, 4.95, 6.02 }, -21.1 ) );
+}
+
+TEST( GalacticSearchFinderTest, RedB )
+{
+    EXPECT_EQ( std::string( "galactic_red_b.xml" ), FindPath( { 24.0, -13.4, 9.5 }, { 1.90, 3.38, 4.60 }, 24.0 ) );
+}
+
+TEST( GalacticSearchFinderTest, BlueB )
+{
+    EXPECT_EQ( std::string( "galactic_blue_b.xml" ), FindPath( { -10.9, 7.9, -6.2 }, { 3.90, 5.70, 6.80 }, -10.9 ) );
+}
+
+TEST( GalacticSearchFinderTest, MissedBallAndClutter )
+{
+    // Blue B with its far ball hidden and a stray reflection at the edge of the frame
+    EXPECT_EQ( std::string( "galactic_blue_b.xml" ), FindPath( { -10.9, 40.0, 7.9 }, { 4.04, 4.20, 5.54 }, -10.9 ) );
+}
+
+TEST( GalacticSearchFinderTest, NoCellArraysFallsBackToAngle )
+{
+    // a coprocessor that only publishes the nearest cell still selects a course from its angle
+    EXPECT_EQ( std::string( "galactic_red_a.xml" ), FindPath( {}, {}, 35.0 ) );
+}
+
+TEST( GalacticSearchFinderTest, UnknownCourseFallsBackToAngle )
+{
+    // cells that match no course defer to the nearest cell angle
+    EXPECT_EQ( std::string( "galactic_red_b.xml" ), FindPath( { -60.0, 60.0 }, { 0.5, 0.5 }, -23.0 ) );
+}
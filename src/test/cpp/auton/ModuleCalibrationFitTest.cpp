@@ -0,0 +1,150 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// ModuleCalibrationFitTest.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Tests for the CalibrateModules fit on known runs.  The circle is walked in small steps to get
+///     the arc each module really rolls, and the drive encoder reports it with the configured (wrong)
+///     wheel diameter; the fit has to give back the true diameter.  On the straight run a module with
+///     a known turn sensor offset error reports its displacement rotated by that error; the fit has to
+///     give back the error.  The chassis is the 14 inch square one in robot.xml.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <array>
+#include <cmath>
+
+// FRC includes
+#include <units/angle.h>
+#include <units/length.h>
+
+// Team 302 includes
+#include <auton/primitives/ModuleCalibrationFit.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+using namespace std;
+
+namespace
+{
+    constexpr double PI          = 3.14159265358979323846;
+    constexpr double HALF_SIZE   = 0.1778;      // half the wheel base and track (meters)
+    constexpr int    STEPS       = 10000;
+
+    // FL, FR, BL, BR (x forward, y left)
+    const array<double, 4> MODULE_X = {  HALF_SIZE,  HALF_SIZE, -HALF_SIZE, -HALF_SIZE };
+    const array<double, 4> MODULE_Y = {  HALF_SIZE, -HALF_SIZE,  HALF_SIZE, -HALF_SIZE };
+
+    /// @brief  Distance a module really travels while the chassis center drives pathLength along an
+    ///         arc of the given curvature, found by walking the arc in small steps
+    double WalkArc
+    (
+        double  moduleX,
+        double  moduleY,
+        double  curvature,
+        double  pathLength
+    )
+    {
+        auto x = 0.0;
+        auto y = 0.0;
+        auto heading = 0.0;
+        auto lastX = moduleX;
+        auto lastY = moduleY;
+        auto arc = 0.0;
+        for ( auto step=1; step<=STEPS; ++step )
+        {
+            auto ds = pathLength / STEPS;
+            heading += 0.5 * curvature * ds;
+            x += ds * cos( heading );
+            y += ds * sin( heading );
+            heading += 0.5 * curvature * ds;
+
+            auto wheelX = x + moduleX * cos( heading ) - moduleY * sin( heading );
+            auto wheelY = y + moduleX * sin( heading ) + moduleY * cos( heading );
+            arc += hypot( wheelX - lastX, wheelY - lastY );
+            lastX = wheelX;
+            lastY = wheelY;
+        }
+        return arc;
+    }
+
+    /// @brief  Diameter ratio fitted for each module after driving pathLength at the curvature with
+    ///         wheels trueRatio times the configured diameter
+    void ExpectDiameterRatio
+    (
+        double  curvature,
+        double  pathLength,
+        double  trueRatio
+    )
+    {
+        auto turn = units::angle::radian_t( abs( curvature ) * pathLength );
+        for ( size_t i=0; i<MODULE_X.size(); ++i )
+        {
+            // the encoder counts wheel turns, so it reports the true distance over the ratio
+            auto reported = units::length::meter_t( WalkArc( MODULE_X[i], MODULE_Y[i], curvature, pathLength ) / trueRatio );
+            auto arc = ModuleCalibrationFit::WheelArc( units::length::meter_t( MODULE_X[i] ), 
+                                                       units::length::meter_t( MODULE_Y[i] ), 
+                                                       curvature, 
+                                                       turn );
+            EXPECT_NEAR( ModuleCalibrationFit::DiameterRatio( arc, reported ), trueRatio, 1e-4 ) << i;
+        }
+    }
+}
+
+/// Two turns to the left on a 1.5 m radius with wheels 4% larger than configured
+TEST( ModuleCalibrationFitTest, DiameterFromLeftCircle )
+{
+    ExpectDiameterRatio( 1.0 / 1.5, 2.0 * 2.0 * PI * 1.5, 1.04 );
+}
+
+/// One and a half turns to the right on a 1 m radius with wheels 3% smaller than configured
+TEST( ModuleCalibrationFitTest, DiameterFromRightCircle )
+{
+    ExpectDiameterRatio( -1.0, 1.5 * 2.0 * PI * 1.0, 0.97 );
+}
+
+/// A wheel that reports no distance can't be fit (and fails the range check)
+TEST( ModuleCalibrationFitTest, NoDistanceIsNoRatio )
+{
+    EXPECT_DOUBLE_EQ( ModuleCalibrationFit::DiameterRatio( units::length::meter_t( 1.0 ), units::length::meter_t( 0.0 ) ), 0.0 );
+}
+
+/// 2 m straight ahead; a module whose offset is 4 degrees off reports its travel 4 degrees to the left
+TEST( ModuleCalibrationFitTest, OffsetFromStraight )
+{
+    constexpr double LENGTH       = 2.0;
+    constexpr double OFFSET_ERROR = 4.0 * PI / 180.0;
+    auto correction = ModuleCalibrationFit::OffsetCorrection( 1.0, 0.0, LENGTH * cos( OFFSET_ERROR ), LENGTH * sin( OFFSET_ERROR ) );
+    EXPECT_NEAR( correction.to<double>(), 4.0, 1e-9 );
+
+    // the robot drifting 2 degrees right is not an offset error
+    auto drift = -2.0 * PI / 180.0;
+    correction = ModuleCalibrationFit::OffsetCorrection( 0.3 * cos( drift ), 0.3 * sin( drift ), LENGTH * cos( drift ), LENGTH * sin( drift ) );
+    EXPECT_NEAR( correction.to<double>(), 0.0, 1e-9 );
+}
+
+/// Directions either side of straight back are 2 degrees apart, not 358
+TEST( ModuleCalibrationFitTest, OffsetWrapsAround )
+{
+    auto travel   = 179.0 * PI / 180.0;
+    auto measured = -179.0 * PI / 180.0;
+    auto correction = ModuleCalibrationFit::OffsetCorrection( cos( travel ), sin( travel ), cos( measured ), sin( measured ) );
+    EXPECT_NEAR( correction.to<double>(), 2.0, 1e-9 );
+}
@@ -0,0 +1,180 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// RoboRIOControlEngineTest.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Tests for the roboRIO control engine's scheduling and overrun accounting.  The loops run on
+///     the engine's notifier against a fake motor that records what is sent to it.  The cycle counts
+///     are checked against wide bounds so a loaded machine doesn't fail the tests.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+// FRC includes
+
+// Team 302 includes
+#include <controllers/ControlData.h>
+#include <controllers/ControlModes.h>
+#include <controllers/RoboRIOControlEngine.h>
+#include <hw/interfaces/IDragonMotorController.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+namespace
+{
+    /// @brief  motor that records the control mode and outputs it is given; the sensors read zero
+    class FakeMotor : public IDragonMotorController
+    {
+        public:
+            double GetRotations() const override { return 0.0; }
+            double GetRPS() const override { return 0.0; }
+            MotorControllerUsage::MOTOR_CONTROLLER_USAGE GetType() const override { return MotorControllerUsage::MOTOR_CONTROLLER_USAGE::UNKNOWN_MOTOR_CONTROLLER_USAGE; }
+            double GetCurrent() const override { return 0.0; }
+            int GetID() const override { return 0; }
+            std::shared_ptr<frc::SpeedController> GetSpeedController() const override { return nullptr; }
+
+            void SetControlMode( ControlModes::CONTROL_TYPE mode ) override { m_mode = mode; }
+            void Set( double value ) override
+            {
+                m_output = value;
+                ++m_sets;
+            }
+            void Set( std::shared_ptr<nt::NetworkTable> nt, double value ) override { Set( value ); }
+            void SetRotationOffset( double rotations ) override {}
+            void SetVoltageRamping( double ramping, double closedLoopRamping ) override {}
+            void EnableCurrentLimiting( bool enabled ) override {}
+            void EnableBrakeMode( bool enabled ) override {}
+            void Invert( bool inverted ) override {}
+            void SetSensorInverted( bool inverted ) override {}
+            void SetDiameter( double diameter ) override {}
+            void SetVoltage( units::volt_t output ) override {}
+            void SetArbitraryFeedForward( double percentOutput ) override {}
+            void SetControlConstants( int slot, ControlData* controlInfo ) override {}
+            void SetRemoteSensor( int canID, ctre::phoenix::motorcontrol::RemoteSensorSource deviceType ) override {}
+            void UpdateFramePeriods( ctre::phoenix::motorcontrol::StatusFrameEnhanced frame, uint8_t milliseconds ) override {}
+            void SetFramePeriodPriority( MOTOR_PRIORITY priority ) override {}
+            double GetCountsPerRev() const override { return 4096.0; }
+            double GetGearRatio() const override { return 1.0; }
+
+            std::atomic<ControlModes::CONTROL_TYPE>     m_mode{ ControlModes::CONTROL_TYPE::POSITION_ABSOLUTE };
+            std::atomic<double>                         m_output{ 0.0 };
+            std::atomic<int>                            m_sets{ 0 };
+    };
+
+    class RoboRIOControlEngineTest : public ::testing::Test
+    {
+        protected:
+            void SetUp() override
+            {
+                m_engine = RoboRIOControlEngine::GetInstance();
+                m_motor = std::make_shared<FakeMotor>();
+            }
+
+            void TearDown() override
+            {
+                m_engine->Stop( m_motor.get() );
+                m_engine->SetPeriod( units::second_t( 0.005 ) );
+            }
+
+            void Wait( int milliseconds )
+            {
+                std::this_thread::sleep_for( std::chrono::milliseconds( milliseconds ) );
+            }
+
+            RoboRIOControlEngine*           m_engine;
+            std::shared_ptr<FakeMotor>      m_motor;
+
+            // p only:  10 rps short of the target is 0.1 percent output
+            ControlData                     m_velocity{ ControlModes::CONTROL_TYPE::VELOCITY_RPS, ControlModes::CONTROL_RUN_LOCS::ROBORIO,
+                                                        "velocity", 0.01, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+    };
+}
+
+TEST_F( RoboRIOControlEngineTest, RunsEveryPeriodAndSendsChangedOutput )
+{
+    m_engine->SetPeriod( units::second_t( 0.005 ) );
+    m_engine->Start( m_motor, &m_velocity );
+    m_engine->SetTarget( m_motor.get(), 10.0 );
+    EXPECT_TRUE( m_engine->IsRunning( m_motor.get() ) );
+    EXPECT_EQ( ControlModes::CONTROL_TYPE::PERCENT_OUTPUT, m_motor->m_mode.load() );
+
+    auto cycles = m_engine->GetCycleCount();
+    Wait( 200 );
+    cycles = m_engine->GetCycleCount() - cycles;
+
+    // 40 cycles at 5 ms; the bounds only catch a loop that doesn't run or runs flat out
+    EXPECT_GE( cycles, 10 );
+    EXPECT_LE( cycles, 60 );
+
+    // an unchanged output isn't sent again (a cycle may have run before the target was set)
+    EXPECT_NEAR( 0.1, m_motor->m_output.load(), 1e-9 );
+    EXPECT_LE( m_motor->m_sets.load(), 2 );
+}
+
+TEST_F( RoboRIOControlEngineTest, SetPeriodChangesTheRate )
+{
+    m_engine->Start( m_motor, &m_velocity );
+    m_engine->SetPeriod( units::second_t( 0.020 ) );
+    auto cycles = m_engine->GetCycleCount();
+    Wait( 200 );
+    cycles = m_engine->GetCycleCount() - cycles;
+
+    // 10 cycles at 20 ms
+    EXPECT_GE( cycles, 3 );
+    EXPECT_LE( cycles, 20 );
+}
+
+TEST_F( RoboRIOControlEngineTest, StopEndsTheMotorsLoop )
+{
+    m_engine->Start( m_motor, &m_velocity );
+    m_engine->SetTarget( m_motor.get(), 10.0 );
+    Wait( 50 );
+    m_engine->Stop( m_motor.get() );
+    EXPECT_FALSE( m_engine->IsRunning( m_motor.get() ) );
+
+    // nothing is written after Stop returns, even when the target changes
+    auto sets = m_motor->m_sets.load();
+    m_engine->SetTarget( m_motor.get(), 50.0 );
+    Wait( 50 );
+    EXPECT_EQ( sets, m_motor->m_sets.load() );
+}
+
+TEST_F( RoboRIOControlEngineTest, CountsCyclesLongerThanThePeriod )
+{
+    m_engine->SetPeriod( units::second_t( 0.002 ) );
+    m_engine->Start( m_motor, &m_velocity );
+
+    // a measurement that takes 2.5 periods makes every cycle an overrun
+    m_engine->SetMeasurement( m_motor.get(), [] { std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) ); return 0.0; } );
+    auto cycles = m_engine->GetCycleCount();
+    auto overruns = m_engine->GetOverrunCount();
+    Wait( 100 );
+    m_engine->Stop( m_motor.get() );
+    cycles = m_engine->GetCycleCount() - cycles;
+    overruns = m_engine->GetOverrunCount() - overruns;
+
+    EXPECT_GE( overruns, 5 );
+    EXPECT_LE( overruns, cycles );
+    EXPECT_GE( m_engine->GetMaxCycleTime().to<double>(), 0.005 );
+}
@@ -0,0 +1,147 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// BallReleaseGateTest.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Tests for the hopper slow release gate:  each ball waits for the previous ball's shot and the
+///     flywheels, the wait time is a fallback, and a release that isn't allowed keeps the shot the
+///     gate is waiting for.
+///
+//========================================================================================================
+
+// C++ Includes
+
+// FRC includes
+
+// Team 302 includes
+#include <states/ballhopper/BallReleaseGate.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+namespace
+{
+    constexpr double WAIT_TIME = 1.5;
+    constexpr double CYCLE = 0.02;
+
+    /// @brief  gate plus the time and shooter inputs of the cycles run so far
+    class BallReleaseGateTest : public ::testing::Test
+    {
+        protected:
+            /// @brief  one cycle; returns true if the ball is held
+            bool Cycle( bool ballDetected, bool allowed = true )
+            {
+                m_now += CYCLE;
+                return m_gate.Update( m_now, ballDetected, m_shots, m_ready, allowed );
+            }
+
+            BallReleaseGate     m_gate{ WAIT_TIME };
+            double              m_now = 0.0;
+            int                 m_shots = 0;
+            bool                m_ready = false;
+    };
+}
+
+TEST_F( BallReleaseGateTest, FirstBallWaitsForTheFlywheels )
+{
+    EXPECT_FALSE( Cycle( false ) );
+    EXPECT_TRUE( Cycle( true ) );
+    EXPECT_TRUE( Cycle( true ) );
+
+    m_ready = true;
+    EXPECT_FALSE( Cycle( true ) );
+    EXPECT_EQ( 1, m_gate.GetBallsSeen() );
+}
+
+TEST_F( BallReleaseGateTest, NextBallWaitsForTheShot )
+{
+    m_ready = true;
+    Cycle( true );
+    Cycle( false );
+
+    // the flywheels still read ready, but the first ball's shot hasn't been seen
+    EXPECT_TRUE( Cycle( true ) );
+    EXPECT_TRUE( Cycle( true ) );
+
+    m_shots = 1;
+    EXPECT_FALSE( Cycle( true ) );
+    EXPECT_EQ( 2, m_gate.GetBallsSeen() );
+}
+
+TEST_F( BallReleaseGateTest, BallIsCountedOnceUntilItClearsTheSensor )
+{
+    m_ready = true;
+    for ( auto inx=0; inx<10; ++inx )
+    {
+        Cycle( true );
+    }
+    EXPECT_EQ( 1, m_gate.GetBallsSeen() );
+
+    Cycle( false );
+    Cycle( true );
+    EXPECT_EQ( 2, m_gate.GetBallsSeen() );
+}
+
+TEST_F( BallReleaseGateTest, WaitTimeIsAFallbackForAMissedShot )
+{
+    m_ready = true;
+    Cycle( true );
+    Cycle( false );
+
+    // no shot is ever detected
+    auto held = 0;
+    while ( Cycle( true ) && held < 1000 )
+    {
+        ++held;
+    }
+    EXPECT_NEAR( WAIT_TIME, held * CYCLE, 2.0 * CYCLE );
+}
+
+TEST_F( BallReleaseGateTest, AimToggleKeepsTheShotState )
+{
+    m_ready = true;
+    Cycle( true );
+    Cycle( false );
+    EXPECT_TRUE( Cycle( true ) );
+
+    // the shot is seen while the aim flickers off and on:  the ball is held and then released at once
+    m_shots = 1;
+    EXPECT_TRUE( Cycle( true, false ) );
+    EXPECT_TRUE( Cycle( true, false ) );
+    EXPECT_FALSE( Cycle( true, true ) );
+    EXPECT_EQ( 2, m_gate.GetBallsSeen() );
+
+    // the third ball still waits for the second ball's shot
+    Cycle( false );
+    EXPECT_TRUE( Cycle( true, false ) );
+    EXPECT_TRUE( Cycle( true, true ) );
+    m_shots = 2;
+    EXPECT_FALSE( Cycle( true, true ) );
+}
+
+TEST_F( BallReleaseGateTest, ResetStartsANewSetOfShots )
+{
+    m_ready = true;
+    Cycle( true );
+    m_gate.Reset();
+    EXPECT_EQ( 0, m_gate.GetBallsSeen() );
+
+    // the first ball after a reset only waits for the flywheels
+    Cycle( false );
+    EXPECT_FALSE( Cycle( true ) );
+}
@@ -0,0 +1,80 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+// C++ Includes
+#include <limits>
+
+// FRC includes
+
+// Team 302 includes
+#include <states/shooter/ShooterDistanceTable.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+namespace
+{
+    ShooterDistanceTable MakeTable()
+    {
+        // out of order on purpose; the table sorts its points
+        return ShooterDistanceTable( { { 200.0, 40.0, 30.0 }, { 100.0, 30.0, 20.0 }, { 150.0, 36.0, 25.0 } } );
+    }
+}
+
+TEST( ShooterDistanceTableTest, InterpolatesBetweenPoints )
+{
+    auto table = MakeTable();
+    double primary = 0.0;
+    double secondary = 0.0;
+    table.GetTargets( 125.0, primary, secondary );
+    EXPECT_DOUBLE_EQ( 33.0, primary );
+    EXPECT_DOUBLE_EQ( 22.5, secondary );
+
+    table.GetTargets( 150.0, primary, secondary );
+    EXPECT_DOUBLE_EQ( 36.0, primary );
+    EXPECT_DOUBLE_EQ( 25.0, secondary );
+}
+
+TEST( ShooterDistanceTableTest, ClampsOutsideTheTable )
+{
+    auto table = MakeTable();
+    double primary = 0.0;
+    double secondary = 0.0;
+    table.GetTargets( 20.0, primary, secondary );
+    EXPECT_DOUBLE_EQ( 30.0, primary );
+    table.GetTargets( 1000.0, primary, secondary );
+    EXPECT_DOUBLE_EQ( 40.0, primary );
+}
+
+TEST( ShooterDistanceTableTest, NonFiniteDistances )
+{
+    auto table = MakeTable();
+    double primary = 0.0;
+    double secondary = 0.0;
+    table.GetTargets( std::numeric_limits<double>::infinity(), primary, secondary );
+    EXPECT_DOUBLE_EQ( 40.0, primary );
+    EXPECT_DOUBLE_EQ( 30.0, secondary );
+
+    table.GetTargets( -std::numeric_limits<double>::infinity(), primary, secondary );
+    EXPECT_DOUBLE_EQ( 30.0, primary );
+    EXPECT_DOUBLE_EQ( 20.0, secondary );
+
+    // NaN keeps the caller's (state data) targets
+    primary = 35.25;
+    secondary = 25.25;
+    table.GetTargets( std::numeric_limits<double>::quiet_NaN(), primary, secondary );
+    EXPECT_DOUBLE_EQ( 35.25, primary );
+    EXPECT_DOUBLE_EQ( 25.25, secondary );
+}
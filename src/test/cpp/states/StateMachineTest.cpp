@@ -0,0 +1,204 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// StateMachineTest.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Tests for the table driven StateMachine.  Buttons come from a scripted pad instead of
+///     TeleopControl, so no controller has to be connected.  The dispatch benchmark is in
+///     src/bench/cpp/states/StateMachineBenchmark.cpp.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <array>
+#include <cstdint>
+
+// FRC includes
+
+// Team 302 includes
+#include <gamepad/TeleopControl.h>
+#include <states/IState.h>
+#include <states/StateMachine.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+namespace
+{
+    /// @brief  buttons for one cycle; a press is a button that is down now and was up last cycle
+    class ScriptedPad
+    {
+        public:
+            void SetButtons( uint64_t down )
+            {
+                m_previous = m_down;
+                m_down = down;
+            }
+
+            bool IsButtonPressed( TeleopControl::FUNCTION_IDENTIFIER function ) const
+            {
+                return ( m_down >> function ) & 1U;
+            }
+
+            bool WasButtonPressed( TeleopControl::FUNCTION_IDENTIFIER function ) const
+            {
+                return IsButtonPressed( function ) && ( ( m_previous >> function ) & 1U ) == 0;
+            }
+
+        private:
+            uint64_t    m_down = 0;
+            uint64_t    m_previous = 0;
+    };
+
+    uint64_t Button( TeleopControl::FUNCTION_IDENTIFIER function )
+    {
+        return uint64_t( 1 ) << function;
+    }
+
+    class CountingState : public IState
+    {
+        public:
+            void Init() override { ++m_inits; }
+            void Run() override { ++m_runs; }
+            bool AtTarget() const override { return true; }
+
+            int     m_inits = 0;
+            int     m_runs = 0;
+    };
+
+    // same shape as the shooter:  off, four prepare-to-shoot states entered from any state
+    enum SHOOTER_STATE
+    {
+        OFF,
+        GREEN,
+        YELLOW,
+        BLUE,
+        RED,
+        MAX_SHOOTER_STATES
+    };
+    using ShooterMachine = StateMachine<SHOOTER_STATE, MAX_SHOOTER_STATES>;
+
+    constexpr std::array<const char*, MAX_SHOOTER_STATES> STATE_NAMES =
+    {
+        "SHOOTEROFF", "SHOOTERSHOOTGREEN", "SHOOTERSHOOTYELLOW", "SHOOTERSHOOTBLUE", "SHOOTERSHOOTRED"
+    };
+
+    bool g_guardOpen = true;
+    bool GuardOpen() { return g_guardOpen; }
+
+    constexpr std::array<ShooterMachine::Transition, 5> TRANSITIONS =
+    {{
+        { MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_GREEN,  GREEN,  nullptr },
+        { MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_YELLOW, YELLOW, nullptr },
+        { MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_BLUE,   BLUE,   nullptr },
+        { MAX_SHOOTER_STATES, TeleopControl::SHOOTER_PREPARE_TO_SHOOT_RED,    RED,    GuardOpen },
+        { GREEN,              TeleopControl::SHOOTER_SHOOT,                   OFF,    nullptr }
+    }};
+
+    class StateMachineTest : public ::testing::Test
+    {
+        protected:
+            void SetUp() override
+            {
+                g_guardOpen = true;
+                for ( auto inx=0; inx<MAX_SHOOTER_STATES; ++inx )
+                {
+                    m_machine.SetState( static_cast<SHOOTER_STATE>( inx ), &m_states[inx] );
+                }
+                m_machine.SetCurrentState( OFF, false, false );
+            }
+
+            /// @brief  one robot cycle:  new button snapshot, then the transitions
+            bool Cycle( uint64_t buttons )
+            {
+                m_pad.SetButtons( buttons );
+                return m_machine.ProcessEvents( &m_pad );
+            }
+
+            ScriptedPad                                         m_pad;
+            std::array<CountingState, MAX_SHOOTER_STATES>       m_states;
+            ShooterMachine                                      m_machine{ STATE_NAMES, TRANSITIONS };
+    };
+}
+
+TEST_F( StateMachineTest, FindState )
+{
+    EXPECT_EQ( BLUE, m_machine.FindState( "SHOOTERSHOOTBLUE" ) );
+    EXPECT_EQ( MAX_SHOOTER_STATES, m_machine.FindState( "NOTASTATE" ) );
+}
+
+TEST_F( StateMachineTest, PressEntersStateOnce )
+{
+    EXPECT_TRUE( Cycle( Button( TeleopControl::SHOOTER_PREPARE_TO_SHOOT_BLUE ) ) );
+    EXPECT_EQ( BLUE, m_machine.GetCurrentStateEnum() );
+
+    // holding the button doesn't re-initialize the state
+    for ( auto inx=0; inx<10; ++inx )
+    {
+        EXPECT_FALSE( Cycle( Button( TeleopControl::SHOOTER_PREPARE_TO_SHOOT_BLUE ) ) );
+    }
+    EXPECT_EQ( 1, m_states[BLUE].m_inits );
+
+    // releasing and pressing again re-enters it
+    Cycle( 0 );
+    EXPECT_TRUE( Cycle( Button( TeleopControl::SHOOTER_PREPARE_TO_SHOOT_BLUE ) ) );
+    EXPECT_EQ( 2, m_states[BLUE].m_inits );
+}
+
+TEST_F( StateMachineTest, FirstTransitionInTableWins )
+{
+    EXPECT_TRUE( Cycle( Button( TeleopControl::SHOOTER_PREPARE_TO_SHOOT_YELLOW ) |
+                        Button( TeleopControl::SHOOTER_PREPARE_TO_SHOOT_GREEN ) ) );
+    EXPECT_EQ( GREEN, m_machine.GetCurrentStateEnum() );
+}
+
+TEST_F( StateMachineTest, TransitionOnlyFromItsState )
+{
+    // shoot only leaves GREEN
+    EXPECT_FALSE( Cycle( Button( TeleopControl::SHOOTER_SHOOT ) ) );
+    EXPECT_EQ( OFF, m_machine.GetCurrentStateEnum() );
+
+    Cycle( Button( TeleopControl::SHOOTER_PREPARE_TO_SHOOT_GREEN ) );
+    EXPECT_TRUE( Cycle( Button( TeleopControl::SHOOTER_SHOOT ) ) );
+    EXPECT_EQ( OFF, m_machine.GetCurrentStateEnum() );
+}
+
+TEST_F( StateMachineTest, GuardBlocksTransition )
+{
+    g_guardOpen = false;
+    EXPECT_FALSE( Cycle( Button( TeleopControl::SHOOTER_PREPARE_TO_SHOOT_RED ) ) );
+    EXPECT_EQ( OFF, m_machine.GetCurrentStateEnum() );
+
+    g_guardOpen = true;
+    Cycle( 0 );
+    EXPECT_TRUE( Cycle( Button( TeleopControl::SHOOTER_PREPARE_TO_SHOOT_RED ) ) );
+    EXPECT_EQ( RED, m_machine.GetCurrentStateEnum() );
+}
+
+TEST_F( StateMachineTest, EntryActionAndRun )
+{
+    SHOOTER_STATE entered = OFF;
+    m_machine.SetEntryAction( [&entered]( SHOOTER_STATE state, bool run ) { entered = state; } );
+    m_machine.SetCurrentState( YELLOW, true, false );
+    EXPECT_EQ( YELLOW, entered );
+    EXPECT_EQ( 1, m_states[YELLOW].m_runs );
+
+    // already current and not re-entering
+    EXPECT_FALSE( m_machine.SetCurrentState( YELLOW, true, false ) );
+    EXPECT_EQ( 1, m_states[YELLOW].m_inits );
+}
@@ -0,0 +1,139 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// FlywheelMonitorTest.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Tests for the flywheel shot detection.  The wheel speeds are the sequences a shot produces:
+///     spin up, settle at the target, dip as the ball goes through and recover.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <subsys/FlywheelMonitor.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+namespace
+{
+    constexpr double TARGET = 50.0;     // rps; the tolerance is 1.5 rps and a shot is a dip of more than 3 rps
+
+    /// @brief  run a speed sequence at the target and return the number of shots detected
+    int Feed( FlywheelMonitor& wheel, const std::vector<double>& speeds )
+    {
+        auto shots = 0;
+        for ( auto speed : speeds )
+        {
+            shots += wheel.Update( true, TARGET, speed ) ? 1 : 0;
+        }
+        return shots;
+    }
+}
+
+TEST( FlywheelMonitorTest, SpinUpIsNotAShot )
+{
+    FlywheelMonitor wheel;
+    EXPECT_EQ( 0, Feed( wheel, { 0.0, 10.0, 25.0, 40.0, 49.0, 50.0 } ) );
+    EXPECT_FALSE( wheel.IsRecovering() );
+
+    // ready after three cycles inside tolerance
+    EXPECT_FALSE( wheel.IsReady() );
+    Feed( wheel, { 50.2 } );
+    EXPECT_TRUE( wheel.IsReady() );
+}
+
+TEST( FlywheelMonitorTest, DipFromSettledWheelIsAShot )
+{
+    FlywheelMonitor wheel;
+    Feed( wheel, { 50.0, 50.0, 50.0 } );
+    EXPECT_TRUE( wheel.IsReady() );
+
+    EXPECT_TRUE( wheel.Update( true, TARGET, 45.0 ) );
+    EXPECT_TRUE( wheel.IsRecovering() );
+    EXPECT_FALSE( wheel.IsReady() );
+
+    // still recovering (and not another shot) while the wheel is slow
+    EXPECT_EQ( 0, Feed( wheel, { 44.0, 46.0, 48.0 } ) );
+    EXPECT_TRUE( wheel.IsRecovering() );
+
+    // back inside tolerance ends the recovery; ready again after three cycles
+    Feed( wheel, { 49.0 } );
+    EXPECT_FALSE( wheel.IsRecovering() );
+    EXPECT_FALSE( wheel.IsReady() );
+    Feed( wheel, { 49.6, 50.0 } );
+    EXPECT_TRUE( wheel.IsReady() );
+}
+
+TEST( FlywheelMonitorTest, SmallDipIsNotAShot )
+{
+    FlywheelMonitor wheel;
+    EXPECT_EQ( 0, Feed( wheel, { 50.0, 50.0, 50.0, 47.5, 48.0, 50.0 } ) );
+    EXPECT_FALSE( wheel.IsRecovering() );
+}
+
+TEST( FlywheelMonitorTest, UnsettledWheelCantDetectAShot )
+{
+    // the wheel never settles, so the dips are part of the spin up
+    FlywheelMonitor wheel;
+    EXPECT_EQ( 0, Feed( wheel, { 50.0, 45.0, 50.0, 50.0, 44.0 } ) );
+}
+
+TEST( FlywheelMonitorTest, CountsEachBallOfAVolley )
+{
+    FlywheelMonitor wheel;
+    std::vector<double> settle = { 50.0, 50.0, 50.0 };
+    std::vector<double> shot   = { 44.0, 45.0, 47.0, 49.0, 50.0, 50.0, 50.0 };
+    auto shots = Feed( wheel, settle );
+    for ( auto ball=0; ball<3; ++ball )
+    {
+        shots += Feed( wheel, shot );
+        EXPECT_TRUE( wheel.IsReady() );
+    }
+    EXPECT_EQ( 3, shots );
+}
+
+TEST( FlywheelMonitorTest, NewSetpointIsASpinUp )
+{
+    FlywheelMonitor wheel;
+    Feed( wheel, { 50.0, 50.0, 50.0 } );
+
+    // 10 rps below the new target, but the wheel hasn't settled at it
+    EXPECT_FALSE( wheel.Update( true, 60.0, 50.0 ) );
+    EXPECT_FALSE( wheel.IsReady() );
+}
+
+TEST( FlywheelMonitorTest, OpenLoopIsNeverReady )
+{
+    FlywheelMonitor wheel;
+    for ( auto inx=0; inx<5; ++inx )
+    {
+        EXPECT_FALSE( wheel.Update( false, TARGET, 50.0 ) );
+    }
+    EXPECT_FALSE( wheel.IsReady() );
+
+    // a recovery ends when the loop is opened
+    Feed( wheel, { 50.0, 50.0, 50.0, 44.0 } );
+    EXPECT_TRUE( wheel.IsRecovering() );
+    wheel.Update( false, TARGET, 44.0 );
+    EXPECT_FALSE( wheel.IsRecovering() );
+}
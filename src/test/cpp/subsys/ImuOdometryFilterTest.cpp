@@ -0,0 +1,220 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// C++ Includes
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <subsys/ImuOdometryFilter.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+using namespace std;
+
+namespace
+{
+    constexpr double PERIOD          = 0.02;    // seconds (robot loop)
+    constexpr double SETTLE_TIME     = 0.5;     // seconds stationary before the path, so the bias is learned
+    constexpr int    SEEDS           = 400;
+    constexpr double FINAL_SCATTER   = 0.001;   // meters; ten standard errors of the summed final error difference
+
+    // sensor models
+    constexpr double MODULE_NOISE    = 0.02;    // meters per second
+    constexpr double ACCEL_NOISE     = 0.1;     // meters per second squared
+    constexpr double MAX_ACCEL_BIAS  = 0.05;    // meters per second squared
+    constexpr double YAW_NOISE       = 0.003;   // radians
+    constexpr double YAW_RATE_NOISE  = 0.005;   // radians per second
+
+    /// One trajectory sample, as exported from the pathweaver json in src/main/deploy/paths:
+    /// time, x, y, heading (radians), velocity, acceleration, curvature
+    struct PathPoint
+    {
+        double  time;
+        double  x;
+        double  y;
+        double  heading;
+        double  velocity;
+        double  acceleration;
+        double  curvature;
+    };
+
+    struct ReplayError
+    {
+        double  eulerRms;       // module velocity integrated at the chassis (EULER_AT_CHASSIS)
+        double  eulerFinal;
+        double  fusedRms;       // ImuOdometryFilter (IMU_FUSED)
+        double  fusedFinal;
+    };
+
+    vector<PathPoint> LoadPath( const string& name )
+    {
+        string file( __FILE__ );
+        auto dir = file.substr( 0, file.rfind( '/' ) + 1 );
+
+        vector<PathPoint> path;
+        auto csv = fopen( ( dir + "replay/" + name + ".csv" ).c_str(), "r" );
+        if ( csv != nullptr )
+        {
+            PathPoint point;
+            while ( fscanf( csv, "%lf %lf %lf %lf %lf %lf %lf", &point.time, &point.x, &point.y, &point.heading, 
+                            &point.velocity, &point.acceleration, &point.curvature ) == 7 )
+            {
+                path.push_back( point );
+            }
+            fclose( csv );
+        }
+        return path;
+    }
+
+    /// Drive the path with synthetic module and pigeon readings and compare both estimates to the truth,
+    /// averaged over SEEDS runs
+    ReplayError Replay( const vector<PathPoint>& path )
+    {
+        ReplayError error{ 0.0, 0.0, 0.0, 0.0 };
+        auto duration = path.back().time;
+        for ( auto seed=0; seed<SEEDS; ++seed )
+        {
+            mt19937 random( seed );
+            normal_distribution<double> noise( 0.0, 1.0 );
+            uniform_real_distribution<double> uniform( 0.0, 1.0 );
+
+            auto x = path[0].x;
+            auto y = path[0].y;
+            auto heading = path[0].heading;
+            auto eulerX = x;
+            auto eulerY = y;
+            ImuOdometryFilter filter;
+            filter.Reset( x, y );
+
+            auto biasX = MAX_ACCEL_BIAS * ( 2.0 * uniform( random ) - 1.0 );
+            auto biasY = MAX_ACCEL_BIAS * ( 2.0 * uniform( random ) - 1.0 );
+
+            size_t inx = 0;
+            auto lastVelocity = 0.0;
+            auto eulerSquares = 0.0;
+            auto fusedSquares = 0.0;
+            auto samples = 0;
+            for ( auto time=-SETTLE_TIME; time<=duration+1e-9; time+=PERIOD )
+            {
+                while ( inx + 1 < path.size() && path[inx+1].time <= time )
+                {
+                    ++inx;
+                }
+
+                // truth:  interpolate the speed and integrate the path finely
+                auto velocity = 0.0;
+                auto curvature = 0.0;
+                if ( time >= 0.0 )
+                {
+                    velocity  = path[inx].velocity;
+                    curvature = path[inx].curvature;
+                    if ( inx + 1 < path.size() )
+                    {
+                        auto u = ( time - path[inx].time ) / ( path[inx+1].time - path[inx].time );
+                        velocity += u * ( path[inx+1].velocity - path[inx].velocity );
+                    }
+                }
+                auto first = time <= -SETTLE_TIME;
+                auto dt = first ? 0.0 : PERIOD;
+                auto acceleration = first ? 0.0 : ( velocity - lastVelocity ) / PERIOD;
+                auto yawRate = velocity * curvature;
+                for ( auto step=0; step<20; ++step )
+                {
+                    // the speed ramps through the step; the sensors only see where it ends
+                    auto speed = lastVelocity + ( step + 0.5 ) / 20.0 * ( velocity - lastVelocity );
+                    heading += 0.5 * speed * curvature * dt / 20.0;
+                    x += speed * cos( heading ) * dt / 20.0;
+                    y += speed * sin( heading ) * dt / 20.0;
+                    heading += 0.5 * speed * curvature * dt / 20.0;
+                }
+                lastVelocity = velocity;
+
+                // sensors (robot frame)
+                auto moving   = velocity > 0.0;
+                auto wheelVx  = moving ? velocity + MODULE_NOISE * noise( random ) : 0.0;
+                auto wheelVy  = moving ? MODULE_NOISE * noise( random ) : 0.0;
+                auto ax       = acceleration + biasX + ACCEL_NOISE * noise( random );
+                auto ay       = velocity * velocity * curvature + biasY + ACCEL_NOISE * noise( random );
+                auto yaw      = heading + YAW_NOISE * noise( random );
+                auto gyroRate = yawRate + YAW_RATE_NOISE * noise( random );
+
+                eulerX += ( wheelVx * cos( yaw ) - wheelVy * sin( yaw ) ) * dt;
+                eulerY += ( wheelVx * sin( yaw ) + wheelVy * cos( yaw ) ) * dt;
+                filter.Update( wheelVx, wheelVy, 1.0, ax, ay, yaw, gyroRate, dt );
+
+                if ( time >= 0.0 )
+                {
+                    eulerSquares += pow( hypot( eulerX - x, eulerY - y ), 2 );
+                    fusedSquares += pow( hypot( filter.GetX() - x, filter.GetY() - y ), 2 );
+                    ++samples;
+                }
+            }
+            error.eulerRms   += sqrt( eulerSquares / samples ) / SEEDS;
+            error.fusedRms   += sqrt( fusedSquares / samples ) / SEEDS;
+            error.eulerFinal += hypot( eulerX - x, eulerY - y ) / SEEDS;
+            error.fusedFinal += hypot( filter.GetX() - x, filter.GetY() - y ) / SEEDS;
+        }
+        return error;
+    }
+
+    const vector<string> PATHS = { "Calibrate", "CalibrateS", "Calibrate_Angle", "Calibrate_CIrcle", "Calibrate_Straight" };
+}
+
+/// Without slip the fused estimate has to be at least as good as the modules alone.  The accelerometer
+/// smooths the module noise out of the velocity, so the error along the path is lower; the final error
+/// ties, since over the whole path both integrate the same module noise.
+TEST( ImuOdometryFilterTest, FusedIsNoWorseThanModules )
+{
+    auto eulerTotal = 0.0;
+    auto fusedTotal = 0.0;
+    for ( const auto& name : PATHS )
+    {
+        auto path = LoadPath( name );
+        ASSERT_FALSE( path.empty() ) << name;
+
+        auto error = Replay( path );
+        EXPECT_LE( error.fusedRms, error.eulerRms ) << name;
+        eulerTotal += error.eulerFinal;
+        fusedTotal += error.fusedFinal;
+    }
+    EXPECT_LE( fusedTotal, eulerTotal + FINAL_SCATTER );
+}
+
+/// Every wheel spinning at once is rejected and the accelerometer carries the velocity through it;
+/// the modules are accepted again once they agree with the accelerometer
+TEST( ImuOdometryFilterTest, AllWheelSpinIsRejected )
+{
+    constexpr double SPEED = 1.0;       // meters per second forward
+    constexpr double SPIN  = 0.6;       // meters per second added to every wheel
+
+    ImuOdometryFilter filter;
+    filter.Reset( 0.0, 0.0 );
+    for ( auto step=0; step<=100; ++step )
+    {
+        auto spinning = step > 50 && step <= 65;
+        filter.Update( SPEED + ( spinning ? SPIN : 0.0 ), 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, step == 0 ? 0.0 : PERIOD );
+        EXPECT_NEAR( filter.GetVx(), SPEED, 0.05 ) << step;
+    }
+    EXPECT_NEAR( filter.GetX(), 100 * PERIOD * SPEED, 0.05 );
+    EXPECT_NEAR( filter.GetY(), 0.0, 1e-9 );
+}
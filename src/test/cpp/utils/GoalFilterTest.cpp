@@ -0,0 +1,158 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// GoalFilterTest.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Tests for the goal Kalman filter:  noisy fixes converge on the goal, fixes that disagree with
+///     the estimate are rejected until the odometry drift makes them plausible, and placing each fix
+///     with the pose from when its image was taken (the pose history) removes the bias a moving
+///     robot would otherwise put into the estimate.  Lengths are inches.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <cmath>
+#include <random>
+
+// FRC includes
+
+// Team 302 includes
+#include <utils/GoalFilter.h>
+#include <utils/PoseHistory.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+namespace
+{
+    constexpr double GOAL_X = 300.0;
+    constexpr double GOAL_Y = 50.0;
+    constexpr double NOISE  = 3.0;      // one standard deviation per axis
+}
+
+TEST( GoalFilterTest, FirstFixSeedsTheFilter )
+{
+    GoalFilter filter;
+    EXPECT_FALSE( filter.IsInitialized() );
+
+    filter.Predict( 100.0 );
+    EXPECT_FALSE( filter.IsInitialized() );
+
+    EXPECT_TRUE( filter.Correct( GOAL_X, GOAL_Y, 9.0, 0.0, 16.0 ) );
+    EXPECT_TRUE( filter.IsInitialized() );
+    EXPECT_DOUBLE_EQ( GOAL_X, filter.GetX() );
+    EXPECT_DOUBLE_EQ( GOAL_Y, filter.GetY() );
+    EXPECT_DOUBLE_EQ( 9.0, filter.GetVariance( 1.0, 0.0 ) );
+    EXPECT_DOUBLE_EQ( 16.0, filter.GetVariance( 0.0, 1.0 ) );
+
+    filter.Reset();
+    EXPECT_FALSE( filter.IsInitialized() );
+}
+
+TEST( GoalFilterTest, NoisyFixesConverge )
+{
+    std::mt19937 rng( 302 );
+    std::normal_distribution<double> noise( 0.0, NOISE );
+
+    GoalFilter filter;
+    const auto r = NOISE * NOISE;
+    for ( auto inx=0; inx<100; ++inx )
+    {
+        filter.Predict( 0.01 );
+        EXPECT_TRUE( filter.Correct( GOAL_X + noise( rng ), GOAL_Y + noise( rng ), r, 0.0, r ) );
+    }
+
+    // the estimate averages the noise down; the drift added each loop keeps the variance from
+    // shrinking below about sqrt( drift * r )
+    EXPECT_NEAR( GOAL_X, filter.GetX(), 1.0 );
+    EXPECT_NEAR( GOAL_Y, filter.GetY(), 1.0 );
+    EXPECT_LT( filter.GetVariance( 1.0, 0.0 ), r / 20.0 );
+    EXPECT_LT( filter.GetVariance( 0.0, 1.0 ), r / 20.0 );
+}
+
+TEST( GoalFilterTest, OutlierIsRejectedUntilDriftAllowsIt )
+{
+    GoalFilter filter;
+    const auto r = NOISE * NOISE;
+    for ( auto inx=0; inx<10; ++inx )
+    {
+        filter.Correct( GOAL_X, GOAL_Y, r, 0.0, r );
+    }
+
+    // 30 in off with a few inches of uncertainty is a bad frame, not the goal
+    EXPECT_FALSE( filter.Correct( GOAL_X + 30.0, GOAL_Y, r, 0.0, r ) );
+    EXPECT_DOUBLE_EQ( GOAL_X, filter.GetX() );
+    EXPECT_DOUBLE_EQ( GOAL_Y, filter.GetY() );
+
+    // after enough odometry drift the same fix is plausible and pulls the estimate most of the way
+    filter.Predict( 1000.0 );
+    EXPECT_TRUE( filter.Correct( GOAL_X + 30.0, GOAL_Y, r, 0.0, r ) );
+    EXPECT_GT( filter.GetX(), GOAL_X + 25.0 );
+    EXPECT_NEAR( GOAL_Y, filter.GetY(), 1e-9 );
+}
+
+TEST( GoalFilterTest, CorrelatedNoiseOnlyGatesAlongItsAxis )
+{
+    // a fix that is noisy in range (x) but precise in bearing (y)
+    GoalFilter filter;
+    filter.Correct( GOAL_X, GOAL_Y, 100.0, 0.0, 1.0 );
+
+    EXPECT_TRUE( filter.Correct( GOAL_X + 20.0, GOAL_Y, 100.0, 0.0, 1.0 ) );
+    EXPECT_FALSE( filter.Correct( GOAL_X, GOAL_Y + 20.0, 100.0, 0.0, 1.0 ) );
+}
+
+TEST( GoalFilterTest, PoseAtImageTimeRemovesLatencyBias )
+{
+    // drive past the goal at 100 in/s; each frame describes the image taken 60 ms earlier
+    constexpr double LOOP    = 0.02;
+    constexpr double LATENCY = 0.06;
+    constexpr double SPEED   = 100.0;
+    const auto r = NOISE * NOISE;
+
+    PoseHistory history;
+    GoalFilter  compensated;
+    GoalFilter  uncompensated;
+    for ( auto inx=0; inx<50; ++inx )
+    {
+        auto now = inx * LOOP;
+        history.Add( PoseHistory::Sample{ now, SPEED * now, 0.0, 0.0, 0.0 } );
+
+        auto imageTime = now - LATENCY;
+        if ( imageTime < 0.0 )
+        {
+            continue;
+        }
+
+        // the camera sees the goal from where the robot was when the image was taken
+        auto dx = GOAL_X - SPEED * imageTime;
+        auto dy = GOAL_Y;
+
+        PoseHistory::Sample pose;
+        ASSERT_TRUE( history.Get( imageTime, pose ) );
+        compensated.Correct( pose.x + dx, pose.y + dy, r, 0.0, r );
+
+        const auto& latest = history.GetLatest();
+        uncompensated.Correct( latest.x + dx, latest.y + dy, r, 0.0, r );
+    }
+
+    EXPECT_NEAR( GOAL_X, compensated.GetX(), 1e-6 );
+    EXPECT_NEAR( GOAL_Y, compensated.GetY(), 1e-6 );
+
+    // without it the goal lands where the robot drove during the latency
+    EXPECT_NEAR( GOAL_X + SPEED * LATENCY, uncompensated.GetX(), 1e-6 );
+}
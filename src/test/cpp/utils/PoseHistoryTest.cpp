@@ -0,0 +1,91 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// PoseHistoryTest.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Tests for the pose history lookup that places camera results at their image time.
+///
+//========================================================================================================
+
+// C++ Includes
+
+// FRC includes
+
+// Team 302 includes
+#include <utils/PoseHistory.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+TEST( PoseHistoryTest, EmptyHistoryHasNoPose )
+{
+    PoseHistory history;
+    PoseHistory::Sample sample;
+    EXPECT_TRUE( history.IsEmpty() );
+    EXPECT_FALSE( history.Get( 1.0, sample ) );
+}
+
+TEST( PoseHistoryTest, InterpolatesBetweenSamples )
+{
+    PoseHistory history;
+    history.Add( PoseHistory::Sample{ 1.00, 10.0, 20.0, 30.0, -10.0 } );
+    history.Add( PoseHistory::Sample{ 1.02, 12.0, 18.0, 40.0,  10.0 } );
+
+    PoseHistory::Sample sample;
+    ASSERT_TRUE( history.Get( 1.005, sample ) );
+    EXPECT_DOUBLE_EQ( 1.005, sample.time );
+    EXPECT_NEAR( 10.5, sample.x, 1e-9 );
+    EXPECT_NEAR( 19.5, sample.y, 1e-9 );
+    EXPECT_NEAR( 32.5, sample.heading, 1e-9 );
+    EXPECT_NEAR( -5.0, sample.turret, 1e-9 );
+
+    // newer than the history is the latest pose; older than it is unknown
+    ASSERT_TRUE( history.Get( 2.0, sample ) );
+    EXPECT_DOUBLE_EQ( 12.0, sample.x );
+    EXPECT_FALSE( history.Get( 0.99, sample ) );
+}
+
+TEST( PoseHistoryTest, HeadingTakesTheShortWayAcrossTheWrap )
+{
+    PoseHistory history;
+    history.Add( PoseHistory::Sample{ 0.0, 0.0, 0.0,  170.0, 0.0 } );
+    history.Add( PoseHistory::Sample{ 1.0, 0.0, 0.0, -170.0, 0.0 } );
+
+    PoseHistory::Sample sample;
+    ASSERT_TRUE( history.Get( 0.5, sample ) );
+    EXPECT_NEAR( 180.0, sample.heading, 1e-9 );
+}
+
+TEST( PoseHistoryTest, KeepsOnlyTheNewestSamples )
+{
+    PoseHistory history;
+    for ( auto inx=0U; inx<PoseHistory::POSE_HISTORY + 10; ++inx )
+    {
+        history.Add( PoseHistory::Sample{ static_cast<double>( inx ), static_cast<double>( inx ), 0.0, 0.0, 0.0 } );
+    }
+
+    PoseHistory::Sample sample;
+    EXPECT_FALSE( history.Get( 9.5, sample ) );
+    ASSERT_TRUE( history.Get( 10.5, sample ) );
+    EXPECT_NEAR( 10.5, sample.x, 1e-9 );
+    EXPECT_DOUBLE_EQ( PoseHistory::POSE_HISTORY + 9.0, history.GetLatest().x );
+
+    history.Reset();
+    EXPECT_TRUE( history.IsEmpty() );
+    EXPECT_FALSE( history.Get( 100.0, sample ) );
+}
@@ -0,0 +1,116 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+//========================================================================================================
+/// ShotSolverTest.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Tests for the shoot on the move lead.  The expected values come from the solver's model:  the
+///     turret lags one 20 ms loop, and a ball takes 0.1 s to leave the shooter and then travels at
+///     500 in/s.  Angles are robot relative degrees (counter-clockwise positive), distances inches.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <cmath>
+
+// FRC includes
+
+// Team 302 includes
+#include <utils/ShotSolver.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+namespace
+{
+    constexpr double TURRET_LAG = 0.02;
+    constexpr double PI = 3.14159265358979323846;
+
+    double TimeOfFlight( double distance )
+    {
+        return 0.10 + distance / 500.0;
+    }
+}
+
+TEST( ShotSolverTest, StationaryRobotHasNoLead )
+{
+    for ( auto bearing : { -60.0, 0.0, 25.0, 90.0 } )
+    {
+        auto solution = ShotSolver::Lead( bearing, 180.0, 0.0, 0.0, 0.0 );
+        EXPECT_NEAR( bearing, solution.turretAngle, 1e-9 );
+        EXPECT_NEAR( 180.0, solution.virtualDistance, 1e-9 );
+        EXPECT_NEAR( 0.0, solution.radialVelocity, 1e-9 );
+        EXPECT_NEAR( 180.0, solution.shooterDistance, 1e-9 );
+    }
+}
+
+TEST( ShotSolverTest, TurningRobotLeadsTheTurretLag )
+{
+    // 90 deg/s for one loop
+    auto solution = ShotSolver::Lead( 10.0, 180.0, 0.0, 0.0, 90.0 );
+    EXPECT_NEAR( 10.0 - 90.0 * TURRET_LAG, solution.turretAngle, 1e-9 );
+    EXPECT_NEAR( 180.0, solution.virtualDistance, 1e-9 );
+}
+
+TEST( ShotSolverTest, DrivingTowardTheGoal )
+{
+    // 200 in ahead at 100 in/s:  198 in after the turret lag, and the ball's 100 in/s carries it
+    // 100 * ( 0.1 + d / 500 ) further, so d = 198 - 10 - 0.2 d = 156.67 in
+    auto solution = ShotSolver::Lead( 0.0, 200.0, 100.0, 0.0, 0.0 );
+    EXPECT_NEAR( 0.0, solution.turretAngle, 1e-9 );
+    EXPECT_NEAR( 156.67, solution.virtualDistance, 0.1 );
+    EXPECT_NEAR( 100.0, solution.radialVelocity, 1e-9 );
+
+    // the wheels are set for the distance 0.15 s later
+    EXPECT_NEAR( solution.virtualDistance - 15.0, solution.shooterDistance, 1e-9 );
+}
+
+TEST( ShotSolverTest, DrivingAcrossTheShot )
+{
+    // 200 in ahead while driving left at 100 in/s:  aim right of the goal by the ball's sideways drift,
+    // d^2 = 200^2 + ( 2 + 100 * ( 0.1 + d / 500 ) )^2, which is 207.0 in at -14.95 degrees
+    auto solution = ShotSolver::Lead( 0.0, 200.0, 0.0, 100.0, 0.0 );
+    EXPECT_NEAR( -14.95, solution.turretAngle, 0.05 );
+    EXPECT_NEAR( 207.0, solution.virtualDistance, 0.1 );
+
+    // moving left takes the robot away from a virtual goal that is to the right
+    EXPECT_LT( solution.radialVelocity, 0.0 );
+    EXPECT_GT( solution.shooterDistance, solution.virtualDistance );
+}
+
+TEST( ShotSolverTest, LeadConvergesToTheFlightTime )
+{
+    // the virtual goal is where the ball's flight time to it, at the robot's velocity, carries it to the goal;
+    // up to 200 in/s, just over the chassis maxVelocity in robot.xml
+    for ( auto speed : { 50.0, 100.0, 150.0, 200.0 } )
+    {
+        for ( auto heading : { 0.0, 45.0, 90.0, 135.0, 180.0, 270.0 } )
+        {
+            auto vx = speed * cos( heading * PI / 180.0 );
+            auto vy = speed * sin( heading * PI / 180.0 );
+            auto solution = ShotSolver::Lead( 30.0, 240.0, vx, vy, 0.0 );
+
+            auto gx = 240.0 * cos( 30.0 * PI / 180.0 ) - vx * TURRET_LAG;
+            auto gy = 240.0 * sin( 30.0 * PI / 180.0 ) - vy * TURRET_LAG;
+            auto tof = TimeOfFlight( solution.virtualDistance );
+            auto tx = solution.virtualDistance * cos( solution.turretAngle * PI / 180.0 );
+            auto ty = solution.virtualDistance * sin( solution.turretAngle * PI / 180.0 );
+            EXPECT_NEAR( gx - vx * tof, tx, 0.1 ) << "speed " << speed << " heading " << heading;
+            EXPECT_NEAR( gy - vy * tof, ty, 0.1 ) << "speed " << speed << " heading " << heading;
+        }
+    }
+}
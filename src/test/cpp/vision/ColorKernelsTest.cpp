@@ -0,0 +1,176 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// C++ Includes
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <vision/ColorKernels.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+using namespace std;
+
+namespace
+{
+    constexpr int WIDTH  = 320;
+
+    // row lengths that exercise full vectors, the scalar tail and rows shorter than one vector
+    const vector<int> ROW_LENGTHS = { 0, 1, 15, 16, 17, 31, 47, 320, 333 };
+
+    /// mask row made of random length runs, so runs start and end at every offset within a vector
+    vector<uint8_t> RandomMask( mt19937& random, int count, int maxRun )
+    {
+        vector<uint8_t> mask( count );
+        uniform_int_distribution<int> runLength( 1, maxRun );
+        auto set = ( random() & 1 ) != 0;
+        for ( auto inx=0; inx<count; set = !set )
+        {
+            auto end = min( count, inx + runLength( random ) );
+            for ( ; inx<end; ++inx )
+            {
+                mask[inx] = set ? 255 : 0;
+            }
+        }
+        return mask;
+    }
+}
+
+/// Every 24-bit color converts to the same H, S and V bytes as the reference
+TEST( ColorKernelsTest, BGRToHSVMatchesReferenceForEveryColor )
+{
+    constexpr int COLORS = 256 * 256;       // one row per blue value
+    vector<uint8_t> bgr( 3 * COLORS );
+    vector<uint8_t> hue( COLORS ), saturation( COLORS ), value( COLORS );
+    vector<uint8_t> refHue( COLORS ), refSaturation( COLORS ), refValue( COLORS );
+
+    for ( auto blue=0; blue<256; ++blue )
+    {
+        for ( auto inx=0; inx<COLORS; ++inx )
+        {
+            bgr[3*inx]   = static_cast<uint8_t>( blue );
+            bgr[3*inx+1] = static_cast<uint8_t>( inx & 0xFF );
+            bgr[3*inx+2] = static_cast<uint8_t>( inx >> 8 );
+        }
+
+        ColorKernels::BGRToHSV( bgr.data(), hue.data(), saturation.data(), value.data(), COLORS );
+        ColorKernels::BGRToHSVReference( bgr.data(), refHue.data(), refSaturation.data(), refValue.data(), COLORS );
+        ASSERT_EQ( hue, refHue ) << "blue " << blue;
+        ASSERT_EQ( saturation, refSaturation ) << "blue " << blue;
+        ASSERT_EQ( value, refValue ) << "blue " << blue;
+    }
+}
+
+/// Spot check the reference against the OpenCV definition
+TEST( ColorKernelsTest, BGRToHSVReferenceValues )
+{
+    const uint8_t bgr[] = { 0, 0, 0,   255, 255, 255,   0, 0, 255,   0, 255, 0,   255, 0, 0,   40, 200, 230 };
+    uint8_t hue[6], saturation[6], value[6];
+    ColorKernels::BGRToHSVReference( bgr, hue, saturation, value, 6 );
+
+    const uint8_t expectedHue[]        = { 0, 0,   0,  60, 120,  25 };
+    const uint8_t expectedSaturation[] = { 0, 0, 255, 255, 255, 211 };
+    const uint8_t expectedValue[]      = { 0, 255, 255, 255, 255, 230 };
+    for ( auto inx=0; inx<6; ++inx )
+    {
+        EXPECT_EQ( hue[inx], expectedHue[inx] ) << "pixel " << inx;
+        EXPECT_EQ( saturation[inx], expectedSaturation[inx] ) << "pixel " << inx;
+        EXPECT_EQ( value[inx], expectedValue[inx] ) << "pixel " << inx;
+    }
+}
+
+TEST( ColorKernelsTest, InRangeMatchesReference )
+{
+    mt19937 random( 302 );
+    uniform_int_distribution<int> byte( 0, 255 );
+    for ( auto count : ROW_LENGTHS )
+    {
+        for ( auto trial=0; trial<200; ++trial )
+        {
+            vector<uint8_t> hue( count ), saturation( count ), value( count );
+            for ( auto inx=0; inx<count; ++inx )
+            {
+                hue[inx]        = static_cast<uint8_t>( byte( random ) % 180 );
+                saturation[inx] = static_cast<uint8_t>( byte( random ) );
+                value[inx]      = static_cast<uint8_t>( byte( random ) );
+            }
+
+            // include the 0 and 255 bounds, where a signed compare would go wrong
+            uint8_t low[3], high[3];
+            for ( auto channel=0; channel<3; ++channel )
+            {
+                auto a = ( trial % 7 == 0 ) ? 0   : byte( random );
+                auto b = ( trial % 5 == 0 ) ? 255 : byte( random );
+                low[channel]  = static_cast<uint8_t>( min( a, b ) );
+                high[channel] = static_cast<uint8_t>( max( a, b ) );
+            }
+
+            vector<uint8_t> mask( count, 1 ), refMask( count, 2 );
+            ColorKernels::InRange( hue.data(), saturation.data(), value.data(), low, high, mask.data(), count );
+            ColorKernels::InRangeReference( hue.data(), saturation.data(), value.data(), low, high, refMask.data(), count );
+            ASSERT_EQ( mask, refMask ) << "count " << count << " trial " << trial;
+        }
+    }
+}
+
+TEST( ColorKernelsTest, FindRunsMatchesReference )
+{
+    mt19937 random( 302 );
+    for ( auto count : ROW_LENGTHS )
+    {
+        for ( auto maxRun : { 1, 3, 16, 40, 400 } )
+        {
+            for ( auto maxRuns : { 1, 4, count / 2 + 1 } )
+            {
+                auto mask = RandomMask( random, count, maxRun );
+                vector<int16_t> starts( maxRuns ), ends( maxRuns ), refStarts( maxRuns ), refEnds( maxRuns );
+                auto runs    = ColorKernels::FindRuns( mask.data(), count, starts.data(), ends.data(), maxRuns );
+                auto refRuns = ColorKernels::FindRunsReference( mask.data(), count, refStarts.data(), refEnds.data(), maxRuns );
+                ASSERT_EQ( runs, refRuns ) << "count " << count << " maxRun " << maxRun << " maxRuns " << maxRuns;
+                for ( auto inx=0; inx<runs; ++inx )
+                {
+                    ASSERT_EQ( starts[inx], refStarts[inx] );
+                    ASSERT_EQ( ends[inx], refEnds[inx] );
+                }
+            }
+        }
+    }
+}
+
+TEST( ColorKernelsTest, FindRunsAllSetAndEmpty )
+{
+    vector<uint8_t> set( WIDTH, 255 ), clear( WIDTH, 0 );
+    int16_t starts[4], ends[4];
+    ASSERT_EQ( ColorKernels::FindRuns( set.data(), WIDTH, starts, ends, 4 ), 1 );
+    EXPECT_EQ( starts[0], 0 );
+    EXPECT_EQ( ends[0], WIDTH );
+    EXPECT_EQ( ColorKernels::FindRuns( clear.data(), WIDTH, starts, ends, 4 ), 0 );
+}
+
+/// x86 builds (the desktop tests) must run the SSE2 kernels, so the tests above cover a vectorized path
+TEST( ColorKernelsTest, VectorizedPathIsBuilt )
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+    EXPECT_STREQ( ColorKernels::GetImplementation(), "SSE2" );
+#elif defined(__arm__) || defined(__aarch64__)
+    EXPECT_STREQ( ColorKernels::GetImplementation(), "NEON" );
+#endif
+}
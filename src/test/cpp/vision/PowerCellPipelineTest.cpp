@@ -0,0 +1,127 @@
+
+//====================================================================================================================================================
+// Copyright 2021 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// C++ Includes
+#include <string>
+
+// FRC includes
+
+// Team 302 includes
+#include <vision/PowerCellPipeline.h>
+
+// Third Party Includes
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgcodecs/imgcodecs.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#include "gtest/gtest.h"
+
+using namespace std;
+
+namespace
+{
+    constexpr int    WIDTH          = 320;
+    constexpr int    HEIGHT         = 240;
+    constexpr double HORIZONTAL_FOV = 61.0;     // degrees (Lifecam HD-3000)
+
+    constexpr double BEARING_TOLERANCE  = 1.0;  // degrees
+    constexpr double DISTANCE_TOLERANCE = 0.12; // fraction of the distance
+
+    /// rendered image from src/test/cpp/vision/images (found relative to this file so the test
+    /// doesn't depend on the directory gradle runs it from)
+    cv::Mat LoadImage( const string& name )
+    {
+        string file( __FILE__ );
+        auto root = file.substr( 0, file.rfind( "src/test/cpp/" ) );
+        return cv::imread( root + "src/test/cpp/vision/images/" + name, cv::IMREAD_COLOR );
+    }
+
+    void ExpectCell
+    (
+        const PowerCellPipeline::PowerCell&     cell,
+        double                                  bearing,
+        double                                  distance
+    )
+    {
+        EXPECT_NEAR( cell.bearing, bearing, BEARING_TOLERANCE );
+        EXPECT_NEAR( cell.distance, distance, distance * DISTANCE_TOLERANCE );
+    }
+}
+
+TEST( PowerCellPipelineTest, FindsCellsNearestFirst )
+{
+    auto image = LoadImage( "path_a_red.png" );
+    ASSERT_FALSE( image.empty() );
+
+    PowerCellPipeline pipeline( WIDTH, HEIGHT, HORIZONTAL_FOV );
+    ASSERT_EQ( pipeline.Process( image ), 3U );
+
+    // the yellow tape stripe is rejected by its shape
+    const auto& cells = pipeline.GetPowerCells();
+    ExpectCell( cells[0], 0.0, 1.5 );
+    ExpectCell( cells[1], -12.0, 3.0 );
+    ExpectCell( cells[2], 18.0, 4.5 );
+}
+
+TEST( PowerCellPipelineTest, IgnoresOtherColors )
+{
+    auto image = LoadImage( "path_b_blue.png" );
+    ASSERT_FALSE( image.empty() );
+
+    PowerCellPipeline pipeline( WIDTH, HEIGHT, HORIZONTAL_FOV );
+    ASSERT_EQ( pipeline.Process( image ), 2U );
+
+    const auto& cells = pipeline.GetPowerCells();
+    ExpectCell( cells[0], 8.0, 2.0 );
+    ExpectCell( cells[1], -20.0, 3.5 );
+}
+
+TEST( PowerCellPipelineTest, EmptyFieldHasNoCells )
+{
+    auto image = LoadImage( "empty.png" );
+    ASSERT_FALSE( image.empty() );
+
+    PowerCellPipeline pipeline( WIDTH, HEIGHT, HORIZONTAL_FOV );
+    EXPECT_EQ( pipeline.Process( image ), 0U );
+}
+
+TEST( PowerCellPipelineTest, ReusedBuffersGiveTheSameResult )
+{
+    auto first  = LoadImage( "path_a_red.png" );
+    auto second = LoadImage( "path_b_blue.png" );
+    ASSERT_FALSE( first.empty() );
+    ASSERT_FALSE( second.empty() );
+
+    // the buffers are reused frame to frame, so nothing from a previous frame may leak into the next one
+    PowerCellPipeline pipeline( WIDTH, HEIGHT, HORIZONTAL_FOV );
+    pipeline.Process( first );
+    pipeline.Process( second );
+    ASSERT_EQ( pipeline.Process( first ), 3U );
+    ExpectCell( pipeline.GetPowerCells()[0], 0.0, 1.5 );
+}
+
+TEST( PowerCellPipelineTest, ResizesOtherImageSizes )
+{
+    auto image = LoadImage( "path_a_red.png" );
+    ASSERT_FALSE( image.empty() );
+
+    // a 640x480 camera gives the same bearings once the pipeline scales it down
+    cv::Mat large;
+    cv::resize( image, large, cv::Size( WIDTH * 2, HEIGHT * 2 ), 0, 0, cv::INTER_NEAREST );
+
+    PowerCellPipeline pipeline( WIDTH, HEIGHT, HORIZONTAL_FOV );
+    ASSERT_EQ( pipeline.Process( large ), 3U );
+    ExpectCell( pipeline.GetPowerCells()[0], 0.0, 1.5 );
+}